@@ -1,7 +1,9 @@
 #include "benchmark/benchmark.h"
 #include <nctl/Array.h>
+#include <nctl/SmallArray.h>
 
 const unsigned int Capacity = 1024;
+const unsigned int SmallCapacity = 8;
 
 static void BM_ArrayCreation(benchmark::State &state)
 {
@@ -121,4 +123,28 @@ static void BM_ArrayReverseErase(benchmark::State &state)
 }
 BENCHMARK(BM_ArrayReverseErase)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity);
 
+static void BM_ArrayTemporary(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		nctl::Array<unsigned int> array(SmallCapacity);
+		for (unsigned int i = 0; i < state.range(0); i++)
+			array.pushBack(i);
+		benchmark::DoNotOptimize(array.data());
+	}
+}
+BENCHMARK(BM_ArrayTemporary)->Arg(SmallCapacity / 2)->Arg(SmallCapacity)->Arg(SmallCapacity * 2);
+
+static void BM_SmallArrayTemporary(benchmark::State &state)
+{
+	for (auto _ : state)
+	{
+		nctl::SmallArray<unsigned int, SmallCapacity> array;
+		for (unsigned int i = 0; i < state.range(0); i++)
+			array.pushBack(i);
+		benchmark::DoNotOptimize(array.data());
+	}
+}
+BENCHMARK(BM_SmallArrayTemporary)->Arg(SmallCapacity / 2)->Arg(SmallCapacity)->Arg(SmallCapacity * 2);
+
 BENCHMARK_MAIN();
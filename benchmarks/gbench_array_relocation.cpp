@@ -0,0 +1,95 @@
+#include "benchmark/benchmark.h"
+#include <nctl/Array.h>
+#include <nctl/UniquePtr.h>
+#include <nctl/String.h>
+
+const unsigned int Capacity = 1024;
+
+namespace {
+
+/// A wrapper that hides the relocatable trait of the contained object
+template <class T>
+struct NotRelocatable
+{
+	explicit NotRelocatable(T &&object)
+	    : object(nctl::move(object)) {}
+	T object;
+};
+
+static_assert(nctl::isTriviallyRelocatable<NotRelocatable<nctl::String>>::value == false, "The wrapper should not be relocatable");
+
+template <class T>
+T createElement(unsigned int i);
+
+template <>
+nctl::UniquePtr<int> createElement(unsigned int i)
+{
+	return nctl::makeUnique<int>(i);
+}
+
+template <>
+nctl::String createElement(unsigned int i)
+{
+	nctl::String string(64);
+	string.format("A string with a heap buffer %u", i);
+	return string;
+}
+
+template <>
+NotRelocatable<nctl::UniquePtr<int>> createElement(unsigned int i)
+{
+	return NotRelocatable<nctl::UniquePtr<int>>(createElement<nctl::UniquePtr<int>>(i));
+}
+
+template <>
+NotRelocatable<nctl::String> createElement(unsigned int i)
+{
+	return NotRelocatable<nctl::String>(createElement<nctl::String>(i));
+}
+
+template <class T>
+void initArray(nctl::Array<T> &array, unsigned int size)
+{
+	for (unsigned int i = 0; i < size; i++)
+		array.pushBack(createElement<T>(i));
+}
+
+}
+
+template <class T>
+static void BM_ArraySetCapacity(benchmark::State &state)
+{
+	nctl::Array<T> array(state.range(0));
+	initArray(array, state.range(0));
+
+	for (auto _ : state)
+	{
+		array.setCapacity(array.capacity() * 2);
+		array.shrinkToFit();
+		benchmark::DoNotOptimize(array.data());
+	}
+}
+BENCHMARK_TEMPLATE(BM_ArraySetCapacity, nctl::UniquePtr<int>)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity);
+BENCHMARK_TEMPLATE(BM_ArraySetCapacity, NotRelocatable<nctl::UniquePtr<int>>)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity);
+BENCHMARK_TEMPLATE(BM_ArraySetCapacity, nctl::String)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity);
+BENCHMARK_TEMPLATE(BM_ArraySetCapacity, NotRelocatable<nctl::String>)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity);
+
+template <class T>
+static void BM_ArrayInsertRemoveFront(benchmark::State &state)
+{
+	nctl::Array<T> array(state.range(0) + 1);
+	initArray(array, state.range(0));
+
+	for (auto _ : state)
+	{
+		array.insertAt(0, createElement<T>(0));
+		array.removeAt(0);
+		benchmark::DoNotOptimize(array.data());
+	}
+}
+BENCHMARK_TEMPLATE(BM_ArrayInsertRemoveFront, nctl::UniquePtr<int>)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity);
+BENCHMARK_TEMPLATE(BM_ArrayInsertRemoveFront, NotRelocatable<nctl::UniquePtr<int>>)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity);
+BENCHMARK_TEMPLATE(BM_ArrayInsertRemoveFront, nctl::String)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity);
+BENCHMARK_TEMPLATE(BM_ArrayInsertRemoveFront, NotRelocatable<nctl::String>)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity);
+
+BENCHMARK_MAIN();
@@ -1,5 +1,7 @@
 #include "benchmark/benchmark.h"
 #include <nctl/HashMap.h>
+#include <nctl/FlatHashMap.h>
+#include <unordered_map>
 #define TEST_WITH_NCTL
 #include "test_movable.h"
 
@@ -10,6 +12,8 @@ using SaxHashMap = nctl::HashMap<unsigned int, Movable, nctl::SaxHashFunc<unsign
 using JenkinsHashMap = nctl::HashMap<unsigned int, Movable, nctl::JenkinsHashFunc<unsigned int>>;
 using FNV1aHashMap = nctl::HashMap<unsigned int, Movable, nctl::FNV1aHashFunc<unsigned int>>;
 using HashMapTestType = FNV1aHashMap;
+using FlatHashMapTestType = nctl::FlatHashMap<unsigned int, Movable, nctl::FNV1aHashFunc<unsigned int>>;
+using StdUnorderedMap = std::unordered_map<unsigned int, Movable>;
 
 static void BM_BigHashMapCreation(benchmark::State &state)
 {
@@ -159,4 +163,211 @@ static void BM_BigHashMapEmplace(benchmark::State &state)
 }
 BENCHMARK(BM_BigHashMapEmplace)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
 
+// The flat hashmap and `std::unordered_map` are measured in the same run for a direct comparison
+
+static void BM_BigFlatHashMapCreation(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	for (auto _ : state)
+	{
+		FlatHashMapTestType map(Capacity);
+		benchmark::DoNotOptimize(map);
+	}
+}
+BENCHMARK(BM_BigFlatHashMapCreation);
+
+static void BM_BigFlatHashMapCopy(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType initMap(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initMap[i] = nctl::move(Movable(Movable::Construction::INITIALIZED));
+	FlatHashMapTestType map(Capacity);
+
+	for (auto _ : state)
+	{
+		map = initMap;
+		benchmark::DoNotOptimize(map);
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_BigFlatHashMapCopy)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_BigFlatHashMapMove(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType initMap(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initMap[i] = nctl::move(Movable(Movable::Construction::INITIALIZED));
+	FlatHashMapTestType map(Capacity);
+
+	for (auto _ : state)
+	{
+		map = nctl::move(initMap);
+		benchmark::DoNotOptimize(map);
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_BigFlatHashMapMove)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_BigFlatHashMapOperatorInsert(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType map(Capacity);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+		{
+			Movable movable(Movable::Construction::INITIALIZED);
+			map[i] = movable;
+		}
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_BigFlatHashMapOperatorInsert)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_BigFlatHashMapOperatorMoveInsert(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType map(Capacity);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+		{
+			Movable movable(Movable::Construction::INITIALIZED);
+			map[i] = nctl::move(movable);
+		}
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_BigFlatHashMapOperatorMoveInsert)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_BigFlatHashMapInsert(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType map(Capacity);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+		{
+			Movable movable(Movable::Construction::INITIALIZED);
+			map.insert(i, movable);
+		}
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_BigFlatHashMapInsert)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_BigFlatHashMapMoveInsert(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType map(Capacity);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+		{
+			Movable movable(Movable::Construction::INITIALIZED);
+			map.insert(i, nctl::move(movable));
+		}
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_BigFlatHashMapMoveInsert)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_BigFlatHashMapEmplace(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType map(Capacity);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			map.emplace(i, Movable::Construction::INITIALIZED);
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_BigFlatHashMapEmplace)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_BigStdUnorderedMapInsert(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	StdUnorderedMap map(Capacity);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+		{
+			Movable movable(Movable::Construction::INITIALIZED);
+			map.emplace(i, movable);
+		}
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_BigStdUnorderedMapInsert)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_BigStdUnorderedMapMoveInsert(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	StdUnorderedMap map(Capacity);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+		{
+			Movable movable(Movable::Construction::INITIALIZED);
+			map.emplace(i, nctl::move(movable));
+		}
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_BigStdUnorderedMapMoveInsert)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_BigStdUnorderedMapEmplace(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	StdUnorderedMap map(Capacity);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			map.emplace(std::piecewise_construct, std::forward_as_tuple(i), std::forward_as_tuple(Movable::Construction::INITIALIZED));
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_BigStdUnorderedMapEmplace)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,119 @@
+#include "benchmark/benchmark.h"
+#include <mutex>
+#include <thread>
+#include <nctl/SpscRingBuffer.h>
+#include <nctl/MpmcQueue.h>
+#include <nctl/List.h>
+
+const unsigned int Capacity = 1024;
+const unsigned int BatchSize = 256;
+
+namespace {
+
+/// A list protected by a mutex, like the queue of the thread pool
+template <class T>
+class LockedQueue
+{
+  public:
+	explicit LockedQueue(unsigned int capacity)
+	    : capacity_(capacity), size_(0) {}
+
+	bool push(const T &element)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (size_ == capacity_)
+			return false;
+		list_.pushBack(element);
+		size_++;
+		return true;
+	}
+
+	bool pop(T &element)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (size_ == 0)
+			return false;
+		element = list_.front();
+		list_.popFront();
+		size_--;
+		return true;
+	}
+
+  private:
+	std::mutex mutex_;
+	nctl::List<T> list_;
+	unsigned int capacity_;
+	unsigned int size_;
+};
+
+/// The queue shared by all the threads of a benchmark
+template <class Queue>
+Queue *&sharedQueue()
+{
+	static Queue *queue = nullptr;
+	return queue;
+}
+
+}
+
+/// Even threads push elements while odd threads pop them, each one moves a batch per iteration
+template <class Queue>
+static void BM_QueueThroughput(benchmark::State &state)
+{
+	// Threads wait on each other before the first iteration and after the last one
+	if (state.thread_index() == 0)
+		sharedQueue<Queue>() = new Queue(Capacity);
+	const bool isProducer = (state.thread_index() % 2 == 0);
+
+	for (auto _ : state)
+	{
+		Queue &queue = *sharedQueue<Queue>();
+		int value = 0;
+		for (unsigned int i = 0; i < BatchSize; i++)
+		{
+			if (isProducer)
+			{
+				while (queue.push(static_cast<int>(i)) == false)
+					std::this_thread::yield();
+			}
+			else
+			{
+				while (queue.pop(value) == false)
+					std::this_thread::yield();
+				benchmark::DoNotOptimize(value);
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * BatchSize);
+
+	if (state.thread_index() == 0)
+	{
+		delete sharedQueue<Queue>();
+		sharedQueue<Queue>() = nullptr;
+	}
+}
+BENCHMARK_TEMPLATE(BM_QueueThroughput, LockedQueue<int>)->Threads(2)->Threads(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueThroughput, nctl::SpscRingBuffer<int>)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueThroughput, nctl::MpmcQueue<int>)->Threads(2)->Threads(4)->UseRealTime();
+
+template <class Queue>
+static void BM_QueuePushPop(benchmark::State &state)
+{
+	Queue queue(Capacity);
+	int value = 0;
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < BatchSize; i++)
+			queue.push(static_cast<int>(i));
+		for (unsigned int i = 0; i < BatchSize; i++)
+			queue.pop(value);
+		benchmark::DoNotOptimize(value);
+	}
+	state.SetItemsProcessed(state.iterations() * BatchSize);
+}
+BENCHMARK_TEMPLATE(BM_QueuePushPop, LockedQueue<int>);
+BENCHMARK_TEMPLATE(BM_QueuePushPop, nctl::SpscRingBuffer<int>);
+BENCHMARK_TEMPLATE(BM_QueuePushPop, nctl::MpmcQueue<int>);
+
+BENCHMARK_MAIN();
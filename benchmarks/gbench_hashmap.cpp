@@ -1,5 +1,10 @@
 #include "benchmark/benchmark.h"
 #include <nctl/HashMap.h>
+#include <nctl/FlatHashMap.h>
+#include <nctl/String.h>
+#include <nctl/HashedName.h>
+#include <unordered_map>
+#include <chrono>
 
 const unsigned int Capacity = 1024;
 const int KeyValueDifference = 10;
@@ -8,6 +13,8 @@ using SaxHashMap = nctl::HashMap<unsigned int, unsigned int, nctl::SaxHashFunc<u
 using JenkinsHashMap = nctl::HashMap<unsigned int, unsigned int, nctl::JenkinsHashFunc<unsigned int>>;
 using FNV1aHashMap = nctl::HashMap<unsigned int, unsigned int, nctl::FNV1aHashFunc<unsigned int>>;
 using HashMapTestType = FNV1aHashMap;
+using FlatHashMapTestType = nctl::FlatHashMap<unsigned int, unsigned int, nctl::FNV1aHashFunc<unsigned int>>;
+using StdUnorderedMap = std::unordered_map<unsigned int, unsigned int>;
 
 static void BM_HashMapCreation(benchmark::State &state)
 {
@@ -147,4 +154,338 @@ static void BM_HashMapRehashDoubleCapacity(benchmark::State &state)
 }
 BENCHMARK(BM_HashMapRehashDoubleCapacity)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
 
+static void BM_HashMapGrow(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	state.counters["Incremental"] = state.range(1);
+	// The lowest of the slowest insertion times of every iteration, to filter out system noise
+	double maxInsertTime = 0.0;
+
+	for (auto _ : state)
+	{
+		HashMapTestType map(Capacity);
+		map.setMaxLoadFactor(0.8f);
+		map.setIncrementalRehash(state.range(1) != 0);
+		double iterationMaxInsertTime = 0.0;
+		for (unsigned int i = 0; i < state.range(0); i++)
+		{
+			// The slowest insertion is the one that triggers a rehash, unless it is incremental
+			const auto start = std::chrono::high_resolution_clock::now();
+			benchmark::DoNotOptimize(map[i] = i + KeyValueDifference);
+			const std::chrono::duration<double, std::micro> elapsed = std::chrono::high_resolution_clock::now() - start;
+			if (elapsed.count() > iterationMaxInsertTime)
+				iterationMaxInsertTime = elapsed.count();
+		}
+		if (maxInsertTime == 0.0 || iterationMaxInsertTime < maxInsertTime)
+			maxInsertTime = iterationMaxInsertTime;
+	}
+	state.counters["MaxInsertUs"] = maxInsertTime;
+}
+BENCHMARK(BM_HashMapGrow)->Args({ Capacity * 16, 0 })->Args({ Capacity * 16, 1 })->Args({ Capacity * 64, 0 })->Args({ Capacity * 64, 1 });
+
+// String keys are looked up like the uniform names of a shader program
+
+using StringHashMapTestType = nctl::HashMap<nctl::String, unsigned int>;
+const unsigned int NumNames = 8;
+const nctl::HashedName Names[NumNames] = { "uTexture", "uProjectionMatrix", "uViewMatrix", "uModelMatrix",
+	                                       "uColor", "uSpriteSize", "uTexRect", "InstanceBlock" };
+
+static void initStringHashMap(StringHashMapTestType &map)
+{
+	for (unsigned int i = 0; i < NumNames; i++)
+		map[Names[i].data()] = i;
+}
+
+static void BM_HashMapFindCString(benchmark::State &state)
+{
+	StringHashMapTestType map(Capacity);
+	initStringHashMap(map);
+
+	unsigned int index = 0;
+	for (auto _ : state)
+	{
+		index = (index + 1) % NumNames;
+		benchmark::DoNotOptimize(map.find(Names[index].data()));
+	}
+}
+BENCHMARK(BM_HashMapFindCString);
+
+static void BM_HashMapFindHashedName(benchmark::State &state)
+{
+	StringHashMapTestType map(Capacity);
+	initStringHashMap(map);
+
+	unsigned int index = 0;
+	for (auto _ : state)
+	{
+		index = (index + 1) % NumNames;
+		benchmark::DoNotOptimize(map.find(Names[index].data(), Names[index].length(), Names[index].hash()));
+	}
+}
+BENCHMARK(BM_HashMapFindHashedName);
+
+static void BM_HashMapFindStringCachedHash(benchmark::State &state)
+{
+	StringHashMapTestType map(Capacity);
+	initStringHashMap(map);
+	nctl::String keys[NumNames];
+	for (unsigned int i = 0; i < NumNames; i++)
+		keys[i] = Names[i].data();
+
+	unsigned int index = 0;
+	for (auto _ : state)
+	{
+		index = (index + 1) % NumNames;
+		benchmark::DoNotOptimize(map.find(keys[index]));
+	}
+}
+BENCHMARK(BM_HashMapFindStringCachedHash);
+
+// The flat hashmap and `std::unordered_map` are measured in the same run for a direct comparison
+
+static void BM_FlatHashMapCreation(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	for (auto _ : state)
+	{
+		FlatHashMapTestType map(Capacity);
+		benchmark::DoNotOptimize(map);
+	}
+}
+BENCHMARK(BM_FlatHashMapCreation);
+
+static void BM_FlatHashMapCopy(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType initMap(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initMap[i] = i * 2;
+	FlatHashMapTestType map(Capacity);
+
+	for (auto _ : state)
+	{
+		map = initMap;
+		benchmark::DoNotOptimize(map);
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_FlatHashMapCopy)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashMapInsert(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType map(Capacity);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			benchmark::DoNotOptimize(map[i] = i + KeyValueDifference);
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_FlatHashMapInsert)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_StdUnorderedMapInsert(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	StdUnorderedMap map(Capacity);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+			benchmark::DoNotOptimize(map[i] = i + KeyValueDifference);
+
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+}
+BENCHMARK(BM_StdUnorderedMapInsert)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashMapGrow(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+
+	for (auto _ : state)
+	{
+		FlatHashMapTestType map(0);
+		for (unsigned int i = 0; i < state.range(0); i++)
+			benchmark::DoNotOptimize(map[i] = i + KeyValueDifference);
+	}
+}
+BENCHMARK(BM_FlatHashMapGrow)->Arg(Capacity)->Arg(Capacity * 4)->Arg(Capacity * 16);
+
+static void BM_StdUnorderedMapGrow(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+
+	for (auto _ : state)
+	{
+		StdUnorderedMap map;
+		for (unsigned int i = 0; i < state.range(0); i++)
+			benchmark::DoNotOptimize(map[i] = i + KeyValueDifference);
+	}
+}
+BENCHMARK(BM_StdUnorderedMapGrow)->Arg(Capacity)->Arg(Capacity * 4)->Arg(Capacity * 16);
+
+static void BM_FlatHashMapRetrieve(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType map(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		map[i] = i * 2;
+
+	unsigned int key = 0;
+	for (auto _ : state)
+	{
+		key = (key + 19) % state.range(0);
+		benchmark::DoNotOptimize(map[key]);
+	}
+}
+BENCHMARK(BM_FlatHashMapRetrieve)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_StdUnorderedMapRetrieve(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	StdUnorderedMap map(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		map[i] = i * 2;
+
+	unsigned int key = 0;
+	for (auto _ : state)
+	{
+		key = (key + 19) % state.range(0);
+		benchmark::DoNotOptimize(map[key]);
+	}
+}
+BENCHMARK(BM_StdUnorderedMapRetrieve)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_HashMapFindMissing(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	HashMapTestType map(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		map[i] = i * 2;
+
+	unsigned int key = 0;
+	for (auto _ : state)
+	{
+		key = (key + 19) % state.range(0);
+		benchmark::DoNotOptimize(map.find(key + Capacity));
+	}
+}
+BENCHMARK(BM_HashMapFindMissing)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashMapFindMissing(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType map(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		map[i] = i * 2;
+
+	unsigned int key = 0;
+	for (auto _ : state)
+	{
+		key = (key + 19) % state.range(0);
+		benchmark::DoNotOptimize(map.find(key + Capacity));
+	}
+}
+BENCHMARK(BM_FlatHashMapFindMissing)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_StdUnorderedMapFindMissing(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	StdUnorderedMap map(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		map[i] = i * 2;
+
+	unsigned int key = 0;
+	for (auto _ : state)
+	{
+		key = (key + 19) % state.range(0);
+		benchmark::DoNotOptimize(map.find(key + Capacity));
+	}
+}
+BENCHMARK(BM_StdUnorderedMapFindMissing)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashMapClear(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType initMap(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initMap[i] = i * 2;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		FlatHashMapTestType map(initMap);
+		state.ResumeTiming();
+
+		map.clear();
+	}
+}
+BENCHMARK(BM_FlatHashMapClear)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashMapRemove(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType initMap(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initMap[i] = i * 2;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		FlatHashMapTestType map(initMap);
+		state.ResumeTiming();
+
+		for (unsigned int i = 0; i < state.range(0); i++)
+			map.remove(i);
+	}
+}
+BENCHMARK(BM_FlatHashMapRemove)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_StdUnorderedMapRemove(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	StdUnorderedMap initMap(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initMap[i] = i * 2;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		StdUnorderedMap map(initMap);
+		state.ResumeTiming();
+
+		for (unsigned int i = 0; i < state.range(0); i++)
+			map.erase(i);
+	}
+}
+BENCHMARK(BM_StdUnorderedMapRemove)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
+static void BM_FlatHashMapRehashDoubleCapacity(benchmark::State &state)
+{
+	state.counters["Capacity"] = Capacity;
+	FlatHashMapTestType initMap(Capacity);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		initMap[i] = i * 2;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		FlatHashMapTestType map(initMap);
+		state.ResumeTiming();
+
+		map.rehash(Capacity * 2);
+	}
+}
+BENCHMARK(BM_FlatHashMapRehashDoubleCapacity)->Arg(Capacity / 4)->Arg(Capacity / 2)->Arg(Capacity / 4 * 3);
+
 BENCHMARK_MAIN();
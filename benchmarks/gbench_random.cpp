@@ -1,9 +1,11 @@
 #include "benchmark/benchmark.h"
 #include <ctime>
 #include <ncine/Random.h>
+#include <nctl/Array.h>
 
 namespace nc = ncine;
 const unsigned int Repetitions = 1024;
+const unsigned int NumParticles = 10000;
 
 static void BM_GenerateInteger(benchmark::State &state)
 {
@@ -89,4 +91,104 @@ static void BM_FastGenerateBoundedReal(benchmark::State &state)
 }
 BENCHMARK(BM_FastGenerateBoundedReal)->Arg(Repetitions);
 
+static void BM_GenerateIntegers(benchmark::State &state)
+{
+	nc::random().init(static_cast<uint64_t>(time(nullptr)), reinterpret_cast<intptr_t>(&nc::random()));
+	nctl::Array<uint32_t> numbers(state.range(0), nctl::ArrayMode::FIXED_CAPACITY);
+	numbers.setSize(state.range(0));
+
+	for (auto _ : state)
+	{
+		nc::random().integers(numbers.data(), state.range(0));
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_GenerateIntegers)->Arg(Repetitions);
+
+static void BM_GenerateBoundedIntegers(benchmark::State &state)
+{
+	nc::random().init(static_cast<uint64_t>(time(nullptr)), reinterpret_cast<intptr_t>(&nc::random()));
+	nctl::Array<uint32_t> numbers(state.range(0), nctl::ArrayMode::FIXED_CAPACITY);
+	numbers.setSize(state.range(0));
+
+	for (auto _ : state)
+	{
+		nc::random().integers(numbers.data(), state.range(0), 50, 100);
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_GenerateBoundedIntegers)->Arg(Repetitions);
+
+static void BM_GenerateReals(benchmark::State &state)
+{
+	nc::random().init(static_cast<uint64_t>(time(nullptr)), reinterpret_cast<intptr_t>(&nc::random()));
+	nctl::Array<float> numbers(state.range(0), nctl::ArrayMode::FIXED_CAPACITY);
+	numbers.setSize(state.range(0));
+
+	for (auto _ : state)
+	{
+		nc::random().reals(numbers.data(), state.range(0));
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_GenerateReals)->Arg(Repetitions);
+
+static void BM_GenerateBoundedReals(benchmark::State &state)
+{
+	nc::random().init(static_cast<uint64_t>(time(nullptr)), reinterpret_cast<intptr_t>(&nc::random()));
+	nctl::Array<float> numbers(state.range(0), nctl::ArrayMode::FIXED_CAPACITY);
+	numbers.setSize(state.range(0));
+
+	for (auto _ : state)
+	{
+		nc::random().reals(numbers.data(), state.range(0), 5.0f, 10.0f);
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_GenerateBoundedReals)->Arg(Repetitions);
+
+// Generating the six random properties of a particle emission, one particle at a time
+static void BM_EmitParticles(benchmark::State &state)
+{
+	nc::random().init(static_cast<uint64_t>(time(nullptr)), reinterpret_cast<intptr_t>(&nc::random()));
+	nctl::Array<float> properties(state.range(0) * 6, nctl::ArrayMode::FIXED_CAPACITY);
+	properties.setSize(state.range(0) * 6);
+
+	for (auto _ : state)
+	{
+		for (unsigned int i = 0; i < state.range(0); i++)
+		{
+			properties[i * 6 + 0] = nc::random().real(1.0f, 2.0f);
+			properties[i * 6 + 1] = nc::random().real(-10.0f, 10.0f);
+			properties[i * 6 + 2] = nc::random().real(-10.0f, 10.0f);
+			properties[i * 6 + 3] = nc::random().real(-5.0f, 5.0f);
+			properties[i * 6 + 4] = nc::random().real(50.0f, 100.0f);
+			properties[i * 6 + 5] = nc::random().real(0.0f, 360.0f);
+		}
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_EmitParticles)->Arg(NumParticles);
+
+// Generating the six random properties of a particle emission in bulk, one property at a time
+static void BM_EmitParticlesBulk(benchmark::State &state)
+{
+	nc::random().init(static_cast<uint64_t>(time(nullptr)), reinterpret_cast<intptr_t>(&nc::random()));
+	const unsigned int count = state.range(0);
+	nctl::Array<float> properties(count * 6, nctl::ArrayMode::FIXED_CAPACITY);
+	properties.setSize(count * 6);
+
+	for (auto _ : state)
+	{
+		nc::random().reals(&properties[count * 0], count, 1.0f, 2.0f);
+		nc::random().reals(&properties[count * 1], count, -10.0f, 10.0f);
+		nc::random().reals(&properties[count * 2], count, -10.0f, 10.0f);
+		nc::random().reals(&properties[count * 3], count, -5.0f, 5.0f);
+		nc::random().reals(&properties[count * 4], count, 50.0f, 100.0f);
+		nc::random().reals(&properties[count * 5], count, 0.0f, 360.0f);
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_EmitParticlesBulk)->Arg(NumParticles);
+
 BENCHMARK_MAIN();
@@ -1,5 +1,6 @@
 #include "benchmark/benchmark.h"
 #include <nctl/String.h>
+#include <nctl/Array.h>
 
 const unsigned int Length = 256;
 
@@ -85,4 +86,75 @@ static void BM_StringClear(benchmark::State &state)
 }
 BENCHMARK(BM_StringClear)->Arg(Length / 4)->Arg(Length / 2)->Arg(Length);
 
+static void BM_StringUtf8Decode(benchmark::State &state)
+{
+	nctl::String string(state.range(0) + 1);
+	string.setLength(state.range(0));
+	for (unsigned int i = 0; i < state.range(0); i++)
+		string[i] = '0';
+	nctl::Array<unsigned int> codePoints(state.range(0), nctl::ArrayMode::FIXED_CAPACITY);
+	codePoints.setSize(state.range(0));
+
+	for (auto _ : state)
+	{
+		unsigned int numCodePoints = 0;
+		for (unsigned int i = 0; i < string.length();) // increments handled by UTF-8 decoding
+			i += string.utf8ToCodePoint(i, codePoints[numCodePoints++]);
+		benchmark::DoNotOptimize(numCodePoints);
+	}
+}
+BENCHMARK(BM_StringUtf8Decode)->Arg(Length / 4)->Arg(Length / 2)->Arg(Length);
+
+static void BM_StringUtf8DecodeBulk(benchmark::State &state)
+{
+	nctl::String string(state.range(0) + 1);
+	string.setLength(state.range(0));
+	for (unsigned int i = 0; i < state.range(0); i++)
+		string[i] = '0';
+	nctl::Array<unsigned int> codePoints(state.range(0), nctl::ArrayMode::FIXED_CAPACITY);
+	codePoints.setSize(state.range(0));
+
+	for (auto _ : state)
+	{
+		const unsigned int numCodePoints = string.utf8ToCodePoints(codePoints.data());
+		benchmark::DoNotOptimize(numCodePoints);
+	}
+}
+BENCHMARK(BM_StringUtf8DecodeBulk)->Arg(Length / 4)->Arg(Length / 2)->Arg(Length);
+
+static void BM_StringUtf8DecodeCjk(benchmark::State &state)
+{
+	// Every code point is encoded with three code units
+	nctl::String string(state.range(0) * 3 + 1);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		string.append("字");
+	nctl::Array<unsigned int> codePoints(string.length(), nctl::ArrayMode::FIXED_CAPACITY);
+	codePoints.setSize(string.length());
+
+	for (auto _ : state)
+	{
+		unsigned int numCodePoints = 0;
+		for (unsigned int i = 0; i < string.length();) // increments handled by UTF-8 decoding
+			i += string.utf8ToCodePoint(i, codePoints[numCodePoints++]);
+		benchmark::DoNotOptimize(numCodePoints);
+	}
+}
+BENCHMARK(BM_StringUtf8DecodeCjk)->Arg(Length / 4)->Arg(Length / 2)->Arg(Length);
+
+static void BM_StringUtf8DecodeCjkBulk(benchmark::State &state)
+{
+	nctl::String string(state.range(0) * 3 + 1);
+	for (unsigned int i = 0; i < state.range(0); i++)
+		string.append("字");
+	nctl::Array<unsigned int> codePoints(string.length(), nctl::ArrayMode::FIXED_CAPACITY);
+	codePoints.setSize(string.length());
+
+	for (auto _ : state)
+	{
+		const unsigned int numCodePoints = string.utf8ToCodePoints(codePoints.data());
+		benchmark::DoNotOptimize(numCodePoints);
+	}
+}
+BENCHMARK(BM_StringUtf8DecodeCjkBulk)->Arg(Length / 4)->Arg(Length / 2)->Arg(Length);
+
 BENCHMARK_MAIN();
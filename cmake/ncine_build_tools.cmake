@@ -0,0 +1,24 @@
+if(NCINE_BUILD_TOOLS AND NOT ANDROID AND NOT EMSCRIPTEN)
+	add_executable(ncine_pack ${CMAKE_SOURCE_DIR}/tools/ncine_pack.cpp)
+	target_link_libraries(ncine_pack PRIVATE ncine)
+	# The archive format header is shared with the engine sources
+	target_include_directories(ncine_pack PRIVATE ${CMAKE_SOURCE_DIR}/src/include)
+	set_target_properties(ncine_pack PROPERTIES FOLDER "Tools")
+
+	add_executable(ncine_replay ${CMAKE_SOURCE_DIR}/tools/ncine_replay.cpp)
+	target_link_libraries(ncine_replay PRIVATE ncine)
+	# The capture format and the queue rules headers are shared with the engine sources
+	target_include_directories(ncine_replay PRIVATE ${CMAKE_SOURCE_DIR}/src/include)
+	set_target_properties(ncine_replay PROPERTIES FOLDER "Tools")
+
+	if(WIN32 AND NCINE_DYNAMIC_LIBRARY)
+		add_custom_command(TARGET ncine_pack POST_BUILD
+			COMMAND ${CMAKE_COMMAND} -E copy_if_different $<TARGET_FILE:ncine> $<TARGET_FILE_DIR:ncine_pack>
+			COMMENT "Copying nCine DLL to tools..."
+		)
+	endif()
+
+	if(NCINE_INSTALL_DEV_SUPPORT)
+		install(TARGETS ncine_pack ncine_replay RUNTIME DESTINATION ${RUNTIME_INSTALL_DESTINATION} COMPONENT devsupport)
+	endif()
+endif()
@@ -101,6 +101,7 @@ if(OPENAL_FOUND)
 
 	list(APPEND HEADERS
 		${NCINE_ROOT}/include/ncine/AudioBuffer.h
+		${NCINE_ROOT}/include/ncine/AudioBufferCache.h
 		${NCINE_ROOT}/include/ncine/AudioStream.h
 		${NCINE_ROOT}/include/ncine/IAudioPlayer.h
 		${NCINE_ROOT}/include/ncine/AudioBufferPlayer.h
@@ -121,6 +122,7 @@ if(OPENAL_FOUND)
 		${NCINE_ROOT}/src/audio/AudioLoaderWav.cpp
 		${NCINE_ROOT}/src/audio/AudioReaderWav.cpp
 		${NCINE_ROOT}/src/audio/AudioBuffer.cpp
+		${NCINE_ROOT}/src/audio/AudioBufferCache.cpp
 		${NCINE_ROOT}/src/audio/AudioStream.cpp
 		${NCINE_ROOT}/src/audio/IAudioPlayer.cpp
 		${NCINE_ROOT}/src/audio/AudioBufferPlayer.cpp
@@ -228,6 +230,7 @@ if(LUA_FOUND)
 
 	list(APPEND PRIVATE_HEADERS
 		${NCINE_ROOT}/src/include/LuaNames.h
+		${NCINE_ROOT}/src/include/LuaCallbacks.h
 		${NCINE_ROOT}/src/include/LuaStatistics.h
 	)
 
@@ -272,6 +275,7 @@ if(LUA_FOUND)
 			${NCINE_ROOT}/src/include/LuaSceneNode.h
 			${NCINE_ROOT}/src/include/LuaDrawableNode.h
 			${NCINE_ROOT}/src/include/LuaTexture.h
+			${NCINE_ROOT}/src/include/LuaTextureReadback.h
 			${NCINE_ROOT}/src/include/LuaBaseSprite.h
 			${NCINE_ROOT}/src/include/LuaSprite.h
 			${NCINE_ROOT}/src/include/LuaMeshSprite.h
@@ -308,6 +312,7 @@ if(LUA_FOUND)
 			${NCINE_ROOT}/src/scripting/LuaSceneNode.cpp
 			${NCINE_ROOT}/src/scripting/LuaDrawableNode.cpp
 			${NCINE_ROOT}/src/scripting/LuaTexture.cpp
+			${NCINE_ROOT}/src/scripting/LuaTextureReadback.cpp
 			${NCINE_ROOT}/src/scripting/LuaBaseSprite.cpp
 			${NCINE_ROOT}/src/scripting/LuaSprite.cpp
 			${NCINE_ROOT}/src/scripting/LuaMeshSprite.cpp
@@ -375,6 +380,8 @@ if(NCINE_WITH_ALLOCATORS)
 		${NCINE_ROOT}/include/nctl/PoolAllocator.h
 		${NCINE_ROOT}/include/nctl/FreeListAllocator.h
 		${NCINE_ROOT}/include/nctl/ProxyAllocator.h
+		${NCINE_ROOT}/include/nctl/FrameAllocator.h
+		${NCINE_ROOT}/include/nctl/AllocTelemetry.h
 	)
 
 	list(APPEND SOURCES
@@ -386,6 +393,8 @@ if(NCINE_WITH_ALLOCATORS)
 		${NCINE_ROOT}/src/base/PoolAllocator.cpp
 		${NCINE_ROOT}/src/base/FreeListAllocator.cpp
 		${NCINE_ROOT}/src/base/ProxyAllocator.cpp
+		${NCINE_ROOT}/src/base/FrameAllocator.cpp
+		${NCINE_ROOT}/src/base/AllocTelemetry.cpp
 	)
 endif()
 
@@ -231,6 +231,7 @@ if(NCINE_WITH_ALLOCATORS)
 		file(APPEND ${CFGALLOC_H_FILE} "#define USE_FREELIST\n")
 		file(APPEND ${CFGALLOC_H_FILE} "#define FREELIST_BUFFER (${NCINE_FREELIST_BUFFER})\n")
 	endif()
+	file(APPEND ${CFGALLOC_H_FILE} "#define FRAME_ALLOCATOR_BUFFER (${NCINE_FRAME_ALLOCATOR_BUFFER})\n")
 endif()
 
 if(EXISTS ${CMAKE_SOURCE_DIR}/config.h.in)
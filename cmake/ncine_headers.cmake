@@ -34,9 +34,11 @@ set(HEADERS
 	${NCINE_ROOT}/include/ncine/Font.h
 	${NCINE_ROOT}/include/ncine/FileSystem.h
 	${NCINE_ROOT}/include/ncine/IFile.h
+	${NCINE_ROOT}/include/ncine/AssetArchive.h
 	${NCINE_ROOT}/include/ncine/IGfxDevice.h
 	${NCINE_ROOT}/include/ncine/Texture.h
 	${NCINE_ROOT}/include/ncine/ITextureSaver.h
+	${NCINE_ROOT}/include/ncine/TextureReadback.h
 	${NCINE_ROOT}/include/ncine/Shader.h
 	${NCINE_ROOT}/include/ncine/ShaderState.h
 	${NCINE_ROOT}/include/ncine/SceneNode.h
@@ -54,6 +56,8 @@ set(HEADERS
 	${NCINE_ROOT}/include/ncine/TextNode.h
 	${NCINE_ROOT}/include/ncine/RectAnimation.h
 	${NCINE_ROOT}/include/ncine/AnimatedSprite.h
+	${NCINE_ROOT}/include/ncine/StaticBatchNode.h
+	${NCINE_ROOT}/include/ncine/TileMapNode.h
 	${NCINE_ROOT}/include/ncine/Viewport.h
 	${NCINE_ROOT}/include/ncine/Camera.h
 )
@@ -67,6 +71,7 @@ set(NCTL_HEADERS
 	${NCINE_ROOT}/include/nctl/Array.h
 	${NCINE_ROOT}/include/nctl/ArrayIterator.h
 	${NCINE_ROOT}/include/nctl/StaticArray.h
+	${NCINE_ROOT}/include/nctl/SmallArray.h
 	${NCINE_ROOT}/include/nctl/List.h
 	${NCINE_ROOT}/include/nctl/ListIterator.h
 	${NCINE_ROOT}/include/nctl/CString.h
@@ -75,12 +80,16 @@ set(NCTL_HEADERS
 	${NCINE_ROOT}/include/nctl/StaticString.h
 	${NCINE_ROOT}/include/nctl/StringIterator.h
 	${NCINE_ROOT}/include/nctl/HashFunctions.h
+	${NCINE_ROOT}/include/nctl/HashedName.h
 	${NCINE_ROOT}/include/nctl/HashMap.h
 	${NCINE_ROOT}/include/nctl/HashMapIterator.h
 	${NCINE_ROOT}/include/nctl/StaticHashMap.h
 	${NCINE_ROOT}/include/nctl/StaticHashMapIterator.h
 	${NCINE_ROOT}/include/nctl/HashMapList.h
 	${NCINE_ROOT}/include/nctl/HashMapListIterator.h
+	${NCINE_ROOT}/include/nctl/FlatHashGroup.h
+	${NCINE_ROOT}/include/nctl/FlatHashMap.h
+	${NCINE_ROOT}/include/nctl/FlatHashMapIterator.h
 	${NCINE_ROOT}/include/nctl/HashSet.h
 	${NCINE_ROOT}/include/nctl/HashSetIterator.h
 	${NCINE_ROOT}/include/nctl/StaticHashSet.h
@@ -91,6 +100,8 @@ set(NCTL_HEADERS
 	${NCINE_ROOT}/include/nctl/SparseSetIterator.h
 	${NCINE_ROOT}/include/nctl/ReverseIterator.h
 	${NCINE_ROOT}/include/nctl/Atomic.h
+	${NCINE_ROOT}/include/nctl/SpscRingBuffer.h
+	${NCINE_ROOT}/include/nctl/MpmcQueue.h
 	${NCINE_ROOT}/include/nctl/UniquePtr.h
 	${NCINE_ROOT}/include/nctl/SharedPtr.h
 	${NCINE_ROOT}/include/nctl/BitSet.h
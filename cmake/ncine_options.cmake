@@ -1,6 +1,7 @@
 option(NCINE_BUILD_TESTS "Build the engine test programs" ON)
 option(NCINE_BUILD_UNIT_TESTS "Build the engine unit tests" OFF)
 option(NCINE_BUILD_BENCHMARKS "Build the engine micro benchmarks" OFF)
+option(NCINE_BUILD_TOOLS "Build the asset packing and render replay tools" ON)
 option(NCINE_INSTALL_DEV_SUPPORT "Install files to support development" ON)
 option(NCINE_LINKTIME_OPTIMIZATION "Compile the engine with link time optimization when in release" OFF)
 option(NCINE_AUTOVECTORIZATION_REPORT "Enable report generation from compiler auto-vectorization" OFF)
@@ -66,6 +67,7 @@ if(NCINE_WITH_ALLOCATORS)
 	option(NCINE_OVERRIDE_NEW "Override global new and delete operators to use custom allocators" OFF)
 	option(NCINE_USE_FREELIST "Use the free list custom allocator instead of malloc()/free()" OFF)
 	set(NCINE_FREELIST_BUFFER "33554432" CACHE STRING "Size in bytes of the free list allocator buffer")
+	set(NCINE_FRAME_ALLOCATOR_BUFFER "2097152" CACHE STRING "Size in bytes of the frame allocator buffer, split between two frames")
 endif()
 
 if(NCINE_WITH_RENDERDOC)
@@ -103,6 +105,7 @@ if(NCINE_USING_OPTIONS_PRESETS)
 	set(NCINE_BUILD_TESTS ON)
 	set(NCINE_BUILD_UNIT_TESTS OFF)
 	set(NCINE_BUILD_BENCHMARKS OFF)
+	set(NCINE_BUILD_TOOLS ON)
 	set(NCINE_LINKTIME_OPTIMIZATION ON)
 	set(NCINE_AUTOVECTORIZATION_REPORT OFF)
 	set(NCINE_DYNAMIC_LIBRARY ON)
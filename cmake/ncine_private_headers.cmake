@@ -5,6 +5,9 @@ set(PRIVATE_HEADERS
 	${NCINE_ROOT}/src/include/ArrayIndexer.h
 	${NCINE_ROOT}/src/include/FrameTimer.h
 	${NCINE_ROOT}/src/include/MemoryFile.h
+	${NCINE_ROOT}/src/include/MappedFile.h
+	${NCINE_ROOT}/src/include/ArchiveFile.h
+	${NCINE_ROOT}/src/include/AssetArchiveFormat.h
 	${NCINE_ROOT}/src/include/StandardFile.h
 	${NCINE_ROOT}/src/include/FileLogger.h
 	${NCINE_ROOT}/src/include/JoyMapping.h
@@ -15,6 +18,12 @@ set(PRIVATE_HEADERS
 	${NCINE_ROOT}/src/include/RenderResources.h
 	${NCINE_ROOT}/src/include/RenderCommand.h
 	${NCINE_ROOT}/src/include/RenderQueue.h
+	${NCINE_ROOT}/src/include/RenderQueueRules.h
+	${NCINE_ROOT}/src/include/RenderCommandTraits.h
+	${NCINE_ROOT}/src/include/TriangleStrip.h
+	${NCINE_ROOT}/src/include/TransformRect.h
+	${NCINE_ROOT}/src/include/RenderCapture.h
+	${NCINE_ROOT}/src/include/RenderCaptureFormat.h
 	${NCINE_ROOT}/src/include/Material.h
 	${NCINE_ROOT}/src/include/Geometry.h
 	${NCINE_ROOT}/src/include/TextureFormat.h
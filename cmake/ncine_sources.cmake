@@ -19,6 +19,9 @@ set(SOURCES
 	${NCINE_ROOT}/src/FileSystem.cpp
 	${NCINE_ROOT}/src/IFile.cpp
 	${NCINE_ROOT}/src/MemoryFile.cpp
+	${NCINE_ROOT}/src/MappedFile.cpp
+	${NCINE_ROOT}/src/ArchiveFile.cpp
+	${NCINE_ROOT}/src/AssetArchive.cpp
 	${NCINE_ROOT}/src/StandardFile.cpp
 	${NCINE_ROOT}/src/input/IInputManager.cpp
 	${NCINE_ROOT}/src/input/JoyMapping.cpp
@@ -30,6 +33,7 @@ set(SOURCES
 	${NCINE_ROOT}/src/graphics/RenderResources.cpp
 	${NCINE_ROOT}/src/graphics/RenderCommand.cpp
 	${NCINE_ROOT}/src/graphics/RenderQueue.cpp
+	${NCINE_ROOT}/src/graphics/RenderCapture.cpp
 	${NCINE_ROOT}/src/graphics/Material.cpp
 	${NCINE_ROOT}/src/graphics/Geometry.cpp
 	${NCINE_ROOT}/src/graphics/TextureFormat.cpp
@@ -40,6 +44,7 @@ set(SOURCES
 	${NCINE_ROOT}/src/graphics/TextureLoaderKtx.cpp
 	${NCINE_ROOT}/src/graphics/ITextureSaver.cpp
 	${NCINE_ROOT}/src/graphics/Texture.cpp
+	${NCINE_ROOT}/src/graphics/TextureReadback.cpp
 	${NCINE_ROOT}/src/graphics/Shader.cpp
 	${NCINE_ROOT}/src/graphics/ShaderState.cpp
 	${NCINE_ROOT}/src/graphics/DrawableNode.cpp
@@ -56,6 +61,8 @@ set(SOURCES
 	${NCINE_ROOT}/src/graphics/TextNode.cpp
 	${NCINE_ROOT}/src/graphics/RectAnimation.cpp
 	${NCINE_ROOT}/src/graphics/AnimatedSprite.cpp
+	${NCINE_ROOT}/src/graphics/StaticBatchNode.cpp
+	${NCINE_ROOT}/src/graphics/TileMapNode.cpp
 	${NCINE_ROOT}/src/graphics/opengl/GLBufferObject.cpp
 	${NCINE_ROOT}/src/graphics/opengl/GLFramebufferObject.cpp
 	${NCINE_ROOT}/src/graphics/opengl/GLRenderbuffer.cpp
@@ -64,11 +64,17 @@ class DLL_PUBLIC AppConfiguration
 	/// The flag is `true` if the shader cache is enabled to load and save binary shader programs
 	/*! \note Even if the flag is `true` the functionality might still not be supported by the OpenGL context */
 	bool useBinaryShaderCache;
+	/// The flag is `true` if the binary shader cache stores all programs in a single packed file instead of one file per program
+	/*! \note The packed file is mapped in memory when the cache is initialized, saving a file system request per shader on startup */
+	bool usePackedShaderCache;
 	/// The directory name (not the complete path) for the binary shaders cache
 	nctl::String shaderCacheDirname;
 	/// The flag is `true` if, on devices with UBOs smaller than 64 KB, batched shaders will be compiled twice to identify their maximum batch size
 	/*! \note When enabled, compatibility with such devices will increase because shaders with standard batch size will not compile */
 	bool compileBatchedShadersTwice;
+	/// The flag is `true` if text nodes store their vertices with half-float positions and normalized 16-bit texture coordinates
+	/*! \note Packed vertices are half the size of the default ones, but glyph positions farther than 1024 pixels from the center of a text node lose sub-pixel precision */
+	bool packedTextVertices;
 
 	/// The maximum size in bytes for each VBO collecting geometry data
 	unsigned long vboSize;
@@ -103,6 +109,9 @@ class DLL_PUBLIC AppConfiguration
 	bool withGlDebugContext;
 	/// The flag is `true` if console log messages should use colors
 	bool withConsoleColors;
+	/// The flag is `true` if the queued log file entries should be written when a crash signal is raised
+	/*! \note The signal handlers are installed for the whole process and they chain to the ones that were set before */
+	bool withLogCrashHandlers;
 
 	/// \returns The path for the application to load data from
 	const nctl::String &dataPath() const;
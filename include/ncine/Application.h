@@ -28,7 +28,8 @@ class DLL_PUBLIC Application
 	{
 		RenderingSettings()
 		    : batchingEnabled(true), batchingWithIndices(false),
-		      cullingEnabled(true), minBatchSize(4), maxBatchSize(512) {}
+		      cullingEnabled(true), minBatchSize(4), maxBatchSize(512),
+		      reorderingEnabled(false), reorderingWindowSize(32) {}
 
 		/// True if batching is enabled
 		bool batchingEnabled;
@@ -40,6 +41,10 @@ class DLL_PUBLIC Application
 		unsigned int minBatchSize;
 		/// Maximum size for a batch before a forced split
 		unsigned int maxBatchSize;
+		/// True if non-overlapping transparent commands can be reordered to group compatible materials
+		bool reorderingEnabled;
+		/// Maximum number of transparent commands to look ahead when reordering
+		unsigned int reorderingWindowSize;
 	};
 
 	/// GUI settings (for ImGui and Nuklear) that can be changed at run-time
@@ -0,0 +1,83 @@
+#ifndef CLASS_NCINE_ASSETARCHIVE
+#define CLASS_NCINE_ASSETARCHIVE
+
+#include "IFile.h"
+#include <nctl/String.h>
+
+namespace ncine {
+
+namespace AssetArchiveFormat {
+	struct Entry;
+}
+
+/// A read-only archive packing many asset files in a single one
+/*! Mounted archives are searched before the file system by `IFile::createFileHandle()`
+ *  and by the `FileSystem` queries, so assets are resolved into them transparently.
+ *  \note Archives should be mounted and unmounted from the main thread, and files opened
+ *  from an archive should be closed before unmounting it */
+class DLL_PUBLIC AssetArchive
+{
+  public:
+	/// Opens an archive and reads its index
+	explicit AssetArchive(const char *filename);
+	~AssetArchive();
+
+	/// Returns true if the archive has been opened and its index is valid
+	inline bool isValid() const { return entries_ != nullptr; }
+	/// Returns the archive file name with path
+	inline const char *filename() const { return filename_.data(); }
+	/// Returns the number of entries in the archive
+	inline unsigned int numEntries() const { return numEntries_; }
+
+	/// Returns the index of the entry with the specified name, or -1 if not found
+	int findEntry(const char *name) const;
+	/// Returns the name of the entry at the specified index
+	const char *entryName(unsigned int index) const;
+	/// Returns the uncompressed size in bytes of the entry at the specified index
+	unsigned long int entrySize(unsigned int index) const;
+	/// Returns the size in bytes of the entry at the specified index as stored in the archive
+	/*! \note It is smaller than the uncompressed size only if the entry is compressed */
+	unsigned long int entryStoredSize(unsigned int index) const;
+	/// Returns a file handle to read the entry at the specified index
+	/*! \param filename The name of the returned file handle */
+	nctl::UniquePtr<IFile> openEntry(unsigned int index, const char *filename) const;
+
+	/// Mounts an archive so that its entries are resolved as files inside the mount point directory
+	static bool mount(const char *filename, const char *mountPoint);
+	/// Unmounts a previously mounted archive
+	static bool unmount(const char *filename);
+	/// Unmounts all the mounted archives
+	static void unmountAll();
+	/// Returns the number of mounted archives
+	static unsigned int numMounted();
+
+	/// Returns the mounted archive containing the specified path, searching the last mounted one first
+	/*! \param entryIndex The index of the entry inside the returned archive */
+	static const AssetArchive *findMounted(const char *path, int &entryIndex);
+
+  private:
+	/// The archive file name with path
+	nctl::String filename_;
+	/// The archive file, mapped in memory when possible
+	nctl::UniquePtr<IFile> fileHandle_;
+	/// The address of the mapped archive, or `nullptr` if entries are streamed from the file
+	const unsigned char *mappedPtr_;
+
+	unsigned int numEntries_;
+	nctl::UniquePtr<AssetArchiveFormat::Entry[]> entries_;
+	nctl::UniquePtr<char[]> names_;
+
+	/// Reads the header, the index and the names table
+	bool readIndex();
+	/// Reads a range of bytes from the archive file
+	bool readRange(void *buffer, unsigned long int offset, unsigned long int size) const;
+
+	/// Deleted copy constructor
+	AssetArchive(const AssetArchive &) = delete;
+	/// Deleted assignment operator
+	AssetArchive &operator=(const AssetArchive &) = delete;
+};
+
+}
+
+#endif
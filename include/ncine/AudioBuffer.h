@@ -2,6 +2,7 @@
 #define CLASS_NCINE_AUDIOBUFFER
 
 #include "Object.h"
+#include "AudioBufferCache.h"
 
 namespace ncine {
 
@@ -21,7 +22,7 @@ class DLL_PUBLIC AudioBuffer : public Object
 		STEREO16
 	};
 
-	/// Creates an OpenAL buffer name
+	/// Creates an empty buffer, the OpenAL buffer name is generated when samples are loaded
 	AudioBuffer();
 	/// A constructor creating a buffer from memory
 	AudioBuffer(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize);
@@ -39,11 +40,22 @@ class DLL_PUBLIC AudioBuffer : public Object
 
 	bool loadFromMemory(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize);
 	bool loadFromFile(const char *filename);
+	/// Loads samples through the audio buffer cache, sharing them with other buffers loaded from the same file
+	bool loadFromCache(const char *filename, AudioBufferCache::Residency residency);
+	/// Loads samples through the audio buffer cache, decoding them at loading time
+	inline bool loadFromCache(const char *filename) { return loadFromCache(filename, AudioBufferCache::Residency::DECODED); }
 	/// Loads samples in raw PCM format from a memory buffer
 	bool loadFromSamples(const unsigned char *bufferPtr, unsigned long int bufferSize);
 
 	/// Returns the OpenAL buffer id
-	inline unsigned int bufferId() const { return bufferId_; }
+	/*! \note A shared buffer has a zero id while its samples are not resident */
+	inline unsigned int bufferId() const { return cachedBuffer_ ? cachedBuffer_->bufferId : bufferId_; }
+	/// Returns true if the samples are shared through the audio buffer cache
+	inline bool isShared() const { return cachedBuffer_ != nullptr; }
+	/// Returns true if the shared samples are being decoded by a worker thread
+	inline bool isDecoding() const { return cachedBuffer_ && cachedBuffer_->state == CachedAudioBuffer::State::DECODING; }
+	/// Marks the shared samples as used and requests their decoding if they are not resident
+	void requestSamples();
 
 	/// Returns the number of bytes per sample
 	inline int bytesPerSample() const { return bytesPerSample_; }
@@ -63,8 +75,10 @@ class DLL_PUBLIC AudioBuffer : public Object
 	inline static ObjectType sType() { return ObjectType::AUDIOBUFFER; }
 
   private:
-	/// The OpenAL buffer id
+	/// The OpenAL buffer id, zero if samples are shared or have not been loaded yet
 	unsigned int bufferId_;
+	/// The shared cache entry, if samples have been loaded through the cache
+	CachedAudioBuffer *cachedBuffer_;
 
 	/// Number of bytes per sample
 	int bytesPerSample_;
@@ -80,6 +94,10 @@ class DLL_PUBLIC AudioBuffer : public Object
 
 	/// Loads audio samples based on information from the audio loader and reader
 	bool load(IAudioLoader &audioLoader);
+	/// Stops sharing samples with the audio buffer cache
+	void releaseCachedBuffer();
+	/// Deletes the OpenAL buffer owned by this object, if any
+	void deleteBufferId();
 
 	/// Deleted copy constructor
 	AudioBuffer(const AudioBuffer &) = delete;
@@ -0,0 +1,171 @@
+#ifndef CLASS_NCINE_AUDIOBUFFERCACHE
+#define CLASS_NCINE_AUDIOBUFFERCACHE
+
+#include "common_defines.h"
+#include <nctl/String.h>
+#include <nctl/HashMap.h>
+#include <nctl/UniquePtr.h>
+#include <nctl/SharedPtr.h>
+
+namespace ncine {
+
+class AudioBufferCache;
+struct AudioDecodeJob;
+
+/// An entry of the audio buffer cache, shared by all the `AudioBuffer` objects loaded from the same file
+struct DLL_PUBLIC CachedAudioBuffer
+{
+	/// The state of the decoded samples
+	enum class State
+	{
+		/// Samples are decoded and uploaded to the OpenAL buffer
+		RESIDENT,
+		/// Only the compressed file is kept in memory
+		COMPRESSED,
+		/// Samples are being decoded by a worker thread
+		DECODING,
+		/// Samples could not be decoded
+		FAILED
+	};
+
+	CachedAudioBuffer();
+	~CachedAudioBuffer();
+
+	/// The name of the file the samples have been loaded from
+	nctl::String filename;
+	/// The state of the decoded samples
+	State state;
+	/// True if the compressed file should be kept in memory to decode the samples on first play
+	bool keepCompressed;
+
+	/// The OpenAL buffer id, or zero if the samples are not resident
+	unsigned int bufferId;
+	/// Number of bytes per sample
+	int bytesPerSample;
+	/// Number of channels
+	int numChannels;
+	/// Samples frequency
+	int frequency;
+	/// Number of samples
+	unsigned long int numSamples;
+
+	/// The compressed file contents, if kept in memory
+	nctl::UniquePtr<unsigned char[]> compressedData;
+	/// The size of the compressed file in bytes
+	unsigned long int compressedSize;
+
+	/// Number of `AudioBuffer` objects referencing this entry
+	unsigned int refCount;
+	/// The value of the cache usage counter when the entry has been used last time
+	unsigned long int lastUsed;
+
+	/// The decoding job in flight, if any
+	nctl::SharedPtr<AudioDecodeJob> decodeJob;
+
+	/// Returns the size of the decoded samples in bytes
+	inline unsigned long int decodedSize() const { return numSamples * numChannels * bytesPerSample; }
+
+  private:
+	/// Deleted copy constructor
+	CachedAudioBuffer(const CachedAudioBuffer &) = delete;
+	/// Deleted assignment operator
+	CachedAudioBuffer &operator=(const CachedAudioBuffer &) = delete;
+};
+
+/// A cache of decoded audio buffers, shared between `AudioBuffer` objects loaded from the same file
+/*! Entries that are not referenced by any `AudioBuffer` are kept resident until the memory budget is exceeded,
+ *  then they are evicted in least recently used order. */
+class DLL_PUBLIC AudioBufferCache
+{
+  public:
+	/// Where decoded samples should be kept after loading
+	enum class Residency
+	{
+		/// Samples are decoded at loading time
+		DECODED,
+		/// The compressed file is kept in memory and samples are decoded on first play (on a worker thread if available)
+		COMPRESSED
+	};
+
+	/// The statistics about the cache and its requests
+	struct Statistics
+	{
+		unsigned int hits = 0;
+		unsigned int misses = 0;
+		unsigned int evictions = 0;
+		unsigned int decodes = 0;
+		unsigned int asyncDecodes = 0;
+	};
+
+	/// Default memory budget in bytes for the decoded samples
+	static const unsigned long int DefaultMemoryBudget = 64 * 1024 * 1024;
+
+	AudioBufferCache();
+	~AudioBufferCache();
+
+	/// Returns the memory budget in bytes for the decoded samples
+	inline unsigned long int memoryBudget() const { return memoryBudget_; }
+	/// Sets the memory budget in bytes for the decoded samples and evicts entries if needed
+	void setMemoryBudget(unsigned long int memoryBudget);
+
+	/// Returns the number of bytes of decoded samples currently resident
+	inline unsigned long int residentBytes() const { return residentBytes_; }
+	/// Returns the number of bytes of compressed files kept in memory
+	inline unsigned long int compressedBytes() const { return compressedBytes_; }
+	/// Returns the number of entries in the cache
+	inline unsigned int numEntries() const { return entries_.size(); }
+	/// Returns the statistics about the cache
+	inline const Statistics &statistics() const { return statistics_; }
+
+	/// Retrieves the entry for the specified file, loading it if needed, and increments its reference count
+	CachedAudioBuffer *acquire(const char *filename, Residency residency);
+	/// Decrements the reference count of an entry
+	void release(CachedAudioBuffer *entry);
+	/// Marks the entry as used and starts decoding its samples if they are not resident
+	void touch(CachedAudioBuffer *entry);
+
+	/// Uploads the samples decoded by worker threads and enforces the memory budget
+	void update();
+	/// Removes every entry that is not referenced by any `AudioBuffer`
+	void purge();
+	/// Releases all OpenAL buffers, it should be called before destroying the audio device
+	void clear();
+
+  private:
+	using EntriesHashMapType = nctl::HashMap<nctl::String, nctl::UniquePtr<CachedAudioBuffer>>;
+
+	/// The memory budget in bytes for the decoded samples
+	unsigned long int memoryBudget_;
+	/// Bytes of decoded samples currently resident
+	unsigned long int residentBytes_;
+	/// Bytes of compressed files kept in memory
+	unsigned long int compressedBytes_;
+	/// A counter incremented every time an entry is used, to track recency
+	unsigned long int usageCounter_;
+
+	EntriesHashMapType entries_;
+	Statistics statistics_;
+
+	/// Loads the file of a new entry according to the requested residency
+	bool loadEntry(CachedAudioBuffer &entry);
+	/// Decodes the samples of an entry on the calling thread or on a worker one
+	void decodeEntry(CachedAudioBuffer &entry);
+	/// Uploads decoded samples to the OpenAL buffer of an entry
+	bool uploadSamples(CachedAudioBuffer &entry, const unsigned char *bufferPtr, unsigned long int bufferSize);
+	/// Deletes the OpenAL buffer of an entry, returns false if the buffer is still in use
+	bool evictEntry(CachedAudioBuffer &entry);
+	/// Evicts least recently used entries until the resident bytes fit in the budget
+	void enforceBudget();
+
+	/// Deleted copy constructor
+	AudioBufferCache(const AudioBufferCache &) = delete;
+	/// Deleted assignment operator
+	AudioBufferCache &operator=(const AudioBufferCache &) = delete;
+};
+
+/// Meyers' Singleton
+DLL_PUBLIC AudioBufferCache &theAudioBufferCache();
+
+}
+
+#endif
@@ -51,6 +51,11 @@ class DLL_PUBLIC AudioBufferPlayer : public IAudioPlayer
 
   private:
 	AudioBuffer *audioBuffer_;
+	/// True if the player is waiting for shared samples to be decoded before starting
+	bool playPending_;
+
+	/// Attaches the buffer to the source and starts playing
+	void startSource();
 
 	/// Deleted copy constructor
 	AudioBufferPlayer(const AudioBufferPlayer &) = delete;
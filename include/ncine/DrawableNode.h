@@ -142,6 +142,7 @@ class DLL_PUBLIC DrawableNode : public SceneNode
 
 	friend class ShaderState;
 	friend class Viewport;
+	friend class StaticBatchNode;
 };
 
 }
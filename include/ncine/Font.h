@@ -107,7 +107,7 @@ class DLL_PUBLIC Font : public Object
 	static const unsigned int GlyphArraySize = 256;
 	/// Array of font glyphs encoded in a single UTF-8 code unit
 	nctl::UniquePtr<FontGlyph[]> glyphArray_;
-	/// Maximum number of font glyphs stored in the hashmap (multi-byte UTF-8 characters)
+	/// Initial capacity of the hashmap of font glyphs (multi-byte UTF-8 characters), it grows when needed
 	static const unsigned int GlyphHashmapSize = 1024;
 	/// Hashmap of font glyphs encoded in more than one UTF-8 code unit
 	nctl::HashMap<unsigned short int, FontGlyph> glyphHashMap_;
@@ -18,7 +18,9 @@ class DLL_PUBLIC IFile
 		BASE = 0,
 		MEMORY,
 		STANDARD,
-		ASSET
+		ASSET,
+		MAPPED,
+		ARCHIVE
 	};
 
 	/// Open mode bitmask
@@ -63,6 +65,9 @@ class DLL_PUBLIC IFile
 	inline void setCloseOnDestruction(bool shouldCloseOnDestruction) { shouldCloseOnDestruction_ = shouldCloseOnDestruction; }
 	/// Returns true if the file has been sucessfully opened
 	virtual bool isOpened() const;
+	/// Returns a read-only view of the whole file contents, or `nullptr` if they are not accessible in memory
+	/*! Loaders can consume the view directly instead of reading the file into a newly allocated buffer. */
+	virtual const void *data() const { return nullptr; }
 
 	/// Returns file name with path
 	const char *filename() const { return filename_.data(); }
@@ -109,6 +114,9 @@ class DLL_PUBLIC IFile
 
 	/// Returns the proper file handle according to prepended tags
 	static nctl::UniquePtr<IFile> createFileHandle(const char *filename);
+	/// Returns a file handle that maps the file in memory when possible
+	/*! \note Fall back to `createFileHandle()` for files that cannot be mapped, like Android assets */
+	static nctl::UniquePtr<IFile> createMappedFileHandle(const char *filename);
 
   protected:
 	/// File type
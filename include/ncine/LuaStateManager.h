@@ -1,8 +1,10 @@
 #ifndef CLASS_NCINE_LUAMANAGER
 #define CLASS_NCINE_LUAMANAGER
 
+#include <cstdint> // for `uintptr_t`
 #include "common_defines.h"
 #include <nctl/HashMap.h>
+#include <nctl/Array.h>
 #include "LuaTypes.h"
 
 struct lua_State;
@@ -103,9 +105,24 @@ class DLL_PUBLIC LuaStateManager
 	inline StandardLibraries standardLibraries() const { return stdLibraries_; }
 
 	LuaTypes::UserDataType trackedType(void *pointer) const;
-	inline nctl::HashMap<void *, LuaTypes::UserDataType> &trackedUserDatas() { return trackedUserDatas_; }
+	inline const nctl::HashMap<void *, LuaTypes::UserDataType> &trackedUserDatas() const { return trackedUserDatas_; }
 	LuaTypes::UserDataType untrackedType(void *pointer) const;
-	inline nctl::HashMap<void *, LuaTypes::UserDataType> &untrackedUserDatas() { return untrackedUserDatas_; }
+	inline const nctl::HashMap<void *, LuaTypes::UserDataType> &untrackedUserDatas() const { return untrackedUserDatas_; }
+	/// Returns the type of a tracked or an untracked userdata, looking in a small cache first
+	LuaTypes::UserDataType userDataType(void *pointer);
+
+	void addTrackedUserData(void *pointer, LuaTypes::UserDataType type);
+	void removeTrackedUserData(void *pointer);
+	void addUntrackedUserData(void *pointer, LuaTypes::UserDataType type);
+	void removeUntrackedUserData(void *pointer);
+
+	/// Pushes the script function registered for the specified `LuaCallbacks` identifier, returns false if there is none
+	/*! The `ncine` table and the callback names are resolved into registry references on first use,
+	 *  while the field is read on every call, so that a function reassigned by the script is always honored. */
+	bool pushCallback(unsigned int callbackId);
+	/// Releases the resolved `ncine` table and callback names, so that they are resolved again on next use
+	/*! \note It is called automatically when a script is loaded */
+	void invalidateCallbacks();
 
 	static LuaStateManager *manager(lua_State *L);
 
@@ -118,6 +135,21 @@ class DLL_PUBLIC LuaStateManager
 	StandardLibraries stdLibraries_;
 	nctl::HashMap<void *, LuaTypes::UserDataType> trackedUserDatas_;
 	nctl::HashMap<void *, LuaTypes::UserDataType> untrackedUserDatas_;
+
+	/// An entry of the direct mapped cache of userdata types
+	struct UserDataTypeEntry
+	{
+		void *pointer = nullptr;
+		LuaTypes::UserDataType type = LuaTypes::UserDataType::UNKNOWN;
+	};
+	static const unsigned int UserDataTypeCacheSize = 64;
+	UserDataTypeEntry userDataTypeCache_[UserDataTypeCacheSize];
+
+	/// Registry reference to the `ncine` table, `LUA_NOREF` if there is none
+	int ncineTableRef_;
+	/// Registry references to the callback name strings, empty if they have not been resolved yet
+	nctl::Array<int> callbackNameRefs_;
+
 	/// True if the Lua state should be closed upon destruction
 	bool closeOnDestruction_;
 
@@ -129,6 +161,9 @@ class DLL_PUBLIC LuaStateManager
 	void shutdown();
 	void unregisterState();
 	void releaseTrackedMemory();
+	void resolveCallbacks();
+	void clearUserDataTypeCache();
+	inline unsigned int userDataTypeCacheIndex(void *pointer) const { return (reinterpret_cast<uintptr_t>(pointer) >> 4) & (UserDataTypeCacheSize - 1); }
 
 	void exposeScriptApi();
 	void exposeModuleApi();
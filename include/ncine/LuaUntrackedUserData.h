@@ -46,12 +46,7 @@ T *LuaUntrackedUserData<T>::retrieve(lua_State *L, int index, RetrieveNull unwra
 
 	void *pointer = LuaUtils::retrieveUserData<void *>(L, index);
 
-	LuaStateManager *stateManager = LuaStateManager::manager(L);
-	LuaTypes::UserDataType type = stateManager->trackedType(pointer);
-
-	if (type == LuaTypes::UNKNOWN)
-		type = stateManager->untrackedType(pointer);
-
+	const LuaTypes::UserDataType type = LuaStateManager::manager(L)->userDataType(pointer);
 	if (type == LuaTypes::UNKNOWN)
 		return nullptr; // TODO: Caller should check return value and abort the call
 
@@ -171,10 +166,7 @@ T *LuaUntrackedUserData<T>::store(lua_State *L, T *object)
 
 	LuaStateManager *stateManager = LuaStateManager::manager(L);
 
-	nctl::HashMap<void *, LuaTypes::UserDataType> &hashMap = stateManager->untrackedUserDatas();
-	if (hashMap.loadFactor() >= 0.8f)
-		hashMap.rehash(hashMap.capacity() * 2);
-	hashMap.insert(object, LuaTypes::classToUserDataType(object));
+	stateManager->addUntrackedUserData(object, LuaTypes::classToUserDataType(object));
 
 	return object;
 }
@@ -78,6 +78,8 @@ namespace LuaUtils {
 	DLL_PUBLIC int pcall(lua_State *L, int nargs, int nresults, RunInfo *runInfo);
 	DLL_PUBLIC int pcall(lua_State *L, int nargs, int nresults, int msgh);
 	DLL_PUBLIC int pcall(lua_State *L, int nargs, int nresults);
+	/// Calls the function on the stack in protected mode, logging and popping the error message if it fails
+	DLL_PUBLIC bool pcallFunction(lua_State *L, const char *functionName, int nargs, int nresults);
 	DLL_PUBLIC void pop(lua_State *L, int n);
 	DLL_PUBLIC void pop(lua_State *L);
 
@@ -107,21 +107,32 @@ class DLL_PUBLIC MeshSprite : public BaseSprite
 
 	/// Returns the number of indices used to draw the sprite mesh
 	inline unsigned int numIndices() const { return numIndices_; }
-	/// Returns the indices used to draw the sprite mesh
+	/// Returns the 16-bit indices used to draw the sprite mesh
 	inline const unsigned short *indices() const { return indexDataPointer_; }
+	/// Returns the 32-bit indices used to draw the sprite mesh
+	inline const unsigned int *indices32() const { return indexDataPointer32_; }
+	/// Returns true if the sprite mesh is drawn with 32-bit indices
+	inline bool uses32BitIndices() const { return indexDataPointer32_ != nullptr; }
 	/// Returns true if the indices belong to the sprite and are not stored externally
-	inline bool uniqueIndices() const { return indexDataPointer_ == indices_.data(); }
+	inline bool uniqueIndices() const { return uses32BitIndices() ? indexDataPointer32_ == indices32_.data() : indexDataPointer_ == indices_.data(); }
 	/// Copies the indices from a pointer into the sprite
 	void copyIndices(unsigned int numIndices, const unsigned short *indices);
+	/// Copies the 32-bit indices from a pointer into the sprite
+	/*! \note Meshes with more than 65536 vertices need 32-bit indices */
+	void copyIndices(unsigned int numIndices, const unsigned int *indices);
 	/// Copies the indices from another sprite
 	void copyIndices(const MeshSprite &meshSprite);
 	/// Sets the indices data to point to an external array
 	void setIndices(unsigned int numIndices, const unsigned short *indices);
+	/// Sets the 32-bit indices data to point to an external array
+	void setIndices(unsigned int numIndices, const unsigned int *indices);
 	/// Sets the indices data to the data used by another sprite
 	void setIndices(const MeshSprite &meshSprite);
 
 	/// Returns the internal indices data, cleared and set to the required size
 	unsigned short *emplaceIndices(unsigned int numIndices);
+	/// Returns the internal 32-bit indices data, cleared and set to the required size
+	unsigned int *emplaceIndices32(unsigned int numIndices);
 
 	inline static ObjectType sType() { return ObjectType::MESH_SPRITE; }
 
@@ -143,6 +154,10 @@ class DLL_PUBLIC MeshSprite : public BaseSprite
 	nctl::Array<unsigned short> indices_;
 	/// Pointer to index data, either from a shared array or unique to this sprite
 	const unsigned short *indexDataPointer_;
+	/// The array of 32-bit indices used to draw the sprite mesh
+	nctl::Array<unsigned int> indices32_;
+	/// Pointer to 32-bit index data, either from a shared array or unique to this sprite
+	const unsigned int *indexDataPointer32_;
 	/// The number of indices, either shared or not, that composes the mesh
 	unsigned int numIndices_;
 
@@ -23,6 +23,8 @@ class DLL_PUBLIC Object
 		PARTICLE_SYSTEM,
 		FONT,
 		TEXTNODE,
+		STATIC_BATCH_NODE,
+		TILEMAP_NODE,
 		AUDIOBUFFER,
 		AUDIOBUFFER_PLAYER,
 		AUDIOSTREAM_PLAYER
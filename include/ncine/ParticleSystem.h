@@ -3,6 +3,7 @@
 
 #include <ctime>
 #include <cstdlib>
+#include <nctl/SmallArray.h>
 #include "Rect.h"
 #include "SceneNode.h"
 #include "ParticleAffectors.h"
@@ -41,9 +42,9 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	void killParticles();
 
 	/// Returns the array of particle affectors
-	inline nctl::Array<nctl::UniquePtr<ParticleAffector>> &affectors() { return affectors_; }
+	inline nctl::SmallArray<nctl::UniquePtr<ParticleAffector>, 4> &affectors() { return affectors_; }
 	/// Returns the constant array of particle affectors
-	inline const nctl::Array<nctl::UniquePtr<ParticleAffector>> &affectors() const { return affectors_; }
+	inline const nctl::SmallArray<nctl::UniquePtr<ParticleAffector>, 4> &affectors() const { return affectors_; }
 
 	/// Returns the local space flag of the system
 	inline bool inLocalSpace(void) const { return inLocalSpace_; }
@@ -53,7 +54,11 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	/// Returns true if particles are updating
 	inline bool isParticlesUpdateEnabled(void) const { return particlesUpdateEnabled_; }
 	/// Enables or disables particles updating
-	inline void setParticlesUpdateEnabled(bool particlesUpdateEnabled) { particlesUpdateEnabled_ = particlesUpdateEnabled; }
+	inline void setParticlesUpdateEnabled(bool particlesUpdateEnabled)
+	{
+		particlesUpdateEnabled_ = particlesUpdateEnabled;
+		markSubtreeDirty();
+	}
 
 	/// Returns true if affectors are modifying particles properties
 	inline bool areAffectorsEnabled(void) const { return affectorsEnabled_; }
@@ -107,7 +112,7 @@ class DLL_PUBLIC ParticleSystem : public SceneNode
 	nctl::Array<nctl::UniquePtr<Particle>> particleArray_;
 
 	/// The array of particle affectors
-	nctl::Array<nctl::UniquePtr<ParticleAffector>> affectors_;
+	nctl::SmallArray<nctl::UniquePtr<ParticleAffector>, 4> affectors_;
 
 	/// A flag indicating whether the system should be simulated in local space
 	bool inLocalSpace_;
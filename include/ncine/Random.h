@@ -37,6 +37,23 @@ class DLL_PUBLIC Random
 	/// Faster but less uniform version of `real()`
 	float fastReal(float min, float max);
 
+	/// Fills an array with uniformly distributed 32-bit numbers
+	/*! \note The numbers are the same that would be returned by calling `integer()` the same number of times */
+	void integers(uint32_t *dest, unsigned int count);
+	/// Fills an array with uniformly distributed 32-bit numbers, r, where min <= r < max
+	/*! \note Like with `fastInteger()`, the numbers are slightly less uniform than the ones returned by `integer()` */
+	void integers(uint32_t *dest, unsigned int count, uint32_t min, uint32_t max);
+	/// Fills an array with uniformly distributed float numbers, r, where 0 <= r < 1
+	void reals(float *dest, unsigned int count);
+	/// Fills an array with uniformly distributed float numbers, r, where min <= r < max
+	void reals(float *dest, unsigned int count, float min, float max);
+
+	/// Advances the generator by the specified number of steps in logarithmic time
+	void advance(uint64_t delta);
+	/// Returns a copy of the generator advanced by `index` times 2^48 steps
+	/*! Generators with different indices do not overlap for the first 2^48 numbers and can be used by parallel emitters. */
+	Random substream(unsigned int index) const;
+
   private:
 	uint64_t state_;
 	uint64_t increment_;
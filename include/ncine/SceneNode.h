@@ -25,6 +25,18 @@ class DLL_PUBLIC SceneNode : public Object
 		SAME_AS_PARENT
 	};
 
+	/// The policy used to decide if a node and its subtree should be updated in a frame
+	enum class UpdateMode
+	{
+		/// The node is updated every frame, this is the default
+		ALWAYS,
+		/// The node is updated only when it, one of its descendants or one of its ancestors has changed
+		/*! \note It should not be used by nodes that override `update()` to do some work every frame */
+		ON_CHANGE,
+		/// Changes to descendants are ignored, the subtree is updated only when the node itself or one of its ancestors has changed
+		STATIC
+	};
+
 	/// The minimum amount of rotation to trigger a sine and cosine calculation
 	static const float MinRotation;
 
@@ -82,11 +94,16 @@ class DLL_PUBLIC SceneNode : public Object
 	/// Returns true if the node visit order is used together with the layer
 	inline enum VisitOrderState visitOrderState() const { return visitOrderState_; }
 	/// Enables the use of the node visit order together with the layer
-	inline void setVisitOrderState(enum VisitOrderState visitOrderState) { visitOrderState_ = visitOrderState; }
+	inline void setVisitOrderState(enum VisitOrderState visitOrderState)
+	{
+		visitOrderState_ = visitOrderState;
+		markSubtreeDirty();
+	}
 	/// Returns the visit drawing order of the node
 	inline uint16_t visitOrderIndex() const { return visitOrderIndex_; }
 
 	/// Called once every frame to update the node
+	/*! \note Children are only visited if they need to inherit a change or if their subtree is dirty */
 	virtual void update(float interval);
 	/// Draws the node and visits its children
 	virtual void visit(RenderQueue &renderQueue, unsigned int &visitOrderIndex);
@@ -96,16 +113,39 @@ class DLL_PUBLIC SceneNode : public Object
 	/// Returns true if the node is updating
 	inline bool isUpdateEnabled() const { return updateEnabled_; }
 	/// Enables or disables node updating
-	inline void setUpdateEnabled(bool updateEnabled) { updateEnabled_ = updateEnabled; }
+	inline void setUpdateEnabled(bool updateEnabled)
+	{
+		if (updateEnabled_ != updateEnabled)
+		{
+			updateEnabled_ = updateEnabled;
+			markSubtreeDirty();
+		}
+	}
 	/// Returns true if the node is drawing
 	inline bool isDrawEnabled() const { return drawEnabled_; }
 	/// Enables or disables node drawing
-	inline void setDrawEnabled(bool drawEnabled) { drawEnabled_ = drawEnabled; }
+	inline void setDrawEnabled(bool drawEnabled)
+	{
+		if (drawEnabled_ != drawEnabled)
+		{
+			drawEnabled_ = drawEnabled;
+			markSubtreeDirty();
+		}
+	}
 	/// Returns true if the node is both updating and drawing
 	inline bool isEnabled() const { return (updateEnabled_ == true && drawEnabled_ == true); }
 	/// Enables or disables both node updating and drawing
 	void setEnabled(bool isEnabled);
 
+	/// Returns the update mode of the node
+	inline UpdateMode updateMode() const { return updateMode_; }
+	/// Sets the update mode of the node
+	/*! \note Skipping clean subtrees is opt-in, every node starts in `UpdateMode::ALWAYS` and is updated each frame.
+	 *  Nodes that rarely change, like static sprites or the children of a `StaticBatchNode`, should be switched to `UpdateMode::ON_CHANGE`. */
+	void setUpdateMode(UpdateMode updateMode);
+	/// Returns true if the node or one of its descendants has changed since the last update
+	inline bool isSubtreeDirty() const { return subtreeDirty_; }
+
 	/// Returns node position relative to its parent
 	inline Vector2f position() const { return position_; }
 	/// Returns absolute node position
@@ -181,7 +221,11 @@ class DLL_PUBLIC SceneNode : public Object
 	/// Sets the node rendering layer
 	/*! \note The lowest value (bottom) is 0 and the highest one (top) is 65535.
 	 *  When the value is 0, the final layer value is inherited from the parent. */
-	void setLayer(uint16_t layer) { layer_ = layer; }
+	void setLayer(uint16_t layer)
+	{
+		layer_ = layer;
+		markSubtreeDirty();
+	}
 
 	/// Gets the node world matrix
 	inline const Matrix4x4f &worldMatrix() const { return worldMatrix_; }
@@ -200,6 +244,7 @@ class DLL_PUBLIC SceneNode : public Object
 	inline void setDeleteChildrenOnDestruction(bool shouldDeleteChildrenOnDestruction) { shouldDeleteChildrenOnDestruction_ = shouldDeleteChildrenOnDestruction; }
 
 	/// Returns the last frame in which any of the viewports have updated this node
+	/*! \note The value is not refreshed while a node in `UpdateMode::ON_CHANGE` or `UpdateMode::STATIC` is skipped */
 	inline unsigned long int lastFrameUpdated() const { return lastFrameUpdated_; }
 
   protected:
@@ -279,6 +324,12 @@ class DLL_PUBLIC SceneNode : public Object
 	/// The last frame any viewport updated this node
 	unsigned long int lastFrameUpdated_;
 
+	/// The update mode of this node
+	UpdateMode updateMode_;
+	/// True if this node or one of its descendants has to be updated
+	/*! \note If the flag is set then it is also set for all ancestors, up to the first static one */
+	bool subtreeDirty_;
+
 	/// Deleted assignment operator
 	SceneNode &operator=(const SceneNode &) = delete;
 
@@ -288,6 +339,13 @@ class DLL_PUBLIC SceneNode : public Object
 	/// Swaps the child pointer of a parent when moving an object
 	void swapChildPointer(SceneNode *first, SceneNode *second);
 
+	/// Flags this node and its ancestors to be updated in the next frame
+	inline void markSubtreeDirty();
+	/// Flags this node and its ancestors, stopping at the first static one
+	void propagateSubtreeDirty();
+	/// Resets the dirty subtree flag at the beginning of an update
+	inline void resetSubtreeDirty();
+
 	virtual void transform();
 };
 
@@ -300,6 +358,22 @@ inline void SceneNode::setEnabled(bool enabled)
 {
 	updateEnabled_ = enabled;
 	drawEnabled_ = enabled;
+	markSubtreeDirty();
+}
+
+inline void SceneNode::markSubtreeDirty()
+{
+	subtreeDirty_ = true;
+	if (parent_ && parent_->subtreeDirty_ == false)
+		parent_->propagateSubtreeDirty();
+}
+
+inline void SceneNode::resetSubtreeDirty()
+{
+	// Changes made during the update will be picked up in the next frame
+	subtreeDirty_ = false;
+	if (updateMode_ == UpdateMode::ALWAYS)
+		markSubtreeDirty();
 }
 
 inline void SceneNode::setPosition(float x, float y)
@@ -307,6 +381,7 @@ inline void SceneNode::setPosition(float x, float y)
 	position_.set(x, y);
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setPosition(const Vector2f &position)
@@ -314,6 +389,7 @@ inline void SceneNode::setPosition(const Vector2f &position)
 	position_ = position;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setPositionX(float x)
@@ -321,6 +397,7 @@ inline void SceneNode::setPositionX(float x)
 	position_.x = x;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setPositionY(float y)
@@ -328,6 +405,7 @@ inline void SceneNode::setPositionY(float y)
 	position_.y = y;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::move(float x, float y)
@@ -336,6 +414,7 @@ inline void SceneNode::move(float x, float y)
 	position_.y += y;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::move(const Vector2f &position)
@@ -343,6 +422,7 @@ inline void SceneNode::move(const Vector2f &position)
 	position_ += position;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::moveX(float x)
@@ -350,6 +430,7 @@ inline void SceneNode::moveX(float x)
 	position_.x += x;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::moveY(float y)
@@ -357,6 +438,7 @@ inline void SceneNode::moveY(float y)
 	position_.y += y;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setAbsAnchorPoint(float x, float y)
@@ -364,6 +446,7 @@ inline void SceneNode::setAbsAnchorPoint(float x, float y)
 	anchorPoint_.set(x, y);
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setAbsAnchorPoint(const Vector2f &point)
@@ -371,6 +454,7 @@ inline void SceneNode::setAbsAnchorPoint(const Vector2f &point)
 	anchorPoint_ = point;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setScale(float scaleFactor)
@@ -378,6 +462,7 @@ inline void SceneNode::setScale(float scaleFactor)
 	scaleFactor_.set(scaleFactor, scaleFactor);
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setScale(float scaleFactorX, float scaleFactorY)
@@ -385,6 +470,7 @@ inline void SceneNode::setScale(float scaleFactorX, float scaleFactorY)
 	scaleFactor_.set(scaleFactorX, scaleFactorY);
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setScale(const Vector2f &scaleFactor)
@@ -392,6 +478,7 @@ inline void SceneNode::setScale(const Vector2f &scaleFactor)
 	scaleFactor_ = scaleFactor;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setRotation(float rotation)
@@ -399,42 +486,49 @@ inline void SceneNode::setRotation(float rotation)
 	rotation_ = fmodf(rotation, 360.0f);
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setColor(Color color)
 {
 	color_ = color;
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setColor(Colorf color)
 {
 	color_ = color;
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setColor(unsigned char red, unsigned char green, unsigned char blue, unsigned char alpha)
 {
 	color_.set(red, green, blue, alpha);
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setColorF(float red, float green, float blue, float alpha)
 {
 	color_ = Colorf(red, green, blue, alpha);
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setAlpha(unsigned char alpha)
 {
 	color_.setAlpha(alpha);
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setAlphaF(float alpha)
 {
 	color_.setAlpha(static_cast<unsigned char>(alpha * 255));
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setWorldMatrix(const Matrix4x4f &worldMatrix)
@@ -442,6 +536,7 @@ inline void SceneNode::setWorldMatrix(const Matrix4x4f &worldMatrix)
 	worldMatrix_ = worldMatrix;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 inline void SceneNode::setLocalMatrix(const Matrix4x4f &localMatrix)
@@ -449,6 +544,7 @@ inline void SceneNode::setLocalMatrix(const Matrix4x4f &localMatrix)
 	localMatrix_ = localMatrix;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 }
@@ -0,0 +1,109 @@
+#ifndef CLASS_NCINE_STATICBATCHNODE
+#define CLASS_NCINE_STATICBATCHNODE
+
+#include "SceneNode.h"
+#include "Rect.h"
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+class RenderCommand;
+class Texture;
+
+/// A scene node that bakes the geometry of its sprite children into static buffers
+/*! Children that are sprites or mesh sprites using a default shader and without children of their own
+ *  are transformed once into the space of this node and stored in a persistent vertex and index buffer.
+ *  Baked sprites sharing the same texture, blending and color are grouped together and every group
+ *  is divided in spatial chunks, each one issued with a single render command and culled on its own.
+ *  The other children are updated and drawn as usual.
+ *  \note Baked sprites are drawn with the layer of this node and their absolute values are not kept updated.
+ *  \note Only children in `UpdateMode::ON_CHANGE` are baked, a child updated every frame would be baked again every frame.
+ *  The update mode of the children is never changed by this node, they should be switched to `UpdateMode::ON_CHANGE` by the user. */
+class DLL_PUBLIC StaticBatchNode : public SceneNode
+{
+  public:
+	/// The default side of the square cells used to divide a bake group in chunks
+	static const float DefaultChunkSize;
+
+	/// Constructor for a static batch node with a parent and a specified relative position
+	StaticBatchNode(SceneNode *parent, float xx, float yy);
+	/// Constructor for a static batch node with a parent and a specified relative position as a vector
+	StaticBatchNode(SceneNode *parent, const Vector2f &position);
+	/// Constructor for a static batch node with a parent and positioned in the relative origin
+	explicit StaticBatchNode(SceneNode *parent);
+	/// Constructor for a static batch node with no parent and positioned in the origin
+	StaticBatchNode();
+	~StaticBatchNode() override;
+
+	/// Default move constructor
+	StaticBatchNode(StaticBatchNode &&);
+	/// Default move assignment operator
+	StaticBatchNode &operator=(StaticBatchNode &&);
+
+	/// Returns a copy of this object
+	/*! \note The copy has no children and it will bake its own ones on the first update */
+	inline StaticBatchNode clone() const { return StaticBatchNode(*this); }
+
+	inline static ObjectType sType() { return ObjectType::STATIC_BATCH_NODE; }
+
+	void update(float interval) override;
+	void visit(RenderQueue &renderQueue, unsigned int &visitOrderIndex) override;
+	bool draw(RenderQueue &renderQueue) override;
+
+	/// Returns the side of the square cells used to divide a bake group in chunks
+	inline float chunkSize() const { return chunkSize_; }
+	/// Sets the side of the square cells used to divide a bake group in chunks
+	void setChunkSize(float chunkSize);
+
+	/// Forces the children to be baked again before the next draw
+	/*! \note It is only needed for changes that do not flag a child as dirty, like its blending state */
+	void invalidateBake();
+
+	/// Returns the number of children baked in the static buffers
+	inline unsigned int numBakedChildren() const { return numBakedChildren_; }
+	/// Returns the number of chunks, each one drawn with a single render command
+	inline unsigned int numChunks() const { return chunks_.size(); }
+	/// Returns the number of times the children have been baked
+	inline unsigned int numBakes() const { return numBakes_; }
+
+  protected:
+	/// Protected copy constructor used to clone objects
+	StaticBatchNode(const StaticBatchNode &other);
+
+  private:
+	struct Chunk;
+
+	/// The side of the square cells used to divide a bake group in chunks
+	float chunkSize_;
+	/// True if the children should be baked again before the next draw
+	bool needsBake_;
+	unsigned int numBakedChildren_;
+	unsigned int numBakes_;
+
+	/// The children array at the time of the last bake, to detect structural changes
+	nctl::Array<SceneNode *> bakedChildrenSnapshot_;
+	/// A flag for every child in the snapshot, true if it has been baked
+	nctl::Array<bool> bakedChildrenMask_;
+	/// The indices of the children that have not been baked, in children order
+	nctl::Array<unsigned int> unbakedIndices_;
+	/// The baked chunks with their render commands
+	nctl::Array<nctl::UniquePtr<Chunk>> chunks_;
+
+	/// Deleted assignment operator
+	StaticBatchNode &operator=(const StaticBatchNode &) = delete;
+
+	/// Returns true if the child can be baked in the static buffers
+	static bool isBakeable(const SceneNode &child);
+	/// Returns true if the children have changed since the last bake
+	bool isBakeOutdated() const;
+	/// Bakes the children in new chunks
+	void bake();
+	/// Updates the transformation and the color of all chunks
+	void updateRenderCommands();
+
+	friend class Viewport;
+};
+
+}
+
+#endif
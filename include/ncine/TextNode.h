@@ -112,6 +112,13 @@ class DLL_PUBLIC TextNode : public DrawableNode
 		    : x(xx), y(yy), u(uu), v(vv) {}
 	};
 
+	/// Packed vertex data for the glyphs, with half-float positions and normalized 16-bit texture coordinates
+	struct PackedVertex
+	{
+		uint16_t x, y;
+		uint16_t u, v;
+	};
+
 	/// Position of degenerate vertices in glyph quad
 	enum class Degenerate
 	{
@@ -123,6 +130,8 @@ class DLL_PUBLIC TextNode : public DrawableNode
 
 	/// The string to be rendered
 	nctl::String string_;
+	/// The Unicode code points of the string, decoded when calculating the boundaries
+	mutable nctl::Array<unsigned int> codePoints_;
 	/// Dirty flag for vertices and texture coordinates
 	bool dirtyDraw_;
 	/// Dirty flag for boundary rectangle
@@ -133,6 +142,10 @@ class DLL_PUBLIC TextNode : public DrawableNode
 	Font *font_;
 	/// The array of vertex positions interleaved with texture coordinates for every glyph in the node
 	nctl::Array<Vertex> interleavedVertices_;
+	/// The flag is `true` if the vertices are converted to the packed format before being uploaded
+	bool usePackedVertices_;
+	/// The array of packed vertices, only used when the packed format is enabled
+	nctl::Array<PackedVertex> packedVertices_;
 
 	/// Advance on the X-axis for the next processed glyph
 	mutable float xAdvance_;
@@ -159,6 +172,8 @@ class DLL_PUBLIC TextNode : public DrawableNode
 	float calculateAlignment(unsigned int lineIndex) const;
 	/// Fills the batch draw command with data from a glyph
 	void processGlyph(const FontGlyph *glyph, Degenerate degen);
+	/// Converts the interleaved vertices to the packed format
+	void packVertices();
 
 	void shaderHasChanged() override;
 
@@ -177,6 +177,7 @@ class DLL_PUBLIC Texture : public Object
 
 	friend class Material;
 	friend class Viewport;
+	friend class TextureReadback;
 };
 
 }
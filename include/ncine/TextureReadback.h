@@ -0,0 +1,80 @@
+#ifndef CLASS_NCINE_TEXTUREREADBACK
+#define CLASS_NCINE_TEXTUREREADBACK
+
+#include "common_defines.h"
+#include "Rect.h"
+#include <nctl/Array.h>
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+class Texture;
+class GLBufferObject;
+class GLFramebufferObject;
+
+/// A class that reads pixels back from the GPU without stalling the frame
+/*! Pixels are copied into a pixel buffer object and retrieved when a fence signals that the copy has completed,
+ *  usually one or two frames later. Saving to a PNG or WebP file is performed on a worker thread when available.
+ *  Completion callbacks are always invoked on the main thread, at the end of a frame.
+ *  \note Pixels are always read back in the `RGBA8` format, with the first row at the bottom of the image.
+ *  \note A request that cannot be issued returns `false` and its callback is never invoked. */
+class DLL_PUBLIC TextureReadback
+{
+  public:
+	/// The outcome of a readback or of a save request
+	struct Result
+	{
+		Result()
+		    : success(false), width(0), height(0), pixels(nullptr), filename(nullptr) {}
+
+		/// The flag is `true` if pixels have been read back and, for a save request, written to the file
+		bool success;
+		int width;
+		int height;
+		/// The pixels read back, only valid during the callback and always `nullptr` for save requests
+		const unsigned char *pixels;
+		/// The name of the file for a save request, `nullptr` otherwise
+		const char *filename;
+	};
+
+	/// The function invoked on the main thread when a request completes
+	using CompletionCallback = void (*)(const Result &result, void *userData);
+
+	/// Reads back the first mip level of a texture, as it is at the time of the call
+	static bool readTexture(const Texture &texture, CompletionCallback callback, void *userData);
+	/// Reads back a region of the screen, as it is at the end of the current frame
+	static bool readScreen(const Recti &region, CompletionCallback callback, void *userData);
+	/// Saves the first mip level of a texture to a PNG or WebP file, depending on the extension
+	static bool saveTexture(const Texture &texture, const char *filename, CompletionCallback callback, void *userData);
+	/// Saves the whole screen to a PNG or WebP file at the end of the current frame, depending on the extension
+	static bool saveScreenshot(const char *filename, CompletionCallback callback, void *userData);
+
+	/// Returns the number of requests that have not completed yet
+	static inline unsigned int numPendingRequests() { return requests_.size(); }
+
+  private:
+	struct Request;
+
+	static nctl::Array<nctl::UniquePtr<Request>> requests_;
+	/// The framebuffer used to read back the texels of a texture
+	static nctl::UniquePtr<GLFramebufferObject> fbo_;
+
+	/// Creates a request and checks that the file extension is supported by a saver
+	static Request *createRequest(int width, int height, const char *filename, CompletionCallback callback, void *userData);
+	/// Reads the pixels of the currently bound read framebuffer into the pixel buffer of a request
+	static void issueRequest(Request &request, int x, int y);
+	/// Reads the texels of the first mip level of a texture into the pixel buffer of a request
+	static bool issueTextureRequest(Request &request, const Texture &texture);
+	/// Issues the screen requests of the frame, polls the fences and invokes the callbacks of the completed requests
+	static void update();
+	/// Retrieves the pixels of a request whose fence has signaled, returns false if the copy is still in progress
+	static bool retrievePixels(Request &request);
+	/// Releases the OpenGL resources of pending requests before the context is destroyed
+	static void dispose();
+
+	friend class Application;
+};
+
+}
+
+#endif
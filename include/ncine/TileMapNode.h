@@ -0,0 +1,133 @@
+#ifndef CLASS_NCINE_TILEMAPNODE
+#define CLASS_NCINE_TILEMAPNODE
+
+#include "SceneNode.h"
+#include "Vector2.h"
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+class Texture;
+
+/// A scene node drawing a grid of tiles taken from a texture atlas
+/*! Tile indices are stored in square chunks that are allocated only when a tile is set in them.
+ *  The vertices of a chunk are generated only when it becomes visible or when it is edited while visible,
+ *  and every visible chunk is drawn with a single render command.
+ *  The tile at the (0, 0) coordinates is the bottom left one and it is placed at the node origin.
+ *  \note Atlas tiles are numbered from the top left corner of the texture, left to right and top to bottom. */
+class DLL_PUBLIC TileMapNode : public SceneNode
+{
+  public:
+	/// The index of a tile with nothing to draw
+	static const uint16_t EmptyTile = 0xFFFF;
+	/// The number of tiles on each side of a chunk
+	static const unsigned int ChunkSize = 32;
+	/// The number of frames a chunk can stay out of view before its vertices are released
+	static const unsigned int ChunkEvictionFrames = 60;
+
+	/// Constructor for a tile map node with a parent, an atlas texture, the size of each tile and the size of the map in tiles
+	TileMapNode(SceneNode *parent, Texture *atlas, const Vector2i &tileSize, const Vector2i &mapSize);
+	/// Constructor for a tile map node with no parent, an atlas texture, the size of each tile and the size of the map in tiles
+	TileMapNode(Texture *atlas, const Vector2i &tileSize, const Vector2i &mapSize);
+	~TileMapNode() override;
+
+	/// Default move constructor
+	TileMapNode(TileMapNode &&);
+	/// Default move assignment operator
+	TileMapNode &operator=(TileMapNode &&);
+
+	inline static ObjectType sType() { return ObjectType::TILEMAP_NODE; }
+
+	/// Adds the commands of the visible chunks to the queue, generating their vertices if needed
+	bool draw(RenderQueue &renderQueue) override;
+
+	/// Gets the atlas texture
+	inline const Texture *atlas() const { return atlas_; }
+	/// Sets the atlas texture, the size of the tiles does not change
+	void setAtlas(Texture *atlas);
+
+	/// Returns the size of a tile in pixels
+	inline const Vector2i &tileSize() const { return tileSize_; }
+	/// Returns the size of the map in tiles
+	inline const Vector2i &mapSize() const { return mapSize_; }
+	/// Returns the number of tiles in the atlas texture
+	inline unsigned int numAtlasTiles() const { return atlasSize_.x * atlasSize_.y; }
+
+	/// Returns the index of the tile at the specified map coordinates
+	uint16_t tile(int x, int y) const;
+	/// Sets the index of the tile at the specified map coordinates
+	/*! \note Use `EmptyTile` to remove a tile */
+	void setTile(int x, int y, uint16_t tileIndex);
+	/// Copies all the tiles of the map from an array of indices ordered by row, starting from the bottom one
+	void copyTiles(const uint16_t *tiles);
+	/// Removes all the tiles of the map
+	void clearTiles();
+
+	/// Returns the total number of chunks of the map
+	inline unsigned int numChunks() const { return chunks_.size(); }
+	/// Returns the number of chunks with generated vertices
+	inline unsigned int numResidentChunks() const { return residentChunks_.size(); }
+
+  private:
+	struct ChunkMesh;
+
+	/// A square portion of the map
+	struct Chunk
+	{
+		Chunk();
+
+		/// The tile indices, allocated when the first tile of the chunk is set
+		nctl::Array<uint16_t> tiles;
+		/// The number of tiles that are not empty
+		unsigned int numTiles;
+		/// True if the vertices do not reflect the tiles anymore
+		bool isDirty;
+		/// The last frame in which the chunk was visible in any viewport
+		unsigned long int lastFrameVisible;
+		/// The vertices and the render command of a visible chunk
+		nctl::UniquePtr<ChunkMesh> mesh;
+	};
+
+	Texture *atlas_;
+	Vector2i tileSize_;
+	Vector2i mapSize_;
+	/// The number of tiles on the two sides of the atlas texture
+	Vector2i atlasSize_;
+	/// The number of chunks on the two sides of the map
+	Vector2i numChunks_;
+
+	nctl::Array<Chunk> chunks_;
+	/// The indices of the chunks with a mesh
+	nctl::Array<unsigned int> residentChunks_;
+	/// Released meshes that can be reused by other chunks
+	nctl::Array<nctl::UniquePtr<ChunkMesh>> freeMeshes_;
+	/// Quad indices shared by all meshes
+	nctl::Array<unsigned short> indices_;
+	/// The last frame the out of view chunks have been released
+	unsigned long int lastFrameEvicted_;
+
+	/// Deleted copy constructor
+	TileMapNode(const TileMapNode &) = delete;
+	/// Deleted assignment operator
+	TileMapNode &operator=(const TileMapNode &) = delete;
+
+	/// Returns the chunk holding the tile at the specified map coordinates
+	inline Chunk &chunkAt(int x, int y) { return chunks_[(y / ChunkSize) * numChunks_.x + (x / ChunkSize)]; }
+	/// Returns the chunk holding the tile at the specified map coordinates
+	inline const Chunk &chunkAt(int x, int y) const { return chunks_[(y / ChunkSize) * numChunks_.x + (x / ChunkSize)]; }
+
+	/// Returns a mesh from the free list or creates a new one
+	nctl::UniquePtr<ChunkMesh> acquireMesh();
+	/// Moves the mesh of a chunk back to the free list
+	void releaseMesh(unsigned int chunkIndex);
+	/// Releases the meshes of the chunks that have been out of view for a while
+	void evictChunks();
+	/// Regenerates the vertices of a chunk from its tiles
+	void fillMesh(unsigned int chunkIndex);
+	/// Updates the transformation and the color of a mesh render command
+	void updateMeshRenderCommand(ChunkMesh &mesh);
+};
+
+}
+
+#endif
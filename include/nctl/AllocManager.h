@@ -6,6 +6,8 @@
 namespace nctl {
 
 class IAllocator;
+class FrameAllocator;
+class AllocTelemetry;
 
 /// Allocator manager initializer
 class DLL_PUBLIC AllocManagerInitializer
@@ -40,6 +42,10 @@ extern DLL_PUBLIC AllocManager &theAllocManager();
 
 extern DLL_PUBLIC IAllocator &theDefaultAllocator();
 extern DLL_PUBLIC IAllocator &theStringAllocator();
+/// Returns the allocator for data that only lives until the end of the next frame
+extern DLL_PUBLIC FrameAllocator &theFrameAllocator();
+/// Returns the per frame statistics and budgets of the allocators
+extern DLL_PUBLIC AllocTelemetry &theAllocTelemetry();
 extern DLL_PUBLIC IAllocator &theImGuiAllocator();
 extern DLL_PUBLIC IAllocator &theNuklearAllocator();
 extern DLL_PUBLIC IAllocator &theLuaAllocator();
@@ -0,0 +1,113 @@
+#ifndef CLASS_NCTL_ALLOCTELEMETRY
+#define CLASS_NCTL_ALLOCTELEMETRY
+
+#include <nctl/StaticArray.h>
+#include <nctl/UniquePtr.h>
+#include <ncine/TimeStamp.h>
+
+namespace ncine {
+class IFile;
+}
+
+namespace nctl {
+
+class IAllocator;
+class FreeListAllocator;
+
+/// A per frame view of the memory used by each allocator, with soft budgets
+/*! The peak memory of the tracked allocators is reset at every update to measure the peak of each frame.
+ *  \note Budgets are soft limits, allocations are never refused when they are exceeded */
+class DLL_PUBLIC AllocTelemetry
+{
+  public:
+	/// What happens when an allocator goes over its budget
+	enum class BudgetPolicy
+	{
+		/// A warning is logged
+		LOG,
+		/// A warning is logged and an assert is triggered in debug builds
+		ASSERT
+	};
+
+	/// The statistics of a tracked allocator
+	struct Entry
+	{
+		IAllocator *allocator = nullptr;
+		/// Only a free list exposes its free blocks to measure fragmentation
+		const FreeListAllocator *freeList = nullptr;
+
+		/// The highest amount of memory used since the allocator is tracked
+		size_t peakMemory = 0;
+		/// The highest amount of memory used during the last frame
+		size_t framePeakMemory = 0;
+		/// The number of allocations performed during the last frame
+		size_t numFrameAllocations = 0;
+		/// The fraction of free memory that is not part of the largest free block
+		float fragmentation = 0.0f;
+
+		/// The amount of memory the allocator should not exceed, zero if disabled
+		size_t budget = 0;
+		BudgetPolicy budgetPolicy = BudgetPolicy::LOG;
+		bool isOverBudget = false;
+
+		/// The number of allocations since creation at the last update
+		size_t lastNumTotalAllocations = 0;
+	};
+
+	/// Maximum number of allocators that can be tracked
+	static const unsigned int MaxAllocators = 16;
+
+	AllocTelemetry();
+	~AllocTelemetry();
+
+	/// Starts tracking an allocator, returns false if it is already tracked or there is no space left
+	bool add(IAllocator &allocator);
+	/// Starts tracking a free list allocator, measuring its fragmentation
+	bool add(FreeListAllocator &allocator);
+	/// Stops tracking an allocator, returns false if it was not tracked
+	bool remove(const IAllocator &allocator);
+
+	/// Returns the number of tracked allocators
+	inline unsigned int numEntries() const { return entries_.size(); }
+	/// Returns the statistics of the tracked allocator at the specified index
+	inline const Entry &entry(unsigned int index) const { return entries_[index]; }
+	/// Returns the statistics of a tracked allocator, or `nullptr` if it is not tracked
+	const Entry *find(const IAllocator &allocator) const;
+
+	/// Sets the budget of a tracked allocator, a zero amount disables it
+	bool setBudget(const IAllocator &allocator, size_t bytes, BudgetPolicy policy);
+	/// Sets the budget of a tracked allocator that only logs when exceeded
+	inline bool setBudget(const IAllocator &allocator, size_t bytes) { return setBudget(allocator, bytes, BudgetPolicy::LOG); }
+
+	/// Returns the number of updates since the telemetry has been created
+	inline unsigned long int numFrames() const { return numFrames_; }
+	/// Samples all the tracked allocators, it should be called once per frame
+	void update();
+	/// Resets the peak memory of all the tracked allocators
+	void resetPeaks();
+
+	/// Starts appending a row per tracked allocator to a CSV file at every update
+	bool startCsvRecording(const char *filename);
+	/// Stops appending rows to the CSV file and closes it
+	void stopCsvRecording();
+	/// Returns true if the statistics are being recorded to a CSV file
+	inline bool isRecordingCsv() const { return csvFile_ != nullptr; }
+
+  private:
+	StaticArray<Entry, MaxAllocators> entries_;
+	unsigned long int numFrames_;
+	UniquePtr<ncine::IFile> csvFile_;
+	ncine::TimeStamp csvStartTime_;
+
+	Entry *findEntry(const IAllocator &allocator);
+	void writeCsvRows();
+
+	/// Deleted copy constructor
+	AllocTelemetry(const AllocTelemetry &) = delete;
+	/// Deleted assignment operator
+	AllocTelemetry &operator=(const AllocTelemetry &) = delete;
+};
+
+}
+
+#endif
@@ -205,6 +205,13 @@ class Array
 	T *extendOne();
 };
 
+/// An array can be relocated with a memory copy, as its elements are stored elsewhere
+template <class T>
+struct isTriviallyRelocatable<Array<T>>
+{
+	static constexpr bool value = true;
+};
+
 #if !NCINE_WITH_ALLOCATORS
 template <class T>
 Array<T>::Array(unsigned int capacity, ArrayMode mode)
@@ -341,7 +348,28 @@ void Array<T>::setCapacity(unsigned int newCapacity)
 			LOGD_X("Array capacity growing from %u to %u", capacity_, newCapacity);
 	}
 
+	if (newCapacity < size_) // shrinking
+	{
+		// Cropping last elements
+		destructArray(array_ + newCapacity, size_ - newCapacity);
+		size_ = newCapacity;
+	}
+
 	T *newArray = nullptr;
+#if NCINE_WITH_ALLOCATORS
+	// Relocatable elements can follow their memory if the allocator is able to resize it
+	if (isTriviallyRelocatable<T>::value && array_ != nullptr && newCapacity > 0)
+	{
+		newArray = static_cast<T *>(alloc_.reallocate(array_, newCapacity * sizeof(T)));
+		if (newArray != nullptr)
+		{
+			array_ = newArray;
+			capacity_ = newCapacity;
+			return;
+		}
+	}
+#endif
+
 	if (newCapacity > 0)
 	{
 #if !NCINE_WITH_ALLOCATORS
@@ -352,14 +380,7 @@ void Array<T>::setCapacity(unsigned int newCapacity)
 	}
 
 	if (size_ > 0)
-	{
-		const unsigned int oldSize = size_;
-		if (newCapacity < size_) // shrinking
-			size_ = newCapacity; // cropping last elements
-
-		moveConstructArray(newArray, array_, size_);
-		destructArray(array_, oldSize);
-	}
+		relocateArray(newArray, array_, size_);
 
 #if !NCINE_WITH_ALLOCATORS
 	::operator delete(array_);
@@ -440,9 +461,14 @@ T *Array<T>::insertRange(unsigned int index, const T *firstPtr, const T *lastPtr
 	if (size_ + numElements > capacity_)
 		setCapacity((size_ + numElements) * 2);
 
-	// Backwards loop to account for overlapping areas
-	for (unsigned int i = size_ - index; i > 0; i--)
-		array_[index + numElements + i - 1] = nctl::move(array_[index + i - 1]);
+	if (isTriviallyRelocatable<T>::value)
+		relocateArray(array_ + index + numElements, array_ + index, size_ - index);
+	else
+	{
+		// Backwards loop to account for overlapping areas
+		for (unsigned int i = size_ - index; i > 0; i--)
+			array_[index + numElements + i - 1] = nctl::move(array_[index + i - 1]);
+	}
 	copyConstructArray(array_ + index, firstPtr, numElements);
 	size_ += numElements;
 
@@ -461,7 +487,7 @@ T *Array<T>::insertAt(unsigned int index, const T &element)
 		setCapacity(newCapacity);
 	}
 
-	if (index < size_)
+	if (index < size_ && isTriviallyRelocatable<T>::value == false)
 	{
 		// Constructing a new element by moving the last one
 		new (array_ + size_) T(nctl::move(array_[size_ - 1]));
@@ -471,7 +497,11 @@ T *Array<T>::insertAt(unsigned int index, const T &element)
 		array_[index] = element;
 	}
 	else
-		new (array_ + size_) T(element);
+	{
+		// Relocated elements leave behind uninitialized memory for the new one
+		relocateArray(array_ + index + 1, array_ + index, size_ - index);
+		new (array_ + index) T(element);
+	}
 	size_++;
 
 	return (array_ + index + 1);
@@ -489,7 +519,7 @@ T *Array<T>::insertAt(unsigned int index, T &&element)
 		setCapacity(newCapacity);
 	}
 
-	if (index < size_)
+	if (index < size_ && isTriviallyRelocatable<T>::value == false)
 	{
 		// Constructing a new element by moving the last one
 		new (array_ + size_) T(nctl::move(array_[size_ - 1]));
@@ -499,7 +529,11 @@ T *Array<T>::insertAt(unsigned int index, T &&element)
 		array_[index] = nctl::move(element);
 	}
 	else
-		new (array_ + size_) T(nctl::move(element));
+	{
+		// Relocated elements leave behind uninitialized memory for the new one
+		relocateArray(array_ + index + 1, array_ + index, size_ - index);
+		new (array_ + index) T(nctl::move(element));
+	}
 	size_++;
 
 	return (array_ + index + 1);
@@ -518,7 +552,7 @@ T *Array<T>::emplaceAt(unsigned int index, Args &&... args)
 		setCapacity(newCapacity);
 	}
 
-	if (index < size_)
+	if (index < size_ && isTriviallyRelocatable<T>::value == false)
 	{
 		// Constructing a new element by moving the last one
 		new (array_ + size_) T(nctl::move(array_[size_ - 1]));
@@ -527,6 +561,8 @@ T *Array<T>::emplaceAt(unsigned int index, Args &&... args)
 			array_[index + i] = nctl::move(array_[index + i - 1]);
 		destructObject(array_ + index);
 	}
+	else
+		relocateArray(array_ + index + 1, array_ + index, size_ - index);
 	new (array_ + index) T(nctl::forward<Args>(args)...);
 	size_++;
 
@@ -581,8 +617,17 @@ T *Array<T>::removeRange(unsigned int firstIndex, unsigned int lastIndex)
 	FATAL_ASSERT_MSG_X(firstIndex <= lastIndex, "First index %u should precede or be equal to the last one %u", firstIndex, lastIndex);
 
 	const unsigned int numElements = lastIndex - firstIndex;
-	moveAssignArray(array_ + firstIndex, array_ + lastIndex, size_ - lastIndex);
-	destructArray(array_ + size_ - numElements, numElements);
+	if (isTriviallyRelocatable<T>::value)
+	{
+		// Following elements are relocated over the destroyed ones
+		destructArray(array_ + firstIndex, numElements);
+		relocateArray(array_ + firstIndex, array_ + lastIndex, size_ - lastIndex);
+	}
+	else
+	{
+		moveAssignArray(array_ + firstIndex, array_ + lastIndex, size_ - lastIndex);
+		destructArray(array_ + size_ - numElements, numElements);
+	}
 	size_ -= numElements;
 
 	return (array_ + firstIndex);
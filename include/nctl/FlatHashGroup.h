@@ -0,0 +1,165 @@
+#ifndef CLASS_NCTL_FLATHASHGROUP
+#define CLASS_NCTL_FLATHASHGROUP
+
+#include <cstdint>
+#include "HashFunctions.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define NCTL_FLATHASH_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+	#define NCTL_FLATHASH_NEON
+	#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#include <intrin.h>
+#endif
+
+namespace nctl {
+
+/// Control bytes and group probing shared by the flat hash containers
+/*! Every bucket has a control byte: the seven low bits of the hash for a full bucket, or a negative marker.
+ *  Control bytes are compared sixteen at a time with SSE2 or NEON instructions, or with a scalar loop otherwise. */
+namespace FlatHash {
+
+	/// The number of control bytes probed at once
+	static const unsigned int GroupSize = 16;
+
+	/// Markers for control bytes of buckets that are not full
+	enum Control : int8_t
+	{
+		EMPTY = -128,
+		/// A bucket whose element has been removed, probing continues past it
+		DELETED = -2
+	};
+
+	/// Returns true if the control byte belongs to a full bucket
+	inline bool isFull(int8_t control) { return control >= 0; }
+
+	/// Mixes the bits of a hash so that weak hash functions still spread over groups
+	/*! A single multiplication moves the entropy to the high bits, the shift brings it back to the low ones. */
+	inline hash_t mix(hash_t hash)
+	{
+		hash *= 0x9e3779b1U;
+		return hash ^ (hash >> 16);
+	}
+
+	/// Returns the probing part of a mixed hash, used to select the first group
+	inline hash_t h1(hash_t mixedHash) { return mixedHash >> 7; }
+	/// Returns the seven bits of a mixed hash stored in the control byte of a full bucket
+	inline int8_t h2(hash_t mixedHash) { return static_cast<int8_t>(mixedHash & 0x7F); }
+
+	/// Returns the index of the least significant bit set in a non zero value
+	inline unsigned int countTrailingZeros(uint64_t value)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+	#if defined(_M_X64) || defined(_M_ARM64)
+		unsigned long index = 0;
+		_BitScanForward64(&index, value);
+		return static_cast<unsigned int>(index);
+	#else
+		unsigned long index = 0;
+		if (_BitScanForward(&index, static_cast<unsigned long>(value)))
+			return static_cast<unsigned int>(index);
+		_BitScanForward(&index, static_cast<unsigned long>(value >> 32));
+		return static_cast<unsigned int>(index) + 32;
+	#endif
+#else
+		return static_cast<unsigned int>(__builtin_ctzll(value));
+#endif
+	}
+
+	/// The set of buckets in a group that matched a probe, iterated from the lowest index
+	class BitMask
+	{
+	  public:
+#ifdef NCTL_FLATHASH_NEON
+		/// Every bucket is represented by the most significant bit of a nibble
+		static const unsigned int Shift = 2;
+#else
+		static const unsigned int Shift = 0;
+#endif
+
+		explicit BitMask(uint64_t mask)
+		    : mask_(mask) {}
+
+		/// Returns true if at least one bucket has matched
+		inline bool hasMatches() const { return mask_ != 0; }
+		/// Returns the index inside the group of the first matching bucket
+		inline unsigned int lowestIndex() const { return countTrailingZeros(mask_) >> Shift; }
+		/// Removes the first matching bucket from the mask
+		inline void clearLowest() { mask_ &= mask_ - 1; }
+
+	  private:
+		uint64_t mask_;
+	};
+
+	/// A group of control bytes probed at once
+	class Group
+	{
+	  public:
+		explicit Group(const int8_t *controls)
+#if defined(NCTL_FLATHASH_SSE2)
+		    : controls_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(controls))) {}
+#elif defined(NCTL_FLATHASH_NEON)
+		    : controls_(vld1q_s8(controls)) {}
+#else
+		    : controls_(controls) {}
+#endif
+
+		/// Returns the buckets whose control byte is equal to the specified one
+		inline BitMask match(int8_t control) const
+		{
+#if defined(NCTL_FLATHASH_SSE2)
+			return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(control), controls_))));
+#elif defined(NCTL_FLATHASH_NEON)
+			return toBitMask(vceqq_s8(controls_, vdupq_n_s8(control)));
+#else
+			uint64_t mask = 0;
+			for (unsigned int i = 0; i < GroupSize; i++)
+				mask |= static_cast<uint64_t>(controls_[i] == control) << i;
+			return BitMask(mask);
+#endif
+		}
+
+		/// Returns the empty buckets of the group
+		inline BitMask matchEmpty() const { return match(EMPTY); }
+
+		/// Returns the buckets of the group that are empty or deleted
+		inline BitMask matchEmptyOrDeleted() const
+		{
+#if defined(NCTL_FLATHASH_SSE2)
+			return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(controls_)));
+#elif defined(NCTL_FLATHASH_NEON)
+			return toBitMask(vcltq_s8(controls_, vdupq_n_s8(0)));
+#else
+			uint64_t mask = 0;
+			for (unsigned int i = 0; i < GroupSize; i++)
+				mask |= static_cast<uint64_t>(controls_[i] < 0) << i;
+			return BitMask(mask);
+#endif
+		}
+
+	  private:
+#if defined(NCTL_FLATHASH_SSE2)
+		__m128i controls_;
+#elif defined(NCTL_FLATHASH_NEON)
+		int8x16_t controls_;
+
+		/// Narrows a byte comparison result to a nibble per bucket, keeping only one bit of every nibble
+		static inline BitMask toBitMask(uint8x16_t comparison)
+		{
+			const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(comparison), 4);
+			return BitMask(vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ULL);
+		}
+#else
+		const int8_t *controls_;
+#endif
+	};
+
+}
+
+}
+
+#endif
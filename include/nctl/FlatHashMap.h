@@ -0,0 +1,681 @@
+#ifndef CLASS_NCTL_FLATHASHMAP
+#define CLASS_NCTL_FLATHASHMAP
+
+#include <new>
+#include <ncine/common_macros.h>
+#include "HashFunctions.h"
+#include "FlatHashGroup.h"
+#include "ReverseIterator.h"
+#include <cstring> // for memset()
+
+#include <ncine/config.h>
+#if NCINE_WITH_ALLOCATORS
+	#include "AllocManager.h"
+	#include "IAllocator.h"
+#endif
+
+namespace nctl {
+
+template <class K, class T, class HashFunc, bool IsConst> class FlatHashMapIterator;
+template <class K, class T, class HashFunc, bool IsConst> struct FlatHashMapHelperTraits;
+
+/// A template based hashmap implementation with open addressing and group probing of control bytes
+/*! The capacity is always a power of two and at least as big as a group. The hashmap grows automatically
+ *  when the number of used buckets, including the ones of removed elements, would exceed the maximum load factor. */
+template <class K, class T, class HashFunc = FNV1aHashFunc<K>>
+class FlatHashMap
+{
+  public:
+	/// Iterator type
+	using Iterator = FlatHashMapIterator<K, T, HashFunc, false>;
+	/// Constant iterator type
+	using ConstIterator = FlatHashMapIterator<K, T, HashFunc, true>;
+	/// Reverse iterator type
+	using ReverseIterator = nctl::ReverseIterator<Iterator>;
+	/// Reverse constant iterator type
+	using ConstReverseIterator = nctl::ReverseIterator<ConstIterator>;
+
+	/// The default maximum ratio between used and total buckets before growing
+	static constexpr float DefaultMaxLoadFactor = 0.875f;
+
+	/// Creates a hashmap with at least the specified number of buckets, zero defers the allocation to the first insertion
+	explicit FlatHashMap(unsigned int capacity);
+#if NCINE_WITH_ALLOCATORS
+	FlatHashMap(unsigned int capacity, IAllocator &alloc);
+#endif
+	~FlatHashMap();
+
+	/// Copy constructor
+	FlatHashMap(const FlatHashMap &other);
+	/// Move constructor
+	FlatHashMap(FlatHashMap &&other);
+	/// Assignment operator
+	FlatHashMap &operator=(const FlatHashMap &other);
+	/// Move assignment operator
+	FlatHashMap &operator=(FlatHashMap &&other);
+
+	/// Swaps two hashmaps without copying their data
+	inline void swap(FlatHashMap &first, FlatHashMap &second)
+	{
+#if NCINE_WITH_ALLOCATORS
+		nctl::swap(first.alloc_, second.alloc_);
+#endif
+		nctl::swap(first.size_, second.size_);
+		nctl::swap(first.capacity_, second.capacity_);
+		nctl::swap(first.numDeleted_, second.numDeleted_);
+		nctl::swap(first.growthLimit_, second.growthLimit_);
+		nctl::swap(first.maxLoadFactor_, second.maxLoadFactor_);
+		nctl::swap(first.controls_, second.controls_);
+		nctl::swap(first.nodes_, second.nodes_);
+	}
+
+	/// Returns an iterator to the first element
+	Iterator begin();
+	/// Returns a reverse iterator to the last element
+	ReverseIterator rBegin();
+	/// Returns an iterator to past the last element
+	Iterator end();
+	/// Returns a reverse iterator to prior the first element
+	ReverseIterator rEnd();
+
+	/// Returns a constant iterator to the first element
+	ConstIterator begin() const;
+	/// Returns a constant reverse iterator to the last element
+	ConstReverseIterator rBegin() const;
+	/// Returns a constant iterator to past the last lement
+	ConstIterator end() const;
+	/// Returns a constant reverse iterator to prior the first element
+	ConstReverseIterator rEnd() const;
+
+	/// Returns a constant iterator to the first element
+	inline ConstIterator cBegin() const { return begin(); }
+	/// Returns a constant reverse iterator to the last element
+	inline ConstReverseIterator crBegin() const { return rBegin(); }
+	/// Returns a constant iterator to past the last lement
+	inline ConstIterator cEnd() const { return end(); }
+	/// Returns a constant reverse iterator to prior the first element
+	inline ConstReverseIterator crEnd() const { return rEnd(); }
+
+	/// Subscript operator
+	T &operator[](const K &key);
+	/// Inserts an element if no other has the same key
+	bool insert(const K &key, const T &value);
+	/// Moves an element if no other has the same key
+	bool insert(const K &key, T &&value);
+	/// Constructs an element if no other has the same key
+	template <typename... Args> bool emplace(const K &key, Args &&... args);
+
+	/// Returns the capacity of the hashmap
+	inline unsigned int capacity() const { return capacity_; }
+	/// Returns true if the hashmap is empty
+	inline bool isEmpty() const { return size_ == 0; }
+	/// Returns the number of elements in the hashmap
+	inline unsigned int size() const { return size_; }
+	/// Returns the ratio between used and total buckets
+	inline float loadFactor() const { return (capacity_ > 0) ? size_ / static_cast<float>(capacity_) : 0.0f; }
+	/// Returns the hash of a given key
+	inline hash_t hash(const K &key) const { return hashFunc_(key); }
+
+	/// Returns the maximum load factor before the hashmap grows
+	inline float maxLoadFactor() const { return maxLoadFactor_; }
+	/// Sets the maximum load factor before the hashmap grows, the change applies from the next insertion
+	void setMaxLoadFactor(float maxLoadFactor);
+
+	/// Clears the hashmap
+	void clear();
+	/// Checks whether an element is in the hashmap or not
+	bool contains(const K &key, T &returnedValue) const;
+	/// Checks whether an element is in the hashmap or not
+	T *find(const K &key);
+	/// Checks whether an element is in the hashmap or not (read-only)
+	const T *find(const K &key) const;
+	/// Removes a key from the hashmap, if it exists
+	bool remove(const K &key);
+
+	/// Sets the number of buckets to at least the specified count and rehashes the container
+	void rehash(unsigned int count);
+
+  private:
+	/// The template class for the node stored inside the hashmap
+	class Node
+	{
+	  public:
+		K key;
+		T value;
+
+		Node() {}
+		explicit Node(K kk)
+		    : key(kk) {}
+		Node(K kk, const T &vv)
+		    : key(kk), value(vv) {}
+		Node(K kk, T &&vv)
+		    : key(kk), value(nctl::move(vv)) {}
+		template <typename... Args>
+		Node(K kk, Args &&... args)
+		    : key(kk), value(nctl::forward<Args>(args)...) {}
+	};
+
+#if NCINE_WITH_ALLOCATORS
+	/// The custom memory allocator for the hashmap
+	IAllocator &alloc_;
+#endif
+	unsigned int size_;
+	unsigned int capacity_;
+	/// The number of buckets marked as deleted, they count towards the load factor until the next rehash
+	unsigned int numDeleted_;
+	/// The maximum number of full and deleted buckets before growing
+	unsigned int growthLimit_;
+	float maxLoadFactor_;
+	int8_t *controls_;
+	Node *nodes_;
+	HashFunc hashFunc_;
+
+	static unsigned int calcCapacity(unsigned int count);
+	unsigned int calcGrowthLimit(unsigned int capacity) const;
+	void allocate(unsigned int capacity);
+	void deallocate();
+	void destructNodes();
+	bool findBucketIndex(const K &key, hash_t mixedHash, unsigned int &foundIndex) const;
+	inline bool findBucketIndex(const K &key, unsigned int &foundIndex) const;
+	unsigned int findInsertionIndex(hash_t mixedHash) const;
+	unsigned int prepareInsertion(hash_t mixedHash);
+
+	friend class FlatHashMapIterator<K, T, HashFunc, false>;
+	friend class FlatHashMapIterator<K, T, HashFunc, true>;
+	friend struct FlatHashMapHelperTraits<K, T, HashFunc, false>;
+	friend struct FlatHashMapHelperTraits<K, T, HashFunc, true>;
+};
+
+template <class K, class T, class HashFunc>
+constexpr float FlatHashMap<K, T, HashFunc>::DefaultMaxLoadFactor;
+
+template <class K, class T, class HashFunc>
+inline typename FlatHashMap<K, T, HashFunc>::Iterator FlatHashMap<K, T, HashFunc>::begin()
+{
+	Iterator iterator(this, Iterator::SentinelTagInit::BEGINNING);
+	return ++iterator;
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::ReverseIterator FlatHashMap<K, T, HashFunc>::rBegin()
+{
+	Iterator iterator(this, Iterator::SentinelTagInit::END);
+	return ReverseIterator(--iterator);
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::Iterator FlatHashMap<K, T, HashFunc>::end()
+{
+	return Iterator(this, Iterator::SentinelTagInit::END);
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::ReverseIterator FlatHashMap<K, T, HashFunc>::rEnd()
+{
+	Iterator iterator(this, Iterator::SentinelTagInit::BEGINNING);
+	return ReverseIterator(iterator);
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::ConstIterator FlatHashMap<K, T, HashFunc>::begin() const
+{
+	ConstIterator iterator(this, ConstIterator::SentinelTagInit::BEGINNING);
+	return ++iterator;
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::ConstReverseIterator FlatHashMap<K, T, HashFunc>::rBegin() const
+{
+	ConstIterator iterator(this, ConstIterator::SentinelTagInit::END);
+	return ConstReverseIterator(--iterator);
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::ConstIterator FlatHashMap<K, T, HashFunc>::end() const
+{
+	return ConstIterator(this, ConstIterator::SentinelTagInit::END);
+}
+
+template <class K, class T, class HashFunc>
+typename FlatHashMap<K, T, HashFunc>::ConstReverseIterator FlatHashMap<K, T, HashFunc>::rEnd() const
+{
+	ConstIterator iterator(this, ConstIterator::SentinelTagInit::BEGINNING);
+	return ConstReverseIterator(iterator);
+}
+
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc>::FlatHashMap(unsigned int capacity)
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(theDefaultAllocator()),
+#endif
+      size_(0), capacity_(0), numDeleted_(0), growthLimit_(0),
+      maxLoadFactor_(DefaultMaxLoadFactor), controls_(nullptr), nodes_(nullptr)
+{
+	if (capacity > 0)
+		allocate(calcCapacity(capacity));
+}
+
+#if NCINE_WITH_ALLOCATORS
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc>::FlatHashMap(unsigned int capacity, IAllocator &alloc)
+    : alloc_(alloc), size_(0), capacity_(0), numDeleted_(0), growthLimit_(0),
+      maxLoadFactor_(DefaultMaxLoadFactor), controls_(nullptr), nodes_(nullptr)
+{
+	if (capacity > 0)
+		allocate(calcCapacity(capacity));
+}
+#endif
+
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc>::~FlatHashMap()
+{
+	destructNodes();
+	deallocate();
+}
+
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc>::FlatHashMap(const FlatHashMap<K, T, HashFunc> &other)
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(other.alloc_),
+#endif
+      size_(0), capacity_(0), numDeleted_(0), growthLimit_(0),
+      maxLoadFactor_(other.maxLoadFactor_), controls_(nullptr), nodes_(nullptr)
+{
+	*this = other;
+}
+
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc>::FlatHashMap(FlatHashMap<K, T, HashFunc> &&other)
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(other.alloc_),
+#endif
+      size_(other.size_), capacity_(other.capacity_), numDeleted_(other.numDeleted_), growthLimit_(other.growthLimit_),
+      maxLoadFactor_(other.maxLoadFactor_), controls_(other.controls_), nodes_(other.nodes_)
+{
+	other.size_ = 0;
+	other.capacity_ = 0;
+	other.numDeleted_ = 0;
+	other.growthLimit_ = 0;
+	other.controls_ = nullptr;
+	other.nodes_ = nullptr;
+}
+
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc> &FlatHashMap<K, T, HashFunc>::operator=(const FlatHashMap<K, T, HashFunc> &other)
+{
+	if (this == &other)
+		return *this;
+
+	destructNodes();
+	if (capacity_ != other.capacity_)
+	{
+		deallocate();
+		if (other.capacity_ > 0)
+			allocate(other.capacity_);
+	}
+
+	maxLoadFactor_ = other.maxLoadFactor_;
+	growthLimit_ = calcGrowthLimit(capacity_);
+	if (capacity_ > 0)
+		memcpy(controls_, other.controls_, capacity_);
+	for (unsigned int i = 0; i < capacity_; i++)
+	{
+		if (FlatHash::isFull(other.controls_[i]))
+			new (nodes_ + i) Node(other.nodes_[i]);
+	}
+	size_ = other.size_;
+	numDeleted_ = other.numDeleted_;
+
+	return *this;
+}
+
+template <class K, class T, class HashFunc>
+FlatHashMap<K, T, HashFunc> &FlatHashMap<K, T, HashFunc>::operator=(FlatHashMap<K, T, HashFunc> &&other)
+{
+	if (this != &other)
+	{
+		swap(*this, other);
+		other.clear();
+	}
+	return *this;
+}
+
+template <class K, class T, class HashFunc>
+T &FlatHashMap<K, T, HashFunc>::operator[](const K &key)
+{
+	const hash_t mixedHash = FlatHash::mix(hashFunc_(key));
+	unsigned int bucketIndex = 0;
+	if (findBucketIndex(key, mixedHash, bucketIndex))
+		return nodes_[bucketIndex].value;
+
+	bucketIndex = prepareInsertion(mixedHash);
+	new (nodes_ + bucketIndex) Node(key);
+	return nodes_[bucketIndex].value;
+}
+
+/*! \return True if the element has been inserted */
+template <class K, class T, class HashFunc>
+bool FlatHashMap<K, T, HashFunc>::insert(const K &key, const T &value)
+{
+	const hash_t mixedHash = FlatHash::mix(hashFunc_(key));
+	unsigned int bucketIndex = 0;
+	if (findBucketIndex(key, mixedHash, bucketIndex))
+		return false;
+
+	bucketIndex = prepareInsertion(mixedHash);
+	new (nodes_ + bucketIndex) Node(key, value);
+	return true;
+}
+
+/*! \return True if the element has been inserted */
+template <class K, class T, class HashFunc>
+bool FlatHashMap<K, T, HashFunc>::insert(const K &key, T &&value)
+{
+	const hash_t mixedHash = FlatHash::mix(hashFunc_(key));
+	unsigned int bucketIndex = 0;
+	if (findBucketIndex(key, mixedHash, bucketIndex))
+		return false;
+
+	bucketIndex = prepareInsertion(mixedHash);
+	new (nodes_ + bucketIndex) Node(key, nctl::move(value));
+	return true;
+}
+
+/*! \return True if the element has been emplaced */
+template <class K, class T, class HashFunc>
+template <typename... Args>
+bool FlatHashMap<K, T, HashFunc>::emplace(const K &key, Args &&... args)
+{
+	const hash_t mixedHash = FlatHash::mix(hashFunc_(key));
+	unsigned int bucketIndex = 0;
+	if (findBucketIndex(key, mixedHash, bucketIndex))
+		return false;
+
+	bucketIndex = prepareInsertion(mixedHash);
+	new (nodes_ + bucketIndex) Node(key, nctl::forward<Args>(args)...);
+	return true;
+}
+
+/*! \note The value is clamped between 0.25 and 0.95, so that there are always empty buckets to stop probing */
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::setMaxLoadFactor(float maxLoadFactor)
+{
+	ASSERT(maxLoadFactor > 0.0f && maxLoadFactor <= 1.0f);
+	if (maxLoadFactor < 0.25f)
+		maxLoadFactor = 0.25f;
+	else if (maxLoadFactor > 0.95f)
+		maxLoadFactor = 0.95f;
+
+	maxLoadFactor_ = maxLoadFactor;
+	growthLimit_ = calcGrowthLimit(capacity_);
+}
+
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::clear()
+{
+	destructNodes();
+	if (capacity_ > 0)
+		memset(controls_, FlatHash::EMPTY, capacity_);
+	numDeleted_ = 0;
+}
+
+template <class K, class T, class HashFunc>
+bool FlatHashMap<K, T, HashFunc>::contains(const K &key, T &returnedValue) const
+{
+	unsigned int bucketIndex = 0;
+	const bool found = findBucketIndex(key, bucketIndex);
+
+	if (found)
+		returnedValue = nodes_[bucketIndex].value;
+
+	return found;
+}
+
+/*! \note Prefer this method if copying `T` is expensive, but always check the validity of returned pointer. */
+template <class K, class T, class HashFunc>
+T *FlatHashMap<K, T, HashFunc>::find(const K &key)
+{
+	unsigned int bucketIndex = 0;
+	const bool found = findBucketIndex(key, bucketIndex);
+
+	T *returnedPtr = nullptr;
+	if (found)
+		returnedPtr = &nodes_[bucketIndex].value;
+
+	return returnedPtr;
+}
+
+/*! \note Prefer this method if copying `T` is expensive, but always check the validity of returned pointer. */
+template <class K, class T, class HashFunc>
+const T *FlatHashMap<K, T, HashFunc>::find(const K &key) const
+{
+	unsigned int bucketIndex = 0;
+	const bool found = findBucketIndex(key, bucketIndex);
+
+	const T *returnedPtr = nullptr;
+	if (found)
+		returnedPtr = &nodes_[bucketIndex].value;
+
+	return returnedPtr;
+}
+
+/*! \return True if the element has been found and removed */
+template <class K, class T, class HashFunc>
+bool FlatHashMap<K, T, HashFunc>::remove(const K &key)
+{
+	unsigned int bucketIndex = 0;
+	const bool found = findBucketIndex(key, bucketIndex);
+
+	if (found)
+	{
+		destructObject(nodes_ + bucketIndex);
+		size_--;
+
+		// A group with an empty bucket has never been full, no probe sequence has continued past it
+		const unsigned int groupIndex = bucketIndex & ~(FlatHash::GroupSize - 1);
+		if (FlatHash::Group(controls_ + groupIndex).matchEmpty().hasMatches())
+			controls_[bucketIndex] = FlatHash::EMPTY;
+		else
+		{
+			controls_[bucketIndex] = FlatHash::DELETED;
+			numDeleted_++;
+		}
+	}
+
+	return found;
+}
+
+/*! \note The capacity is rounded up to a power of two that can store all the elements without exceeding the maximum load factor */
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::rehash(unsigned int count)
+{
+	if (count < size_)
+		return;
+
+	unsigned int newCapacity = calcCapacity(count);
+	while (calcGrowthLimit(newCapacity) <= size_)
+		newCapacity *= 2;
+
+#if !NCINE_WITH_ALLOCATORS
+	FlatHashMap<K, T, HashFunc> hashMap(0);
+#else
+	FlatHashMap<K, T, HashFunc> hashMap(0, alloc_);
+#endif
+	hashMap.maxLoadFactor_ = maxLoadFactor_;
+	hashMap.allocate(newCapacity);
+
+	unsigned int rehashedNodes = 0;
+	for (unsigned int i = 0; i < capacity_ && rehashedNodes < size_; i++)
+	{
+		if (FlatHash::isFull(controls_[i]))
+		{
+			Node &node = nodes_[i];
+			// Keys are already unique, there is no need to search them in the new hashmap
+			const unsigned int newIndex = hashMap.prepareInsertion(FlatHash::mix(hashFunc_(node.key)));
+			new (hashMap.nodes_ + newIndex) Node(node.key, nctl::move(node.value));
+			rehashedNodes++;
+		}
+	}
+
+	destructNodes();
+	swap(*this, hashMap);
+}
+
+template <class K, class T, class HashFunc>
+unsigned int FlatHashMap<K, T, HashFunc>::calcCapacity(unsigned int count)
+{
+	unsigned int capacity = FlatHash::GroupSize;
+	while (capacity < count)
+		capacity *= 2;
+	return capacity;
+}
+
+template <class K, class T, class HashFunc>
+unsigned int FlatHashMap<K, T, HashFunc>::calcGrowthLimit(unsigned int capacity) const
+{
+	const unsigned int growthLimit = static_cast<unsigned int>(capacity * maxLoadFactor_);
+	// At least one bucket is always empty
+	return (growthLimit < capacity) ? growthLimit : capacity - 1;
+}
+
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::allocate(unsigned int capacity)
+{
+	FATAL_ASSERT(capacity >= FlatHash::GroupSize && (capacity & (capacity - 1)) == 0);
+
+	capacity_ = capacity;
+	growthLimit_ = calcGrowthLimit(capacity_);
+#if !NCINE_WITH_ALLOCATORS
+	controls_ = static_cast<int8_t *>(::operator new(capacity_));
+	nodes_ = static_cast<Node *>(::operator new(sizeof(Node) * capacity_));
+#else
+	controls_ = static_cast<int8_t *>(alloc_.allocate(capacity_));
+	nodes_ = static_cast<Node *>(alloc_.allocate(sizeof(Node) * capacity_));
+#endif
+	memset(controls_, FlatHash::EMPTY, capacity_);
+}
+
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::deallocate()
+{
+#if !NCINE_WITH_ALLOCATORS
+	::operator delete(controls_);
+	::operator delete(nodes_);
+#else
+	if (controls_ != nullptr)
+		alloc_.deallocate(controls_);
+	if (nodes_ != nullptr)
+		alloc_.deallocate(nodes_);
+#endif
+	controls_ = nullptr;
+	nodes_ = nullptr;
+	capacity_ = 0;
+	growthLimit_ = 0;
+	numDeleted_ = 0;
+}
+
+template <class K, class T, class HashFunc>
+void FlatHashMap<K, T, HashFunc>::destructNodes()
+{
+	for (unsigned int i = 0; i < capacity_ && size_ > 0; i++)
+	{
+		if (FlatHash::isFull(controls_[i]))
+		{
+			destructObject(nodes_ + i);
+			controls_[i] = FlatHash::EMPTY;
+			size_--;
+		}
+	}
+	size_ = 0;
+}
+
+template <class K, class T, class HashFunc>
+bool FlatHashMap<K, T, HashFunc>::findBucketIndex(const K &key, hash_t mixedHash, unsigned int &foundIndex) const
+{
+	if (size_ == 0)
+		return false;
+
+	const int8_t control = FlatHash::h2(mixedHash);
+	const unsigned int groupMask = capacity_ / FlatHash::GroupSize - 1;
+	unsigned int groupIndex = FlatHash::h1(mixedHash) & groupMask;
+
+	// Triangular probing visits every group once when their number is a power of two
+	for (unsigned int step = 1; step <= groupMask + 1; step++)
+	{
+		const unsigned int firstIndex = groupIndex * FlatHash::GroupSize;
+		const FlatHash::Group group(controls_ + firstIndex);
+
+		FlatHash::BitMask matches = group.match(control);
+		while (matches.hasMatches())
+		{
+			const unsigned int index = firstIndex + matches.lowestIndex();
+			if (equalTo(nodes_[index].key, key))
+			{
+				foundIndex = index;
+				return true;
+			}
+			matches.clearLowest();
+		}
+
+		if (group.matchEmpty().hasMatches())
+			return false;
+
+		groupIndex = (groupIndex + step) & groupMask;
+	}
+
+	return false;
+}
+
+template <class K, class T, class HashFunc>
+bool FlatHashMap<K, T, HashFunc>::findBucketIndex(const K &key, unsigned int &foundIndex) const
+{
+	if (size_ == 0)
+		return false;
+
+	return findBucketIndex(key, FlatHash::mix(hashFunc_(key)), foundIndex);
+}
+
+template <class K, class T, class HashFunc>
+unsigned int FlatHashMap<K, T, HashFunc>::findInsertionIndex(hash_t mixedHash) const
+{
+	const unsigned int groupMask = capacity_ / FlatHash::GroupSize - 1;
+	unsigned int groupIndex = FlatHash::h1(mixedHash) & groupMask;
+
+	for (unsigned int step = 1;; step++)
+	{
+		const unsigned int firstIndex = groupIndex * FlatHash::GroupSize;
+		const FlatHash::BitMask available = FlatHash::Group(controls_ + firstIndex).matchEmptyOrDeleted();
+		if (available.hasMatches())
+			return firstIndex + available.lowestIndex();
+
+		groupIndex = (groupIndex + step) & groupMask;
+	}
+}
+
+template <class K, class T, class HashFunc>
+unsigned int FlatHashMap<K, T, HashFunc>::prepareInsertion(hash_t mixedHash)
+{
+	if (size_ + numDeleted_ >= growthLimit_)
+	{
+		// Removing the deleted buckets is enough if they account for at least half of the limit
+		if (capacity_ > 0 && size_ < growthLimit_ / 2)
+			rehash(capacity_);
+		else
+			rehash(capacity_ > 0 ? capacity_ * 2 : FlatHash::GroupSize);
+	}
+
+	const unsigned int index = findInsertionIndex(mixedHash);
+	if (controls_[index] == FlatHash::DELETED)
+		numDeleted_--;
+	controls_[index] = FlatHash::h2(mixedHash);
+	size_++;
+
+	return index;
+}
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef CLASS_NCTL_FRAMEALLOCATOR
+#define CLASS_NCTL_FRAMEALLOCATOR
+
+#include <nctl/LinearAllocator.h>
+
+namespace nctl {
+
+/// A double buffered linear allocator for data that only lives for a frame
+/*! The buffer is split in two linear halves, allocations are served by the half of the current frame and
+ *  are lost when it is reused two frames later. Deallocations of arena memory do nothing, while requests
+ *  that do not fit are served by the fallback allocator and should be deallocated as usual.
+ *  \note The allocator is not thread-safe and should only be used by the thread that advances the frames */
+class DLL_PUBLIC FrameAllocator : public IAllocator
+{
+  public:
+	FrameAllocator()
+	    : FrameAllocator("Frame") {}
+	explicit FrameAllocator(const char *name);
+	FrameAllocator(size_t size, void *base, IAllocator &fallback)
+	    : FrameAllocator("Frame", size, base, fallback) {}
+	FrameAllocator(const char *name, size_t size, void *base, IAllocator &fallback);
+	~FrameAllocator();
+
+	void init(size_t size, void *base, IAllocator &fallback);
+	/// Starts a new frame, losing the allocations made two frames ago
+	void nextFrame();
+	/// Clears and loses the allocations of both frames in costant time
+	void clear();
+
+	/// Returns the allocator that serves the requests that do not fit in the current half
+	inline IAllocator *fallback() const { return fallback_; }
+	/// Returns the amount of memory used by the previous frame
+	inline size_t lastFrameUsedMemory() const { return lastFrameUsedMemory_; }
+	/// Returns the maximum amount of memory used by a single frame
+	inline size_t highWaterMark() const { return highWaterMark_; }
+	/// Resets the maximum amount of memory used by a single frame
+	inline void resetHighWaterMark() { highWaterMark_ = 0; }
+	/// Returns the number of requests served by the fallback allocator in the current frame
+	inline size_t numFallbacks() const { return numFallbacks_; }
+	/// Returns the number of requests served by the fallback allocator in the previous frame
+	inline size_t lastFrameNumFallbacks() const { return lastFrameNumFallbacks_; }
+
+  private:
+	/// The two halves of the buffer, used in alternate frames
+	LinearAllocator buffers_[2];
+	unsigned int currentIndex_;
+	IAllocator *fallback_;
+
+	size_t lastFrameUsedMemory_;
+	size_t highWaterMark_;
+	size_t numFallbacks_;
+	size_t lastFrameNumFallbacks_;
+
+	FrameAllocator(const FrameAllocator &) = delete;
+	FrameAllocator &operator=(const FrameAllocator &) = delete;
+
+	/// Returns true if the pointer belongs to one of the two halves of the buffer
+	bool isInArena(const void *ptr) const;
+	/// Updates the statistics after the current half has been used
+	void updateUsedMemory();
+
+	static void *allocateImpl(IAllocator *allocator, size_t size, uint8_t alignment);
+	static void *reallocateImpl(IAllocator *allocator, void *ptr, size_t size, uint8_t alignment, size_t &oldSize);
+	static void deallocateImpl(IAllocator *allocator, void *ptr);
+};
+
+}
+
+#endif
@@ -171,6 +171,30 @@ class JenkinsHashFunc<String>
 	}
 };
 
+/// The FNV-1a hash of character sequences, shared by the string specializations of `FNV1aHashFunc` and by `HashedName`
+namespace FNV1a {
+
+	static const hash_t Prime = 0x01000193; //  16777619
+	static const hash_t Seed = 0x811C9DC5; // 2166136261
+
+	/// Calculates the FNV-1a hash of a sequence of characters
+	inline hash_t hash(const char *string, unsigned int length)
+	{
+		hash_t hash = Seed;
+		for (unsigned int i = 0; i < length; i++)
+			hash = (static_cast<unsigned char>(string[i]) ^ hash) * Prime;
+
+		return hash;
+	}
+
+	/// Calculates the FNV-1a hash of a sequence of characters at compile time
+	/*! \note The recursion depth is proportional to the length, it should only be used for short strings */
+	constexpr hash_t hashConstexpr(const char *string, unsigned int length, hash_t hash = Seed)
+	{
+		return (length == 0) ? hash : hashConstexpr(string + 1, length - 1, (static_cast<unsigned char>(string[0]) ^ hash) * Prime);
+	}
+}
+
 /// Fowler-Noll-Vo Hash (FNV-1a)
 /*!
  * For more information: http://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
@@ -208,29 +232,12 @@ template <>
 class FNV1aHashFunc<const char *>
 {
   public:
-	hash_t operator()(const char *key) const
-	{
-		const unsigned int length = strlen(key);
-		hash_t hash = static_cast<hash_t>(Seed);
-		for (unsigned int i = 0; i < length; i++)
-			hash = fnv1a(key[i], hash);
-
-		return hash;
-	}
-
-  private:
-	static const hash_t Prime = 0x01000193; //  16777619
-	static const hash_t Seed = 0x811C9DC5; // 2166136261
-
-	inline hash_t fnv1a(const char oneByte, hash_t hash = Seed) const
-	{
-		return (oneByte ^ hash) * Prime;
-	}
+	hash_t operator()(const char *key) const { return FNV1a::hash(key, strlen(key)); }
 };
 
 /// Fowler-Noll-Vo Hash (FNV-1a)
 /*!
- * \note Specialized version of the function for String objects
+ * \note Specialized version of the function for String objects, the hash is cached by the string until it is modified
  *
  * For more information: http://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
  */
@@ -238,24 +245,7 @@ template <>
 class FNV1aHashFunc<String>
 {
   public:
-	hash_t operator()(const String &string) const
-	{
-		const unsigned int length = string.length();
-		hash_t hash = static_cast<hash_t>(Seed);
-		for (unsigned int i = 0; i < length; i++)
-			hash = fnv1a(static_cast<hash_t>(string[i]), hash);
-
-		return hash;
-	}
-
-  private:
-	static const hash_t Prime = 0x01000193; //  16777619
-	static const hash_t Seed = 0x811C9DC5; // 2166136261
-
-	inline hash_t fnv1a(unsigned char oneByte, hash_t hash = Seed) const
-	{
-		return (oneByte ^ hash) * Prime;
-	}
+	hash_t operator()(const String &string) const { return string.hash(); }
 };
 
 uint64_t fasthash64(const void *buf, size_t len, uint64_t seed);
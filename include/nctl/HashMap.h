@@ -21,6 +21,8 @@ template <class K, class T, class HashFunc, bool IsConst> struct HashMapHelperTr
 class String;
 
 /// A template based hashmap implementation with open addressing and leapfrog probing
+/*! The hashmap can optionally grow when a maximum load factor is reached, either all at once or incrementally.
+ *  With incremental rehashing the old buckets are kept aside and migrated a few at a time by every modifying operation. */
 template <class K, class T, class HashFunc = FNV1aHashFunc<K>>
 class HashMap
 {
@@ -62,6 +64,10 @@ class HashMap
 		nctl::swap(first.delta2_, second.delta2_);
 		nctl::swap(first.hashes_, second.hashes_);
 		nctl::swap(first.nodes_, second.nodes_);
+		nctl::swap(first.maxLoadFactor_, second.maxLoadFactor_);
+		nctl::swap(first.incrementalRehash_, second.incrementalRehash_);
+		nctl::swap(first.rehashSource_, second.rehashSource_);
+		nctl::swap(first.rehashIndex_, second.rehashIndex_);
 	}
 
 	/// Returns an iterator to the first element
@@ -103,30 +109,57 @@ class HashMap
 	/// Returns the capacity of the hashmap
 	inline unsigned int capacity() const { return capacity_; }
 	/// Returns true if the hashmap is empty
-	inline bool isEmpty() const { return size_ == 0; }
+	inline bool isEmpty() const { return size() == 0; }
 	/// Returns the number of elements in the hashmap
-	inline unsigned int size() const { return size_; }
+	inline unsigned int size() const { return (rehashSource_ == nullptr) ? size_ : size_ + rehashSource_->size_; }
 	/// Returns the ratio between used and total buckets
-	inline float loadFactor() const { return size_ / static_cast<float>(capacity_); }
+	inline float loadFactor() const { return size() / static_cast<float>(capacity_); }
 	/// Returns the hash of a given key
 	inline hash_t hash(const K &key) const { return hashFunc_(key); }
 
 	/// Clears the hashmap
 	void clear();
 	/// Checks whether an element is in the hashmap or not
-	bool contains(const K &key, T &returnedValue) const;
+	inline bool contains(const K &key, T &returnedValue) const { return contains(key, hashFunc_(key), returnedValue); }
 	/// Checks whether an element is in the hashmap or not
-	T *find(const K &key);
+	inline T *find(const K &key) { return find(key, hashFunc_(key)); }
 	/// Checks whether an element is in the hashmap or not (read-only)
-	const T *find(const K &key) const;
+	inline const T *find(const K &key) const { return find(key, hashFunc_(key)); }
+	/// Checks whether an element is in the hashmap or not, using a precomputed hash of the key
+	bool contains(const K &key, hash_t hash, T &returnedValue) const;
+	/// Checks whether an element is in the hashmap or not, using a precomputed hash of the key
+	T *find(const K &key, hash_t hash);
+	/// Checks whether an element is in the hashmap or not, using a precomputed hash of the key (read-only)
+	const T *find(const K &key, hash_t hash) const;
+	/// Checks whether an element with a string key is in the hashmap or not, comparing the characters without constructing a key
+	bool contains(const char *key, unsigned int length, hash_t hash, T &returnedValue) const;
+	/// Checks whether an element with a string key is in the hashmap or not, comparing the characters without constructing a key
+	T *find(const char *key, unsigned int length, hash_t hash);
+	/// Checks whether an element with a string key is in the hashmap or not, comparing the characters without constructing a key (read-only)
+	const T *find(const char *key, unsigned int length, hash_t hash) const;
 	/// Removes a key from the hashmap, if it exists
 	bool remove(const K &key);
 
 	/// Sets the number of buckets to the new specified size and rehashes the container
 	void rehash(unsigned int count);
 
+	/// Returns the load factor that makes the hashmap double its capacity, zero if it never grows automatically
+	inline float maxLoadFactor() const { return maxLoadFactor_; }
+	/// Sets the load factor that makes the hashmap double its capacity, zero disables automatic growth
+	void setMaxLoadFactor(float maxLoadFactor);
+	/// Returns true if automatic growth migrates the elements a few buckets at a time
+	inline bool incrementalRehash() const { return incrementalRehash_; }
+	/// Sets whether automatic growth migrates the elements a few buckets at a time instead of all at once
+	void setIncrementalRehash(bool enabled);
+	/// Returns true if an incremental rehash is in progress
+	inline bool isRehashing() const { return rehashSource_ != nullptr; }
+	/// Migrates all the elements still waiting for an incremental rehash
+	void finishRehash();
+
   private:
 	static const unsigned int AlignmentBytes = sizeof(int);
+	/// The number of old buckets migrated by every modifying operation during an incremental rehash
+	static const unsigned int RehashBucketsPerOperation = 8;
 
 	/// The template class for the node stored inside the hashmap
 	class Node
@@ -160,24 +193,59 @@ class HashMap
 	hash_t *hashes_;
 	Node *nodes_;
 	HashFunc hashFunc_;
-
+	float maxLoadFactor_;
+	bool incrementalRehash_;
+	/// The hashmap with the old buckets during an incremental rehash
+	HashMap *rehashSource_;
+	/// The index of the next old bucket to migrate
+	unsigned int rehashIndex_;
+
+	void allocate(unsigned int capacity);
 	void initPointers();
 	void initValues();
 	void destructNodes();
 	void deallocate();
-	bool findBucketIndex(const K &key, unsigned int &foundIndex, unsigned int &prevFoundIndex) const;
-	inline bool findBucketIndex(const K &key, unsigned int &foundIndex) const;
+	template <class KeyType> bool findBucketIndex(const KeyType &key, hash_t hash, unsigned int &foundIndex, unsigned int &prevFoundIndex) const;
+	template <class KeyType> inline bool findBucketIndex(const KeyType &key, hash_t hash, unsigned int &foundIndex) const;
 	unsigned int addDelta1(unsigned int bucketIndex) const;
 	unsigned int addDelta2(unsigned int bucketIndex) const;
 	unsigned int calcNewDelta(unsigned int bucketIndex, unsigned int newIndex) const;
 	unsigned int linearSearch(unsigned int index, hash_t hash, const K &key) const;
-	bool bucketFoundOrEmpty(unsigned int index, hash_t hash, const K &key) const;
-	bool bucketFound(unsigned int index, hash_t hash, const K &key) const;
+	template <class KeyType> bool bucketFoundOrEmpty(unsigned int index, hash_t hash, const KeyType &key) const;
+	template <class KeyType> bool bucketFound(unsigned int index, hash_t hash, const KeyType &key) const;
+
+	/// The characters of a string key, compared with the stored keys in place of a temporary `K` object
+	struct CharsKey
+	{
+		const char *chars;
+		unsigned int length;
+	};
+
+	inline bool keyEquals(const K &nodeKey, const K &key) const { return equalTo(nodeKey, key); }
+	inline bool keyEquals(const K &nodeKey, const CharsKey &key) const { return (nodeKey.length() == key.length && memcmp(nodeKey.data(), key.chars, key.length) == 0); }
+	inline bool hashMatches(const K &key, hash_t hash) const { return hash == hashFunc_(key); }
+	/// The hash function can only be applied to a `K` object, the hash of the characters is not checked
+	inline bool hashMatches(const CharsKey &, hash_t) const { return true; }
 	T &addNode(unsigned int index, hash_t hash, const K &key);
 	void insertNode(unsigned int index, hash_t hash, const K &key, const T &value);
 	void insertNode(unsigned int index, hash_t hash, const K &key, T &&value);
 	template <typename... Args> void emplaceNode(unsigned int index, hash_t hash, const K &key, Args &&... args);
 
+	inline bool needsPreparation() const { return (rehashSource_ != nullptr || maxLoadFactor_ > 0.0f); }
+	T *prepareInsertion(const K &key);
+	void grow();
+	void startRehash(unsigned int count);
+	void migrateBuckets(unsigned int numBuckets);
+	void migrateNode(hash_t hash, Node &node);
+	void copyRehashSource(const HashMap &other);
+	void deleteRehashSource();
+
+	/// Returns the number of buckets visited by iterators, including the old ones during an incremental rehash
+	inline unsigned int numIteratorBuckets() const { return (rehashSource_ == nullptr) ? capacity_ : capacity_ + rehashSource_->capacity_; }
+	inline hash_t iteratorHash(unsigned int index) const { return (index < capacity_) ? hashes_[index] : rehashSource_->hashes_[index - capacity_]; }
+	inline Node &iteratorNode(unsigned int index) { return (index < capacity_) ? nodes_[index] : rehashSource_->nodes_[index - capacity_]; }
+	inline const Node &iteratorNode(unsigned int index) const { return (index < capacity_) ? nodes_[index] : rehashSource_->nodes_[index - capacity_]; }
+
 	friend class HashMapIterator<K, T, HashFunc, false>;
 	friend class HashMapIterator<K, T, HashFunc, true>;
 	friend struct HashMapHelperTraits<K, T, HashFunc, false>;
@@ -245,7 +313,8 @@ HashMap<K, T, HashFunc>::HashMap(unsigned int capacity)
       alloc_(theDefaultAllocator()),
 #endif
       size_(0), capacity_(capacity), buffer_(nullptr),
-      delta1_(nullptr), delta2_(nullptr), hashes_(nullptr), nodes_(nullptr)
+      delta1_(nullptr), delta2_(nullptr), hashes_(nullptr), nodes_(nullptr),
+      maxLoadFactor_(0.0f), incrementalRehash_(false), rehashSource_(nullptr), rehashIndex_(0)
 {
 	FATAL_ASSERT_MSG(capacity > 0, "Zero is not a valid capacity");
 
@@ -275,7 +344,8 @@ HashMap<K, T, HashFunc>::HashMap(unsigned int capacity)
 template <class K, class T, class HashFunc>
 HashMap<K, T, HashFunc>::HashMap(unsigned int capacity, IAllocator &alloc)
     : alloc_(alloc), size_(0), capacity_(capacity), buffer_(nullptr),
-      delta1_(nullptr), delta2_(nullptr), hashes_(nullptr), nodes_(nullptr)
+      delta1_(nullptr), delta2_(nullptr), hashes_(nullptr), nodes_(nullptr),
+      maxLoadFactor_(0.0f), incrementalRehash_(false), rehashSource_(nullptr), rehashIndex_(0)
 {
 	FATAL_ASSERT_MSG(capacity > 0, "Zero is not a valid capacity");
 
@@ -291,6 +361,7 @@ HashMap<K, T, HashFunc>::HashMap(unsigned int capacity, IAllocator &alloc)
 template <class K, class T, class HashFunc>
 HashMap<K, T, HashFunc>::~HashMap()
 {
+	deleteRehashSource();
 	destructNodes();
 	deallocate();
 }
@@ -302,7 +373,8 @@ HashMap<K, T, HashFunc>::HashMap(const HashMap<K, T, HashFunc> &other)
       alloc_(other.alloc_),
 #endif
       size_(other.size_), capacity_(other.capacity_), buffer_(nullptr),
-      delta1_(nullptr), delta2_(nullptr), hashes_(nullptr), nodes_(nullptr)
+      delta1_(nullptr), delta2_(nullptr), hashes_(nullptr), nodes_(nullptr),
+      maxLoadFactor_(other.maxLoadFactor_), incrementalRehash_(other.incrementalRehash_), rehashSource_(nullptr), rehashIndex_(0)
 {
 	const unsigned int bytes = capacity_ * (sizeof(uint8_t) * 2 + sizeof(hash_t));
 	const unsigned int alignedBytes = bytes + 3 * AlignmentBytes; // 3 align adjustments in `initPointers()`
@@ -321,6 +393,8 @@ HashMap<K, T, HashFunc>::HashMap(const HashMap<K, T, HashFunc> &other)
 		if (other.hashes_[i] != NullHash)
 			new (nodes_ + i) Node(other.nodes_[i]);
 	}
+
+	copyRehashSource(other);
 }
 
 template <class K, class T, class HashFunc>
@@ -330,7 +404,9 @@ HashMap<K, T, HashFunc>::HashMap(HashMap<K, T, HashFunc> &&other)
       alloc_(other.alloc_),
 #endif
       size_(other.size_), capacity_(other.capacity_), buffer_(other.buffer_),
-      delta1_(other.delta1_), delta2_(other.delta2_), hashes_(other.hashes_), nodes_(other.nodes_)
+      delta1_(other.delta1_), delta2_(other.delta2_), hashes_(other.hashes_), nodes_(other.nodes_),
+      maxLoadFactor_(other.maxLoadFactor_), incrementalRehash_(other.incrementalRehash_),
+      rehashSource_(other.rehashSource_), rehashIndex_(other.rehashIndex_)
 {
 	other.size_ = 0;
 	other.capacity_ = 0;
@@ -339,6 +415,8 @@ HashMap<K, T, HashFunc>::HashMap(HashMap<K, T, HashFunc> &&other)
 	other.delta2_ = nullptr;
 	other.hashes_ = nullptr;
 	other.nodes_ = nullptr;
+	other.rehashSource_ = nullptr;
+	other.rehashIndex_ = 0;
 }
 
 template <class K, class T, class HashFunc>
@@ -347,22 +425,13 @@ HashMap<K, T, HashFunc> &HashMap<K, T, HashFunc>::operator=(const HashMap<K, T,
 	if (this == &other)
 		return *this;
 
-	if (other.size_ > capacity_)
+	deleteRehashSource();
+	// Buckets are copied one by one, the capacity must match as it determines their position
+	if (other.capacity_ != capacity_)
 	{
 		destructNodes();
 		deallocate();
-
-		capacity_ = other.capacity_;
-		const unsigned int bytes = capacity_ * (sizeof(uint8_t) * 2 + sizeof(hash_t));
-		const unsigned int alignedBytes = bytes + 3 * AlignmentBytes; // 3 align adjustments in `initPointers()`
-#if !NCINE_WITH_ALLOCATORS
-		buffer_ = static_cast<uint8_t *>(::operator new(alignedBytes));
-		nodes_ = static_cast<Node *>(::operator new(sizeof(Node) * capacity_));
-#else
-		buffer_ = static_cast<uint8_t *>(alloc_.allocate(alignedBytes));
-		nodes_ = static_cast<Node *>(alloc_.allocate(sizeof(Node) * capacity_));
-#endif
-		initPointers();
+		allocate(other.capacity_);
 	}
 
 	for (unsigned int i = 0; i < capacity_; i++)
@@ -382,6 +451,9 @@ HashMap<K, T, HashFunc> &HashMap<K, T, HashFunc>::operator=(const HashMap<K, T,
 		hashes_[i] = other.hashes_[i];
 	}
 	size_ = other.size_;
+	maxLoadFactor_ = other.maxLoadFactor_;
+	incrementalRehash_ = other.incrementalRehash_;
+	copyRehashSource(other);
 
 	return *this;
 }
@@ -400,6 +472,13 @@ HashMap<K, T, HashFunc> &HashMap<K, T, HashFunc>::operator=(HashMap<K, T, HashFu
 template <class K, class T, class HashFunc>
 T &HashMap<K, T, HashFunc>::operator[](const K &key)
 {
+	if (needsPreparation())
+	{
+		T *value = prepareInsertion(key);
+		if (value != nullptr)
+			return *value;
+	}
+
 	const hash_t hash = hashFunc_(key);
 	int unsigned bucketIndex = hash % capacity_;
 
@@ -451,6 +530,9 @@ T &HashMap<K, T, HashFunc>::operator[](const K &key)
 template <class K, class T, class HashFunc>
 bool HashMap<K, T, HashFunc>::insert(const K &key, const T &value)
 {
+	if (needsPreparation() && prepareInsertion(key) != nullptr)
+		return false;
+
 	const hash_t hash = hashFunc_(key);
 	int unsigned bucketIndex = hash % capacity_;
 
@@ -507,6 +589,9 @@ bool HashMap<K, T, HashFunc>::insert(const K &key, const T &value)
 template <class K, class T, class HashFunc>
 bool HashMap<K, T, HashFunc>::insert(const K &key, T &&value)
 {
+	if (needsPreparation() && prepareInsertion(key) != nullptr)
+		return false;
+
 	const hash_t hash = hashFunc_(key);
 	int unsigned bucketIndex = hash % capacity_;
 
@@ -564,6 +649,9 @@ template <class K, class T, class HashFunc>
 template <typename... Args>
 bool HashMap<K, T, HashFunc>::emplace(const K &key, Args &&... args)
 {
+	if (needsPreparation() && prepareInsertion(key) != nullptr)
+		return false;
+
 	const hash_t hash = hashFunc_(key);
 	int unsigned bucketIndex = hash % capacity_;
 
@@ -619,46 +707,106 @@ bool HashMap<K, T, HashFunc>::emplace(const K &key, Args &&... args)
 template <class K, class T, class HashFunc>
 void HashMap<K, T, HashFunc>::clear()
 {
+	deleteRehashSource();
 	destructNodes();
 	initValues();
 }
 
 template <class K, class T, class HashFunc>
-bool HashMap<K, T, HashFunc>::contains(const K &key, T &returnedValue) const
+bool HashMap<K, T, HashFunc>::contains(const K &key, hash_t hash, T &returnedValue) const
 {
 	int unsigned bucketIndex = 0;
-	const bool found = findBucketIndex(key, bucketIndex);
+	const bool found = findBucketIndex(key, hash, bucketIndex);
 
 	if (found)
 		returnedValue = nodes_[bucketIndex].value;
+	else if (rehashSource_ != nullptr)
+		return rehashSource_->contains(key, hash, returnedValue);
 
 	return found;
 }
 
 /*! \note Prefer this method if copying `T` is expensive, but always check the validity of returned pointer. */
 template <class K, class T, class HashFunc>
-T *HashMap<K, T, HashFunc>::find(const K &key)
+T *HashMap<K, T, HashFunc>::find(const K &key, hash_t hash)
 {
 	int unsigned bucketIndex = 0;
-	const bool found = findBucketIndex(key, bucketIndex);
+	const bool found = findBucketIndex(key, hash, bucketIndex);
 
 	T *returnedPtr = nullptr;
 	if (found)
 		returnedPtr = &nodes_[bucketIndex].value;
+	else if (rehashSource_ != nullptr)
+		returnedPtr = rehashSource_->find(key, hash);
 
 	return returnedPtr;
 }
 
 /*! \note Prefer this method if copying `T` is expensive, but always check the validity of returned pointer. */
 template <class K, class T, class HashFunc>
-const T *HashMap<K, T, HashFunc>::find(const K &key) const
+const T *HashMap<K, T, HashFunc>::find(const K &key, hash_t hash) const
 {
 	int unsigned bucketIndex = 0;
-	const bool found = findBucketIndex(key, bucketIndex);
+	const bool found = findBucketIndex(key, hash, bucketIndex);
 
 	const T *returnedPtr = nullptr;
 	if (found)
 		returnedPtr = &nodes_[bucketIndex].value;
+	else if (rehashSource_ != nullptr)
+		returnedPtr = static_cast<const HashMap *>(rehashSource_)->find(key, hash);
+
+	return returnedPtr;
+}
+
+/*! \note The key characters do not need to be null-terminated, only `length` of them are compared.
+ *  \warning Only for maps with string keys, the hash has to be calculated from the same characters. */
+template <class K, class T, class HashFunc>
+bool HashMap<K, T, HashFunc>::contains(const char *key, unsigned int length, hash_t hash, T &returnedValue) const
+{
+	const CharsKey charsKey = { key, length };
+	int unsigned bucketIndex = 0;
+	const bool found = findBucketIndex(charsKey, hash, bucketIndex);
+
+	if (found)
+		returnedValue = nodes_[bucketIndex].value;
+	else if (rehashSource_ != nullptr)
+		return rehashSource_->contains(key, length, hash, returnedValue);
+
+	return found;
+}
+
+/*! \note The key characters do not need to be null-terminated, only `length` of them are compared.
+ *  \warning Only for maps with string keys, the hash has to be calculated from the same characters. */
+template <class K, class T, class HashFunc>
+T *HashMap<K, T, HashFunc>::find(const char *key, unsigned int length, hash_t hash)
+{
+	const CharsKey charsKey = { key, length };
+	int unsigned bucketIndex = 0;
+	const bool found = findBucketIndex(charsKey, hash, bucketIndex);
+
+	T *returnedPtr = nullptr;
+	if (found)
+		returnedPtr = &nodes_[bucketIndex].value;
+	else if (rehashSource_ != nullptr)
+		returnedPtr = rehashSource_->find(key, length, hash);
+
+	return returnedPtr;
+}
+
+/*! \note The key characters do not need to be null-terminated, only `length` of them are compared.
+ *  \warning Only for maps with string keys, the hash has to be calculated from the same characters. */
+template <class K, class T, class HashFunc>
+const T *HashMap<K, T, HashFunc>::find(const char *key, unsigned int length, hash_t hash) const
+{
+	const CharsKey charsKey = { key, length };
+	int unsigned bucketIndex = 0;
+	const bool found = findBucketIndex(charsKey, hash, bucketIndex);
+
+	const T *returnedPtr = nullptr;
+	if (found)
+		returnedPtr = &nodes_[bucketIndex].value;
+	else if (rehashSource_ != nullptr)
+		returnedPtr = static_cast<const HashMap *>(rehashSource_)->find(key, length, hash);
 
 	return returnedPtr;
 }
@@ -667,9 +815,16 @@ const T *HashMap<K, T, HashFunc>::find(const K &key) const
 template <class K, class T, class HashFunc>
 bool HashMap<K, T, HashFunc>::remove(const K &key)
 {
+	if (rehashSource_ != nullptr)
+	{
+		migrateBuckets(RehashBucketsPerOperation);
+		if (rehashSource_ != nullptr && rehashSource_->remove(key))
+			return true;
+	}
+
 	int unsigned foundBucketIndex = 0;
 	int unsigned prevFoundBucketIndex = 0;
-	const bool found = findBucketIndex(key, foundBucketIndex, prevFoundBucketIndex);
+	const bool found = findBucketIndex(key, hashFunc_(key), foundBucketIndex, prevFoundBucketIndex);
 	unsigned int bucketIndex = foundBucketIndex;
 
 	if (found)
@@ -722,6 +877,7 @@ bool HashMap<K, T, HashFunc>::remove(const K &key)
 template <class K, class T, class HashFunc>
 void HashMap<K, T, HashFunc>::rehash(unsigned int count)
 {
+	finishRehash();
 	if (size_ == 0 || count < size_)
 		return;
 
@@ -740,10 +896,57 @@ void HashMap<K, T, HashFunc>::rehash(unsigned int count)
 				break;
 		}
 	}
+	// The growth settings are assigned only now, so that the new hashmap does not grow while it is being filled
+	hashMap.maxLoadFactor_ = maxLoadFactor_;
+	hashMap.incrementalRehash_ = incrementalRehash_;
 
 	*this = nctl::move(hashMap);
 }
 
+/*! \note Values greater than one are clamped, as the hashmap can never store more elements than buckets */
+template <class K, class T, class HashFunc>
+void HashMap<K, T, HashFunc>::setMaxLoadFactor(float maxLoadFactor)
+{
+	ASSERT(maxLoadFactor >= 0.0f);
+	if (maxLoadFactor < 0.0f)
+		maxLoadFactor = 0.0f;
+	else if (maxLoadFactor > 1.0f)
+		maxLoadFactor = 1.0f;
+	maxLoadFactor_ = maxLoadFactor;
+}
+
+template <class K, class T, class HashFunc>
+void HashMap<K, T, HashFunc>::setIncrementalRehash(bool enabled)
+{
+	if (enabled == false)
+		finishRehash();
+	incrementalRehash_ = enabled;
+}
+
+template <class K, class T, class HashFunc>
+void HashMap<K, T, HashFunc>::finishRehash()
+{
+	if (rehashSource_ != nullptr)
+		migrateBuckets(rehashSource_->capacity_);
+}
+
+template <class K, class T, class HashFunc>
+void HashMap<K, T, HashFunc>::allocate(unsigned int capacity)
+{
+	capacity_ = capacity;
+	const unsigned int bytes = capacity_ * (sizeof(uint8_t) * 2 + sizeof(hash_t));
+	const unsigned int alignedBytes = bytes + 3 * AlignmentBytes; // 3 align adjustments in `initPointers()`
+#if !NCINE_WITH_ALLOCATORS
+	buffer_ = static_cast<uint8_t *>(::operator new(alignedBytes));
+	nodes_ = static_cast<Node *>(::operator new(sizeof(Node) * capacity_));
+#else
+	buffer_ = static_cast<uint8_t *>(alloc_.allocate(alignedBytes));
+	nodes_ = static_cast<Node *>(alloc_.allocate(sizeof(Node) * capacity_));
+#endif
+	initPointers();
+	initValues();
+}
+
 template <class K, class T, class HashFunc>
 void HashMap<K, T, HashFunc>::initPointers()
 {
@@ -804,13 +1007,14 @@ void HashMap<K, T, HashFunc>::deallocate()
 }
 
 template <class K, class T, class HashFunc>
-bool HashMap<K, T, HashFunc>::findBucketIndex(const K &key, unsigned int &foundIndex, unsigned int &prevFoundIndex) const
+template <class KeyType>
+bool HashMap<K, T, HashFunc>::findBucketIndex(const KeyType &key, hash_t hash, unsigned int &foundIndex, unsigned int &prevFoundIndex) const
 {
 	if (size_ == 0)
 		return false;
 
+	ASSERT_MSG(hashMatches(key, hash), "The hash does not match the one calculated by the hash function");
 	bool found = false;
-	const hash_t hash = hashFunc_(key);
 	foundIndex = hash % capacity_;
 	prevFoundIndex = foundIndex;
 
@@ -854,10 +1058,11 @@ bool HashMap<K, T, HashFunc>::findBucketIndex(const K &key, unsigned int &foundI
 }
 
 template <class K, class T, class HashFunc>
-bool HashMap<K, T, HashFunc>::findBucketIndex(const K &key, unsigned int &foundIndex) const
+template <class KeyType>
+bool HashMap<K, T, HashFunc>::findBucketIndex(const KeyType &key, hash_t hash, unsigned int &foundIndex) const
 {
 	unsigned int prevFoundIndex = 0;
-	return findBucketIndex(key, foundIndex, prevFoundIndex);
+	return findBucketIndex(key, hash, foundIndex, prevFoundIndex);
 }
 
 template <class K, class T, class HashFunc>
@@ -910,15 +1115,17 @@ unsigned int HashMap<K, T, HashFunc>::linearSearch(unsigned int index, hash_t ha
 }
 
 template <class K, class T, class HashFunc>
-bool HashMap<K, T, HashFunc>::bucketFoundOrEmpty(unsigned int index, hash_t hash, const K &key) const
+template <class KeyType>
+bool HashMap<K, T, HashFunc>::bucketFoundOrEmpty(unsigned int index, hash_t hash, const KeyType &key) const
 {
-	return (hashes_[index] == NullHash || (hashes_[index] == hash && equalTo(nodes_[index].key, key)));
+	return (hashes_[index] == NullHash || (hashes_[index] == hash && keyEquals(nodes_[index].key, key)));
 }
 
 template <class K, class T, class HashFunc>
-bool HashMap<K, T, HashFunc>::bucketFound(unsigned int index, hash_t hash, const K &key) const
+template <class KeyType>
+bool HashMap<K, T, HashFunc>::bucketFound(unsigned int index, hash_t hash, const KeyType &key) const
 {
-	return (hashes_[index] == hash && equalTo(nodes_[index].key, key));
+	return (hashes_[index] == hash && keyEquals(nodes_[index].key, key));
 }
 
 template <class K, class T, class HashFunc>
@@ -968,6 +1175,128 @@ void HashMap<K, T, HashFunc>::emplaceNode(unsigned int index, hash_t hash, const
 	new (nodes_ + index) Node(key, nctl::forward<Args>(args)...);
 }
 
+/*! \return A pointer to the value if the key is in the old buckets of an incremental rehash */
+template <class K, class T, class HashFunc>
+T *HashMap<K, T, HashFunc>::prepareInsertion(const K &key)
+{
+	if (rehashSource_ != nullptr)
+		migrateBuckets(RehashBucketsPerOperation);
+
+	// Growing before the key is searched might be unnecessary, but it avoids searching the current buckets twice
+	if (maxLoadFactor_ > 0.0f && size_ + 1 > capacity_ * maxLoadFactor_)
+		grow();
+
+	if (rehashSource_ != nullptr)
+		return rehashSource_->find(key);
+
+	return nullptr;
+}
+
+template <class K, class T, class HashFunc>
+void HashMap<K, T, HashFunc>::grow()
+{
+	// The new buckets can only fill up before the end of a migration if the load factor has been lowered meanwhile
+	finishRehash();
+	if (incrementalRehash_ && size_ > 0)
+		startRehash(capacity_ * 2);
+	else
+		rehash(capacity_ * 2);
+}
+
+template <class K, class T, class HashFunc>
+void HashMap<K, T, HashFunc>::startRehash(unsigned int count)
+{
+	ASSERT(rehashSource_ == nullptr);
+	// The current buckets are moved to the rehash source, while this hashmap allocates new ones
+#if !NCINE_WITH_ALLOCATORS
+	rehashSource_ = new HashMap(nctl::move(*this));
+#else
+	rehashSource_ = alloc_.template newObject<HashMap>(nctl::move(*this));
+#endif
+	rehashIndex_ = 0;
+	allocate(count);
+}
+
+template <class K, class T, class HashFunc>
+void HashMap<K, T, HashFunc>::migrateBuckets(unsigned int numBuckets)
+{
+	HashMap &source = *rehashSource_;
+	const unsigned int endIndex = (numBuckets < source.capacity_ - rehashIndex_) ? rehashIndex_ + numBuckets : source.capacity_;
+	for (; rehashIndex_ < endIndex; rehashIndex_++)
+	{
+		// Removing a node can move another one of the same chain into the bucket, but never into one already migrated
+		while (source.hashes_[rehashIndex_] != NullHash)
+		{
+			Node &node = source.nodes_[rehashIndex_];
+			migrateNode(source.hashes_[rehashIndex_], node);
+			source.remove(node.key);
+		}
+	}
+
+	if (rehashIndex_ == source.capacity_)
+	{
+		FATAL_ASSERT(source.size_ == 0);
+		deleteRehashSource();
+	}
+}
+
+template <class K, class T, class HashFunc>
+void HashMap<K, T, HashFunc>::migrateNode(hash_t hash, Node &node)
+{
+	// The key is known not to be in the new buckets, only the end of its chain is searched
+	unsigned int bucketIndex = hash % capacity_;
+	if (hashes_[bucketIndex] != NullHash)
+	{
+		if (delta1_[bucketIndex] != 0)
+		{
+			bucketIndex = addDelta1(bucketIndex);
+			while (delta2_[bucketIndex] != 0)
+				bucketIndex = addDelta2(bucketIndex);
+
+			const unsigned int newIndex = linearSearch(bucketIndex + 1, hash, node.key);
+			delta2_[bucketIndex] = calcNewDelta(bucketIndex, newIndex);
+			bucketIndex = newIndex;
+		}
+		else
+		{
+			const unsigned int newIndex = linearSearch(bucketIndex + 1, hash, node.key);
+			delta1_[bucketIndex] = calcNewDelta(bucketIndex, newIndex);
+			bucketIndex = newIndex;
+		}
+	}
+
+	insertNode(bucketIndex, hash, node.key, nctl::move(node.value));
+}
+
+template <class K, class T, class HashFunc>
+void HashMap<K, T, HashFunc>::copyRehashSource(const HashMap &other)
+{
+	if (other.rehashSource_ == nullptr)
+		return;
+
+#if !NCINE_WITH_ALLOCATORS
+	rehashSource_ = new HashMap(*other.rehashSource_);
+#else
+	rehashSource_ = alloc_.template newObject<HashMap>(*other.rehashSource_);
+#endif
+	rehashIndex_ = other.rehashIndex_;
+}
+
+template <class K, class T, class HashFunc>
+void HashMap<K, T, HashFunc>::deleteRehashSource()
+{
+	if (rehashSource_ == nullptr)
+		return;
+
+#if !NCINE_WITH_ALLOCATORS
+	delete rehashSource_;
+#else
+	alloc_.deleteObject(rehashSource_);
+#endif
+	rehashSource_ = nullptr;
+	rehashIndex_ = 0;
+}
+
 }
 
 #endif
@@ -198,7 +198,7 @@ HashMapIterator<K, T, HashFunc, IsConst> HashMapIterator<K, T, HashFunc, IsConst
 template <class K, class T, class HashFunc, bool IsConst>
 typename HashMapHelperTraits<K, T, HashFunc, IsConst>::NodeReference HashMapIterator<K, T, HashFunc, IsConst>::node() const
 {
-	return hashMap_->nodes_[bucketIndex_];
+	return hashMap_->iteratorNode(bucketIndex_);
 }
 
 template <class K, class T, class HashFunc, bool IsConst>
@@ -216,7 +216,7 @@ const K &HashMapIterator<K, T, HashFunc, IsConst>::key() const
 template <class K, class T, class HashFunc, bool IsConst>
 hash_t HashMapIterator<K, T, HashFunc, IsConst>::hash() const
 {
-	return hashMap_->hashes_[bucketIndex_];
+	return hashMap_->iteratorHash(bucketIndex_);
 }
 
 template <class K, class T, class HashFunc, bool IsConst>
@@ -224,7 +224,7 @@ void HashMapIterator<K, T, HashFunc, IsConst>::next()
 {
 	if (tag_ == SentinelTag::REGULAR)
 	{
-		if (bucketIndex_ >= hashMap_->capacity() - 1)
+		if (bucketIndex_ >= hashMap_->numIteratorBuckets() - 1)
 		{
 			tag_ = SentinelTag::END;
 			return;
@@ -241,10 +241,10 @@ void HashMapIterator<K, T, HashFunc, IsConst>::next()
 		return;
 
 	// Search the first non empty index starting from the current one
-	while (bucketIndex_ < hashMap_->capacity() - 1 && hashMap_->hashes_[bucketIndex_] == NullHash)
+	while (bucketIndex_ < hashMap_->numIteratorBuckets() - 1 && hashMap_->iteratorHash(bucketIndex_) == NullHash)
 		bucketIndex_++;
 
-	if (hashMap_->hashes_[bucketIndex_] == NullHash)
+	if (hashMap_->iteratorHash(bucketIndex_) == NullHash)
 		tag_ = SentinelTag::END;
 }
 
@@ -264,16 +264,16 @@ void HashMapIterator<K, T, HashFunc, IsConst>::previous()
 	else if (tag_ == SentinelTag::END)
 	{
 		tag_ = SentinelTag::REGULAR;
-		bucketIndex_ = hashMap_->capacity() - 1;
+		bucketIndex_ = hashMap_->numIteratorBuckets() - 1;
 	}
 	else if (tag_ == SentinelTag::BEGINNING)
 		return;
 
 	// Search the first non empty index starting from the current one
-	while (bucketIndex_ > 0 && hashMap_->hashes_[bucketIndex_] == NullHash)
+	while (bucketIndex_ > 0 && hashMap_->iteratorHash(bucketIndex_) == NullHash)
 		bucketIndex_--;
 
-	if (hashMap_->hashes_[bucketIndex_] == NullHash)
+	if (hashMap_->iteratorHash(bucketIndex_) == NullHash)
 		tag_ = SentinelTag::BEGINNING;
 }
 
@@ -21,6 +21,8 @@ template <class K, class HashFunc> struct HashSetHelperTraits;
 class String;
 
 /// A template based hashset implementation with open addressing and leapfrog probing
+/*! The hashset can optionally grow when a maximum load factor is reached, either all at once or incrementally.
+ *  With incremental rehashing the old buckets are kept aside and migrated a few at a time by every modifying operation. */
 template <class K, class HashFunc = FNV1aHashFunc<K>>
 class HashSet
 {
@@ -63,6 +65,10 @@ class HashSet
 		nctl::swap(first.delta2_, second.delta2_);
 		nctl::swap(first.hashes_, second.hashes_);
 		nctl::swap(first.keys_, second.keys_);
+		nctl::swap(first.maxLoadFactor_, second.maxLoadFactor_);
+		nctl::swap(first.incrementalRehash_, second.incrementalRehash_);
+		nctl::swap(first.rehashSource_, second.rehashSource_);
+		nctl::swap(first.rehashIndex_, second.rehashIndex_);
 	}
 
 	/// Returns a constant iterator to the first element
@@ -100,11 +106,11 @@ class HashSet
 	/// Returns the capacity of the hashset
 	inline unsigned int capacity() const { return capacity_; }
 	/// Returns true if the hashset is empty
-	inline bool isEmpty() const { return size_ == 0; }
+	inline bool isEmpty() const { return size() == 0; }
 	/// Returns the number of elements in the hashset
-	inline unsigned int size() const { return size_; }
+	inline unsigned int size() const { return (rehashSource_ == nullptr) ? size_ : size_ + rehashSource_->size_; }
 	/// Returns the ratio between used and total buckets
-	inline float loadFactor() const { return size_ / static_cast<float>(capacity_); }
+	inline float loadFactor() const { return size() / static_cast<float>(capacity_); }
 	/// Returns the hash of a given key
 	inline hash_t hash(const K &key) const { return hashFunc_(key); }
 
@@ -122,8 +128,23 @@ class HashSet
 	/// Sets the number of buckets to the new specified size and rehashes the container
 	void rehash(unsigned int count);
 
+	/// Returns the load factor that makes the hashset double its capacity, zero if it never grows automatically
+	inline float maxLoadFactor() const { return maxLoadFactor_; }
+	/// Sets the load factor that makes the hashset double its capacity, zero disables automatic growth
+	void setMaxLoadFactor(float maxLoadFactor);
+	/// Returns true if automatic growth migrates the elements a few buckets at a time
+	inline bool incrementalRehash() const { return incrementalRehash_; }
+	/// Sets whether automatic growth migrates the elements a few buckets at a time instead of all at once
+	void setIncrementalRehash(bool enabled);
+	/// Returns true if an incremental rehash is in progress
+	inline bool isRehashing() const { return rehashSource_ != nullptr; }
+	/// Migrates all the elements still waiting for an incremental rehash
+	void finishRehash();
+
   private:
 	static const unsigned int AlignmentBytes = sizeof(int);
+	/// The number of old buckets migrated by every modifying operation during an incremental rehash
+	static const unsigned int RehashBucketsPerOperation = 8;
 
 #if NCINE_WITH_ALLOCATORS
 	/// The custom memory allocator for the hashset
@@ -138,7 +159,14 @@ class HashSet
 	hash_t *hashes_;
 	K *keys_;
 	HashFunc hashFunc_;
-
+	float maxLoadFactor_;
+	bool incrementalRehash_;
+	/// The hashset with the old buckets during an incremental rehash
+	HashSet *rehashSource_;
+	/// The index of the next old bucket to migrate
+	unsigned int rehashIndex_;
+
+	void allocate(unsigned int capacity);
 	void initPointers();
 	void initValues();
 	void destructKeys();
@@ -154,6 +182,20 @@ class HashSet
 	void insertKey(unsigned int index, hash_t hash, const K &key);
 	void insertKey(unsigned int index, hash_t hash, K &&key);
 
+	inline bool needsPreparation() const { return (rehashSource_ != nullptr || maxLoadFactor_ > 0.0f); }
+	bool prepareInsertion(const K &key);
+	void grow();
+	void startRehash(unsigned int count);
+	void migrateBuckets(unsigned int numBuckets);
+	void migrateKey(hash_t hash, K &key);
+	void copyRehashSource(const HashSet &other);
+	void deleteRehashSource();
+
+	/// Returns the number of buckets visited by iterators, including the old ones during an incremental rehash
+	inline unsigned int numIteratorBuckets() const { return (rehashSource_ == nullptr) ? capacity_ : capacity_ + rehashSource_->capacity_; }
+	inline hash_t iteratorHash(unsigned int index) const { return (index < capacity_) ? hashes_[index] : rehashSource_->hashes_[index - capacity_]; }
+	inline const K &iteratorKey(unsigned int index) const { return (index < capacity_) ? keys_[index] : rehashSource_->keys_[index - capacity_]; }
+
 	friend class HashSetIterator<K, HashFunc>;
 	friend struct HashSetHelperTraits<K, HashFunc>;
 };
@@ -219,7 +261,8 @@ HashSet<K, HashFunc>::HashSet(unsigned int capacity)
       alloc_(theDefaultAllocator()),
 #endif
       size_(0), capacity_(capacity), buffer_(nullptr),
-      delta1_(nullptr), delta2_(nullptr), hashes_(nullptr), keys_(nullptr)
+      delta1_(nullptr), delta2_(nullptr), hashes_(nullptr), keys_(nullptr),
+      maxLoadFactor_(0.0f), incrementalRehash_(false), rehashSource_(nullptr), rehashIndex_(0)
 {
 	FATAL_ASSERT_MSG(capacity > 0, "Zero is not a valid capacity");
 
@@ -241,7 +284,8 @@ HashSet<K, HashFunc>::HashSet(unsigned int capacity)
 template <class K, class HashFunc>
 HashSet<K, HashFunc>::HashSet(unsigned int capacity, IAllocator &alloc)
     : alloc_(alloc), size_(0), capacity_(capacity), buffer_(nullptr),
-      delta1_(nullptr), delta2_(nullptr), hashes_(nullptr), keys_(nullptr)
+      delta1_(nullptr), delta2_(nullptr), hashes_(nullptr), keys_(nullptr),
+      maxLoadFactor_(0.0f), incrementalRehash_(false), rehashSource_(nullptr), rehashIndex_(0)
 {
 	FATAL_ASSERT_MSG(capacity > 0, "Zero is not a valid capacity");
 
@@ -257,6 +301,7 @@ HashSet<K, HashFunc>::HashSet(unsigned int capacity, IAllocator &alloc)
 template <class K, class HashFunc>
 HashSet<K, HashFunc>::~HashSet()
 {
+	deleteRehashSource();
 	destructKeys();
 	deallocate();
 }
@@ -268,7 +313,8 @@ HashSet<K, HashFunc>::HashSet(const HashSet<K, HashFunc> &other)
       alloc_(other.alloc_),
 #endif
       size_(other.size_), capacity_(other.capacity_), buffer_(nullptr),
-      delta1_(nullptr), delta2_(nullptr), hashes_(nullptr), keys_(nullptr)
+      delta1_(nullptr), delta2_(nullptr), hashes_(nullptr), keys_(nullptr),
+      maxLoadFactor_(other.maxLoadFactor_), incrementalRehash_(other.incrementalRehash_), rehashSource_(nullptr), rehashIndex_(0)
 {
 	const unsigned int bytes = capacity_ * (sizeof(uint8_t) * 2 + sizeof(hash_t));
 	const unsigned int alignedBytes = bytes + 3 * AlignmentBytes; // 3 align adjustments in `initPointers()`
@@ -287,6 +333,8 @@ HashSet<K, HashFunc>::HashSet(const HashSet<K, HashFunc> &other)
 		if (other.hashes_[i] != NullHash)
 			new (keys_ + i) K(other.keys_[i]);
 	}
+
+	copyRehashSource(other);
 }
 
 template <class K, class HashFunc>
@@ -296,7 +344,9 @@ HashSet<K, HashFunc>::HashSet(HashSet<K, HashFunc> &&other)
       alloc_(other.alloc_),
 #endif
       size_(other.size_), capacity_(other.capacity_), buffer_(other.buffer_),
-      delta1_(other.delta1_), delta2_(other.delta2_), hashes_(other.hashes_), keys_(other.keys_)
+      delta1_(other.delta1_), delta2_(other.delta2_), hashes_(other.hashes_), keys_(other.keys_),
+      maxLoadFactor_(other.maxLoadFactor_), incrementalRehash_(other.incrementalRehash_),
+      rehashSource_(other.rehashSource_), rehashIndex_(other.rehashIndex_)
 {
 	other.size_ = 0;
 	other.capacity_ = 0;
@@ -305,6 +355,8 @@ HashSet<K, HashFunc>::HashSet(HashSet<K, HashFunc> &&other)
 	other.delta2_ = nullptr;
 	other.hashes_ = nullptr;
 	other.keys_ = nullptr;
+	other.rehashSource_ = nullptr;
+	other.rehashIndex_ = 0;
 }
 
 template <class K, class HashFunc>
@@ -313,22 +365,13 @@ HashSet<K, HashFunc> &HashSet<K, HashFunc>::operator=(const HashSet<K, HashFunc>
 	if (this == &other)
 		return *this;
 
-	if (other.size_ > capacity_)
+	deleteRehashSource();
+	// Buckets are copied one by one, the capacity must match as it determines their position
+	if (other.capacity_ != capacity_)
 	{
 		destructKeys();
 		deallocate();
-
-		capacity_ = other.capacity_;
-		const unsigned int bytes = capacity_ * (sizeof(uint8_t) * 2 + sizeof(hash_t));
-		const unsigned int alignedBytes = bytes + 3 * AlignmentBytes; // 3 align adjustments in `initPointers()`
-#if !NCINE_WITH_ALLOCATORS
-		buffer_ = static_cast<uint8_t *>(::operator new(alignedBytes));
-		keys_ = static_cast<K *>(::operator new(sizeof(K) * capacity_));
-#else
-		buffer_ = static_cast<uint8_t *>(alloc_.allocate(alignedBytes));
-		keys_ = static_cast<K *>(alloc_.allocate(sizeof(K) * capacity_));
-#endif
-		initPointers();
+		allocate(other.capacity_);
 	}
 
 	for (unsigned int i = 0; i < capacity_; i++)
@@ -348,6 +391,9 @@ HashSet<K, HashFunc> &HashSet<K, HashFunc>::operator=(const HashSet<K, HashFunc>
 		hashes_[i] = other.hashes_[i];
 	}
 	size_ = other.size_;
+	maxLoadFactor_ = other.maxLoadFactor_;
+	incrementalRehash_ = other.incrementalRehash_;
+	copyRehashSource(other);
 
 	return *this;
 }
@@ -367,6 +413,9 @@ HashSet<K, HashFunc> &HashSet<K, HashFunc>::operator=(HashSet<K, HashFunc> &&oth
 template <class K, class HashFunc>
 bool HashSet<K, HashFunc>::insert(const K &key)
 {
+	if (needsPreparation() && prepareInsertion(key))
+		return false;
+
 	const hash_t hash = hashFunc_(key);
 	int unsigned bucketIndex = hash % capacity_;
 
@@ -423,6 +472,9 @@ bool HashSet<K, HashFunc>::insert(const K &key)
 template <class K, class HashFunc>
 bool HashSet<K, HashFunc>::insert(K &&key)
 {
+	if (needsPreparation() && prepareInsertion(key))
+		return false;
+
 	const hash_t hash = hashFunc_(key);
 	int unsigned bucketIndex = hash % capacity_;
 
@@ -478,6 +530,7 @@ bool HashSet<K, HashFunc>::insert(K &&key)
 template <class K, class HashFunc>
 void HashSet<K, HashFunc>::clear()
 {
+	deleteRehashSource();
 	destructKeys();
 	initValues();
 }
@@ -486,7 +539,10 @@ template <class K, class HashFunc>
 bool HashSet<K, HashFunc>::contains(const K &key) const
 {
 	int unsigned bucketIndex = 0;
-	return findBucketIndex(key, bucketIndex);
+	if (findBucketIndex(key, bucketIndex))
+		return true;
+
+	return (rehashSource_ != nullptr && rehashSource_->contains(key));
 }
 
 /*! \note Prefer this method if copying `K` is expensive, but always check the validity of returned pointer. */
@@ -499,6 +555,8 @@ K *HashSet<K, HashFunc>::find(const K &key)
 	K *returnedPtr = nullptr;
 	if (found)
 		returnedPtr = &keys_[bucketIndex];
+	else if (rehashSource_ != nullptr)
+		returnedPtr = rehashSource_->find(key);
 
 	return returnedPtr;
 }
@@ -513,6 +571,8 @@ const K *HashSet<K, HashFunc>::find(const K &key) const
 	const K *returnedPtr = nullptr;
 	if (found)
 		returnedPtr = &keys_[bucketIndex];
+	else if (rehashSource_ != nullptr)
+		returnedPtr = static_cast<const HashSet *>(rehashSource_)->find(key);
 
 	return returnedPtr;
 }
@@ -521,6 +581,13 @@ const K *HashSet<K, HashFunc>::find(const K &key) const
 template <class K, class HashFunc>
 bool HashSet<K, HashFunc>::remove(const K &key)
 {
+	if (rehashSource_ != nullptr)
+	{
+		migrateBuckets(RehashBucketsPerOperation);
+		if (rehashSource_ != nullptr && rehashSource_->remove(key))
+			return true;
+	}
+
 	int unsigned foundBucketIndex = 0;
 	int unsigned prevFoundBucketIndex = 0;
 	const bool found = findBucketIndex(key, foundBucketIndex, prevFoundBucketIndex);
@@ -575,6 +642,7 @@ bool HashSet<K, HashFunc>::remove(const K &key)
 template <class K, class HashFunc>
 void HashSet<K, HashFunc>::rehash(unsigned int count)
 {
+	finishRehash();
 	if (size_ == 0 || count < size_)
 		return;
 
@@ -592,10 +660,57 @@ void HashSet<K, HashFunc>::rehash(unsigned int count)
 				break;
 		}
 	}
+	// The growth settings are assigned only now, so that the new hashset does not grow while it is being filled
+	hashSet.maxLoadFactor_ = maxLoadFactor_;
+	hashSet.incrementalRehash_ = incrementalRehash_;
 
 	*this = nctl::move(hashSet);
 }
 
+/*! \note Values greater than one are clamped, as the hashset can never store more elements than buckets */
+template <class K, class HashFunc>
+void HashSet<K, HashFunc>::setMaxLoadFactor(float maxLoadFactor)
+{
+	ASSERT(maxLoadFactor >= 0.0f);
+	if (maxLoadFactor < 0.0f)
+		maxLoadFactor = 0.0f;
+	else if (maxLoadFactor > 1.0f)
+		maxLoadFactor = 1.0f;
+	maxLoadFactor_ = maxLoadFactor;
+}
+
+template <class K, class HashFunc>
+void HashSet<K, HashFunc>::setIncrementalRehash(bool enabled)
+{
+	if (enabled == false)
+		finishRehash();
+	incrementalRehash_ = enabled;
+}
+
+template <class K, class HashFunc>
+void HashSet<K, HashFunc>::finishRehash()
+{
+	if (rehashSource_ != nullptr)
+		migrateBuckets(rehashSource_->capacity_);
+}
+
+template <class K, class HashFunc>
+void HashSet<K, HashFunc>::allocate(unsigned int capacity)
+{
+	capacity_ = capacity;
+	const unsigned int bytes = capacity_ * (sizeof(uint8_t) * 2 + sizeof(hash_t));
+	const unsigned int alignedBytes = bytes + 3 * AlignmentBytes; // 3 align adjustments in `initPointers()`
+#if !NCINE_WITH_ALLOCATORS
+	buffer_ = static_cast<uint8_t *>(::operator new(alignedBytes));
+	keys_ = static_cast<K *>(::operator new(sizeof(K) * capacity_));
+#else
+	buffer_ = static_cast<uint8_t *>(alloc_.allocate(alignedBytes));
+	keys_ = static_cast<K *>(alloc_.allocate(sizeof(K) * capacity_));
+#endif
+	initPointers();
+	initValues();
+}
+
 template <class K, class HashFunc>
 void HashSet<K, HashFunc>::initPointers()
 {
@@ -795,6 +910,126 @@ void HashSet<K, HashFunc>::insertKey(unsigned int index, hash_t hash, K &&key)
 	new (keys_ + index) K(nctl::move(key));
 }
 
+/*! \return True if the key is in the old buckets of an incremental rehash */
+template <class K, class HashFunc>
+bool HashSet<K, HashFunc>::prepareInsertion(const K &key)
+{
+	if (rehashSource_ != nullptr)
+		migrateBuckets(RehashBucketsPerOperation);
+
+	// Growing before the key is searched might be unnecessary, but it avoids searching the current buckets twice
+	if (maxLoadFactor_ > 0.0f && size_ + 1 > capacity_ * maxLoadFactor_)
+		grow();
+
+	return (rehashSource_ != nullptr && rehashSource_->contains(key));
+}
+
+template <class K, class HashFunc>
+void HashSet<K, HashFunc>::grow()
+{
+	// The new buckets can only fill up before the end of a migration if the load factor has been lowered meanwhile
+	finishRehash();
+	if (incrementalRehash_ && size_ > 0)
+		startRehash(capacity_ * 2);
+	else
+		rehash(capacity_ * 2);
+}
+
+template <class K, class HashFunc>
+void HashSet<K, HashFunc>::startRehash(unsigned int count)
+{
+	ASSERT(rehashSource_ == nullptr);
+	// The current buckets are moved to the rehash source, while this hashset allocates new ones
+#if !NCINE_WITH_ALLOCATORS
+	rehashSource_ = new HashSet(nctl::move(*this));
+#else
+	rehashSource_ = alloc_.template newObject<HashSet>(nctl::move(*this));
+#endif
+	rehashIndex_ = 0;
+	allocate(count);
+}
+
+template <class K, class HashFunc>
+void HashSet<K, HashFunc>::migrateBuckets(unsigned int numBuckets)
+{
+	HashSet &source = *rehashSource_;
+	const unsigned int endIndex = (numBuckets < source.capacity_ - rehashIndex_) ? rehashIndex_ + numBuckets : source.capacity_;
+	for (; rehashIndex_ < endIndex; rehashIndex_++)
+	{
+		// Removing a key can move another one of the same chain into the bucket, but never into one already migrated
+		while (source.hashes_[rehashIndex_] != NullHash)
+		{
+			K &key = source.keys_[rehashIndex_];
+			migrateKey(source.hashes_[rehashIndex_], key);
+			source.remove(key);
+		}
+	}
+
+	if (rehashIndex_ == source.capacity_)
+	{
+		FATAL_ASSERT(source.size_ == 0);
+		deleteRehashSource();
+	}
+}
+
+template <class K, class HashFunc>
+void HashSet<K, HashFunc>::migrateKey(hash_t hash, K &key)
+{
+	// The key is known not to be in the new buckets, only the end of its chain is searched
+	unsigned int bucketIndex = hash % capacity_;
+	if (hashes_[bucketIndex] != NullHash)
+	{
+		if (delta1_[bucketIndex] != 0)
+		{
+			bucketIndex = addDelta1(bucketIndex);
+			while (delta2_[bucketIndex] != 0)
+				bucketIndex = addDelta2(bucketIndex);
+
+			const unsigned int newIndex = linearSearch(bucketIndex + 1, hash, key);
+			delta2_[bucketIndex] = calcNewDelta(bucketIndex, newIndex);
+			bucketIndex = newIndex;
+		}
+		else
+		{
+			const unsigned int newIndex = linearSearch(bucketIndex + 1, hash, key);
+			delta1_[bucketIndex] = calcNewDelta(bucketIndex, newIndex);
+			bucketIndex = newIndex;
+		}
+	}
+
+	// The key is copied, as the source one is still needed to remove it from the old buckets
+	insertKey(bucketIndex, hash, static_cast<const K &>(key));
+}
+
+template <class K, class HashFunc>
+void HashSet<K, HashFunc>::copyRehashSource(const HashSet &other)
+{
+	if (other.rehashSource_ == nullptr)
+		return;
+
+#if !NCINE_WITH_ALLOCATORS
+	rehashSource_ = new HashSet(*other.rehashSource_);
+#else
+	rehashSource_ = alloc_.template newObject<HashSet>(*other.rehashSource_);
+#endif
+	rehashIndex_ = other.rehashIndex_;
+}
+
+template <class K, class HashFunc>
+void HashSet<K, HashFunc>::deleteRehashSource()
+{
+	if (rehashSource_ == nullptr)
+		return;
+
+#if !NCINE_WITH_ALLOCATORS
+	delete rehashSource_;
+#else
+	alloc_.deleteObject(rehashSource_);
+#endif
+	rehashSource_ = nullptr;
+	rehashIndex_ = 0;
+}
+
 }
 
 #endif
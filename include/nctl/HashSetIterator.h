@@ -121,7 +121,7 @@ HashSetIterator<K, HashFunc>::HashSetIterator(typename HashSetHelperTraits<K, Ha
 template <class K, class HashFunc>
 typename HashSetIterator<K, HashFunc>::Reference HashSetIterator<K, HashFunc>::operator*() const
 {
-	return hashSet_->keys_[bucketIndex_];
+	return hashSet_->iteratorKey(bucketIndex_);
 }
 
 template <class K, class HashFunc>
@@ -159,13 +159,13 @@ HashSetIterator<K, HashFunc> HashSetIterator<K, HashFunc>::operator--(int)
 template <class K, class HashFunc>
 const K &HashSetIterator<K, HashFunc>::key() const
 {
-	return hashSet_->keys_[bucketIndex_];
+	return hashSet_->iteratorKey(bucketIndex_);
 }
 
 template <class K, class HashFunc>
 hash_t HashSetIterator<K, HashFunc>::hash() const
 {
-	return hashSet_->hashes_[bucketIndex_];
+	return hashSet_->iteratorHash(bucketIndex_);
 }
 
 template <class K, class HashFunc>
@@ -173,7 +173,7 @@ void HashSetIterator<K, HashFunc>::next()
 {
 	if (tag_ == SentinelTag::REGULAR)
 	{
-		if (bucketIndex_ >= hashSet_->capacity() - 1)
+		if (bucketIndex_ >= hashSet_->numIteratorBuckets() - 1)
 		{
 			tag_ = SentinelTag::END;
 			return;
@@ -190,10 +190,10 @@ void HashSetIterator<K, HashFunc>::next()
 		return;
 
 	// Search the first non empty index starting from the current one
-	while (bucketIndex_ < hashSet_->capacity() - 1 && hashSet_->hashes_[bucketIndex_] == NullHash)
+	while (bucketIndex_ < hashSet_->numIteratorBuckets() - 1 && hashSet_->iteratorHash(bucketIndex_) == NullHash)
 		bucketIndex_++;
 
-	if (hashSet_->hashes_[bucketIndex_] == NullHash)
+	if (hashSet_->iteratorHash(bucketIndex_) == NullHash)
 		tag_ = SentinelTag::END;
 }
 
@@ -213,16 +213,16 @@ void HashSetIterator<K, HashFunc>::previous()
 	else if (tag_ == SentinelTag::END)
 	{
 		tag_ = SentinelTag::REGULAR;
-		bucketIndex_ = hashSet_->capacity() - 1;
+		bucketIndex_ = hashSet_->numIteratorBuckets() - 1;
 	}
 	else if (tag_ == SentinelTag::BEGINNING)
 		return;
 
 	// Search the first non empty index starting from the current one
-	while (bucketIndex_ > 0 && hashSet_->hashes_[bucketIndex_] == NullHash)
+	while (bucketIndex_ > 0 && hashSet_->iteratorHash(bucketIndex_) == NullHash)
 		bucketIndex_--;
 
-	if (hashSet_->hashes_[bucketIndex_] == NullHash)
+	if (hashSet_->iteratorHash(bucketIndex_) == NullHash)
 		tag_ = SentinelTag::BEGINNING;
 }
 
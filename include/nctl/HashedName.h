@@ -0,0 +1,41 @@
+#ifndef CLASS_NCTL_HASHEDNAME
+#define CLASS_NCTL_HASHEDNAME
+
+#include "HashFunctions.h"
+
+namespace nctl {
+
+/// A name together with its FNV-1a hash, calculated at compile time for string literals
+/*! The hash is the same calculated by `FNV1aHashFunc`, the default hash function of the hashmaps,
+ *  so a hashmap can be queried with the precomputed hash instead of hashing the key again.
+ *  \note The name is not copied and it should outlive the object */
+class HashedName
+{
+  public:
+	/// Constructs a hashed name from a string literal, the hash is calculated at compile time
+	template <unsigned int N>
+	constexpr HashedName(const char (&name)[N])
+	    : name_(name), length_(N - 1), hash_(FNV1a::hashConstexpr(name, N - 1)) {}
+	/// Constructs a hashed name from a C string of the specified length
+	HashedName(const char *name, unsigned int length)
+	    : name_(name), length_(length), hash_(FNV1a::hash(name, length)) {}
+
+	/// Returns the name as a C string
+	constexpr const char *data() const { return name_; }
+	/// Returns the length of the name
+	constexpr unsigned int length() const { return length_; }
+	/// Returns the hash of the name
+	constexpr hash_t hash() const { return hash_; }
+
+	/// Converts the hashed name to a C string, to be used where the hash is not needed
+	constexpr operator const char *() const { return name_; }
+
+  private:
+	const char *name_;
+	unsigned int length_;
+	hash_t hash_;
+};
+
+}
+
+#endif
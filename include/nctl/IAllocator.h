@@ -59,8 +59,8 @@ class DLL_PUBLIC IAllocator
 	IAllocator(const char *name, AllocateFunction allocFunc, ReallocateFunction reallocFunc, DeallocateFunction deallocFunc, size_t size, void *base);
 
 	/// Tries to allocate the specified amount of memory with the specified alignment requirement
-	inline void *allocate(size_t bytes, uint8_t alignment) { return (*allocateFunc_)(this, bytes, alignment); }
-	inline void *allocate(size_t bytes) { return (*allocateFunc_)(this, bytes, DefaultAlignment); }
+	inline void *allocate(size_t bytes, uint8_t alignment) { return trackAllocation((*allocateFunc_)(this, bytes, alignment)); }
+	inline void *allocate(size_t bytes) { return trackAllocation((*allocateFunc_)(this, bytes, DefaultAlignment)); }
 	/// Tries to reallocate the allocation at the specified pointer with a different size
 	void *reallocate(void *ptr, size_t bytes, uint8_t alignment);
 	inline void *reallocate(void *ptr, size_t bytes) { return reallocate(ptr, bytes, DefaultAlignment); }
@@ -81,6 +81,12 @@ class DLL_PUBLIC IAllocator
 	inline size_t freeMemory() const { return size_ - usedMemory_; }
 	/// Returns the number of active allocations
 	inline size_t numAllocations() const { return numAllocations_; }
+	/// Returns the highest amount of memory in use since the last reset
+	inline size_t peakMemory() const { return peakMemory_; }
+	/// Resets the highest amount of memory in use to the current one
+	inline void resetPeakMemory() { peakMemory_ = usedMemory_; }
+	/// Returns the number of allocations served since the allocator has been created
+	inline size_t numTotalAllocations() const { return numTotalAllocations_; }
 
 	/// Returns the state of the copy on reallocation flag
 	inline bool copyOnReallocation() const { return copyOnReallocation_; }
@@ -103,8 +109,22 @@ class DLL_PUBLIC IAllocator
 	void *base_;
 	size_t usedMemory_;
 	size_t numAllocations_;
+	size_t peakMemory_;
+	size_t numTotalAllocations_;
 	bool copyOnReallocation_;
 
+	/// Updates the allocation counter and the peak of used memory after a successful allocation
+	inline void *trackAllocation(void *ptr)
+	{
+		if (ptr)
+		{
+			numTotalAllocations_++;
+			if (usedMemory_ > peakMemory_)
+				peakMemory_ = usedMemory_;
+		}
+		return ptr;
+	}
+
 #if defined(RECORD_ALLOCATIONS) || defined(WITH_TRACY)
 	AllocateFunction realAllocateFunc_;
 	ReallocateFunction realReallocateFunc_;
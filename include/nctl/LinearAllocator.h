@@ -24,6 +24,8 @@ class DLL_PUBLIC LinearAllocator : public IAllocator
 
   private:
 	void *current_;
+	/// The last allocation, the only one that can be resized in place
+	void *lastAllocation_;
 
 	LinearAllocator(const LinearAllocator &) = delete;
 	LinearAllocator &operator=(const LinearAllocator &) = delete;
@@ -0,0 +1,205 @@
+#ifndef CLASS_NCTL_MPMCQUEUE
+#define CLASS_NCTL_MPMCQUEUE
+
+#include <new>
+#include <cstdint>
+#include <ncine/common_macros.h>
+#include "Atomic.h"
+#include "utility.h"
+
+#include <ncine/config.h>
+#if NCINE_WITH_ALLOCATORS
+	#include "AllocManager.h"
+	#include "IAllocator.h"
+#endif
+
+namespace nctl {
+
+/// A bounded lock-free queue for any number of producer and consumer threads
+/*! The capacity is rounded up to a power of two. Every slot has a sequence number that tells if it is ready to be
+ *  written or read at the current position, threads only contend on the position they are trying to claim. */
+template <class T>
+class MpmcQueue
+{
+  public:
+#if !NCINE_WITH_ALLOCATORS
+	/// Constructs a queue with the specified capacity
+	explicit MpmcQueue(unsigned int capacity);
+#else
+	/// Constructs a queue with the specified capacity
+	explicit MpmcQueue(unsigned int capacity)
+	    : MpmcQueue(capacity, theDefaultAllocator()) {}
+	/// Constructs a queue with the specified capacity and a custom allocator
+	MpmcQueue(unsigned int capacity, IAllocator &alloc);
+#endif
+	~MpmcQueue();
+
+	/// Returns the queue capacity
+	inline unsigned int capacity() const { return capacity_; }
+	/// Returns the number of elements in the queue
+	/*! \note The value might already be outdated when the function returns if other threads are active */
+	unsigned int size() const;
+	/// Returns true if the queue is empty
+	/*! \note The value might already be outdated when the function returns if other threads are active */
+	inline bool isEmpty() const { return size() == 0; }
+
+	/// Copies an element at the back of the queue, returns false if it is full
+	inline bool push(const T &element) { return emplace(element); }
+	/// Moves an element at the back of the queue, returns false if it is full
+	inline bool push(T &&element) { return emplace(nctl::move(element)); }
+	/// Constructs a new element at the back of the queue, returns false if it is full
+	template <typename... Args> bool emplace(Args &&... args);
+
+	/// Moves the element at the front of the queue in the specified one, returns false if it is empty
+	bool pop(T &element);
+
+  private:
+	/// Alignment that keeps the positions claimed by producers and consumers on different cache lines
+	static const unsigned int CacheLineSize = 64;
+
+	/// A queue slot with the sequence number that synchronizes the access to its element
+	struct Slot
+	{
+		explicit Slot(int32_t position)
+		    : sequence(position) {}
+
+		/// The queue position that can access the slot next, plus one if it has to be read
+		Atomic32 sequence;
+		alignas(T) unsigned char element[sizeof(T)];
+
+		inline T *ptr() { return reinterpret_cast<T *>(element); }
+	};
+
+#if NCINE_WITH_ALLOCATORS
+	/// The custom memory allocator for the queue
+	IAllocator &alloc_;
+#endif
+	Slot *slots_;
+	unsigned int capacity_;
+
+	/// The next position to be claimed by a producer
+	alignas(CacheLineSize) mutable Atomic32 enqueuePos_;
+	/// The next position to be claimed by a consumer
+	alignas(CacheLineSize) mutable Atomic32 dequeuePos_;
+
+	/// Deleted copy constructor
+	MpmcQueue(const MpmcQueue &) = delete;
+	/// Deleted assignment operator
+	MpmcQueue &operator=(const MpmcQueue &) = delete;
+};
+
+#if !NCINE_WITH_ALLOCATORS
+template <class T>
+MpmcQueue<T>::MpmcQueue(unsigned int capacity)
+#else
+template <class T>
+MpmcQueue<T>::MpmcQueue(unsigned int capacity, IAllocator &alloc)
+#endif
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(alloc),
+#endif
+      slots_(nullptr), capacity_(1)
+{
+	FATAL_ASSERT_MSG(capacity > 0, "Zero is not a valid capacity");
+	FATAL_ASSERT_MSG_X(capacity <= (1u << 30), "Capacity %u is too big", capacity);
+
+	while (capacity_ < capacity)
+		capacity_ *= 2;
+
+#if !NCINE_WITH_ALLOCATORS
+	slots_ = static_cast<Slot *>(::operator new(capacity_ * sizeof(Slot)));
+#else
+	slots_ = static_cast<Slot *>(alloc_.allocate(capacity_ * sizeof(Slot)));
+#endif
+	for (unsigned int i = 0; i < capacity_; i++)
+		new (slots_ + i) Slot(static_cast<int32_t>(i));
+}
+
+template <class T>
+MpmcQueue<T>::~MpmcQueue()
+{
+	const uint32_t Mask = capacity_ - 1;
+	const uint32_t enqueuePos = static_cast<uint32_t>(enqueuePos_.load(Atomic32::MemoryModel::ACQUIRE));
+	for (uint32_t pos = static_cast<uint32_t>(dequeuePos_.load(Atomic32::MemoryModel::ACQUIRE)); pos != enqueuePos; pos++)
+		destructObject(slots_[pos & Mask].ptr());
+	destructArray(slots_, capacity_);
+
+#if !NCINE_WITH_ALLOCATORS
+	::operator delete(slots_);
+#else
+	alloc_.deallocate(slots_);
+#endif
+}
+
+template <class T>
+unsigned int MpmcQueue<T>::size() const
+{
+	// Loading the dequeue position first ensures it never surpasses the enqueue one
+	const uint32_t dequeuePos = static_cast<uint32_t>(dequeuePos_.load(Atomic32::MemoryModel::ACQUIRE));
+	const uint32_t enqueuePos = static_cast<uint32_t>(enqueuePos_.load(Atomic32::MemoryModel::ACQUIRE));
+	const uint32_t size = enqueuePos - dequeuePos;
+	return (size < capacity_) ? size : capacity_;
+}
+
+template <class T>
+template <typename... Args>
+bool MpmcQueue<T>::emplace(Args &&... args)
+{
+	const uint32_t Mask = capacity_ - 1;
+	Slot *slot = nullptr;
+
+	uint32_t pos = static_cast<uint32_t>(enqueuePos_.load(Atomic32::MemoryModel::RELAXED));
+	while (true)
+	{
+		slot = &slots_[pos & Mask];
+		const uint32_t sequence = static_cast<uint32_t>(slot->sequence.load(Atomic32::MemoryModel::ACQUIRE));
+		const int32_t diff = static_cast<int32_t>(sequence - pos);
+
+		if (diff == 0)
+		{
+			if (enqueuePos_.cmpExchange(static_cast<int32_t>(pos + 1), static_cast<int32_t>(pos), Atomic32::MemoryModel::RELAXED))
+				break;
+		}
+		else if (diff < 0)
+			return false; // the slot has not been read yet since the last lap
+		pos = static_cast<uint32_t>(enqueuePos_.load(Atomic32::MemoryModel::RELAXED));
+	}
+
+	new (slot->ptr()) T(nctl::forward<Args>(args)...);
+	slot->sequence.store(static_cast<int32_t>(pos + 1), Atomic32::MemoryModel::RELEASE);
+	return true;
+}
+
+template <class T>
+bool MpmcQueue<T>::pop(T &element)
+{
+	const uint32_t Mask = capacity_ - 1;
+	Slot *slot = nullptr;
+
+	uint32_t pos = static_cast<uint32_t>(dequeuePos_.load(Atomic32::MemoryModel::RELAXED));
+	while (true)
+	{
+		slot = &slots_[pos & Mask];
+		const uint32_t sequence = static_cast<uint32_t>(slot->sequence.load(Atomic32::MemoryModel::ACQUIRE));
+		const int32_t diff = static_cast<int32_t>(sequence - (pos + 1));
+
+		if (diff == 0)
+		{
+			if (dequeuePos_.cmpExchange(static_cast<int32_t>(pos + 1), static_cast<int32_t>(pos), Atomic32::MemoryModel::RELAXED))
+				break;
+		}
+		else if (diff < 0)
+			return false; // the slot has not been written yet
+		pos = static_cast<uint32_t>(dequeuePos_.load(Atomic32::MemoryModel::RELAXED));
+	}
+
+	element = nctl::move(*slot->ptr());
+	destructObject(slot->ptr());
+	slot->sequence.store(static_cast<int32_t>(pos + capacity_), Atomic32::MemoryModel::RELEASE);
+	return true;
+}
+
+}
+
+#endif
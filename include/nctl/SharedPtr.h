@@ -141,6 +141,13 @@ class SharedPtr
 #endif
 };
 
+/// A shared pointer can be relocated with a memory copy, as the control block does not point back to it
+template <class T>
+struct isTriviallyRelocatable<SharedPtr<T>>
+{
+	static constexpr bool value = true;
+};
+
 template <class T>
 SharedPtr<T>::SharedPtr(T *ptr)
     : ptr_(ptr),
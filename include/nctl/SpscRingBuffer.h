@@ -0,0 +1,175 @@
+#ifndef CLASS_NCTL_SPSCRINGBUFFER
+#define CLASS_NCTL_SPSCRINGBUFFER
+
+#include <new>
+#include <cstdint>
+#include <ncine/common_macros.h>
+#include "Atomic.h"
+#include "utility.h"
+
+#include <ncine/config.h>
+#if NCINE_WITH_ALLOCATORS
+	#include "AllocManager.h"
+	#include "IAllocator.h"
+#endif
+
+namespace nctl {
+
+/// A bounded lock-free ring buffer for a single producer thread and a single consumer thread
+/*! The capacity is rounded up to a power of two. Only one thread can push and only one thread can pop at the same time.
+ *  Every thread caches the last seen index of the other one and only reads the shared one when the cached value is not enough. */
+template <class T>
+class SpscRingBuffer
+{
+  public:
+#if !NCINE_WITH_ALLOCATORS
+	/// Constructs a ring buffer with the specified capacity
+	explicit SpscRingBuffer(unsigned int capacity);
+#else
+	/// Constructs a ring buffer with the specified capacity
+	explicit SpscRingBuffer(unsigned int capacity)
+	    : SpscRingBuffer(capacity, theDefaultAllocator()) {}
+	/// Constructs a ring buffer with the specified capacity and a custom allocator
+	SpscRingBuffer(unsigned int capacity, IAllocator &alloc);
+#endif
+	~SpscRingBuffer();
+
+	/// Returns the ring buffer capacity
+	inline unsigned int capacity() const { return capacity_; }
+	/// Returns the number of elements in the ring buffer
+	/*! \note The value might already be outdated when the function returns if the other thread is active */
+	unsigned int size() const;
+	/// Returns true if the ring buffer is empty
+	/*! \note The value might already be outdated when the function returns if the other thread is active */
+	inline bool isEmpty() const { return size() == 0; }
+
+	/// Copies an element at the back of the ring buffer, returns false if it is full
+	/*! \note It can only be called by the producer thread */
+	inline bool push(const T &element) { return emplace(element); }
+	/// Moves an element at the back of the ring buffer, returns false if it is full
+	/*! \note It can only be called by the producer thread */
+	inline bool push(T &&element) { return emplace(nctl::move(element)); }
+	/// Constructs a new element at the back of the ring buffer, returns false if it is full
+	/*! \note It can only be called by the producer thread */
+	template <typename... Args> bool emplace(Args &&... args);
+
+	/// Moves the element at the front of the ring buffer in the specified one, returns false if it is empty
+	/*! \note It can only be called by the consumer thread */
+	bool pop(T &element);
+
+  private:
+	/// Alignment that keeps the indices written by different threads on different cache lines
+	static const unsigned int CacheLineSize = 64;
+
+#if NCINE_WITH_ALLOCATORS
+	/// The custom memory allocator for the ring buffer
+	IAllocator &alloc_;
+#endif
+	T *array_;
+	unsigned int capacity_;
+
+	/// The next position written by the producer thread
+	alignas(CacheLineSize) mutable Atomic32 writePos_;
+	/// The last read position seen by the producer thread
+	uint32_t cachedReadPos_;
+
+	/// The next position read by the consumer thread
+	alignas(CacheLineSize) mutable Atomic32 readPos_;
+	/// The last write position seen by the consumer thread
+	uint32_t cachedWritePos_;
+
+	/// Deleted copy constructor
+	SpscRingBuffer(const SpscRingBuffer &) = delete;
+	/// Deleted assignment operator
+	SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+};
+
+#if !NCINE_WITH_ALLOCATORS
+template <class T>
+SpscRingBuffer<T>::SpscRingBuffer(unsigned int capacity)
+#else
+template <class T>
+SpscRingBuffer<T>::SpscRingBuffer(unsigned int capacity, IAllocator &alloc)
+#endif
+    :
+#if NCINE_WITH_ALLOCATORS
+      alloc_(alloc),
+#endif
+      array_(nullptr), capacity_(1), cachedReadPos_(0), cachedWritePos_(0)
+{
+	FATAL_ASSERT_MSG(capacity > 0, "Zero is not a valid capacity");
+	FATAL_ASSERT_MSG_X(capacity <= (1u << 31), "Capacity %u is too big", capacity);
+
+	while (capacity_ < capacity)
+		capacity_ *= 2;
+
+#if !NCINE_WITH_ALLOCATORS
+	array_ = static_cast<T *>(::operator new(capacity_ * sizeof(T)));
+#else
+	array_ = static_cast<T *>(alloc_.allocate(capacity_ * sizeof(T)));
+#endif
+}
+
+template <class T>
+SpscRingBuffer<T>::~SpscRingBuffer()
+{
+	const uint32_t Mask = capacity_ - 1;
+	const uint32_t writePos = static_cast<uint32_t>(writePos_.load(Atomic32::MemoryModel::ACQUIRE));
+	for (uint32_t pos = static_cast<uint32_t>(readPos_.load(Atomic32::MemoryModel::RELAXED)); pos != writePos; pos++)
+		destructObject(array_ + (pos & Mask));
+
+#if !NCINE_WITH_ALLOCATORS
+	::operator delete(array_);
+#else
+	alloc_.deallocate(array_);
+#endif
+}
+
+template <class T>
+unsigned int SpscRingBuffer<T>::size() const
+{
+	// Loading the read position first ensures it never surpasses the write one
+	const uint32_t readPos = static_cast<uint32_t>(readPos_.load(Atomic32::MemoryModel::ACQUIRE));
+	const uint32_t writePos = static_cast<uint32_t>(writePos_.load(Atomic32::MemoryModel::ACQUIRE));
+	const uint32_t size = writePos - readPos;
+	return (size < capacity_) ? size : capacity_;
+}
+
+template <class T>
+template <typename... Args>
+bool SpscRingBuffer<T>::emplace(Args &&... args)
+{
+	const uint32_t writePos = static_cast<uint32_t>(writePos_.load(Atomic32::MemoryModel::RELAXED));
+	if (writePos - cachedReadPos_ == capacity_)
+	{
+		cachedReadPos_ = static_cast<uint32_t>(readPos_.load(Atomic32::MemoryModel::ACQUIRE));
+		if (writePos - cachedReadPos_ == capacity_)
+			return false;
+	}
+
+	new (array_ + (writePos & (capacity_ - 1))) T(nctl::forward<Args>(args)...);
+	writePos_.store(static_cast<int32_t>(writePos + 1), Atomic32::MemoryModel::RELEASE);
+	return true;
+}
+
+template <class T>
+bool SpscRingBuffer<T>::pop(T &element)
+{
+	const uint32_t readPos = static_cast<uint32_t>(readPos_.load(Atomic32::MemoryModel::RELAXED));
+	if (readPos == cachedWritePos_)
+	{
+		cachedWritePos_ = static_cast<uint32_t>(writePos_.load(Atomic32::MemoryModel::ACQUIRE));
+		if (readPos == cachedWritePos_)
+			return false;
+	}
+
+	T *slot = array_ + (readPos & (capacity_ - 1));
+	element = nctl::move(*slot);
+	destructObject(slot);
+	readPos_.store(static_cast<int32_t>(readPos + 1), Atomic32::MemoryModel::RELEASE);
+	return true;
+}
+
+}
+
+#endif
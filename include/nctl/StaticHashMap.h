@@ -5,6 +5,7 @@
 #include <ncine/common_macros.h>
 #include "HashFunctions.h"
 #include "ReverseIterator.h"
+#include <cstring> // for memcmp()
 
 namespace nctl {
 
@@ -89,11 +90,23 @@ class StaticHashMap
 	/// Clears the hashmap
 	void clear();
 	/// Checks whether an element is in the hashmap or not
-	bool contains(const K &key, T &returnedValue) const;
+	inline bool contains(const K &key, T &returnedValue) const { return contains(key, hashFunc_(key), returnedValue); }
 	/// Checks whether an element is in the hashmap or not
-	T *find(const K &key);
+	inline T *find(const K &key) { return find(key, hashFunc_(key)); }
 	/// Checks whether an element is in the hashmap or not (read-only)
-	const T *find(const K &key) const;
+	inline const T *find(const K &key) const { return find(key, hashFunc_(key)); }
+	/// Checks whether an element is in the hashmap or not, using a precomputed hash of the key
+	bool contains(const K &key, hash_t hash, T &returnedValue) const;
+	/// Checks whether an element is in the hashmap or not, using a precomputed hash of the key
+	T *find(const K &key, hash_t hash);
+	/// Checks whether an element is in the hashmap or not, using a precomputed hash of the key (read-only)
+	const T *find(const K &key, hash_t hash) const;
+	/// Checks whether an element with a string key is in the hashmap or not, comparing the characters without constructing a key
+	bool contains(const char *key, unsigned int length, hash_t hash, T &returnedValue) const;
+	/// Checks whether an element with a string key is in the hashmap or not, comparing the characters without constructing a key
+	T *find(const char *key, unsigned int length, hash_t hash);
+	/// Checks whether an element with a string key is in the hashmap or not, comparing the characters without constructing a key (read-only)
+	const T *find(const char *key, unsigned int length, hash_t hash) const;
 	/// Removes a key from the hashmap, if it exists
 	bool remove(const K &key);
 
@@ -127,14 +140,27 @@ class StaticHashMap
 
 	void init();
 	void destructNodes();
-	bool findBucketIndex(const K &key, unsigned int &foundIndex, unsigned int &prevFoundIndex) const;
-	inline bool findBucketIndex(const K &key, unsigned int &foundIndex) const;
+	template <class KeyType> bool findBucketIndex(const KeyType &key, hash_t hash, unsigned int &foundIndex, unsigned int &prevFoundIndex) const;
+	template <class KeyType> inline bool findBucketIndex(const KeyType &key, hash_t hash, unsigned int &foundIndex) const;
 	unsigned int addDelta1(unsigned int bucketIndex) const;
 	unsigned int addDelta2(unsigned int bucketIndex) const;
 	unsigned int calcNewDelta(unsigned int bucketIndex, unsigned int newIndex) const;
 	unsigned int linearSearch(unsigned int index, hash_t hash, const K &key) const;
-	bool bucketFoundOrEmpty(unsigned int index, hash_t hash, const K &key) const;
-	bool bucketFound(unsigned int index, hash_t hash, const K &key) const;
+	template <class KeyType> bool bucketFoundOrEmpty(unsigned int index, hash_t hash, const KeyType &key) const;
+	template <class KeyType> bool bucketFound(unsigned int index, hash_t hash, const KeyType &key) const;
+
+	/// The characters of a string key, compared with the stored keys in place of a temporary `K` object
+	struct CharsKey
+	{
+		const char *chars;
+		unsigned int length;
+	};
+
+	inline bool keyEquals(const K &nodeKey, const K &key) const { return equalTo(nodeKey, key); }
+	inline bool keyEquals(const K &nodeKey, const CharsKey &key) const { return (nodeKey.length() == key.length && memcmp(nodeKey.data(), key.chars, key.length) == 0); }
+	inline bool hashMatches(const K &key, hash_t hash) const { return hash == hashFunc_(key); }
+	/// The hash function can only be applied to a `K` object, the hash of the characters is not checked
+	inline bool hashMatches(const CharsKey &, hash_t) const { return true; }
 	T &addNode(unsigned int index, hash_t hash, const K &key);
 	void insertNode(unsigned int index, hash_t hash, const K &key, const T &value);
 	void insertNode(unsigned int index, hash_t hash, const K &key, T &&value);
@@ -507,10 +533,10 @@ void StaticHashMap<K, T, Capacity, HashFunc>::clear()
 }
 
 template <class K, class T, unsigned int Capacity, class HashFunc>
-bool StaticHashMap<K, T, Capacity, HashFunc>::contains(const K &key, T &returnedValue) const
+bool StaticHashMap<K, T, Capacity, HashFunc>::contains(const K &key, hash_t hash, T &returnedValue) const
 {
 	int unsigned bucketIndex = 0;
-	const bool found = findBucketIndex(key, bucketIndex);
+	const bool found = findBucketIndex(key, hash, bucketIndex);
 
 	if (found)
 		returnedValue = nodes_[bucketIndex].value;
@@ -520,10 +546,10 @@ bool StaticHashMap<K, T, Capacity, HashFunc>::contains(const K &key, T &returned
 
 /*! \note Prefer this method if copying `T` is expensive, but always check the validity of returned pointer. */
 template <class K, class T, unsigned int Capacity, class HashFunc>
-T *StaticHashMap<K, T, Capacity, HashFunc>::find(const K &key)
+T *StaticHashMap<K, T, Capacity, HashFunc>::find(const K &key, hash_t hash)
 {
 	int unsigned bucketIndex = 0;
-	const bool found = findBucketIndex(key, bucketIndex);
+	const bool found = findBucketIndex(key, hash, bucketIndex);
 
 	T *returnedPtr = nullptr;
 	if (found)
@@ -534,10 +560,57 @@ T *StaticHashMap<K, T, Capacity, HashFunc>::find(const K &key)
 
 /*! \note Prefer this method if copying `T` is expensive, but always check the validity of returned pointer. */
 template <class K, class T, unsigned int Capacity, class HashFunc>
-const T *StaticHashMap<K, T, Capacity, HashFunc>::find(const K &key) const
+const T *StaticHashMap<K, T, Capacity, HashFunc>::find(const K &key, hash_t hash) const
 {
 	int unsigned bucketIndex = 0;
-	const bool found = findBucketIndex(key, bucketIndex);
+	const bool found = findBucketIndex(key, hash, bucketIndex);
+
+	const T *returnedPtr = nullptr;
+	if (found)
+		returnedPtr = &nodes_[bucketIndex].value;
+
+	return returnedPtr;
+}
+
+/*! \note The key characters do not need to be null-terminated, only `length` of them are compared.
+ *  \warning Only for maps with string keys, the hash has to be calculated from the same characters. */
+template <class K, class T, unsigned int Capacity, class HashFunc>
+bool StaticHashMap<K, T, Capacity, HashFunc>::contains(const char *key, unsigned int length, hash_t hash, T &returnedValue) const
+{
+	const CharsKey charsKey = { key, length };
+	int unsigned bucketIndex = 0;
+	const bool found = findBucketIndex(charsKey, hash, bucketIndex);
+
+	if (found)
+		returnedValue = nodes_[bucketIndex].value;
+
+	return found;
+}
+
+/*! \note The key characters do not need to be null-terminated, only `length` of them are compared.
+ *  \warning Only for maps with string keys, the hash has to be calculated from the same characters. */
+template <class K, class T, unsigned int Capacity, class HashFunc>
+T *StaticHashMap<K, T, Capacity, HashFunc>::find(const char *key, unsigned int length, hash_t hash)
+{
+	const CharsKey charsKey = { key, length };
+	int unsigned bucketIndex = 0;
+	const bool found = findBucketIndex(charsKey, hash, bucketIndex);
+
+	T *returnedPtr = nullptr;
+	if (found)
+		returnedPtr = &nodes_[bucketIndex].value;
+
+	return returnedPtr;
+}
+
+/*! \note The key characters do not need to be null-terminated, only `length` of them are compared.
+ *  \warning Only for maps with string keys, the hash has to be calculated from the same characters. */
+template <class K, class T, unsigned int Capacity, class HashFunc>
+const T *StaticHashMap<K, T, Capacity, HashFunc>::find(const char *key, unsigned int length, hash_t hash) const
+{
+	const CharsKey charsKey = { key, length };
+	int unsigned bucketIndex = 0;
+	const bool found = findBucketIndex(charsKey, hash, bucketIndex);
 
 	const T *returnedPtr = nullptr;
 	if (found)
@@ -552,7 +625,7 @@ bool StaticHashMap<K, T, Capacity, HashFunc>::remove(const K &key)
 {
 	int unsigned foundBucketIndex = 0;
 	int unsigned prevFoundBucketIndex = 0;
-	const bool found = findBucketIndex(key, foundBucketIndex, prevFoundBucketIndex);
+	const bool found = findBucketIndex(key, hashFunc_(key), foundBucketIndex, prevFoundBucketIndex);
 	unsigned int bucketIndex = foundBucketIndex;
 
 	if (found)
@@ -628,13 +701,14 @@ void StaticHashMap<K, T, Capacity, HashFunc>::destructNodes()
 }
 
 template <class K, class T, unsigned int Capacity, class HashFunc>
-bool StaticHashMap<K, T, Capacity, HashFunc>::findBucketIndex(const K &key, unsigned int &foundIndex, unsigned int &prevFoundIndex) const
+template <class KeyType>
+bool StaticHashMap<K, T, Capacity, HashFunc>::findBucketIndex(const KeyType &key, hash_t hash, unsigned int &foundIndex, unsigned int &prevFoundIndex) const
 {
 	if (size_ == 0)
 		return false;
 
+	ASSERT_MSG(hashMatches(key, hash), "The hash does not match the one calculated by the hash function");
 	bool found = false;
-	const hash_t hash = hashFunc_(key);
 	foundIndex = hash % Capacity;
 	prevFoundIndex = foundIndex;
 
@@ -678,10 +752,11 @@ bool StaticHashMap<K, T, Capacity, HashFunc>::findBucketIndex(const K &key, unsi
 }
 
 template <class K, class T, unsigned int Capacity, class HashFunc>
-bool StaticHashMap<K, T, Capacity, HashFunc>::findBucketIndex(const K &key, unsigned int &foundIndex) const
+template <class KeyType>
+bool StaticHashMap<K, T, Capacity, HashFunc>::findBucketIndex(const KeyType &key, hash_t hash, unsigned int &foundIndex) const
 {
 	unsigned int prevFoundIndex = 0;
-	return findBucketIndex(key, foundIndex, prevFoundIndex);
+	return findBucketIndex(key, hash, foundIndex, prevFoundIndex);
 }
 
 template <class K, class T, unsigned int Capacity, class HashFunc>
@@ -734,15 +809,17 @@ unsigned int StaticHashMap<K, T, Capacity, HashFunc>::linearSearch(unsigned int
 }
 
 template <class K, class T, unsigned int Capacity, class HashFunc>
-bool StaticHashMap<K, T, Capacity, HashFunc>::bucketFoundOrEmpty(unsigned int index, hash_t hash, const K &key) const
+template <class KeyType>
+bool StaticHashMap<K, T, Capacity, HashFunc>::bucketFoundOrEmpty(unsigned int index, hash_t hash, const KeyType &key) const
 {
-	return (hashes_[index] == NullHash || (hashes_[index] == hash && equalTo(nodes_[index].key, key)));
+	return (hashes_[index] == NullHash || (hashes_[index] == hash && keyEquals(nodes_[index].key, key)));
 }
 
 template <class K, class T, unsigned int Capacity, class HashFunc>
-bool StaticHashMap<K, T, Capacity, HashFunc>::bucketFound(unsigned int index, hash_t hash, const K &key) const
+template <class KeyType>
+bool StaticHashMap<K, T, Capacity, HashFunc>::bucketFound(unsigned int index, hash_t hash, const KeyType &key) const
 {
-	return (hashes_[index] == hash && equalTo(nodes_[index].key, key));
+	return (hashes_[index] == hash && keyEquals(nodes_[index].key, key));
 }
 
 template <class K, class T, unsigned int Capacity, class HashFunc>
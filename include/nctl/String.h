@@ -1,6 +1,7 @@
 #ifndef CLASS_NCTL_STRING
 #define CLASS_NCTL_STRING
 
+#include <cstdint>
 #include <ncine/common_macros.h>
 #include "Utf8.h"
 #include "StringIterator.h"
@@ -69,6 +70,7 @@ class DLL_PUBLIC String
 		nctl::swap(first.length_, second.length_);
 		nctl::swap(first.capacity_, second.capacity_);
 		nctl::swap(first.fixedCapacity_, second.fixedCapacity_);
+		nctl::swap(first.hash_, second.hash_);
 	}
 
 	/// Returns an iterator to the first character
@@ -115,7 +117,12 @@ class DLL_PUBLIC String
 	void clear();
 
 	/// Returns a pointer to the internal array
-	inline char *data() { return (capacity_ > SmallBufferSize) ? array_.begin_ : array_.local_; }
+	/*! \note The cached hash is invalidated, as the string could be modified through the pointer */
+	inline char *data()
+	{
+		hash_ = 0;
+		return (capacity_ > SmallBufferSize) ? array_.begin_ : array_.local_;
+	}
 	/// Returns a constant pointer to the internal array
 	inline const char *data() const { return (capacity_ > SmallBufferSize) ? array_.begin_ : array_.local_; }
 
@@ -213,6 +220,17 @@ class DLL_PUBLIC String
 	/*! \returns The number of code units used by UTF-8 to encode the Unicode code point */
 	int utf8ToCodePoint(unsigned int position, unsigned int &codePoint) const;
 
+	/// Decodes the whole UTF-8 string to an array of Unicode code points
+	/*! The array should have space for `length()` elements.
+	 *  \returns The number of decoded code points */
+	unsigned int utf8ToCodePoints(unsigned int *codePoints) const;
+	/// Returns true if the string is well-formed UTF-8
+	bool isValidUtf8() const;
+
+	/// Returns the FNV-1a hash of the string, calculating it only if it has been modified since the last call
+	/*! \note Every non-constant access invalidates the cached hash, a pointer to the data should not be used to modify the string afterwards */
+	uint32_t hash() const;
+
   private:
 	/// Size of the local buffer
 	static const unsigned int SmallBufferSize = 16;
@@ -227,12 +245,21 @@ class DLL_PUBLIC String
 	Buffer array_;
 	unsigned int length_;
 	unsigned int capacity_;
+	/// The cached hash of the string, zero if it needs to be calculated
+	mutable uint32_t hash_;
 	unsigned char fixedCapacity_;
 
 	/// Doubling current capacity until the required minimum can be contained
 	bool extendCapacity(unsigned int minimum);
 };
 
+/// A string can be relocated with a memory copy, as the local buffer is selected by capacity and not by a pointer
+template <>
+struct isTriviallyRelocatable<String>
+{
+	static constexpr bool value = true;
+};
+
 DLL_PUBLIC String operator+(const char *cString, const String &string);
 
 }
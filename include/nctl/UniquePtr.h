@@ -310,6 +310,13 @@ void UniquePtr<T[], Deleter>::reset(nullptr_t)
 	pair_.first = nullptr;
 }
 
+/// A unique pointer can be relocated with a memory copy if its deleter can
+template <class T, class Deleter>
+struct isTriviallyRelocatable<UniquePtr<T, Deleter>>
+{
+	static constexpr bool value = isTriviallyRelocatable<Deleter>::value;
+};
+
 template <class T, class Deleter = DefaultDelete<T>>
 struct MakeUniqueReturn
 {
@@ -22,6 +22,15 @@ namespace Utf8 {
 	/// Encodes a Unicode code point to a UTF-8 C substring and code units
 	/*! \returns The number of characters used to encode a valid code point */
 	DLL_PUBLIC int codePointToUtf8(unsigned int codePoint, char *substring, unsigned int *codeUnits);
+
+	/// Decodes a UTF-8 C string of the specified length to an array of Unicode code points
+	/*! Invalid sequences are decoded as `InvalidUnicode`, like with `utf8ToCodePoint()`.
+	 *  The array should have space for `length` elements.
+	 *  \returns The number of decoded code points */
+	DLL_PUBLIC unsigned int utf8ToCodePoints(const char *string, unsigned int length, unsigned int *codePoints);
+	/// Returns true if the C string of the specified length is well-formed UTF-8
+	/*! Overlong encodings, surrogates and code points beyond U+10FFFF are not accepted */
+	DLL_PUBLIC bool isValid(const char *string, unsigned int length);
 }
 
 }
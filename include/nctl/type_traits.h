@@ -112,6 +112,14 @@ struct isTriviallyCopyable
 	static constexpr bool value = __is_trivially_copyable(T);
 };
 
+/// Tells if an object can be moved to a new address and stop existing at the old one with a simple memory copy
+/*! Types owning memory without pointing into themselves can specialize it, like smart pointers and containers. */
+template <class T>
+struct isTriviallyRelocatable
+{
+	static constexpr bool value = isTriviallyCopyable<T>::value;
+};
+
 template <class T, typename = void>
 struct isDestructible
 {
@@ -1,7 +1,7 @@
 #ifndef NCTL_UTILITY
 #define NCTL_UTILITY
 
-#include <cstring> // for `memcpy()`
+#include <cstring> // for `memcpy()` and `memmove()`
 #include "type_traits.h"
 
 namespace nctl {
@@ -107,6 +107,32 @@ namespace detail {
 		}
 	};
 
+	/// A container for functions to relocate arrays of objects
+	template <bool value>
+	struct relocateHelpers
+	{
+		template <class T>
+		inline static void relocateArray(T *dest, T *src, unsigned int numElements)
+		{
+			for (unsigned int i = 0; i < numElements; i++)
+			{
+				new (dest + i) T(nctl::move(src[i]));
+				src[i].~T();
+			}
+		}
+	};
+
+	/// Specialization for trivially relocatable types
+	template <>
+	struct relocateHelpers<true>
+	{
+		template <class T>
+		inline static void relocateArray(T *dest, T *src, unsigned int numElements)
+		{
+			memmove(static_cast<void *>(dest), static_cast<const void *>(src), numElements * sizeof(T));
+		}
+	};
+
 	/// A container for functions to copy arrays of objects
 	template <bool value>
 	struct copyHelpers
@@ -139,7 +165,8 @@ namespace detail {
 		template <class T>
 		inline static void moveAssignArray(T *dest, T *src, unsigned int numElements)
 		{
-			memcpy(dest, src, numElements * sizeof(T));
+			// Ranges overlap when elements are shifted inside the same array
+			memmove(dest, src, numElements * sizeof(T));
 		}
 	};
 
@@ -233,6 +260,14 @@ void destructArray(T *ptr, unsigned int numElements)
 	detail::destructHelpers<isTriviallyDestructible<T>::value>::destructArray(ptr, numElements);
 }
 
+/// Moves elements to uninitialized memory, leaving the source elements destroyed
+/*! \note Source and destination can only overlap for trivially relocatable types */
+template <class T>
+void relocateArray(T *dest, T *src, unsigned int numElements)
+{
+	detail::relocateHelpers<isTriviallyRelocatable<T>::value>::relocateArray(dest, src, numElements);
+}
+
 template <class T>
 void copyAssignArray(T *dest, const T *src, unsigned int numElements)
 {
@@ -0,0 +1,88 @@
+#!/usr/bin/env lua
+
+-- Stresses the cost of calling binding functions and script callbacks every frame
+
+if ncine == nil then
+	ncine = require "libncine"
+	needs_start = true
+end
+
+nc = ncine
+
+num_sprites_ = 1000
+calls_per_sprite_ = 4
+report_interval_ = 120
+
+function nc.on_pre_init(cfg)
+	cfg.resolution = {x = 1280, y = 720}
+	cfg.window_title = "nCine Lua bindings benchmark"
+	return cfg
+end
+
+function nc.on_init()
+	local texture_file = "texture2.png"
+	if nc.ANDROID then
+		texture_file = "texture2_ETC2.ktx"
+	end
+
+	local rootnode = nc.application.get_rootnode()
+	resolution_ = nc.application.get_resolution()
+	texture_ = nc.texture.new(nc.fs.get_data_path().."textures/"..texture_file)
+
+	sprites_ = {}
+	for i = 1, num_sprites_ do
+		local x = math.random() * resolution_.x
+		local y = math.random() * resolution_.y
+		sprites_[i] = nc.sprite.new(rootnode, texture_, x, y)
+		nc.sprite.set_scale(sprites_[i], 0.1)
+	end
+
+	angle_ = 0
+	frames_ = 0
+	elapsed_ = 0
+end
+
+function nc.on_frame_start()
+	local start = os.clock()
+
+	angle_ = angle_ + 50 * nc.application.get_interval()
+	local offset = math.sin(math.rad(angle_))
+	for i = 1, num_sprites_ do
+		local sprite = sprites_[i]
+		local pos = nc.sprite.get_position(sprite)
+		nc.sprite.set_position(sprite, pos.x + offset, pos.y)
+		nc.sprite.set_rotation(sprite, angle_ + i)
+		nc.sprite.get_rotation(sprite)
+	end
+
+	elapsed_ = elapsed_ + (os.clock() - start)
+	frames_ = frames_ + 1
+	if frames_ == report_interval_ then
+		local calls = num_sprites_ * calls_per_sprite_
+		local frame_ms = elapsed_ * 1000 / frames_
+		nc.log.info(string.format("%d binding calls per frame: %.3f ms (%.1f ns per call)", calls, frame_ms, frame_ms * 1000000 / calls))
+		frames_ = 0
+		elapsed_ = 0
+	end
+end
+
+function nc.on_shutdown()
+	for i = 1, num_sprites_ do
+		nc.sprite.delete(sprites_[i])
+		sprites_[i] = nil
+	end
+	sprites_ = nil
+
+	nc.texture.delete(texture_)
+	texture_ = nil
+end
+
+function nc.on_key_released(event)
+	if event.sym == nc.keysym.ESCAPE then
+		nc.application.quit()
+	end
+end
+
+if needs_start then
+	nc.start()
+end
@@ -43,9 +43,15 @@ AppConfiguration::AppConfiguration()
       useBinaryShaderCache(true),
 #else
       useBinaryShaderCache(false),
+#endif
+#if defined(__ANDROID__)
+      usePackedShaderCache(true),
+#else
+      usePackedShaderCache(false),
 #endif
       shaderCacheDirname(64),
       compileBatchedShadersTwice(true),
+      packedTextVertices(false),
 #if defined(WITH_IMGUI) || defined(WITH_NUKLEAR)
       vboSize(512 * 1024),
       iboSize(128 * 1024),
@@ -65,6 +71,7 @@ AppConfiguration::AppConfiguration()
       withVSync(true),
       withGlDebugContext(false),
       withConsoleColors(true),
+      withLogCrashHandlers(false),
 
       // Compile-time variables
       glCoreProfile_(true),
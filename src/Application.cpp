@@ -6,6 +6,7 @@
 #include "GfxCapabilities.h"
 #include "RenderResources.h"
 #include "RenderQueue.h"
+#include "TextureReadback.h"
 #include "ScreenViewport.h"
 #include "GLDebug.h"
 #include "Timer.h" // for `sleep()`
@@ -16,6 +17,7 @@
 
 #ifdef WITH_AUDIO
 	#include "ALAudioDevice.h"
+	#include "AudioBufferCache.h"
 #endif
 
 #ifdef WITH_THREADS
@@ -35,6 +37,12 @@
 	#include "NuklearDrawing.h"
 #endif
 
+#ifdef WITH_ALLOCATORS
+	#include <nctl/AllocManager.h>
+	#include <nctl/FrameAllocator.h>
+	#include <nctl/AllocTelemetry.h>
+#endif
+
 #include "tracy.h"
 #include "tracy_opengl.h"
 
@@ -198,6 +206,12 @@ void Application::step()
 {
 	ZoneScoped;
 	frameTimer_->addFrame();
+#ifdef WITH_ALLOCATORS
+	// Sampling the allocators before the frame allocator starts a new frame
+	nctl::theAllocTelemetry().update();
+	// Frame allocations are available until the end of the next frame
+	nctl::theFrameAllocator().nextFrame();
+#endif
 
 #ifdef WITH_IMGUI
 	{
@@ -318,6 +332,9 @@ void Application::step()
 
 	{
 		ZoneScopedN("Audio");
+#ifdef WITH_AUDIO
+		theAudioBufferCache().update();
+#endif
 		theServiceLocator().audioDevice().updatePlayers();
 	}
 
@@ -331,6 +348,9 @@ void Application::step()
 	if (debugOverlay_)
 		debugOverlay_->updateFrameTimings();
 
+	// Screen readbacks are issued when the frame is complete, before swapping buffers
+	TextureReadback::update();
+
 	gfxDevice_->update();
 	FrameMark;
 	TracyGpuCollect;
@@ -366,6 +386,7 @@ void Application::shutdownCommon()
 
 	debugOverlay_.reset(nullptr);
 	rootNode_.reset(nullptr);
+	TextureReadback::dispose();
 	RenderResources::dispose();
 	frameTimer_.reset(nullptr);
 	inputManager_.reset(nullptr);
@@ -379,6 +400,10 @@ void Application::shutdownCommon()
 
 	LOGI("Application shut down");
 
+#ifdef WITH_AUDIO
+	// Cached OpenAL buffers need to be deleted before the audio device
+	theAudioBufferCache().clear();
+#endif
 	theServiceLocator().unregisterAll();
 }
 
@@ -0,0 +1,149 @@
+#include <cstring> // for memcpy()
+#include "common_macros.h"
+#include "ArchiveFile.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+ArchiveFile::ArchiveFile(const char *filename, const unsigned char *dataPtr, unsigned long int size)
+    : IFile(filename), dataPtr_(dataPtr), archiveOffset_(0), isOpened_(false), seekOffset_(0)
+{
+	type_ = FileType::ARCHIVE;
+	fileSize_ = size;
+}
+
+ArchiveFile::ArchiveFile(const char *filename, nctl::UniquePtr<unsigned char[]> buffer, unsigned long int size)
+    : IFile(filename), dataPtr_(buffer.get()), buffer_(nctl::move(buffer)), archiveOffset_(0), isOpened_(false), seekOffset_(0)
+{
+	type_ = FileType::ARCHIVE;
+	fileSize_ = size;
+}
+
+ArchiveFile::ArchiveFile(const char *filename, nctl::UniquePtr<IFile> archiveHandle, unsigned long int offset, unsigned long int size)
+    : IFile(filename), dataPtr_(nullptr), archiveHandle_(nctl::move(archiveHandle)), archiveOffset_(offset), isOpened_(false), seekOffset_(0)
+{
+	type_ = FileType::ARCHIVE;
+	fileSize_ = size;
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void ArchiveFile::open(unsigned char mode)
+{
+	// Checking if the file is already opened
+	if (isOpened_)
+	{
+		LOGW_X("File \"%s\" is already opened", filename_.data());
+		return;
+	}
+
+	if ((mode & OpenMode::WRITE) || (mode & OpenMode::READ) == 0)
+	{
+		LOGE_X("Cannot open the file \"%s\", archived files can only be opened for reading", filename_.data());
+		return;
+	}
+
+	if (archiveHandle_ != nullptr)
+	{
+		archiveHandle_->open(OpenMode::READ | OpenMode::BINARY);
+		isOpened_ = archiveHandle_->isOpened();
+	}
+	else
+		isOpened_ = (dataPtr_ != nullptr || fileSize_ == 0);
+
+	if (isOpened_ == false)
+	{
+		LOGE_X("Cannot open the archived file \"%s\"", filename_.data());
+		return;
+	}
+
+	seekOffset_ = 0;
+	LOGI_X("Archived file \"%s\" opened", filename_.data());
+}
+
+void ArchiveFile::close()
+{
+	if (archiveHandle_ != nullptr && archiveHandle_->isOpened())
+		archiveHandle_->close();
+	isOpened_ = false;
+	seekOffset_ = 0;
+}
+
+long int ArchiveFile::seek(long int offset, int whence) const
+{
+	long int seekValue = -1;
+
+	if (isOpened_)
+	{
+		switch (whence)
+		{
+			case SEEK_SET:
+				seekValue = offset;
+				break;
+			case SEEK_CUR:
+				seekValue = seekOffset_ + offset;
+				break;
+			case SEEK_END:
+				seekValue = fileSize_ + offset;
+				break;
+		}
+	}
+
+	if (seekValue < 0 || seekValue > static_cast<long int>(fileSize_))
+		seekValue = -1;
+	else
+		seekOffset_ = seekValue;
+
+	return seekValue;
+}
+
+long int ArchiveFile::tell() const
+{
+	long int tellValue = -1;
+
+	if (isOpened_)
+		tellValue = seekOffset_;
+
+	return tellValue;
+}
+
+unsigned long int ArchiveFile::read(void *buffer, unsigned long int bytes) const
+{
+	ASSERT(buffer);
+
+	unsigned long int bytesRead = 0;
+
+	if (isOpened_)
+	{
+		bytesRead = (seekOffset_ + bytes > fileSize_) ? fileSize_ - seekOffset_ : bytes;
+		if (dataPtr_)
+			memcpy(buffer, dataPtr_ + seekOffset_, bytesRead);
+		else if (bytesRead > 0)
+		{
+			// The archive handle is owned by this file, so its position can be changed freely
+			archiveHandle_->seek(static_cast<long int>(archiveOffset_ + seekOffset_), SEEK_SET);
+			bytesRead = archiveHandle_->read(buffer, bytesRead);
+		}
+		seekOffset_ += bytesRead;
+	}
+
+	return bytesRead;
+}
+
+unsigned long int ArchiveFile::write(const void *buffer, unsigned long int bytes)
+{
+	// Archived files are read-only
+	return 0;
+}
+
+bool ArchiveFile::isOpened() const
+{
+	return isOpened_;
+}
+
+}
@@ -17,6 +17,8 @@ const char *objectTypeToString(Object::ObjectType type)
 		case Object::ObjectType::PARTICLE_SYSTEM:		return "ParticleSystem";
 		case Object::ObjectType::FONT:					return "Font";
 		case Object::ObjectType::TEXTNODE:				return "TextNode";
+		case Object::ObjectType::STATIC_BATCH_NODE:		return "StaticBatchNode";
+		case Object::ObjectType::TILEMAP_NODE:			return "TileMapNode";
 		case Object::ObjectType::AUDIOBUFFER:			return "AudioBuffer";
 		case Object::ObjectType::AUDIOBUFFER_PLAYER:	return "AudioBufferPlayer";
 		case Object::ObjectType::AUDIOSTREAM_PLAYER:	return "AudioStreamPlayer";
@@ -0,0 +1,462 @@
+#include <cstring> // for memcmp()
+#include "common_macros.h"
+#include "AssetArchive.h"
+#include "AssetArchiveFormat.h"
+#include "ArchiveFile.h"
+#include "StandardFile.h"
+#include "MappedFile.h"
+#include <nctl/Array.h>
+#include <nctl/CString.h>
+
+#ifdef __ANDROID__
+	#include "AssetFile.h"
+#endif
+
+namespace ncine {
+
+namespace {
+
+	struct MountedArchive
+	{
+		/// The normalized mount point, without a trailing separator
+		nctl::String mountPoint;
+		nctl::UniquePtr<AssetArchive> archive;
+	};
+
+	nctl::Array<MountedArchive> &mountedArchives()
+	{
+		static nctl::Array<MountedArchive> archives;
+		return archives;
+	}
+
+	/// Creates a handle to the archive file itself, bypassing the mounted archives
+	nctl::UniquePtr<IFile> createArchiveHandle(const char *filename, bool mapped)
+	{
+#ifdef __ANDROID__
+		const char *assetFilename = AssetFile::assetPath(filename);
+		if (assetFilename)
+			return nctl::makeUnique<AssetFile>(assetFilename);
+#endif
+		if (mapped)
+			return nctl::makeUnique<MappedFile>(filename);
+		return nctl::makeUnique<StandardFile>(filename);
+	}
+
+	inline bool isSeparator(char c)
+	{
+		return (c == '/' || c == '\\');
+	}
+
+	/// Copies the mount point removing a trailing separator and converting separators to forward slashes
+	void normalizeMountPoint(const char *mountPoint, nctl::String &dest)
+	{
+		dest = mountPoint;
+		for (unsigned int i = 0; i < dest.length(); i++)
+		{
+			if (dest[i] == '\\')
+				dest[i] = '/';
+		}
+		unsigned int length = dest.length();
+		while (length > 1 && dest[length - 1] == '/')
+			length--;
+		dest.setLength(length);
+		dest.data()[length] = '\0';
+	}
+
+	/// Writes the entry name corresponding to the path if it is inside the mount point
+	/*! \returns The length of the entry name or zero if the path is not inside the mount point */
+	unsigned int pathToEntryName(const char *path, const nctl::String &mountPoint, char *dest)
+	{
+		const unsigned int mountPointLength = mountPoint.length();
+		unsigned int i = 0;
+		for (; i < mountPointLength; i++)
+		{
+			const char c = (path[i] == '\\') ? '/' : path[i];
+			if (c != mountPoint[i])
+				return 0;
+		}
+		if (mountPointLength > 0 && path[i] != '\0' && isSeparator(path[i]) == false && mountPoint[mountPointLength - 1] != '/')
+			return 0;
+
+		// Skipping separators and current directory references between the mount point and the entry name
+		if (mountPointLength > 0)
+		{
+			while (isSeparator(path[i]))
+				i++;
+		}
+		while (path[i] == '.' && isSeparator(path[i + 1]))
+		{
+			i += 2;
+			while (isSeparator(path[i]))
+				i++;
+		}
+
+		unsigned int length = 0;
+		for (; path[i] != '\0'; i++)
+		{
+			if (length >= AssetArchiveFormat::MaxNameLength - 1)
+				return 0;
+			dest[length++] = isSeparator(path[i]) ? '/' : path[i];
+		}
+		dest[length] = '\0';
+
+		return length;
+	}
+
+	/// Decompresses an LZ4 block, checking every read and write against the buffer boundaries
+	bool decompressLz4Block(const unsigned char *src, unsigned long int srcSize, unsigned char *dest, unsigned long int destSize)
+	{
+		const unsigned char *ip = src;
+		const unsigned char *const ipEnd = src + srcSize;
+		unsigned char *op = dest;
+		unsigned char *const opEnd = dest + destSize;
+
+		while (ip < ipEnd)
+		{
+			const unsigned int token = *ip++;
+
+			unsigned long int literalLength = token >> 4;
+			if (literalLength == 15)
+			{
+				unsigned char byte = 255;
+				while (byte == 255 && ip < ipEnd)
+				{
+					byte = *ip++;
+					literalLength += byte;
+				}
+			}
+			if (literalLength > static_cast<unsigned long int>(ipEnd - ip) ||
+			    literalLength > static_cast<unsigned long int>(opEnd - op))
+				return false;
+			memcpy(op, ip, literalLength);
+			ip += literalLength;
+			op += literalLength;
+
+			// The last sequence of a block only contains literals
+			if (ip == ipEnd)
+				break;
+
+			if (ipEnd - ip < 2)
+				return false;
+			const unsigned long int matchOffset = ip[0] | (ip[1] << 8);
+			ip += 2;
+			if (matchOffset == 0 || matchOffset > static_cast<unsigned long int>(op - dest))
+				return false;
+
+			unsigned long int matchLength = token & 15;
+			if (matchLength == 15)
+			{
+				unsigned char byte = 255;
+				while (byte == 255 && ip < ipEnd)
+				{
+					byte = *ip++;
+					matchLength += byte;
+				}
+			}
+			matchLength += 4;
+			if (matchLength > static_cast<unsigned long int>(opEnd - op))
+				return false;
+
+			// Matches can overlap the bytes they are producing
+			const unsigned char *match = op - matchOffset;
+			for (unsigned long int i = 0; i < matchLength; i++)
+				*op++ = *match++;
+		}
+
+		return (op == opEnd);
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+AssetArchive::AssetArchive(const char *filename)
+    : filename_(filename), mappedPtr_(nullptr), numEntries_(0)
+{
+	ASSERT(filename);
+
+	fileHandle_ = createArchiveHandle(filename, true);
+	fileHandle_->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+	if (fileHandle_->isOpened() == false && fileHandle_->type() == IFile::FileType::MAPPED)
+	{
+		// Falling back to streaming entries from the file if it cannot be mapped
+		fileHandle_ = createArchiveHandle(filename, false);
+		fileHandle_->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+	}
+
+	if (fileHandle_->isOpened() == false)
+	{
+		LOGE_X("Cannot open the archive \"%s\"", filename);
+		return;
+	}
+
+	mappedPtr_ = static_cast<const unsigned char *>(fileHandle_->data());
+	if (readIndex() == false)
+	{
+		entries_.reset(nullptr);
+		names_.reset(nullptr);
+		numEntries_ = 0;
+		fileHandle_->close();
+		return;
+	}
+
+	LOGI_X("Archive \"%s\" opened with %u entries (%s)", filename, numEntries_, mappedPtr_ ? "mapped" : "streamed");
+}
+
+AssetArchive::~AssetArchive() = default;
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+int AssetArchive::findEntry(const char *name) const
+{
+	ASSERT(name);
+	if (entries_ == nullptr)
+		return -1;
+
+	const unsigned int length = nctl::strnlen(name, AssetArchiveFormat::MaxNameLength);
+	const uint64_t hash = AssetArchiveFormat::hashName(name, length);
+
+	// Lower bound binary search on the name hash
+	unsigned int first = 0;
+	unsigned int count = numEntries_;
+	while (count > 0)
+	{
+		const unsigned int step = count / 2;
+		if (entries_[first + step].hash < hash)
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else
+			count = step;
+	}
+
+	for (unsigned int i = first; i < numEntries_ && entries_[i].hash == hash; i++)
+	{
+		const AssetArchiveFormat::Entry &entry = entries_[i];
+		if (entry.nameLength == length && memcmp(names_.get() + entry.nameOffset, name, length) == 0)
+			return static_cast<int>(i);
+	}
+
+	return -1;
+}
+
+const char *AssetArchive::entryName(unsigned int index) const
+{
+	ASSERT(index < numEntries_);
+	return names_.get() + entries_[index].nameOffset;
+}
+
+unsigned long int AssetArchive::entrySize(unsigned int index) const
+{
+	ASSERT(index < numEntries_);
+	return entries_[index].size;
+}
+
+unsigned long int AssetArchive::entryStoredSize(unsigned int index) const
+{
+	ASSERT(index < numEntries_);
+	return entries_[index].storedSize;
+}
+
+nctl::UniquePtr<IFile> AssetArchive::openEntry(unsigned int index, const char *filename) const
+{
+	ASSERT(index < numEntries_);
+	ASSERT(filename);
+	const AssetArchiveFormat::Entry &entry = entries_[index];
+
+	if (entry.compression == AssetArchiveFormat::Compression::NONE)
+	{
+		if (mappedPtr_)
+			return nctl::makeUnique<ArchiveFile>(filename, mappedPtr_ + entry.offset, entry.size);
+		else
+		{
+			// Every streamed entry has its own handle to the archive, so that it can be read independently
+			nctl::UniquePtr<IFile> archiveHandle = createArchiveHandle(filename_.data(), false);
+			return nctl::makeUnique<ArchiveFile>(filename, nctl::move(archiveHandle), static_cast<unsigned long int>(entry.offset), entry.size);
+		}
+	}
+
+	nctl::UniquePtr<unsigned char[]> buffer = nctl::makeUnique<unsigned char[]>(entry.size);
+	bool decompressed = false;
+	if (mappedPtr_)
+		decompressed = decompressLz4Block(mappedPtr_ + entry.offset, entry.storedSize, buffer.get(), entry.size);
+	else
+	{
+		nctl::UniquePtr<unsigned char[]> storedData = nctl::makeUnique<unsigned char[]>(entry.storedSize);
+		if (readRange(storedData.get(), static_cast<unsigned long int>(entry.offset), entry.storedSize))
+			decompressed = decompressLz4Block(storedData.get(), entry.storedSize, buffer.get(), entry.size);
+	}
+
+	if (decompressed == false)
+	{
+		LOGE_X("Cannot decompress the entry \"%s\" of the archive \"%s\"", entryName(index), filename_.data());
+		buffer.reset(nullptr);
+	}
+	return nctl::makeUnique<ArchiveFile>(filename, nctl::move(buffer), entry.size);
+}
+
+bool AssetArchive::mount(const char *filename, const char *mountPoint)
+{
+	ASSERT(filename);
+	ASSERT(mountPoint);
+
+	nctl::UniquePtr<AssetArchive> archive = nctl::makeUnique<AssetArchive>(filename);
+	if (archive->isValid() == false)
+		return false;
+
+	MountedArchive mounted;
+	normalizeMountPoint(mountPoint, mounted.mountPoint);
+	mounted.archive = nctl::move(archive);
+	LOGI_X("Archive \"%s\" mounted on \"%s\"", filename, mounted.mountPoint.data());
+	mountedArchives().pushBack(nctl::move(mounted));
+
+	return true;
+}
+
+bool AssetArchive::unmount(const char *filename)
+{
+	ASSERT(filename);
+
+	nctl::Array<MountedArchive> &archives = mountedArchives();
+	for (unsigned int i = 0; i < archives.size(); i++)
+	{
+		if (archives[i].archive->filename_ == filename)
+		{
+			archives.removeAt(i);
+			LOGI_X("Archive \"%s\" unmounted", filename);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void AssetArchive::unmountAll()
+{
+	mountedArchives().clear();
+}
+
+unsigned int AssetArchive::numMounted()
+{
+	return mountedArchives().size();
+}
+
+const AssetArchive *AssetArchive::findMounted(const char *path, int &entryIndex)
+{
+	entryIndex = -1;
+	const nctl::Array<MountedArchive> &archives = mountedArchives();
+	if (path == nullptr || archives.isEmpty())
+		return nullptr;
+
+	char entryName[AssetArchiveFormat::MaxNameLength];
+	for (int i = archives.size() - 1; i >= 0; i--)
+	{
+		const unsigned int length = pathToEntryName(path, archives[i].mountPoint, entryName);
+		if (length == 0)
+			continue;
+
+		entryIndex = archives[i].archive->findEntry(entryName);
+		if (entryIndex >= 0)
+			return archives[i].archive.get();
+	}
+
+	return nullptr;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool AssetArchive::readIndex()
+{
+	const unsigned long int archiveSize = fileHandle_->size();
+
+	AssetArchiveFormat::Header header;
+	if (archiveSize < sizeof(AssetArchiveFormat::Header) || readRange(&header, 0, sizeof(AssetArchiveFormat::Header)) == false)
+	{
+		LOGE_X("The archive \"%s\" is too small", filename_.data());
+		return false;
+	}
+
+	if (memcmp(header.signature, AssetArchiveFormat::Signature, sizeof(AssetArchiveFormat::Signature)) != 0)
+	{
+		LOGE_X("The file \"%s\" is not an asset archive", filename_.data());
+		return false;
+	}
+
+	const uint32_t version = IFile::int32FromLE(header.version);
+	if (version != AssetArchiveFormat::Version)
+	{
+		LOGE_X("The archive \"%s\" has version %u instead of %u", filename_.data(), version, AssetArchiveFormat::Version);
+		return false;
+	}
+
+	numEntries_ = IFile::int32FromLE(header.numEntries);
+	const uint64_t indexOffset = IFile::int64FromLE(header.indexOffset);
+	const uint64_t namesOffset = IFile::int64FromLE(header.namesOffset);
+	const uint32_t namesSize = IFile::int32FromLE(header.namesSize);
+	const uint64_t indexSize = uint64_t(numEntries_) * sizeof(AssetArchiveFormat::Entry);
+
+	if (indexOffset + indexSize > archiveSize || namesOffset + namesSize > archiveSize)
+	{
+		LOGE_X("The index of the archive \"%s\" is out of bounds", filename_.data());
+		return false;
+	}
+
+	entries_ = nctl::makeUnique<AssetArchiveFormat::Entry[]>(numEntries_);
+	names_ = nctl::makeUnique<char[]>(namesSize + 1);
+	if (readRange(entries_.get(), static_cast<unsigned long int>(indexOffset), static_cast<unsigned long int>(indexSize)) == false ||
+	    readRange(names_.get(), static_cast<unsigned long int>(namesOffset), namesSize) == false)
+	{
+		LOGE_X("Cannot read the index of the archive \"%s\"", filename_.data());
+		return false;
+	}
+	names_[namesSize] = '\0';
+
+	for (unsigned int i = 0; i < numEntries_; i++)
+	{
+		AssetArchiveFormat::Entry &entry = entries_[i];
+		entry.hash = IFile::int64FromLE(entry.hash);
+		entry.offset = IFile::int64FromLE(entry.offset);
+		entry.size = IFile::int32FromLE(entry.size);
+		entry.storedSize = IFile::int32FromLE(entry.storedSize);
+		entry.nameOffset = IFile::int32FromLE(entry.nameOffset);
+		entry.nameLength = IFile::int16FromLE(entry.nameLength);
+
+		const bool validName = (uint64_t(entry.nameOffset) + entry.nameLength < namesSize && names_[entry.nameOffset + entry.nameLength] == '\0');
+		const bool validData = (entry.offset + entry.storedSize <= archiveSize);
+		const bool validCompression = (entry.compression == AssetArchiveFormat::Compression::NONE && entry.storedSize == entry.size) ||
+		                              entry.compression == AssetArchiveFormat::Compression::LZ4;
+		const bool sorted = (i == 0 || entries_[i - 1].hash <= entry.hash);
+		if (validName == false || validData == false || validCompression == false || sorted == false)
+		{
+			LOGE_X("The entry %u of the archive \"%s\" is not valid", i, filename_.data());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool AssetArchive::readRange(void *buffer, unsigned long int offset, unsigned long int size) const
+{
+	if (size == 0)
+		return true;
+
+	if (mappedPtr_)
+	{
+		memcpy(buffer, mappedPtr_ + offset, size);
+		return true;
+	}
+
+	if (fileHandle_->seek(static_cast<long int>(offset), SEEK_SET) < 0)
+		return false;
+	return (fileHandle_->read(buffer, size) == size);
+}
+
+}
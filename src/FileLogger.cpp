@@ -6,6 +6,8 @@
 #endif
 
 #include <ctime>
+#include <cstring> // for memcpy()
+#include <csignal>
 #include "FileLogger.h"
 #include "common_macros.h"
 #include <nctl/algorithms.h>
@@ -13,6 +15,15 @@
 #include "Application.h"
 #include "tracy.h"
 
+#ifdef WITH_THREADS
+	#include <cerrno>
+	#ifdef _WIN32
+		#include <io.h> // for `_dup()`, `_write()` and `_close()`
+	#else
+		#include <unistd.h> // for `dup()`, `write()` and `close()`
+	#endif
+#endif
+
 namespace {
 
 const char *Reset = "\033[0m";
@@ -24,6 +35,65 @@ const char *BrightGreen = "\033[92m";
 const char *BrightYellow = "\033[93m";
 const char *BrightRedBg = "\033[101m";
 
+#ifdef WITH_THREADS
+const int CrashSignals[] = {
+	SIGABRT, SIGSEGV, SIGFPE, SIGILL,
+	#ifdef SIGTRAP
+	SIGTRAP,
+	#endif
+	#ifdef SIGBUS
+	SIGBUS,
+	#endif
+};
+const unsigned int NumCrashSignals = sizeof(CrashSignals) / sizeof(CrashSignals[0]);
+
+	#ifdef _WIN32
+using SignalHandler = void (*)(int);
+SignalHandler previousHandlers[NumCrashSignals];
+	#else
+struct sigaction previousActions[NumCrashSignals];
+	#endif
+ncine::FileLogger *crashLogger = nullptr;
+
+int duplicateDescriptor(FILE *fp)
+{
+	#ifdef _WIN32
+	return _dup(_fileno(fp));
+	#else
+	return dup(fileno(fp));
+	#endif
+}
+
+void closeDescriptor(int fd)
+{
+	#ifdef _WIN32
+	_close(fd);
+	#else
+	close(fd);
+	#endif
+}
+
+/// Writes a buffer with async-signal-safe calls only, retrying after partial writes
+void writeToDescriptor(int fd, const char *buffer, unsigned int length)
+{
+	while (length > 0)
+	{
+	#ifdef _WIN32
+		const int written = _write(fd, buffer, length);
+	#else
+		const ssize_t written = write(fd, buffer, length);
+		if (written < 0 && errno == EINTR)
+			continue;
+	#endif
+		if (written <= 0)
+			return;
+
+		buffer += written;
+		length -= static_cast<unsigned int>(written);
+	}
+}
+#endif
+
 }
 
 namespace ncine {
@@ -50,6 +120,10 @@ FileLogger::FileLogger(LogLevel consoleLevel, LogLevel fileLevel, const char *fi
       ,
       logString_(LogStringCapacity)
 #endif
+#ifdef WITH_THREADS
+      ,
+      queue_(QueueCapacity), crashFd_(-1)
+#endif
 {
 	// The setter will create the console on Windows, if needed
 	setConsoleLevel(consoleLevel);
@@ -63,6 +137,13 @@ FileLogger::FileLogger(LogLevel consoleLevel, LogLevel fileLevel, const char *fi
 FileLogger::~FileLogger()
 {
 	write(LogLevel::VERBOSE, "FileLogger::~FileLogger -> End of the log");
+#ifdef WITH_THREADS
+	setCrashHandlersEnabled(false);
+	// Every queued entry is written before the file is closed
+	stopWriterThread();
+	if (crashFd_ >= 0)
+		closeDescriptor(crashFd_);
+#endif
 
 	// The setter will destroy the console on Windows, if needed
 	setConsoleLevel(LogLevel::OFF);
@@ -103,8 +184,20 @@ bool FileLogger::openLogFile(const char *filename)
 	if (fileLevel_ == LogLevel::OFF || filename == nullptr)
 		return false;
 
+#ifdef WITH_THREADS
+	// Entries queued for the previous file are written to it before it is closed
+	fileMutex_.lock();
+	drainEntries();
+#endif
 	fileHandle_ = IFile::createFileHandle(filename);
 	fileHandle_->open(IFile::OpenMode::WRITE);
+#ifdef WITH_THREADS
+	// The descriptor is duplicated in advance, as opening it is not safe from a signal handler
+	if (crashFd_ >= 0)
+		closeDescriptor(crashFd_);
+	crashFd_ = fileHandle_->isOpened() ? duplicateDescriptor(fileHandle_->ptr()) : -1;
+	fileMutex_.unlock();
+#endif
 
 	if (fileHandle_->isOpened() == false)
 	{
@@ -120,6 +213,9 @@ bool FileLogger::openLogFile(const char *filename)
 		return false;
 	}
 
+#ifdef WITH_THREADS
+	startWriterThread();
+#endif
 	return true;
 }
 
@@ -136,38 +232,46 @@ unsigned int FileLogger::write(LogLevel level, const char *fmt, ...)
 	const int fileLevelInt = static_cast<int>(fileLevel_);
 
 	time_t now;
-	struct tm *ts;
+	struct tm ts;
 	now = time(nullptr);
-	ts = localtime(&now);
+#ifdef _WIN32
+	localtime_s(&ts, &now);
+#else
+	localtime_r(&now, &ts);
+#endif
 
-	logEntry_[0] = '\0';
-	logEntry_[MaxEntryLength - 1] = '\0';
+	// Entries are formatted on the stack of the calling thread
+	char logEntry[MaxEntryLength];
+	char logEntryWithColors[MaxEntryLength];
+
+	logEntry[0] = '\0';
+	logEntry[MaxEntryLength - 1] = '\0';
 	unsigned int length = 0;
 
 	const unsigned int timeMsgStart = length;
-	const unsigned int timeMsgLength = strftime(logEntry_ + length, MaxEntryLength - length - 1, "- %H:%M:%S ", ts);
+	const unsigned int timeMsgLength = strftime(logEntry + length, MaxEntryLength - length - 1, "- %H:%M:%S ", &ts);
 	length += timeMsgLength;
 
-	length += snprintf(logEntry_ + length, MaxEntryLength - length - 1, "[L%d] - ", levelInt);
+	length += snprintf(logEntry + length, MaxEntryLength - length - 1, "[L%d] - ", levelInt);
 
 	const unsigned int logMsgStart = length;
 	va_list args;
 	va_start(args, fmt);
-	const unsigned int logMsgLength = vsnprintf(logEntry_ + length, MaxEntryLength - length - 1, fmt, args);
+	const unsigned int logMsgLength = vsnprintf(logEntry + length, MaxEntryLength - length - 1, fmt, args);
 	va_end(args);
 	length += logMsgLength;
 
 	if (length < MaxEntryLength - 2)
 	{
-		logEntry_[length++] = '\n';
-		logEntry_[length] = '\0';
+		logEntry[length++] = '\n';
+		logEntry[length] = '\0';
 	}
 
-	const char *consoleLogEntry = logEntry_;
+	const char *consoleLogEntry = logEntry;
 	if (canUseColors_)
 	{
-		writeWithColors(level, logEntry_ + timeMsgStart, timeMsgLength, logEntry_ + logMsgStart, logMsgLength);
-		consoleLogEntry = logEntryWithColors_;
+		writeWithColors(level, logEntry + timeMsgStart, timeMsgLength, logEntry + logMsgStart, logMsgLength, logEntryWithColors);
+		consoleLogEntry = logEntryWithColors;
 	}
 
 	if (consoleLevel_ != LogLevel::OFF && levelInt >= consoleLevelInt)
@@ -179,7 +283,7 @@ unsigned int FileLogger::write(LogLevel level, const char *fmt, ...)
 			fputs(consoleLogEntry, stdout);
 
 	#ifdef _WIN32
-		writeOutputDebug(logEntry_);
+		writeOutputDebug(logEntry);
 	#endif
 
 #else
@@ -199,24 +303,26 @@ unsigned int FileLogger::write(LogLevel level, const char *fmt, ...)
 		}
 		// clang-format on
 
-		__android_log_write(priority, "nCine", logEntry_);
+		__android_log_write(priority, "nCine", logEntry);
 #endif
 	}
 
-	if (fileLevel_ != LogLevel::OFF && levelInt >= fileLevelInt &&
-	    fileHandle_ != nullptr && fileHandle_->isOpened())
-	{
-		fprintf(fileHandle_->ptr(), "%s", logEntry_);
-		fflush(fileHandle_->ptr());
-	}
+	if (fileLevel_ != LogLevel::OFF && levelInt >= fileLevelInt)
+		writeToFile(level, logEntry, nctl::min(length, MaxEntryLength - 1));
 
 #ifdef WITH_IMGUI
 	if (levelInt >= consoleLevelInt || levelInt >= fileLevelInt)
 	{
+	#ifdef WITH_THREADS
+		logStringMutex_.lock();
+	#endif
 		if (length > logString_.capacity() - logString_.length() - 1)
 			logString_.clear();
 
-		logString_.append(logEntry_);
+		logString_.append(logEntry);
+	#ifdef WITH_THREADS
+		logStringMutex_.unlock();
+	#endif
 	}
 #endif
 
@@ -238,31 +344,89 @@ unsigned int FileLogger::write(LogLevel level, const char *fmt, ...)
 		}
 		// clang-format on
 
-		TracyMessageC(logEntry_, length, color);
+		TracyMessageC(logEntry, length, color);
 	}
 #endif
 
 	return length;
 }
 
+void FileLogger::flush()
+{
+#ifdef WITH_THREADS
+	// The calling thread does not depend on the writer thread being scheduled
+	fileMutex_.lock();
+	drainEntries();
+	fileMutex_.unlock();
+#else
+	if (fileHandle_ != nullptr && fileHandle_->isOpened())
+		fflush(fileHandle_->ptr());
+#endif
+}
+
+unsigned int FileLogger::numDroppedEntries()
+{
+#ifdef WITH_THREADS
+	return static_cast<unsigned int>(totalDropped_.load(nctl::Atomic32::MemoryModel::RELAXED));
+#else
+	return 0;
+#endif
+}
+
+void FileLogger::setCrashHandlersEnabled(bool enabled)
+{
+#ifdef WITH_THREADS
+	if (enabled && crashLogger == nullptr)
+	{
+		crashLogger = this;
+		for (unsigned int i = 0; i < NumCrashSignals; i++)
+		{
+	#ifdef _WIN32
+			previousHandlers[i] = signal(CrashSignals[i], crashSignalHandler);
+	#else
+			struct sigaction action;
+			memset(&action, 0, sizeof(action));
+			action.sa_sigaction = crashSignalHandler;
+			action.sa_flags = SA_SIGINFO;
+			sigemptyset(&action.sa_mask);
+			sigaction(CrashSignals[i], &action, &previousActions[i]);
+	#endif
+		}
+	}
+	else if (enabled == false && crashLogger == this)
+	{
+		for (unsigned int i = 0; i < NumCrashSignals; i++)
+		{
+	#ifdef _WIN32
+			if (previousHandlers[i] != SIG_ERR)
+				signal(CrashSignals[i], previousHandlers[i]);
+	#else
+			sigaction(CrashSignals[i], &previousActions[i], nullptr);
+	#endif
+		}
+		crashLogger = nullptr;
+	}
+#endif
+}
+
 ///////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
 
-unsigned int FileLogger::writeWithColors(LogLevel level, const char *timeMsg, unsigned int timeMsgLength, const char *logMsg, unsigned int logMsgLength)
+unsigned int FileLogger::writeWithColors(LogLevel level, const char *timeMsg, unsigned int timeMsgLength, const char *logMsg, unsigned int logMsgLength, char *logEntryWithColors)
 {
 	const int levelInt = static_cast<int>(level);
 
-	logEntryWithColors_[0] = '\0';
-	logEntryWithColors_[MaxEntryLength - 1] = '\0';
+	logEntryWithColors[0] = '\0';
+	logEntryWithColors[MaxEntryLength - 1] = '\0';
 	unsigned int length = 0;
 
-	length += snprintf(logEntryWithColors_ + length, MaxEntryLength - length - 1, "%s", Faint);
+	length += snprintf(logEntryWithColors + length, MaxEntryLength - length - 1, "%s", Faint);
 
-	nctl::strncpy(logEntryWithColors_ + length, timeMsg, timeMsgLength);
+	nctl::strncpy(logEntryWithColors + length, timeMsg, timeMsgLength);
 	length += timeMsgLength;
 
-	length += snprintf(logEntryWithColors_ + length, MaxEntryLength - length - 1, " %s", Reset);
+	length += snprintf(logEntryWithColors + length, MaxEntryLength - length - 1, " %s", Reset);
 
 	const char *levelColor = BrightGreen;
 	switch (level)
@@ -283,36 +447,254 @@ unsigned int FileLogger::writeWithColors(LogLevel level, const char *timeMsg, un
 	}
 
 	if (level == LogLevel::FATAL)
-		length += snprintf(logEntryWithColors_ + length, MaxEntryLength - length - 1, "%s", BrightRedBg);
+		length += snprintf(logEntryWithColors + length, MaxEntryLength - length - 1, "%s", BrightRedBg);
 
-	length += snprintf(logEntryWithColors_ + length, MaxEntryLength - length - 1, "%s[L%d]%s", levelColor, levelInt, Reset);
-	length += snprintf(logEntryWithColors_ + length, MaxEntryLength - length - 1, " %s- ", Faint);
+	length += snprintf(logEntryWithColors + length, MaxEntryLength - length - 1, "%s[L%d]%s", levelColor, levelInt, Reset);
+	length += snprintf(logEntryWithColors + length, MaxEntryLength - length - 1, " %s- ", Faint);
 
 	unsigned int logMsgFuncLength = 0;
 	while (logMsg[logMsgFuncLength] != '>' && logMsg[logMsgFuncLength] != '\0')
 		logMsgFuncLength++;
 	logMsgFuncLength++; // skip '>' character
 
-	nctl::strncpy(logEntryWithColors_ + length, logMsg, nctl::min(logMsgFuncLength, MaxEntryLength - length - 1));
+	nctl::strncpy(logEntryWithColors + length, logMsg, nctl::min(logMsgFuncLength, MaxEntryLength - length - 1));
 	length += logMsgFuncLength;
 
-	length += snprintf(logEntryWithColors_ + length, MaxEntryLength - length - 1, "%s", Reset);
+	length += snprintf(logEntryWithColors + length, MaxEntryLength - length - 1, "%s", Reset);
 
 	if (level == LogLevel::WARN || level == LogLevel::ERROR || level == LogLevel::FATAL)
-		length += snprintf(logEntryWithColors_ + length, MaxEntryLength - length - 1, "%s", Bold);
+		length += snprintf(logEntryWithColors + length, MaxEntryLength - length - 1, "%s", Bold);
 
-	nctl::strncpy(logEntryWithColors_ + length, logMsg + logMsgFuncLength, nctl::min(logMsgLength - logMsgFuncLength, MaxEntryLength - length - 1));
+	nctl::strncpy(logEntryWithColors + length, logMsg + logMsgFuncLength, nctl::min(logMsgLength - logMsgFuncLength, MaxEntryLength - length - 1));
 	length += logMsgLength - logMsgFuncLength;
 
 	if (level == LogLevel::WARN || level == LogLevel::ERROR || level == LogLevel::FATAL)
-		length += snprintf(logEntryWithColors_ + length, MaxEntryLength - length - 1, "%s", Reset);
+		length += snprintf(logEntryWithColors + length, MaxEntryLength - length - 1, "%s", Reset);
 
 	if (length < MaxEntryLength - 2)
 	{
-		logEntryWithColors_[length++] = '\n';
-		logEntryWithColors_[length] = '\0';
+		logEntryWithColors[length++] = '\n';
+		logEntryWithColors[length] = '\0';
 	}
 
 	return length;
 }
+
+void FileLogger::writeToFile(LogLevel level, const char *logEntry, unsigned int length)
+{
+#ifdef WITH_THREADS
+	if (writerRunning_.load(nctl::Atomic32::MemoryModel::ACQUIRE))
+	{
+		if (enqueueEntry(logEntry, length) == false)
+		{
+			// Errors are never dropped, the calling thread frees slots by writing the queued entries itself
+			if (level == LogLevel::ERROR || level == LogLevel::FATAL)
+			{
+				while (enqueueEntry(logEntry, length) == false)
+					flush();
+			}
+			else
+			{
+				numDropped_.fetchAdd(1, nctl::Atomic32::MemoryModel::RELAXED);
+				totalDropped_.fetchAdd(1, nctl::Atomic32::MemoryModel::RELAXED);
+			}
+		}
+
+		// The application is going to terminate after a fatal error.
+		// The writer thread might also have been stopped after the flag was checked, leaving the entry in the queue.
+		if (level == LogLevel::FATAL || writerRunning_.load() == 0)
+			flush();
+		return;
+	}
+
+	fileMutex_.lock();
+	// Entries queued before the writer thread has been stopped come first
+	drainEntries();
+#endif
+
+	if (fileHandle_ != nullptr && fileHandle_->isOpened())
+	{
+		fwrite(logEntry, 1, length, fileHandle_->ptr());
+		fflush(fileHandle_->ptr());
+	}
+#ifdef WITH_THREADS
+	fileMutex_.unlock();
+#endif
+}
+
+#ifdef WITH_THREADS
+FileLogger::QueuedEntry::QueuedEntry(const char *logEntry, unsigned int entryLength)
+    : length(entryLength)
+{
+	memcpy(entry, logEntry, entryLength);
+}
+
+bool FileLogger::enqueueEntry(const char *logEntry, unsigned int length)
+{
+	if (queue_.emplace(logEntry, length) == false)
+		return false; // the writer thread has not freed a slot yet
+
+	// The writer thread is only woken up when it has gone to sleep
+	numPending_.fetchAdd(1);
+	if (writerSleeping_.load())
+	{
+		writerMutex_.lock();
+		writerCV_.signal();
+		writerMutex_.unlock();
+	}
+
+	return true;
+}
+
+void FileLogger::drainEntries()
+{
+	// Entries are discarded if the log file could not be opened
+	FILE *fp = (fileHandle_ != nullptr && fileHandle_->isOpened()) ? fileHandle_->ptr() : nullptr;
+
+	QueuedEntry queuedEntry;
+	int32_t numWritten = 0;
+	while (queue_.pop(queuedEntry))
+	{
+		if (fp)
+			fwrite(queuedEntry.entry, 1, queuedEntry.length, fp);
+		numWritten++;
+	}
+
+	const int32_t numDropped = numDropped_.load(nctl::Atomic32::MemoryModel::RELAXED);
+	if (numDropped > 0)
+	{
+		numDropped_.fetchSub(numDropped, nctl::Atomic32::MemoryModel::RELAXED);
+		if (fp)
+			fprintf(fp, "- %d log entries have been dropped, the queue was full\n", numDropped);
+	}
+
+	// A single flush for the whole batch
+	if (numWritten > 0 || numDropped > 0)
+	{
+		if (fp)
+			fflush(fp);
+		numPending_.fetchSub(numWritten);
+	}
+}
+
+/*! The queue can have more than one consumer, so entries are popped without waiting for the file mutex
+ *  that the crashing thread might be holding. Entries already passed to `fwrite()` are written by `stdio`, if ever. */
+void FileLogger::drainEntriesOnCrash()
+{
+	const int fd = crashFd_;
+	if (fd < 0)
+		return;
+
+	QueuedEntry queuedEntry;
+	while (queue_.pop(queuedEntry))
+		writeToDescriptor(fd, queuedEntry.entry, queuedEntry.length);
+}
+
+void FileLogger::startWriterThread()
+{
+	// Reopening the log file keeps the same writer thread
+	if (writerRunning_.load())
+		return;
+
+	writerSleeping_.store(0);
+	writerShouldQuit_.store(0);
+	writerThread_.run(writerFunction, this);
+#if !defined(__EMSCRIPTEN__) && !defined(__APPLE__)
+	writerThread_.setName("LogWriter");
+#endif
+	writerRunning_.store(1, nctl::Atomic32::MemoryModel::RELEASE);
+}
+
+void FileLogger::stopWriterThread()
+{
+	if (writerRunning_.load() == 0)
+		return;
+
+	// From now on producers write directly to the file, or drain the queue themselves if they have just enqueued
+	writerRunning_.store(0);
+	writerMutex_.lock();
+	writerShouldQuit_.store(1);
+	writerCV_.signal();
+	writerMutex_.unlock();
+	writerThread_.join();
+
+	// Draining again after the join collects the entries queued after the last drain of the thread
+	flush();
+}
+
+void FileLogger::writerFunction(void *arg)
+{
+	FileLogger *logger = static_cast<FileLogger *>(arg);
+
+	bool shouldQuit = false;
+	while (shouldQuit == false)
+	{
+		logger->flush();
+
+		logger->writerMutex_.lock();
+		while (logger->numPending_.load() == 0 && logger->writerShouldQuit_.load() == 0)
+		{
+			// Producers check the flag after publishing an entry, so a wake-up cannot be missed
+			logger->writerSleeping_.store(1);
+			if (logger->numPending_.load() == 0 && logger->writerShouldQuit_.load() == 0)
+				logger->writerCV_.wait(logger->writerMutex_);
+			logger->writerSleeping_.store(0);
+		}
+		shouldQuit = (logger->writerShouldQuit_.load() != 0);
+		logger->writerMutex_.unlock();
+	}
+
+	logger->flush();
+}
+
+/*! Only async-signal-safe functions are called, then the handler that was set before the installation is invoked.
+ *  If there was none, the default one is restored and the signal is raised again to terminate the application. */
+#ifdef _WIN32
+void FileLogger::crashSignalHandler(int signum)
+#else
+void FileLogger::crashSignalHandler(int signum, siginfo_t *info, void *context)
+#endif
+{
+	FileLogger *logger = crashLogger;
+	if (logger != nullptr)
+		logger->drainEntriesOnCrash();
+
+	for (unsigned int i = 0; i < NumCrashSignals; i++)
+	{
+		if (CrashSignals[i] != signum)
+			continue;
+
+	#ifdef _WIN32
+		const SignalHandler previousHandler = previousHandlers[i];
+		if (previousHandler != SIG_ERR && previousHandler != SIG_DFL && previousHandler != SIG_IGN)
+		{
+			previousHandler(signum);
+			return;
+		}
+		signal(signum, SIG_DFL);
+	#else
+		const struct sigaction &previousAction = previousActions[i];
+		if (previousAction.sa_flags & SA_SIGINFO)
+		{
+			previousAction.sa_sigaction(signum, info, context);
+			return;
+		}
+		else if (previousAction.sa_handler != SIG_DFL && previousAction.sa_handler != SIG_IGN)
+		{
+			previousAction.sa_handler(signum);
+			return;
+		}
+
+		struct sigaction defaultAction;
+		memset(&defaultAction, 0, sizeof(defaultAction));
+		defaultAction.sa_handler = SIG_DFL;
+		sigemptyset(&defaultAction.sa_mask);
+		sigaction(signum, &defaultAction, nullptr);
+	#endif
+		break;
+	}
+	raise(signum);
+}
+#endif
+
 }
@@ -1,4 +1,5 @@
 #include "FileSystem.h"
+#include "AssetArchive.h"
 #include <nctl/CString.h>
 
 #ifdef _WIN32
@@ -520,6 +521,10 @@ bool FileSystem::isFile(const char *path)
 	if (path == nullptr)
 		return false;
 
+	int entryIndex = -1;
+	if (AssetArchive::findMounted(path, entryIndex))
+		return true;
+
 #ifdef _WIN32
 	const DWORD attrs = GetFileAttributesA(path);
 	return (attrs != INVALID_FILE_ATTRIBUTES && (attrs & FILE_ATTRIBUTE_DIRECTORY) == 0);
@@ -542,6 +547,10 @@ bool FileSystem::exists(const char *path)
 	if (path == nullptr)
 		return false;
 
+	int entryIndex = -1;
+	if (AssetArchive::findMounted(path, entryIndex))
+		return true;
+
 #ifdef _WIN32
 	const DWORD attrs = GetFileAttributesA(path);
 	return !(attrs == INVALID_FILE_ATTRIBUTES && GetLastError() == ERROR_FILE_NOT_FOUND);
@@ -562,6 +571,10 @@ bool FileSystem::isReadable(const char *path)
 	if (path == nullptr)
 		return false;
 
+	int entryIndex = -1;
+	if (AssetArchive::findMounted(path, entryIndex))
+		return true;
+
 #ifdef _WIN32
 	// Assuming that every file that exists is also readable
 	const DWORD attrs = GetFileAttributesA(path);
@@ -634,6 +647,10 @@ bool FileSystem::isReadableFile(const char *path)
 	if (path == nullptr)
 		return false;
 
+	int entryIndex = -1;
+	if (AssetArchive::findMounted(path, entryIndex))
+		return true;
+
 #ifdef _WIN32
 	const DWORD attrs = GetFileAttributesA(path);
 	return (attrs != INVALID_FILE_ATTRIBUTES && (attrs & FILE_ATTRIBUTE_DIRECTORY) == 0);
@@ -891,6 +908,11 @@ long int FileSystem::fileSize(const char *path)
 	if (path == nullptr)
 		return -1;
 
+	int entryIndex = -1;
+	const AssetArchive *archive = AssetArchive::findMounted(path, entryIndex);
+	if (archive)
+		return static_cast<long int>(archive->entrySize(entryIndex));
+
 #ifdef _WIN32
 	HANDLE hFile = CreateFile(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
 	LARGE_INTEGER fileSize;
@@ -916,6 +938,13 @@ long int FileSystem::fileSize(const char *path)
 FileSystem::FileDate FileSystem::lastModificationTime(const char *path)
 {
 	FileDate date = {};
+
+	// Archived files share the modification time of their archive
+	int entryIndex = -1;
+	const AssetArchive *archive = AssetArchive::findMounted(path, entryIndex);
+	if (archive)
+		return lastModificationTime(archive->filename());
+
 #ifdef _WIN32
 	HANDLE hFile = CreateFile(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
 	FILETIME fileTime;
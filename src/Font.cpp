@@ -24,6 +24,7 @@ Font::Font()
       glyphArray_(nctl::makeUnique<FontGlyph[]>(GlyphArraySize)),
       glyphHashMap_(GlyphHashmapSize), renderMode_(RenderMode::GLYPH_IN_RED)
 {
+	glyphHashMap_.setMaxLoadFactor(0.8f);
 }
 
 /*! \note The specified texture will override the one in the FNT file */
@@ -376,8 +377,7 @@ void Font::retrieveInfoFromFnt(const FntParser &fntParser)
 	width_ = static_cast<unsigned int>(commonTag.scaleW);
 	height_ = static_cast<unsigned int>(commonTag.scaleH);
 
-	const unsigned int numChars = (fntParser.numCharTags() < GlyphArraySize + GlyphHashmapSize) ? fntParser.numCharTags() : GlyphArraySize + GlyphHashmapSize;
-	for (unsigned int i = 0; i < numChars; i++)
+	for (unsigned int i = 0; i < fntParser.numCharTags(); i++)
 	{
 		const FntParser::CharTag &charTag = fntParser.charTag(i);
 		if (charTag.id < static_cast<int>(GlyphArraySize))
@@ -2,6 +2,8 @@
 #include "IFile.h"
 #include "MemoryFile.h"
 #include "StandardFile.h"
+#include "MappedFile.h"
+#include "AssetArchive.h"
 
 #ifdef __ANDROID__
 	#include <cstring>
@@ -66,6 +68,12 @@ nctl::UniquePtr<IFile> IFile::createFromMemory(const unsigned char *bufferPtr, u
 nctl::UniquePtr<IFile> IFile::createFileHandle(const char *filename)
 {
 	ASSERT(filename);
+
+	int entryIndex = -1;
+	const AssetArchive *archive = AssetArchive::findMounted(filename, entryIndex);
+	if (archive)
+		return archive->openEntry(entryIndex, filename);
+
 #ifdef __ANDROID__
 	const char *assetFilename = AssetFile::assetPath(filename);
 	if (assetFilename)
@@ -75,4 +83,22 @@ nctl::UniquePtr<IFile> IFile::createFileHandle(const char *filename)
 		return nctl::makeUnique<StandardFile>(filename);
 }
 
+nctl::UniquePtr<IFile> IFile::createMappedFileHandle(const char *filename)
+{
+	ASSERT(filename);
+
+	int entryIndex = -1;
+	const AssetArchive *archive = AssetArchive::findMounted(filename, entryIndex);
+	if (archive)
+		return archive->openEntry(entryIndex, filename);
+
+#ifdef __ANDROID__
+	const char *assetFilename = AssetFile::assetPath(filename);
+	if (assetFilename)
+		return nctl::makeUnique<AssetFile>(assetFilename);
+	else
+#endif
+		return nctl::makeUnique<MappedFile>(filename);
+}
+
 }
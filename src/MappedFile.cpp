@@ -0,0 +1,210 @@
+#if defined(_WIN32)
+	#include "common_windefines.h"
+	#include <windef.h>
+	#include <winbase.h>
+#else
+	#include <sys/mman.h> // for mmap()
+	#include <sys/stat.h> // for fstat()
+	#include <fcntl.h> // for open()
+	#include <unistd.h> // for close()
+#endif
+
+#include <cstring> // for memcpy()
+#include "common_macros.h"
+#include "MappedFile.h"
+
+namespace ncine {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+MappedFile::MappedFile(const char *filename)
+    : IFile(filename), mappedPtr_(nullptr), isOpened_(false), seekOffset_(0)
+#if defined(_WIN32)
+      ,
+      fileHandle_(INVALID_HANDLE_VALUE), mappingHandle_(nullptr)
+#endif
+{
+	type_ = FileType::MAPPED;
+}
+
+MappedFile::~MappedFile()
+{
+	if (shouldCloseOnDestruction_)
+		close();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void MappedFile::open(unsigned char mode)
+{
+	// Checking if the file is already opened
+	if (isOpened_)
+	{
+		LOGW_X("File \"%s\" is already opened", filename_.data());
+		return;
+	}
+
+	if ((mode & OpenMode::WRITE) || (mode & OpenMode::READ) == 0)
+	{
+		LOGE_X("Cannot open the file \"%s\", mapped files can only be opened for reading", filename_.data());
+		return;
+	}
+
+#if defined(_WIN32)
+	fileHandle_ = CreateFileA(filename_.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle_ == INVALID_HANDLE_VALUE)
+	{
+		LOGE_X("Cannot open the file \"%s\"", filename_.data());
+		return;
+	}
+
+	LARGE_INTEGER fileSize;
+	GetFileSizeEx(fileHandle_, &fileSize);
+	fileSize_ = static_cast<unsigned long int>(fileSize.QuadPart);
+
+	// Empty files cannot be mapped but can still be opened
+	isOpened_ = true;
+	if (fileSize_ > 0)
+	{
+		mappingHandle_ = CreateFileMappingA(fileHandle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mappingHandle_ != nullptr)
+			mappedPtr_ = static_cast<const unsigned char *>(MapViewOfFile(mappingHandle_, FILE_MAP_READ, 0, 0, 0));
+		isOpened_ = (mappedPtr_ != nullptr);
+	}
+
+	if (isOpened_ == false)
+	{
+		LOGE_X("Cannot map the file \"%s\"", filename_.data());
+		close();
+		return;
+	}
+#else
+	const int fd = ::open(filename_.data(), O_RDONLY);
+	if (fd < 0)
+	{
+		LOGE_X("Cannot open the file \"%s\"", filename_.data());
+		return;
+	}
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) == 0)
+	{
+		fileSize_ = static_cast<unsigned long int>(fileStat.st_size);
+		// Empty files cannot be mapped but can still be opened
+		isOpened_ = true;
+		if (fileSize_ > 0)
+		{
+			void *mappedPtr = mmap(nullptr, fileSize_, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mappedPtr != MAP_FAILED)
+				mappedPtr_ = static_cast<const unsigned char *>(mappedPtr);
+			isOpened_ = (mappedPtr_ != nullptr);
+		}
+	}
+	// The mapping stays valid after closing the file descriptor
+	::close(fd);
+
+	if (isOpened_ == false)
+	{
+		LOGE_X("Cannot map the file \"%s\"", filename_.data());
+		fileSize_ = 0;
+		return;
+	}
+#endif
+
+	seekOffset_ = 0;
+	LOGI_X("File \"%s\" opened and mapped", filename_.data());
+}
+
+void MappedFile::close()
+{
+#if defined(_WIN32)
+	if (mappedPtr_)
+		UnmapViewOfFile(mappedPtr_);
+	if (mappingHandle_)
+		CloseHandle(mappingHandle_);
+	if (fileHandle_ != INVALID_HANDLE_VALUE)
+		CloseHandle(fileHandle_);
+	mappingHandle_ = nullptr;
+	fileHandle_ = INVALID_HANDLE_VALUE;
+#else
+	if (mappedPtr_)
+		munmap(const_cast<unsigned char *>(mappedPtr_), fileSize_);
+#endif
+
+	if (isOpened_)
+		LOGI_X("File \"%s\" unmapped and closed", filename_.data());
+	mappedPtr_ = nullptr;
+	isOpened_ = false;
+	seekOffset_ = 0;
+}
+
+long int MappedFile::seek(long int offset, int whence) const
+{
+	long int seekValue = -1;
+
+	if (isOpened_)
+	{
+		switch (whence)
+		{
+			case SEEK_SET:
+				seekValue = offset;
+				break;
+			case SEEK_CUR:
+				seekValue = seekOffset_ + offset;
+				break;
+			case SEEK_END:
+				seekValue = fileSize_ + offset;
+				break;
+		}
+	}
+
+	if (seekValue < 0 || seekValue > static_cast<long int>(fileSize_))
+		seekValue = -1;
+	else
+		seekOffset_ = seekValue;
+
+	return seekValue;
+}
+
+long int MappedFile::tell() const
+{
+	long int tellValue = -1;
+
+	if (isOpened_)
+		tellValue = seekOffset_;
+
+	return tellValue;
+}
+
+unsigned long int MappedFile::read(void *buffer, unsigned long int bytes) const
+{
+	ASSERT(buffer);
+
+	unsigned long int bytesRead = 0;
+
+	if (mappedPtr_)
+	{
+		bytesRead = (seekOffset_ + bytes > fileSize_) ? fileSize_ - seekOffset_ : bytes;
+		memcpy(buffer, mappedPtr_ + seekOffset_, bytesRead);
+		seekOffset_ += bytesRead;
+	}
+
+	return bytesRead;
+}
+
+unsigned long int MappedFile::write(const void *buffer, unsigned long int bytes)
+{
+	// Mapped files are read-only
+	return 0;
+}
+
+bool MappedFile::isOpened() const
+{
+	return isOpened_;
+}
+
+}
@@ -250,6 +250,7 @@ void AndroidApplication::preInit()
 	fileLogger.setConsoleLevel(appCfg_.consoleLogLevel);
 	fileLogger.setFileLevel(appCfg_.fileLogLevel);
 	fileLogger.openLogFile(logFilePath.data());
+	fileLogger.setCrashHandlersEnabled(appCfg_.withLogCrashHandlers);
 }
 
 void AndroidApplication::init()
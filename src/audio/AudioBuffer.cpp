@@ -30,15 +30,9 @@ namespace {
 ///////////////////////////////////////////////////////////
 
 AudioBuffer::AudioBuffer()
-    : Object(ObjectType::AUDIOBUFFER), bufferId_(0),
+    : Object(ObjectType::AUDIOBUFFER), bufferId_(0), cachedBuffer_(nullptr),
       bytesPerSample_(0), numChannels_(0), frequency_(0), numSamples_(0), duration_(0.0f)
 {
-	alGetError();
-	alGenBuffers(1, &bufferId_);
-	const ALenum error = alGetError();
-	FATAL_ASSERT_MSG_X(error == AL_NO_ERROR, "alGenBuffers failed: 0x%x", error);
-
-	ASSERT(alIsBuffer(bufferId_) == AL_TRUE);
 }
 
 AudioBuffer::AudioBuffer(const char *bufferName, const unsigned char *bufferPtr, unsigned long int bufferSize)
@@ -59,23 +53,27 @@ AudioBuffer::AudioBuffer(const char *filename)
 
 AudioBuffer::~AudioBuffer()
 {
-	// Moved out objects have their buffer id set to zero
-	alDeleteBuffers(1, &bufferId_);
+	releaseCachedBuffer();
+	deleteBufferId();
 }
 
 AudioBuffer::AudioBuffer(AudioBuffer &&other)
-    : Object(nctl::move(other)), bufferId_(other.bufferId_),
+    : Object(nctl::move(other)), bufferId_(other.bufferId_), cachedBuffer_(other.cachedBuffer_),
       bytesPerSample_(other.bytesPerSample_), numChannels_(other.numChannels_),
       frequency_(other.frequency_), numSamples_(other.numSamples_), duration_(other.duration_)
 {
 	other.bufferId_ = 0;
+	other.cachedBuffer_ = nullptr;
 }
 
 AudioBuffer &AudioBuffer::operator=(AudioBuffer &&other)
 {
 	Object::operator=(nctl::move(other));
 
+	releaseCachedBuffer();
+	deleteBufferId();
 	bufferId_ = other.bufferId_;
+	cachedBuffer_ = other.cachedBuffer_;
 	bytesPerSample_ = other.bytesPerSample_;
 	numChannels_ = other.numChannels_;
 	frequency_ = other.frequency_;
@@ -83,6 +81,7 @@ AudioBuffer &AudioBuffer::operator=(AudioBuffer &&other)
 	duration_ = other.duration_;
 
 	other.bufferId_ = 0;
+	other.cachedBuffer_ = nullptr;
 	return *this;
 }
 
@@ -163,6 +162,37 @@ bool AudioBuffer::loadFromFile(const char *filename)
 	return true;
 }
 
+bool AudioBuffer::loadFromCache(const char *filename, AudioBufferCache::Residency residency)
+{
+	ZoneScoped;
+	ZoneText(filename, nctl::strnlen(filename, nctl::String::MaxCStringLength));
+
+	CachedAudioBuffer *cachedBuffer = theAudioBufferCache().acquire(filename, residency);
+	if (cachedBuffer == nullptr)
+		return false;
+
+	// Releasing after acquiring, so that an entry is not evicted when reloading the same file
+	releaseCachedBuffer();
+	cachedBuffer_ = cachedBuffer;
+	// The samples are played from the shared OpenAL buffer
+	deleteBufferId();
+
+	bytesPerSample_ = cachedBuffer_->bytesPerSample;
+	numChannels_ = cachedBuffer_->numChannels;
+	frequency_ = cachedBuffer_->frequency;
+	numSamples_ = cachedBuffer_->numSamples;
+	duration_ = float(numSamples_) / frequency_;
+
+	setName(filename);
+	return true;
+}
+
+void AudioBuffer::requestSamples()
+{
+	if (cachedBuffer_)
+		theAudioBufferCache().touch(cachedBuffer_);
+}
+
 bool AudioBuffer::loadFromSamples(const unsigned char *bufferPtr, unsigned long int bufferSize)
 {
 	if (bytesPerSample_ == 0 || numChannels_ == 0 || frequency_ == 0)
@@ -171,6 +201,17 @@ bool AudioBuffer::loadFromSamples(const unsigned char *bufferPtr, unsigned long
 	if (bufferSize % (bytesPerSample_ * numChannels_) != 0)
 		LOGW("Buffer size is incompatible with format");
 	const ALenum format = alFormat(bytesPerSample_, numChannels_);
+	// Shared samples are never modified, the buffer uses its own OpenAL buffer from now on
+	releaseCachedBuffer();
+
+	if (bufferId_ == 0)
+	{
+		alGetError();
+		alGenBuffers(1, &bufferId_);
+		const ALenum error = alGetError();
+		FATAL_ASSERT_MSG_X(error == AL_NO_ERROR, "alGenBuffers failed: 0x%x", error);
+		ASSERT(alIsBuffer(bufferId_) == AL_TRUE);
+	}
 
 	alGetError();
 	// On iOS `alBufferDataStatic()` could be used instead
@@ -209,4 +250,22 @@ bool AudioBuffer::load(IAudioLoader &audioLoader)
 	return loadFromSamples(buffer.get(), bufferSize);
 }
 
+void AudioBuffer::releaseCachedBuffer()
+{
+	if (cachedBuffer_)
+	{
+		theAudioBufferCache().release(cachedBuffer_);
+		cachedBuffer_ = nullptr;
+	}
+}
+
+void AudioBuffer::deleteBufferId()
+{
+	if (bufferId_ != 0)
+	{
+		alDeleteBuffers(1, &bufferId_);
+		bufferId_ = 0;
+	}
+}
+
 }
@@ -0,0 +1,449 @@
+#define NCINE_INCLUDE_OPENAL
+#include "common_headers.h"
+#include "return_macros.h"
+#include <nctl/Array.h>
+#include <nctl/Atomic.h>
+#include <nctl/HashMapIterator.h>
+#include <nctl/algorithms.h>
+#include "AudioBufferCache.h"
+#include "IAudioLoader.h"
+#include "IThreadCommand.h"
+#include "Application.h"
+#include "tracy.h"
+
+namespace ncine {
+
+/// The data shared between a cache entry and the worker thread decoding its samples
+struct AudioDecodeJob
+{
+	AudioDecodeJob()
+	    : compressedSize(0), decodedSize(0), isDone(0) {}
+
+	nctl::String filename;
+	nctl::UniquePtr<unsigned char[]> compressedData;
+	unsigned long int compressedSize;
+	nctl::UniquePtr<unsigned char[]> decodedData;
+	unsigned long int decodedSize;
+	/// Set to one by the worker thread when decoding has finished
+	nctl::Atomic32 isDone;
+};
+
+namespace {
+
+	ALenum alFormat(int bytesPerSample, int numChannels)
+	{
+		ALenum format = AL_FORMAT_MONO8;
+		if (bytesPerSample == 1 && numChannels == 2)
+			format = AL_FORMAT_STEREO8;
+		else if (bytesPerSample == 2 && numChannels == 1)
+			format = AL_FORMAT_MONO16;
+		else if (bytesPerSample == 2 && numChannels == 2)
+			format = AL_FORMAT_STEREO16;
+
+		return format;
+	}
+
+	/// Decodes all samples of an audio loader in a newly allocated buffer, returns the number of bytes read
+	unsigned long int decodeSamples(IAudioLoader &audioLoader, nctl::UniquePtr<unsigned char[]> &decodedData)
+	{
+		const unsigned long int bufferSize = audioLoader.bufferSize();
+		decodedData = nctl::makeUnique<unsigned char[]>(bufferSize);
+
+		nctl::UniquePtr<IAudioReader> audioReader = audioLoader.createReader();
+		return audioReader->read(decodedData.get(), bufferSize);
+	}
+
+	/// Decodes samples from a compressed file in memory
+	unsigned long int decodeSamples(const char *filename, const unsigned char *compressedData, unsigned long int compressedSize,
+	                                nctl::UniquePtr<unsigned char[]> &decodedData)
+	{
+		nctl::UniquePtr<IAudioLoader> audioLoader = IAudioLoader::createFromMemory(filename, compressedData, compressedSize);
+		if (audioLoader->hasLoaded() == false)
+			return 0;
+
+		return decodeSamples(*audioLoader.get(), decodedData);
+	}
+
+	/// The command that decodes the samples of a cache entry on a worker thread
+	class AudioDecodeCommand : public IThreadCommand
+	{
+	  public:
+		explicit AudioDecodeCommand(const nctl::SharedPtr<AudioDecodeJob> &job)
+		    : job_(job) {}
+
+		void execute() override
+		{
+			job_->decodedSize = decodeSamples(job_->filename.data(), job_->compressedData.get(), job_->compressedSize, job_->decodedData);
+			job_->isDone.store(1, nctl::Atomic32::MemoryModel::RELEASE);
+		}
+
+	  private:
+		/// The job is shared so that it survives the cache entry if it gets destroyed while decoding
+		nctl::SharedPtr<AudioDecodeJob> job_;
+	};
+
+	bool lessRecentlyUsed(const CachedAudioBuffer *a, const CachedAudioBuffer *b)
+	{
+		return a->lastUsed < b->lastUsed;
+	}
+
+}
+
+AudioBufferCache &theAudioBufferCache()
+{
+	static AudioBufferCache instance;
+	return instance;
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+CachedAudioBuffer::CachedAudioBuffer()
+    : state(State::FAILED), keepCompressed(false), bufferId(0), bytesPerSample(0), numChannels(0),
+      frequency(0), numSamples(0), compressedSize(0), refCount(0), lastUsed(0)
+{
+}
+
+CachedAudioBuffer::~CachedAudioBuffer() = default;
+
+AudioBufferCache::AudioBufferCache()
+    : memoryBudget_(DefaultMemoryBudget), residentBytes_(0), compressedBytes_(0),
+      usageCounter_(0), entries_(32)
+{
+}
+
+AudioBufferCache::~AudioBufferCache()
+{
+	// The audio device has already been destroyed, OpenAL buffers should have been released by `clear()`
+	entries_.clear();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void AudioBufferCache::setMemoryBudget(unsigned long int memoryBudget)
+{
+	memoryBudget_ = memoryBudget;
+	enforceBudget();
+}
+
+CachedAudioBuffer *AudioBufferCache::acquire(const char *filename, Residency residency)
+{
+	ZoneScoped;
+	ASSERT(filename);
+
+	nctl::UniquePtr<CachedAudioBuffer> *cachedEntry = entries_.find(filename);
+	if (cachedEntry != nullptr)
+	{
+		CachedAudioBuffer *entry = cachedEntry->get();
+		if (entry->state == CachedAudioBuffer::State::FAILED)
+		{
+			LOGE_X("Audio file \"%s\" has failed to load", filename);
+			return nullptr;
+		}
+
+		statistics_.hits++;
+		entry->refCount++;
+		entry->lastUsed = ++usageCounter_;
+
+		// Samples evicted from memory are decoded again if requested at loading time
+		if (residency == Residency::DECODED && entry->state == CachedAudioBuffer::State::COMPRESSED)
+			decodeEntry(*entry);
+		return entry;
+	}
+
+	statistics_.misses++;
+	nctl::UniquePtr<CachedAudioBuffer> newEntry = nctl::makeUnique<CachedAudioBuffer>();
+	newEntry->filename = filename;
+	newEntry->keepCompressed = (residency == Residency::COMPRESSED);
+	if (loadEntry(*newEntry) == false)
+		return nullptr;
+
+	CachedAudioBuffer *entry = newEntry.get();
+	entry->refCount = 1;
+	entry->lastUsed = ++usageCounter_;
+
+	if (entries_.loadFactor() >= 0.8f)
+		entries_.rehash(entries_.capacity() * 2);
+	entries_.insert(filename, nctl::move(newEntry));
+
+	enforceBudget();
+	return entry;
+}
+
+void AudioBufferCache::release(CachedAudioBuffer *entry)
+{
+	ASSERT(entry);
+	ASSERT(entry->refCount > 0);
+
+	entry->refCount--;
+	// Failed entries are useless once they are no longer referenced
+	if (entry->refCount == 0 && entry->state == CachedAudioBuffer::State::FAILED)
+	{
+		const nctl::String filename(entry->filename);
+		entries_.remove(filename);
+	}
+}
+
+void AudioBufferCache::touch(CachedAudioBuffer *entry)
+{
+	ASSERT(entry);
+
+	entry->lastUsed = ++usageCounter_;
+	if (entry->state == CachedAudioBuffer::State::COMPRESSED)
+		decodeEntry(*entry);
+}
+
+void AudioBufferCache::update()
+{
+	ZoneScoped;
+
+	for (EntriesHashMapType::Iterator i = entries_.begin(); i != entries_.end(); ++i)
+	{
+		CachedAudioBuffer &entry = **i;
+		if (entry.state != CachedAudioBuffer::State::DECODING)
+			continue;
+
+		AudioDecodeJob &job = *entry.decodeJob;
+		if (job.isDone.load(nctl::Atomic32::MemoryModel::ACQUIRE) == 0)
+			continue;
+
+		entry.compressedData = nctl::move(job.compressedData);
+		if (job.decodedSize == entry.decodedSize())
+			uploadSamples(entry, job.decodedData.get(), job.decodedSize);
+		else
+		{
+			LOGE_X("Audio file \"%s\" cannot be decoded", entry.filename.data());
+			entry.state = CachedAudioBuffer::State::FAILED;
+			entry.compressedData.reset(nullptr);
+			compressedBytes_ -= entry.compressedSize;
+		}
+		entry.decodeJob.reset(nullptr);
+	}
+
+	enforceBudget();
+}
+
+void AudioBufferCache::purge()
+{
+	nctl::Array<nctl::String> removedFilenames;
+	for (EntriesHashMapType::Iterator i = entries_.begin(); i != entries_.end(); ++i)
+	{
+		CachedAudioBuffer &entry = **i;
+		if (entry.refCount > 0 || entry.state == CachedAudioBuffer::State::DECODING)
+			continue;
+
+		if (entry.state == CachedAudioBuffer::State::RESIDENT && evictEntry(entry) == false)
+			continue;
+		compressedBytes_ -= (entry.compressedData) ? entry.compressedSize : 0;
+		removedFilenames.pushBack(i.key());
+	}
+
+	for (unsigned int i = 0; i < removedFilenames.size(); i++)
+		entries_.remove(removedFilenames[i]);
+}
+
+void AudioBufferCache::clear()
+{
+	unsigned int numReferenced = 0;
+	nctl::Array<nctl::String> removedFilenames;
+	for (EntriesHashMapType::Iterator i = entries_.begin(); i != entries_.end(); ++i)
+	{
+		CachedAudioBuffer &entry = **i;
+		if (entry.bufferId != 0)
+			alDeleteBuffers(1, &entry.bufferId);
+		entry.bufferId = 0;
+
+		if (entry.refCount > 0)
+		{
+			// Referenced entries are kept without samples so that their `AudioBuffer` objects can still release them
+			entry.state = CachedAudioBuffer::State::FAILED;
+			entry.compressedData.reset(nullptr);
+			entry.decodeJob.reset(nullptr);
+			numReferenced++;
+		}
+		else
+			removedFilenames.pushBack(i.key());
+	}
+
+	for (unsigned int i = 0; i < removedFilenames.size(); i++)
+		entries_.remove(removedFilenames[i]);
+
+	if (numReferenced > 0)
+		LOGW_X("The audio buffer cache still has %u referenced entries", numReferenced);
+
+	residentBytes_ = 0;
+	compressedBytes_ = 0;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool AudioBufferCache::loadEntry(CachedAudioBuffer &entry)
+{
+	ZoneScoped;
+	ZoneText(entry.filename.data(), entry.filename.length());
+
+	nctl::UniquePtr<IAudioLoader> audioLoader;
+	if (entry.keepCompressed)
+	{
+		nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(entry.filename.data());
+		fileHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+		if (fileHandle->isOpened() == false)
+			return false;
+
+		entry.compressedSize = fileHandle->size();
+		entry.compressedData = nctl::makeUnique<unsigned char[]>(entry.compressedSize);
+		fileHandle->read(entry.compressedData.get(), entry.compressedSize);
+		audioLoader = IAudioLoader::createFromMemory(entry.filename.data(), entry.compressedData.get(), entry.compressedSize);
+	}
+	else
+		audioLoader = IAudioLoader::createFromFile(entry.filename.data());
+
+	if (audioLoader->hasLoaded() == false)
+		return false;
+
+	RETURNF_ASSERT_MSG_X(audioLoader->bytesPerSample() == 1 || audioLoader->bytesPerSample() == 2,
+	                     "Unsupported number of bytes per sample: %d", audioLoader->bytesPerSample());
+	RETURNF_ASSERT_MSG_X(audioLoader->numChannels() == 1 || audioLoader->numChannels() == 2,
+	                     "Unsupported number of channels: %d", audioLoader->numChannels());
+
+	entry.bytesPerSample = audioLoader->bytesPerSample();
+	entry.numChannels = audioLoader->numChannels();
+	entry.frequency = audioLoader->frequency();
+	entry.numSamples = audioLoader->numSamples();
+
+	if (entry.keepCompressed)
+	{
+		// Header information has been retrieved, samples will be decoded on first play
+		entry.state = CachedAudioBuffer::State::COMPRESSED;
+		compressedBytes_ += entry.compressedSize;
+		return true;
+	}
+
+	nctl::UniquePtr<unsigned char[]> decodedData;
+	const unsigned long int decodedSize = decodeSamples(*audioLoader.get(), decodedData);
+	statistics_.decodes++;
+	return uploadSamples(entry, decodedData.get(), decodedSize);
+}
+
+void AudioBufferCache::decodeEntry(CachedAudioBuffer &entry)
+{
+	ZoneScoped;
+	ASSERT(entry.state == CachedAudioBuffer::State::COMPRESSED);
+	ASSERT(entry.compressedData);
+
+#ifdef WITH_THREADS
+	if (theApplication().appConfiguration().withThreads)
+	{
+		entry.decodeJob = nctl::makeShared<AudioDecodeJob>();
+		entry.decodeJob->filename = entry.filename;
+		entry.decodeJob->compressedData = nctl::move(entry.compressedData);
+		entry.decodeJob->compressedSize = entry.compressedSize;
+		entry.state = CachedAudioBuffer::State::DECODING;
+
+		theServiceLocator().threadPool().enqueueCommand(nctl::makeUnique<AudioDecodeCommand>(entry.decodeJob));
+		statistics_.asyncDecodes++;
+		return;
+	}
+#endif
+
+	nctl::UniquePtr<unsigned char[]> decodedData;
+	const unsigned long int decodedSize = decodeSamples(entry.filename.data(), entry.compressedData.get(), entry.compressedSize, decodedData);
+	statistics_.decodes++;
+	if (decodedSize == entry.decodedSize())
+		uploadSamples(entry, decodedData.get(), decodedSize);
+	else
+	{
+		LOGE_X("Audio file \"%s\" cannot be decoded", entry.filename.data());
+		entry.state = CachedAudioBuffer::State::FAILED;
+		entry.compressedData.reset(nullptr);
+		compressedBytes_ -= entry.compressedSize;
+	}
+}
+
+bool AudioBufferCache::uploadSamples(CachedAudioBuffer &entry, const unsigned char *bufferPtr, unsigned long int bufferSize)
+{
+	alGetError();
+	if (entry.bufferId == 0)
+	{
+		alGenBuffers(1, &entry.bufferId);
+		const ALenum error = alGetError();
+		if (error != AL_NO_ERROR)
+		{
+			LOGE_X("alGenBuffers failed: 0x%x", error);
+			entry.bufferId = 0;
+			entry.state = CachedAudioBuffer::State::FAILED;
+			return false;
+		}
+	}
+
+	const ALenum format = alFormat(entry.bytesPerSample, entry.numChannels);
+	alBufferData(entry.bufferId, format, bufferPtr, bufferSize, entry.frequency);
+	const ALenum error = alGetError();
+	if (error != AL_NO_ERROR)
+	{
+		LOGE_X("alBufferData failed: 0x%x", error);
+		alDeleteBuffers(1, &entry.bufferId);
+		entry.bufferId = 0;
+		entry.state = CachedAudioBuffer::State::FAILED;
+		return false;
+	}
+
+	entry.state = CachedAudioBuffer::State::RESIDENT;
+	residentBytes_ += bufferSize;
+	return true;
+}
+
+bool AudioBufferCache::evictEntry(CachedAudioBuffer &entry)
+{
+	ASSERT(entry.state == CachedAudioBuffer::State::RESIDENT);
+
+	// Deleting a buffer that is still attached to a source fails and leaves it untouched
+	alGetError();
+	alDeleteBuffers(1, &entry.bufferId);
+	if (alGetError() != AL_NO_ERROR)
+		return false;
+
+	entry.bufferId = 0;
+	residentBytes_ -= entry.decodedSize();
+	entry.state = (entry.compressedData) ? CachedAudioBuffer::State::COMPRESSED : CachedAudioBuffer::State::FAILED;
+	statistics_.evictions++;
+	return true;
+}
+
+void AudioBufferCache::enforceBudget()
+{
+	if (residentBytes_ <= memoryBudget_)
+		return;
+
+	ZoneScoped;
+	// Referenced entries can only drop their samples if they can decode them again from the compressed file
+	nctl::Array<CachedAudioBuffer *> candidates(entries_.size());
+	for (EntriesHashMapType::Iterator i = entries_.begin(); i != entries_.end(); ++i)
+	{
+		CachedAudioBuffer *entry = (*i).get();
+		if (entry->state == CachedAudioBuffer::State::RESIDENT && (entry->refCount == 0 || entry->compressedData))
+			candidates.pushBack(entry);
+	}
+	nctl::quicksort(candidates.begin(), candidates.end(), lessRecentlyUsed);
+
+	nctl::Array<nctl::String> removedFilenames;
+	for (unsigned int i = 0; i < candidates.size() && residentBytes_ > memoryBudget_; i++)
+	{
+		CachedAudioBuffer &entry = *candidates[i];
+		if (evictEntry(entry) && entry.refCount == 0 && entry.keepCompressed == false)
+			removedFilenames.pushBack(entry.filename);
+	}
+
+	for (unsigned int i = 0; i < removedFilenames.size(); i++)
+		entries_.remove(removedFilenames[i]);
+
+	if (residentBytes_ > memoryBudget_)
+		LOGW_X("Audio buffer cache is over budget: %lu / %lu bytes", residentBytes_, memoryBudget_);
+}
+
+}
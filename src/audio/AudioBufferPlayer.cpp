@@ -10,12 +10,12 @@ namespace ncine {
 ///////////////////////////////////////////////////////////
 
 AudioBufferPlayer::AudioBufferPlayer()
-    : IAudioPlayer(ObjectType::AUDIOBUFFER_PLAYER), audioBuffer_(nullptr)
+    : IAudioPlayer(ObjectType::AUDIOBUFFER_PLAYER), audioBuffer_(nullptr), playPending_(false)
 {
 }
 
 AudioBufferPlayer::AudioBufferPlayer(AudioBuffer *audioBuffer)
-    : IAudioPlayer(ObjectType::AUDIOBUFFER_PLAYER), audioBuffer_(audioBuffer)
+    : IAudioPlayer(ObjectType::AUDIOBUFFER_PLAYER), audioBuffer_(audioBuffer), playPending_(false)
 {
 	if (audioBuffer)
 		setName(audioBuffer->name());
@@ -98,11 +98,11 @@ void AudioBufferPlayer::play()
 
 			if (sourceId_ != IAudioDevice::InvalidSource)
 			{
-				alSourcei(sourceId_, AL_BUFFER, audioBuffer_->bufferId());
-				// Setting OpenAL source looping only if not streaming
-				alSourcei(sourceId_, AL_LOOPING, isLooping_);
-
-				alSourcePlay(sourceId_);
+				// Shared samples that are not resident are decoded, the source starts when they are ready
+				audioBuffer_->requestSamples();
+				playPending_ = (audioBuffer_->bufferId() == 0 && audioBuffer_->isDecoding());
+				if (playPending_ == false)
+					startSource();
 				state_ = PlayerState::PLAYING;
 			}
 			break;
@@ -111,7 +111,8 @@ void AudioBufferPlayer::play()
 			break;
 		case PlayerState::PAUSED:
 		{
-			alSourcePlay(sourceId_);
+			if (playPending_ == false)
+				alSourcePlay(sourceId_);
 			state_ = PlayerState::PLAYING;
 			break;
 		}
@@ -127,7 +128,8 @@ void AudioBufferPlayer::pause()
 			break;
 		case PlayerState::PLAYING:
 		{
-			alSourcePause(sourceId_);
+			if (playPending_ == false)
+				alSourcePause(sourceId_);
 			state_ = PlayerState::PAUSED;
 			break;
 		}
@@ -149,6 +151,7 @@ void AudioBufferPlayer::stop()
 			alSourceStop(sourceId_);
 			// Detach the buffer from source
 			alSourcei(sourceId_, AL_BUFFER, 0);
+			playPending_ = false;
 
 			if (sourceLocked_ == false)
 			{
@@ -167,6 +170,16 @@ void AudioBufferPlayer::stop()
 
 void AudioBufferPlayer::updateState()
 {
+	if (state_ == PlayerState::PLAYING && playPending_)
+	{
+		if (audioBuffer_->isDecoding())
+			return;
+
+		playPending_ = false;
+		if (audioBuffer_->bufferId() != 0)
+			startSource();
+	}
+
 	if (state_ == PlayerState::PLAYING)
 	{
 		ALenum alState;
@@ -183,4 +196,17 @@ void AudioBufferPlayer::updateState()
 	}
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void AudioBufferPlayer::startSource()
+{
+	alSourcei(sourceId_, AL_BUFFER, audioBuffer_->bufferId());
+	// Setting OpenAL source looping only if not streaming
+	alSourcei(sourceId_, AL_LOOPING, isLooping_);
+
+	alSourcePlay(sourceId_);
+}
+
 }
@@ -4,6 +4,8 @@
 #include <nctl/MallocAllocator.h>
 #include <nctl/FreeListAllocator.h>
 #include <nctl/ProxyAllocator.h>
+#include <nctl/FrameAllocator.h>
+#include <nctl/AllocTelemetry.h>
 
 #ifdef WITH_IMGUI
 	#include "imgui.h"
@@ -41,6 +43,17 @@ alignas(IAllocator::DefaultAlignment) static uint8_t mallocAllocatorBuffer[sizeo
 static MallocAllocator &mallocAllocator = reinterpret_cast<MallocAllocator &>(mallocAllocatorBuffer);
 #endif
 
+#ifndef FRAME_ALLOCATOR_BUFFER
+	#define FRAME_ALLOCATOR_BUFFER (2 * 1024 * 1024)
+#endif
+static const unsigned int FrameAllocatorSize = FRAME_ALLOCATOR_BUFFER;
+alignas(IAllocator::DefaultAlignment) static uint8_t frameAllocatorMemory[FrameAllocatorSize];
+alignas(IAllocator::DefaultAlignment) static uint8_t frameAllocatorBuffer[sizeof(FrameAllocator)];
+static FrameAllocator &frameAllocator = reinterpret_cast<FrameAllocator &>(frameAllocatorBuffer);
+
+alignas(IAllocator::DefaultAlignment) static uint8_t allocTelemetryBuffer[sizeof(AllocTelemetry)];
+static AllocTelemetry &allocTelemetry = reinterpret_cast<AllocTelemetry &>(allocTelemetryBuffer);
+
 #ifdef WITH_IMGUI
 alignas(IAllocator::DefaultAlignment) static uint8_t imguiAllocatorBuffer[sizeof(ProxyAllocator)];
 static ProxyAllocator &imguiAllocator = reinterpret_cast<ProxyAllocator &>(imguiAllocatorBuffer);
@@ -76,6 +89,16 @@ IAllocator &theStringAllocator()
 	return theAllocManager().stringAllocator();
 }
 
+FrameAllocator &theFrameAllocator()
+{
+	return frameAllocator;
+}
+
+AllocTelemetry &theAllocTelemetry()
+{
+	return allocTelemetry;
+}
+
 IAllocator &theImGuiAllocator()
 {
 #ifdef WITH_IMGUI
@@ -162,6 +185,8 @@ AllocManager::AllocManager()
 	defaultAllocator_ = mainAllocator;
 	stringAllocator_ = mainAllocator;
 
+	new (&frameAllocator) FrameAllocator("Frame", FrameAllocatorSize, frameAllocatorMemory, *mainAllocator);
+
 #ifdef WITH_IMGUI
 	new (&imguiAllocator) ProxyAllocator("ImGui", *mainAllocator);
 	ImGui::SetAllocatorFunctions(imguiAllocate, imguiDeallocate);
@@ -182,10 +207,32 @@ AllocManager::AllocManager()
 
 	glfwInitAllocator(&allocator);
 #endif
+
+	new (&allocTelemetry) AllocTelemetry();
+#ifdef USE_FREELIST
+	allocTelemetry.add(freelistAllocator);
+#else
+	allocTelemetry.add(mallocAllocator);
+#endif
+	allocTelemetry.add(frameAllocator);
+#ifdef WITH_IMGUI
+	allocTelemetry.add(imguiAllocator);
+#endif
+#ifdef WITH_NUKLEAR
+	allocTelemetry.add(nuklearAllocator);
+#endif
+#ifdef WITH_LUA
+	allocTelemetry.add(luaAllocator);
+#endif
+#if defined(WITH_GLFW) && GLFW_VERSION_COMBINED >= 3400
+	allocTelemetry.add(glfwAllocator);
+#endif
 }
 
 AllocManager::~AllocManager()
 {
+	(&allocTelemetry)->~AllocTelemetry();
+
 #if defined(WITH_GLFW) && GLFW_VERSION_COMBINED >= 3400
 	(&glfwAllocator)->~ProxyAllocator();
 #endif
@@ -198,6 +245,7 @@ AllocManager::~AllocManager()
 #ifdef WITH_IMGUI
 	(&imguiAllocator)->~ProxyAllocator();
 #endif
+	(&frameAllocator)->~FrameAllocator();
 
 #ifdef USE_FREELIST
 	(&freelistAllocator)->~FreeListAllocator();
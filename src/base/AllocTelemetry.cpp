@@ -0,0 +1,196 @@
+#include <ncine/common_macros.h>
+#include <nctl/AllocTelemetry.h>
+#include <nctl/IAllocator.h>
+#include <nctl/FreeListAllocator.h>
+#include <nctl/StaticString.h>
+#include <ncine/IFile.h>
+
+namespace nctl {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+AllocTelemetry::AllocTelemetry()
+    : numFrames_(0)
+{
+}
+
+AllocTelemetry::~AllocTelemetry()
+{
+	stopCsvRecording();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool AllocTelemetry::add(IAllocator &allocator)
+{
+	if (findEntry(allocator) != nullptr || entries_.size() >= MaxAllocators)
+		return false;
+
+	Entry entry;
+	entry.allocator = &allocator;
+	entry.peakMemory = allocator.usedMemory();
+	entry.lastNumTotalAllocations = allocator.numTotalAllocations();
+	entries_.pushBack(entry);
+	allocator.resetPeakMemory();
+
+	return true;
+}
+
+bool AllocTelemetry::add(FreeListAllocator &allocator)
+{
+	const bool added = add(static_cast<IAllocator &>(allocator));
+	if (added)
+		entries_.back().freeList = &allocator;
+
+	return added;
+}
+
+bool AllocTelemetry::remove(const IAllocator &allocator)
+{
+	for (unsigned int i = 0; i < entries_.size(); i++)
+	{
+		if (entries_[i].allocator == &allocator)
+		{
+			entries_.removeAt(i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+const AllocTelemetry::Entry *AllocTelemetry::find(const IAllocator &allocator) const
+{
+	for (unsigned int i = 0; i < entries_.size(); i++)
+	{
+		if (entries_[i].allocator == &allocator)
+			return &entries_[i];
+	}
+
+	return nullptr;
+}
+
+bool AllocTelemetry::setBudget(const IAllocator &allocator, size_t bytes, BudgetPolicy policy)
+{
+	Entry *entry = findEntry(allocator);
+	if (entry == nullptr)
+		return false;
+
+	entry->budget = bytes;
+	entry->budgetPolicy = policy;
+	entry->isOverBudget = false;
+
+	return true;
+}
+
+void AllocTelemetry::update()
+{
+	for (Entry &entry : entries_)
+	{
+		IAllocator &allocator = *entry.allocator;
+
+		entry.framePeakMemory = allocator.peakMemory();
+		if (entry.framePeakMemory > entry.peakMemory)
+			entry.peakMemory = entry.framePeakMemory;
+		allocator.resetPeakMemory();
+
+		const size_t numTotalAllocations = allocator.numTotalAllocations();
+		entry.numFrameAllocations = numTotalAllocations - entry.lastNumTotalAllocations;
+		entry.lastNumTotalAllocations = numTotalAllocations;
+
+		if (entry.freeList)
+		{
+			size_t freeMemory = 0;
+			size_t largestFreeBlock = 0;
+			for (const FreeListAllocator::Block *block = entry.freeList->freeBlock(); block != nullptr; block = block->next)
+			{
+				freeMemory += block->size;
+				if (block->size > largestFreeBlock)
+					largestFreeBlock = block->size;
+			}
+			entry.fragmentation = (freeMemory > 0) ? 1.0f - largestFreeBlock / static_cast<float>(freeMemory) : 0.0f;
+		}
+
+		// Warning only once when the budget is exceeded, and again if memory usage goes back below it and then over it
+		const bool isOverBudget = (entry.budget > 0 && entry.framePeakMemory > entry.budget);
+		if (isOverBudget && entry.isOverBudget == false)
+		{
+			LOGW_X("Allocator \"%s\" is over budget: %lu of %lu bytes", allocator.name(), entry.framePeakMemory, entry.budget);
+			ASSERT_MSG_X(entry.budgetPolicy != BudgetPolicy::ASSERT, "Allocator \"%s\" is over budget", allocator.name());
+		}
+		entry.isOverBudget = isOverBudget;
+	}
+
+	if (csvFile_)
+		writeCsvRows();
+	numFrames_++;
+}
+
+void AllocTelemetry::resetPeaks()
+{
+	for (Entry &entry : entries_)
+	{
+		entry.allocator->resetPeakMemory();
+		entry.peakMemory = entry.allocator->usedMemory();
+		entry.framePeakMemory = entry.peakMemory;
+	}
+}
+
+bool AllocTelemetry::startCsvRecording(const char *filename)
+{
+	ASSERT(filename);
+	stopCsvRecording();
+
+	csvFile_ = ncine::IFile::createFileHandle(filename);
+	csvFile_->open(ncine::IFile::OpenMode::WRITE);
+	if (csvFile_->isOpened() == false)
+	{
+		csvFile_.reset(nullptr);
+		return false;
+	}
+
+	const char header[] = "frame,seconds,allocator,used_memory,peak_memory,frame_peak_memory,allocations,frame_allocations,fragmentation,budget\n";
+	csvFile_->write(header, sizeof(header) - 1);
+	csvStartTime_ = ncine::TimeStamp::now();
+
+	return true;
+}
+
+void AllocTelemetry::stopCsvRecording()
+{
+	if (csvFile_)
+	{
+		csvFile_->close();
+		csvFile_.reset(nullptr);
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+AllocTelemetry::Entry *AllocTelemetry::findEntry(const IAllocator &allocator)
+{
+	return const_cast<Entry *>(find(allocator));
+}
+
+void AllocTelemetry::writeCsvRows()
+{
+	const float seconds = csvStartTime_.secondsSince();
+
+	StaticString<256> row;
+	for (const Entry &entry : entries_)
+	{
+		const IAllocator &allocator = *entry.allocator;
+		row.format("%lu,%.3f,%s,%lu,%lu,%lu,%lu,%lu,%.4f,%lu\n", numFrames_, seconds, allocator.name(),
+		           allocator.usedMemory(), entry.peakMemory, entry.framePeakMemory, allocator.numAllocations(),
+		           entry.numFrameAllocations, entry.fragmentation, entry.budget);
+		csvFile_->write(row.data(), row.length());
+	}
+}
+
+}
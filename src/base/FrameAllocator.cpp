@@ -0,0 +1,155 @@
+#include <ncine/common_macros.h>
+#include <nctl/FrameAllocator.h>
+#include <nctl/PointerMath.h>
+
+namespace nctl {
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+FrameAllocator::FrameAllocator(const char *name)
+    : IAllocator(name, allocateImpl, reallocateImpl, deallocateImpl),
+      currentIndex_(0), fallback_(nullptr), lastFrameUsedMemory_(0),
+      highWaterMark_(0), numFallbacks_(0), lastFrameNumFallbacks_(0)
+{
+#ifdef RECORD_ALLOCATIONS
+	buffers_[0].setRecordAllocations(false);
+	buffers_[1].setRecordAllocations(false);
+#endif
+}
+
+FrameAllocator::FrameAllocator(const char *name, size_t size, void *base, IAllocator &fallback)
+    : FrameAllocator(name)
+{
+	init(size, base, fallback);
+}
+
+FrameAllocator::~FrameAllocator()
+{
+	// Frame allocations are never freed, they are lost together with the buffer
+	clear();
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void FrameAllocator::init(size_t size, void *base, IAllocator &fallback)
+{
+	FATAL_ASSERT(usedMemory_ == 0 && numAllocations_ == 0);
+	FATAL_ASSERT(&fallback != this);
+
+	// The second half should start at an aligned address like the first one
+	const size_t halfSize = (size / 2) & ~static_cast<size_t>(DefaultAlignment - 1);
+	buffers_[0].init(halfSize, base);
+	buffers_[1].init(halfSize, PointerMath::add(base, halfSize));
+
+	size_ = halfSize * 2;
+	base_ = base;
+	fallback_ = &fallback;
+	currentIndex_ = 0;
+}
+
+void FrameAllocator::nextFrame()
+{
+	LinearAllocator &current = buffers_[currentIndex_];
+	lastFrameUsedMemory_ = current.usedMemory();
+	lastFrameNumFallbacks_ = numFallbacks_;
+	numFallbacks_ = 0;
+
+	// The allocations of the frame that is ending survive until the end of the next one
+	currentIndex_ = 1 - currentIndex_;
+	buffers_[currentIndex_].clear();
+
+	usedMemory_ = current.usedMemory();
+	numAllocations_ = current.numAllocations();
+}
+
+void FrameAllocator::clear()
+{
+	buffers_[0].clear();
+	buffers_[1].clear();
+	usedMemory_ = 0;
+	numAllocations_ = 0;
+	lastFrameUsedMemory_ = 0;
+	numFallbacks_ = 0;
+	lastFrameNumFallbacks_ = 0;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool FrameAllocator::isInArena(const void *ptr) const
+{
+	const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+	const uintptr_t base = reinterpret_cast<uintptr_t>(base_);
+	return (address >= base && address < base + size_);
+}
+
+void FrameAllocator::updateUsedMemory()
+{
+	const LinearAllocator &current = buffers_[currentIndex_];
+	const LinearAllocator &previous = buffers_[1 - currentIndex_];
+	usedMemory_ = current.usedMemory() + previous.usedMemory();
+	numAllocations_ = current.numAllocations() + previous.numAllocations();
+
+	if (current.usedMemory() > highWaterMark_)
+		highWaterMark_ = current.usedMemory();
+}
+
+void *FrameAllocator::allocateImpl(IAllocator *allocator, size_t bytes, uint8_t alignment)
+{
+	FATAL_ASSERT(allocator);
+	FrameAllocator *allocatorImpl = static_cast<FrameAllocator *>(allocator);
+
+	void *ptr = allocatorImpl->buffers_[allocatorImpl->currentIndex_].allocate(bytes, alignment);
+	if (ptr)
+		allocatorImpl->updateUsedMemory();
+	else if (allocatorImpl->fallback_)
+	{
+		allocatorImpl->numFallbacks_++;
+		ptr = allocatorImpl->fallback_->allocate(bytes, alignment);
+	}
+
+	return ptr;
+}
+
+void *FrameAllocator::reallocateImpl(IAllocator *allocator, void *ptr, size_t bytes, uint8_t alignment, size_t &oldSize)
+{
+	FATAL_ASSERT(allocator);
+	FrameAllocator *allocatorImpl = static_cast<FrameAllocator *>(allocator);
+
+	// Arena allocations can only be resized in place, containers will copy them when needed
+	allocatorImpl->copyOnReallocation_ = false;
+	oldSize = 0;
+
+	if (allocatorImpl->isInArena(ptr) == false)
+		return (allocatorImpl->fallback_) ? allocatorImpl->fallback_->reallocate(ptr, bytes, alignment) : nullptr;
+
+	LinearAllocator &current = allocatorImpl->buffers_[allocatorImpl->currentIndex_];
+	void *newPtr = current.reallocate(ptr, bytes, alignment);
+	if (newPtr)
+		allocatorImpl->updateUsedMemory();
+
+	return newPtr;
+}
+
+void FrameAllocator::deallocateImpl(IAllocator *allocator, void *ptr)
+{
+	if (ptr == nullptr)
+		return;
+
+	FATAL_ASSERT(allocator);
+	FrameAllocator *allocatorImpl = static_cast<FrameAllocator *>(allocator);
+
+	// Arena memory is only reclaimed when its half is reused
+	if (allocatorImpl->isInArena(ptr) == false)
+	{
+		FATAL_ASSERT(allocatorImpl->fallback_);
+		allocatorImpl->fallback_->deallocate(ptr);
+	}
+}
+
+}
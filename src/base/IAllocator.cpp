@@ -18,10 +18,10 @@ IAllocator::IAllocator(const char *name, AllocateFunction allocFunc, ReallocateF
 
 #if !defined(RECORD_ALLOCATIONS) && !defined(WITH_TRACY)
     : allocateFunc_(allocFunc), reallocateFunc_(reallocFunc), deallocateFunc_(deallocFunc),
-      size_(size), base_(base), usedMemory_(0), numAllocations_(0), copyOnReallocation_(true)
+      size_(size), base_(base), usedMemory_(0), numAllocations_(0), peakMemory_(0), numTotalAllocations_(0), copyOnReallocation_(true)
 #else
     : allocateFunc_(wrapAllocate), reallocateFunc_(wrapReallocate), deallocateFunc_(wrapDeallocate),
-      size_(size), base_(base), usedMemory_(0), numAllocations_(0), copyOnReallocation_(true),
+      size_(size), base_(base), usedMemory_(0), numAllocations_(0), peakMemory_(0), numTotalAllocations_(0), copyOnReallocation_(true),
       realAllocateFunc_(allocFunc), realReallocateFunc_(reallocFunc), realDeallocateFunc_(deallocFunc)
 #endif
 #if defined(RECORD_ALLOCATIONS)
@@ -196,6 +196,8 @@ void *IAllocator::reallocate(void *ptr, size_t bytes, uint8_t alignment)
 			(*deallocateFunc_)(this, ptr);
 		}
 	}
+	else if (newPtr && usedMemory_ > peakMemory_)
+		peakMemory_ = usedMemory_;
 
 	return newPtr;
 }
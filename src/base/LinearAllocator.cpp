@@ -10,13 +10,13 @@ namespace nctl {
 
 LinearAllocator::LinearAllocator(const char *name)
     : IAllocator(name, allocateImpl, reallocateImpl, deallocateImpl),
-      current_(nullptr)
+      current_(nullptr), lastAllocation_(nullptr)
 {
 }
 
 LinearAllocator::LinearAllocator(const char *name, size_t size, void *base)
     : IAllocator(name, allocateImpl, reallocateImpl, deallocateImpl, size, base),
-      current_(base)
+      current_(base), lastAllocation_(nullptr)
 {
 }
 
@@ -35,11 +35,13 @@ void LinearAllocator::init(size_t size, void *base)
 	size_ = size;
 	base_ = base;
 	current_ = base_;
+	lastAllocation_ = nullptr;
 }
 
 void LinearAllocator::clear()
 {
 	current_ = base_;
+	lastAllocation_ = nullptr;
 	usedMemory_ = 0;
 	numAllocations_ = 0;
 }
@@ -70,14 +72,13 @@ void *LinearAllocator::allocateImpl(IAllocator *allocator, size_t bytes, uint8_t
 		allocatorImpl->usedMemory_ += bytes + adjustment;
 		allocatorImpl->numAllocations_++;
 		allocatorImpl->current_ = PointerMath::add(allocatorImpl->current_, bytes + adjustment);
+		allocatorImpl->lastAllocation_ = alignedAddress;
 		return alignedAddress;
 	}
 }
 
 void *LinearAllocator::reallocateImpl(IAllocator *allocator, void *ptr, size_t bytes, uint8_t alignment, size_t &oldSize)
 {
-	ASSERT_MSG(false, "LinearAllocator cannot reallocate");
-
 	FATAL_ASSERT(allocator);
 	LinearAllocator *allocatorImpl = static_cast<LinearAllocator *>(allocator);
 
@@ -85,7 +86,17 @@ void *LinearAllocator::reallocateImpl(IAllocator *allocator, void *ptr, size_t b
 	allocatorImpl->copyOnReallocation_ = false;
 	oldSize = 0;
 
-	return nullptr;
+	// Only the last allocation can be resized, by moving the current pointer. Containers probe for it, failing is not an error.
+	if (ptr == nullptr || ptr != allocatorImpl->lastAllocation_ || PointerMath::alignAdjustment(ptr, alignment) != 0 ||
+	    PointerMath::add(ptr, bytes) > PointerMath::add(allocatorImpl->base_, allocatorImpl->size_))
+	{
+		return nullptr;
+	}
+
+	oldSize = PointerMath::subtract(allocatorImpl->current_, ptr);
+	allocatorImpl->usedMemory_ = allocatorImpl->usedMemory_ - oldSize + bytes;
+	allocatorImpl->current_ = PointerMath::add(ptr, bytes);
+	return ptr;
 }
 
 void LinearAllocator::deallocateImpl(IAllocator *allocator, void *ptr)
@@ -1,8 +1,32 @@
 #include <ncine/common_macros.h>
 #include <nctl/MallocAllocator.h>
 
+#if defined(__APPLE__)
+	#include <malloc/malloc.h>
+#elif defined(_WIN32) || defined(__linux__) || defined(__EMSCRIPTEN__)
+	#include <malloc.h>
+#endif
+
 namespace nctl {
 
+namespace {
+
+	/// Returns the number of bytes reserved by `malloc()` for an allocation, or zero if the platform cannot tell
+	size_t allocationSize(void *ptr)
+	{
+#if defined(__APPLE__)
+		return malloc_size(ptr);
+#elif defined(_WIN32)
+		return _msize(ptr);
+#elif defined(__linux__) || defined(__EMSCRIPTEN__)
+		return malloc_usable_size(ptr);
+#else
+		return 0;
+#endif
+	}
+
+}
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -33,7 +57,10 @@ void *MallocAllocator::allocateImpl(IAllocator *allocator, size_t bytes, uint8_t
 	void *ptr = malloc(bytes);
 
 	if (ptr != nullptr)
+	{
+		allocatorImpl->usedMemory_ += allocationSize(ptr);
 		allocatorImpl->numAllocations_++;
+	}
 
 	return ptr;
 }
@@ -53,8 +80,12 @@ void *MallocAllocator::reallocateImpl(IAllocator *allocator, void *ptr, size_t b
 	// Previous allocation size is unknown
 	oldSize = 0;
 
-	// There is no way to know how many bytes were allocated previously
-	return realloc(ptr, bytes);
+	const size_t previousSize = allocationSize(ptr);
+	void *newPtr = realloc(ptr, bytes);
+	if (newPtr != nullptr)
+		allocatorImpl->usedMemory_ = allocatorImpl->usedMemory_ - previousSize + allocationSize(newPtr);
+
+	return newPtr;
 }
 
 void MallocAllocator::deallocateImpl(IAllocator *allocator, void *ptr)
@@ -66,6 +97,7 @@ void MallocAllocator::deallocateImpl(IAllocator *allocator, void *ptr)
 	MallocAllocator *allocatorImpl = static_cast<MallocAllocator *>(allocator);
 
 	FATAL_ASSERT(allocatorImpl->numAllocations_ > 0);
+	allocatorImpl->usedMemory_ -= allocationSize(ptr);
 	allocatorImpl->numAllocations_--;
 
 	free(ptr);
@@ -29,7 +29,7 @@ void *ProxyAllocator::allocateImpl(IAllocator *allocator, size_t bytes, uint8_t
 	IAllocator &subject = allocatorImpl->allocator_;
 
 	const size_t memoryUsedBefore = subject.usedMemory();
-	void *ptr = subject.allocateFunc_(&subject, bytes, alignment);
+	void *ptr = subject.trackAllocation(subject.allocateFunc_(&subject, bytes, alignment));
 	if (ptr)
 	{
 		allocatorImpl->usedMemory_ += subject.usedMemory() - memoryUsedBefore;
@@ -48,7 +48,11 @@ void *ProxyAllocator::reallocateImpl(IAllocator *allocator, void *ptr, size_t by
 	const size_t memoryUsedBefore = subject.usedMemory();
 	void *newPtr = subject.reallocateFunc_(&subject, ptr, bytes, alignment, oldSize);
 	if (newPtr)
+	{
 		allocatorImpl->usedMemory_ += subject.usedMemory() - memoryUsedBefore;
+		if (subject.usedMemory_ > subject.peakMemory_)
+			subject.peakMemory_ = subject.usedMemory_;
+	}
 
 	return newPtr;
 }
@@ -8,16 +8,87 @@ namespace {
 
 	const uint64_t DefaultInitState = 0x853c49e6748fea9bULL;
 	const uint64_t DefaultInitSequence = 0xda3e39cb94b95bdbULL;
+	const uint64_t Multiplier = 6364136223846793005ULL;
 
-	uint32_t random(uint64_t &state, uint64_t &increment)
+	/// Number of positions of the sequence that are generated at the same time by the bulk functions
+	const unsigned int NumLanes = 8;
+	/// Steps between the starting points of two substreams
+	const uint64_t SubstreamDistance = 1ULL << 48;
+
+	inline uint32_t output(uint64_t state)
 	{
-		const uint64_t oldState = state;
-		state = oldState * 6364136223846793005ULL + increment;
-		const uint32_t xorShifted = static_cast<uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
-		const uint32_t rotation = static_cast<uint32_t>(oldState >> 59u);
+		const uint32_t xorShifted = static_cast<uint32_t>(((state >> 18u) ^ state) >> 27u);
+		const uint32_t rotation = static_cast<uint32_t>(state >> 59u);
 		return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31));
 	}
 
+	inline uint32_t random(uint64_t &state, uint64_t &increment)
+	{
+		const uint64_t oldState = state;
+		state = oldState * Multiplier + increment;
+		return output(oldState);
+	}
+
+	/// Converts the 24 most significant bits to a float number, r, where 0 <= r < 1
+	inline float toReal(uint32_t number)
+	{
+		return static_cast<float>(number >> 8) * (1.0f / 16777216.0f);
+	}
+
+	/// Calculates the multiplier and the increment that advance a state by `delta` steps at once
+	void jumpCoefficients(uint64_t delta, uint64_t increment, uint64_t &jumpMultiplier, uint64_t &jumpIncrement)
+	{
+		uint64_t currentMultiplier = Multiplier;
+		uint64_t currentIncrement = increment;
+		jumpMultiplier = 1u;
+		jumpIncrement = 0u;
+
+		while (delta > 0)
+		{
+			if (delta & 1u)
+			{
+				jumpMultiplier *= currentMultiplier;
+				jumpIncrement = jumpIncrement * currentMultiplier + currentIncrement;
+			}
+			currentIncrement = (currentMultiplier + 1u) * currentIncrement;
+			currentMultiplier *= currentMultiplier;
+			delta /= 2;
+		}
+	}
+
+	/// Passes `count` consecutive numbers of the sequence to the function, together with their index
+	/*! Consecutive positions are assigned to independent lanes that jump ahead by the number of lanes, breaking the
+	 *  dependency of every state on the previous one. The lanes can be computed in parallel by the CPU or by the compiler. */
+	template <class Function>
+	void generate(uint64_t &state, uint64_t increment, unsigned int count, Function function)
+	{
+		unsigned int i = 0;
+		if (count >= NumLanes * 2)
+		{
+			uint64_t lanes[NumLanes];
+			lanes[0] = state;
+			for (unsigned int j = 1; j < NumLanes; j++)
+				lanes[j] = lanes[j - 1] * Multiplier + increment;
+
+			uint64_t laneMultiplier = 0;
+			uint64_t laneIncrement = 0;
+			jumpCoefficients(NumLanes, increment, laneMultiplier, laneIncrement);
+
+			for (; i + NumLanes <= count; i += NumLanes)
+			{
+				for (unsigned int j = 0; j < NumLanes; j++)
+				{
+					function(i + j, output(lanes[j]));
+					lanes[j] = lanes[j] * laneMultiplier + laneIncrement;
+				}
+			}
+			state = lanes[0];
+		}
+
+		for (; i < count; i++)
+			function(i, random(state, increment));
+	}
+
 	uint32_t boundRandom(uint64_t &state, uint64_t &increment, uint32_t bound)
 	{
 		const uint32_t threshold = -bound % bound;
@@ -112,4 +183,54 @@ float Random::fastReal(float min, float max)
 	return min + static_cast<float>(random(state_, increment_) / static_cast<float>(UINT32_MAX)) * (max - min);
 }
 
+void Random::integers(uint32_t *dest, unsigned int count)
+{
+	ASSERT(dest != nullptr || count == 0);
+	generate(state_, increment_, count, [dest](unsigned int index, uint32_t number) { dest[index] = number; });
+}
+
+void Random::integers(uint32_t *dest, unsigned int count, uint32_t min, uint32_t max)
+{
+	ASSERT(dest != nullptr || count == 0);
+	ASSERT(min <= max);
+
+	// Mapping the numbers to the range with a multiplication avoids both the division and the rejection loop
+	const uint64_t range = max - min;
+	generate(state_, increment_, count, [dest, min, range](unsigned int index, uint32_t number) {
+		dest[index] = min + static_cast<uint32_t>((number * range) >> 32);
+	});
+}
+
+void Random::reals(float *dest, unsigned int count)
+{
+	ASSERT(dest != nullptr || count == 0);
+	generate(state_, increment_, count, [dest](unsigned int index, uint32_t number) { dest[index] = toReal(number); });
+}
+
+void Random::reals(float *dest, unsigned int count, float min, float max)
+{
+	ASSERT(dest != nullptr || count == 0);
+	ASSERT(min <= max);
+
+	const float range = max - min;
+	generate(state_, increment_, count, [dest, min, range](unsigned int index, uint32_t number) {
+		dest[index] = min + toReal(number) * range;
+	});
+}
+
+void Random::advance(uint64_t delta)
+{
+	uint64_t jumpMultiplier = 0;
+	uint64_t jumpIncrement = 0;
+	jumpCoefficients(delta, increment_, jumpMultiplier, jumpIncrement);
+	state_ = state_ * jumpMultiplier + jumpIncrement;
+}
+
+Random Random::substream(unsigned int index) const
+{
+	Random copy(*this);
+	copy.advance(index * SubstreamDistance);
+	return copy;
+}
+
 }
@@ -1,6 +1,7 @@
 #include "common_macros.h"
 #include <nctl/CString.h>
 #include <nctl/String.h>
+#include <nctl/HashFunctions.h>
 #include <nctl/algorithms.h>
 
 #ifdef WITH_ALLOCATORS
@@ -15,13 +16,13 @@ namespace nctl {
 ///////////////////////////////////////////////////////////
 
 String::String()
-    : length_(0), capacity_(SmallBufferSize), fixedCapacity_(false)
+    : length_(0), capacity_(SmallBufferSize), hash_(0), fixedCapacity_(false)
 {
 	array_.local_[0] = '\0';
 }
 
 String::String(unsigned int capacity, StringMode mode)
-    : length_(0), capacity_(capacity), fixedCapacity_(mode == StringMode::FIXED_CAPACITY)
+    : length_(0), capacity_(capacity), hash_(0), fixedCapacity_(mode == StringMode::FIXED_CAPACITY)
 {
 	array_.local_[0] = '\0';
 
@@ -39,7 +40,7 @@ String::String(unsigned int capacity, StringMode mode)
 }
 
 String::String(const char *cString, StringMode mode)
-    : length_(0), capacity_(0), fixedCapacity_(mode == StringMode::FIXED_CAPACITY)
+    : length_(0), capacity_(0), hash_(0), fixedCapacity_(mode == StringMode::FIXED_CAPACITY)
 {
 	ASSERT(cString);
 
@@ -74,7 +75,7 @@ String::~String()
 }
 
 String::String(const String &other)
-    : length_(other.length_), capacity_(other.capacity_), fixedCapacity_(other.fixedCapacity_)
+    : length_(other.length_), capacity_(other.capacity_), hash_(0), fixedCapacity_(other.fixedCapacity_)
 {
 	if (capacity_ > SmallBufferSize)
 	{
@@ -87,10 +88,11 @@ String::String(const String &other)
 
 	nctl::strncpy(data(), capacity_, other.data(), length_);
 	data()[length_] = '\0';
+	hash_ = other.hash_;
 }
 
 String::String(String &&other)
-    : length_(0), capacity_(0), fixedCapacity_(false)
+    : length_(0), capacity_(0), hash_(0), fixedCapacity_(false)
 {
 	swap(*this, other);
 }
@@ -131,6 +133,7 @@ String &String::operator=(const char *cString)
 /*! The method is useful to update the string length after writing into it through the `data()` pointer. */
 unsigned int String::setLength(unsigned int newLength)
 {
+	hash_ = 0;
 	length_ = (newLength > capacity_ - 1) ? capacity_ - 1 : newLength;
 	return length_;
 }
@@ -154,23 +157,25 @@ void String::setCapacity(unsigned int newCapacity)
 	else if (newCapacity > capacity_)
 		LOGD_X("String capacity growing from %u to %u", capacity_, newCapacity);
 
+	// The length could be cropped
+	hash_ = 0;
 	char *newArray = nullptr;
 	if (newCapacity > SmallBufferSize)
 	{
 #if !defined(WITH_ALLOCATORS)
 		newArray = static_cast<char *>(::operator new[](newCapacity * sizeof(char)));
 #else
-		newArray = theStringAllocator().newArray<char>(capacity_);
+		newArray = theStringAllocator().newArray<char>(newCapacity);
 #endif
 		if (length_ > 0)
 		{
-			if (newCapacity < length_) // shrinking
-				length_ = newCapacity; // cropping last elements
+			if (newCapacity <= length_) // shrinking
+				length_ = newCapacity - 1; // cropping last elements
 
 			if (capacity_ > SmallBufferSize)
-				nctl::strncpy(newArray, capacity_, array_.begin_, length_);
+				nctl::strncpy(newArray, newCapacity, array_.begin_, length_);
 			else
-				nctl::strncpy(newArray, SmallBufferSize, array_.local_, length_);
+				nctl::strncpy(newArray, newCapacity, array_.local_, length_);
 
 			newArray[length_] = '\0';
 		}
@@ -179,8 +184,8 @@ void String::setCapacity(unsigned int newCapacity)
 	{
 		// Capacity can't be smaller than the local buffer size
 		newCapacity = SmallBufferSize;
-		if (newCapacity < length_) // shrinking
-			length_ = newCapacity; // cropping last elements
+		if (newCapacity <= length_) // shrinking
+			length_ = newCapacity - 1; // cropping last elements
 	}
 
 	if (capacity_ > SmallBufferSize)
@@ -578,6 +583,24 @@ int String::utf8ToCodePoint(unsigned int position, unsigned int &codePoint) cons
 	return utf8ToCodePoint(position, codePoint, nullptr);
 }
 
+unsigned int String::utf8ToCodePoints(unsigned int *codePoints) const
+{
+	return Utf8::utf8ToCodePoints(data(), length_, codePoints);
+}
+
+bool String::isValidUtf8() const
+{
+	return Utf8::isValid(data(), length_);
+}
+
+uint32_t String::hash() const
+{
+	// A string whose hash is actually zero is hashed again every time
+	if (hash_ == 0)
+		hash_ = FNV1a::hash(data(), length_);
+	return hash_;
+}
+
 ///////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
@@ -1,7 +1,70 @@
+#include <cstdint>
+#include <cstring> // for memcpy()
 #include <nctl/Utf8.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define NCTL_UTF8_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+	#define NCTL_UTF8_NEON
+	#include <arm_neon.h>
+#endif
+
 namespace nctl {
 
+namespace {
+
+	/// The number of bytes checked at once by the ASCII fast path
+	const unsigned int BlockSize = 16;
+
+	/// Returns true if none of the bytes in the block has the most significant bit set
+	inline bool isAsciiBlock(const char *block)
+	{
+#if defined(NCTL_UTF8_SSE2)
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+		return (_mm_movemask_epi8(bytes) == 0);
+#elif defined(NCTL_UTF8_NEON)
+		const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t *>(block));
+		const uint8x8_t merged = vorr_u8(vget_low_u8(bytes), vget_high_u8(bytes));
+		return ((vget_lane_u64(vreinterpret_u64_u8(merged), 0) & 0x8080808080808080ULL) == 0);
+#else
+		uint64_t words[2];
+		memcpy(words, block, sizeof(words));
+		return (((words[0] | words[1]) & 0x8080808080808080ULL) == 0);
+#endif
+	}
+
+	/// Widens a block of ASCII characters to code points
+	inline void asciiBlockToCodePoints(const char *block, unsigned int *codePoints)
+	{
+#if defined(NCTL_UTF8_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+		const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+		const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+		__m128i *dest = reinterpret_cast<__m128i *>(codePoints);
+		_mm_storeu_si128(dest + 0, _mm_unpacklo_epi16(low, zero));
+		_mm_storeu_si128(dest + 1, _mm_unpackhi_epi16(low, zero));
+		_mm_storeu_si128(dest + 2, _mm_unpacklo_epi16(high, zero));
+		_mm_storeu_si128(dest + 3, _mm_unpackhi_epi16(high, zero));
+#elif defined(NCTL_UTF8_NEON)
+		static_assert(sizeof(unsigned int) == sizeof(uint32_t), "Code points should be 32 bits wide");
+		const uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t *>(block));
+		const uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+		const uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+		uint32_t *dest = reinterpret_cast<uint32_t *>(codePoints);
+		vst1q_u32(dest + 0, vmovl_u16(vget_low_u16(low)));
+		vst1q_u32(dest + 4, vmovl_u16(vget_high_u16(low)));
+		vst1q_u32(dest + 8, vmovl_u16(vget_low_u16(high)));
+		vst1q_u32(dest + 12, vmovl_u16(vget_high_u16(high)));
+#else
+		for (unsigned int i = 0; i < BlockSize; i++)
+			codePoints[i] = static_cast<unsigned char>(block[i]);
+#endif
+	}
+
+}
+
 const char *Utf8::utf8ToCodePoint(const char *substring, unsigned int &codePoint, unsigned int *codeUnits)
 {
 	if (substring == nullptr || *substring == '\0')
@@ -159,4 +222,114 @@ int Utf8::codePointToUtf8(unsigned int codePoint, char *substring, unsigned int
 	}
 }
 
+unsigned int Utf8::utf8ToCodePoints(const char *string, unsigned int length, unsigned int *codePoints)
+{
+	if (string == nullptr || codePoints == nullptr)
+		return 0;
+
+	unsigned int numCodePoints = 0;
+	unsigned int i = 0;
+	while (i < length)
+	{
+		// ASCII fast path, a block at a time
+		while (i + BlockSize <= length && isAsciiBlock(string + i))
+		{
+			asciiBlockToCodePoints(string + i, codePoints + numCodePoints);
+			i += BlockSize;
+			numCodePoints += BlockSize;
+		}
+
+		if (i >= length)
+			break;
+
+		const unsigned char character = static_cast<unsigned char>(string[i]);
+		if (character < 0x80)
+		{
+			codePoints[numCodePoints++] = character;
+			i++;
+			continue;
+		}
+
+		// The decoder stops at a null character, the last bytes are copied so as not to read past the end
+		const char *substring = string + i;
+		char lastBytes[5] = { '\0', '\0', '\0', '\0', '\0' };
+		if (length - i < 4)
+		{
+			memcpy(lastBytes, substring, length - i);
+			substring = lastBytes;
+		}
+
+		const char *nextSubstring = utf8ToCodePoint(substring, codePoints[numCodePoints++], nullptr);
+		i += static_cast<unsigned int>(nextSubstring - substring);
+	}
+
+	return numCodePoints;
+}
+
+bool Utf8::isValid(const char *string, unsigned int length)
+{
+	if (string == nullptr)
+		return (length == 0);
+
+	unsigned int i = 0;
+	while (i < length)
+	{
+		while (i + BlockSize <= length && isAsciiBlock(string + i))
+			i += BlockSize;
+
+		if (i >= length)
+			break;
+
+		const unsigned char character = static_cast<unsigned char>(string[i]);
+		if (character < 0x80)
+		{
+			i++;
+			continue;
+		}
+
+		unsigned int numContinuationBytes = 0;
+		unsigned int codePoint = 0;
+		unsigned int minCodePoint = 0;
+		if (character >= 0xc2 && character <= 0xdf)
+		{
+			numContinuationBytes = 1;
+			codePoint = character & 0x1f;
+			minCodePoint = 0x80;
+		}
+		else if (character >= 0xe0 && character <= 0xef)
+		{
+			numContinuationBytes = 2;
+			codePoint = character & 0x0f;
+			minCodePoint = 0x800;
+		}
+		else if (character >= 0xf0 && character <= 0xf4)
+		{
+			numContinuationBytes = 3;
+			codePoint = character & 0x07;
+			minCodePoint = 0x10000;
+		}
+		else
+			return false;
+
+		if (numContinuationBytes >= length - i)
+			return false;
+
+		for (unsigned int j = 1; j <= numContinuationBytes; j++)
+		{
+			const unsigned char continuation = static_cast<unsigned char>(string[i + j]);
+			if ((continuation & 0xc0) != 0x80)
+				return false;
+			codePoint = (codePoint << 6) | (continuation & 0x3f);
+		}
+
+		// Overlong encodings, surrogates and code points outside the Unicode range
+		if (codePoint < minCodePoint || codePoint > 0x10ffff || (codePoint >= 0xd800 && codePoint <= 0xdfff))
+			return false;
+
+		i += numContinuationBytes + 1;
+	}
+
+	return true;
+}
+
 }
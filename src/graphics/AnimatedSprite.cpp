@@ -73,6 +73,10 @@ void AnimatedSprite::update(float interval)
 	}
 
 	Sprite::update(interval);
+
+	// Animations advance every frame, and a paused one can be resumed through `currentAnimation()`
+	if (anims_.isEmpty() == false)
+		markSubtreeDirty();
 }
 
 void AnimatedSprite::addAnimation(const RectAnimation &anim)
@@ -82,6 +86,7 @@ void AnimatedSprite::addAnimation(const RectAnimation &anim)
 		anims_.pushBack(anim);
 		currentAnimIndex_ = anims_.size() - 1;
 		setTexRect(anims_[currentAnimIndex_].rect());
+		markSubtreeDirty();
 	}
 }
 
@@ -92,6 +97,7 @@ void AnimatedSprite::addAnimation(RectAnimation &&anim)
 		anims_.pushBack(nctl::move(anim));
 		currentAnimIndex_ = anims_.size() - 1;
 		setTexRect(anims_[currentAnimIndex_].rect());
+		markSubtreeDirty();
 	}
 }
 
@@ -36,6 +36,7 @@ void BaseSprite::setSize(float width, float height)
 	height_ = height;
 	dirtyBits_.set(DirtyBitPositions::SizeBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 }
 
 /*! \note If you set a texture that is already assigned, this method would be equivalent to `resetTexture()` */
@@ -45,6 +46,7 @@ void BaseSprite::setTexture(Texture *texture)
 	textureHasChanged(texture);
 	texture_ = texture;
 	dirtyBits_.set(DirtyBitPositions::TextureBit);
+	markSubtreeDirty();
 }
 
 /*! \note Use this method when the content of the currently assigned texture changes */
@@ -52,6 +54,7 @@ void BaseSprite::resetTexture()
 {
 	textureHasChanged(texture_);
 	dirtyBits_.set(DirtyBitPositions::TextureBit);
+	markSubtreeDirty();
 }
 
 void BaseSprite::setTexRect(const Recti &rect)
@@ -72,6 +75,7 @@ void BaseSprite::setTexRect(const Recti &rect)
 	}
 
 	dirtyBits_.set(DirtyBitPositions::TextureBit);
+	markSubtreeDirty();
 }
 
 void BaseSprite::setFlippedX(bool flippedX)
@@ -83,6 +87,7 @@ void BaseSprite::setFlippedX(bool flippedX)
 		flippedX_ = flippedX;
 
 		dirtyBits_.set(DirtyBitPositions::TextureBit);
+		markSubtreeDirty();
 	}
 }
 
@@ -95,6 +100,7 @@ void BaseSprite::setFlippedY(bool flippedY)
 		flippedY_ = flippedY;
 
 		dirtyBits_.set(DirtyBitPositions::TextureBit);
+		markSubtreeDirty();
 	}
 }
 
@@ -1,5 +1,7 @@
 #include <cstdint>
 #include <cstdlib> // for `strtoull()`
+#include <cstdio> // for `SEEK_SET`
+#include <cstring> // for `memcpy()`
 #include <nctl/CString.h>
 #include <nctl/HashMapIterator.h>
 #include "BinaryShaderCache.h"
@@ -14,20 +16,60 @@ namespace {
 	char const * const ShaderFilenameFormat = "%016llx_%08x_%016llx.bin";
 	char const * const ShaderInfoFilenameFormat = "%016llx_%08x_shaderInfo.txt";
 
+	/// The magic number at the beginning of a packed file ("NCSHADER")
+	const uint64_t PackedMagic = 0x5245444148534E43ULL;
+	const uint32_t PackedVersion = 1;
+
+	/// The header at the beginning of a packed file
+	struct PackedHeader
+	{
+		uint64_t magic;
+		uint32_t version;
+		uint32_t numEntries;
+		/// The size in bytes of the committed records following the header
+		uint64_t dataSize;
+	};
+
+	/// The header preceding every binary shader in a packed file
+	struct PackedRecord
+	{
+		uint64_t platformHash;
+		uint64_t shaderHash;
+		uint32_t binaryFormat;
+		uint32_t length;
+	};
+
+	/// Binaries are padded so that every record header is aligned to eight bytes
+	inline unsigned long int paddedLength(uint32_t length) { return (length + 7UL) & ~7UL; }
+
+	bool isValidHeader(const PackedHeader &header)
+	{
+		return (header.magic == PackedMagic && header.version == PackedVersion);
+	}
+
 	unsigned int bufferSize = 0;
 	nctl::UniquePtr<uint8_t[]> bufferPtr;
+	/// The last binary shader loaded, kept mapped until the next one is requested
+	nctl::UniquePtr<IFile> mappedFile;
 
 	nctl::String fileBaseName(64);
 	nctl::String filePath(fs::MaxPathLength);
 	char componentString[17] = "\0";
 }
 
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const char *BinaryShaderCache::PackedFilename = "binaryShaders.pack";
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
 
-BinaryShaderCache::BinaryShaderCache(bool enable, const char *dirname)
-    : isAvailable_(false), isInitialized_(false), isEnabled_(false), binaryFormat_(0), platformHash_(0), shaderInfos_(64)
+BinaryShaderCache::BinaryShaderCache(bool enable, bool packed, const char *dirname)
+    : isAvailable_(false), isInitialized_(false), isEnabled_(false), isPacked_(packed),
+      binaryFormat_(0), platformHash_(0), shaderInfos_(64), packedIndex_(64)
 {
 	const IGfxCapabilities &gfxCaps = theServiceLocator().gfxCapabilities();
 	const bool isSupported = gfxCaps.hasExtension(IGfxCapabilities::GLExtensions::ARB_GET_PROGRAM_BINARY) &&
@@ -140,6 +182,12 @@ unsigned int BinaryShaderCache::binarySize(uint32_t binaryFormat, uint64_t hash)
 	if (isEnabled_ == false || isAvailable_ == false)
 		return 0;
 
+	if (isPacked_)
+	{
+		const PackedEntry *entry = packedIndex_.find(hash);
+		return (entry != nullptr && entry->binaryFormat == binaryFormat) ? entry->length : 0;
+	}
+
 	fileBaseName.format(ShaderFilenameFormat, platformHash_, binaryFormat, hash);
 	filePath = fs::joinPath(directory_, fileBaseName);
 
@@ -155,32 +203,56 @@ const void *BinaryShaderCache::loadFromCache(uint32_t binaryFormat, uint64_t has
 	if (isEnabled_ == false || isAvailable_ == false)
 		return nullptr;
 
-	bool fileRead = false;
+	const void *binaryPtr = nullptr;
+	if (isPacked_)
+	{
+		const PackedEntry *entry = packedIndex_.find(hash);
+		if (entry == nullptr || entry->binaryFormat != binaryFormat)
+			return nullptr;
+
+		// Binaries appended after the file has been mapped are not part of the mapping yet
+		if (packedFile_ == nullptr || entry->offset + entry->length > static_cast<unsigned long int>(packedFile_->size()))
+			mapPackedFile();
+
+		if (packedFile_ != nullptr && entry->offset + entry->length <= static_cast<unsigned long int>(packedFile_->size()))
+		{
+			binaryPtr = static_cast<const uint8_t *>(packedFile_->data()) + entry->offset;
+			LOGI_X("Loaded binary shader 0x%016llx from the packed cache", hash);
+			statistics_.LoadedShaders++;
+		}
+		return binaryPtr;
+	}
+
 	fileBaseName.format(ShaderFilenameFormat, platformHash_, binaryFormat, hash);
 	filePath = fs::joinPath(directory_, fileBaseName);
 	if (fs::isReadableFile(filePath.data()))
 	{
-		nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(filePath.data());
-		fileHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
-		if (fileHandle->isOpened())
+		mappedFile = IFile::createMappedFileHandle(filePath.data());
+		mappedFile->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+		if (mappedFile->isOpened())
 		{
-			const long int fileSize = fileHandle->size();
-			if (bufferSize < fileSize)
+			// The binary is passed to OpenGL directly from the mapped file if possible
+			binaryPtr = mappedFile->data();
+			if (binaryPtr == nullptr)
 			{
-				bufferSize = fileSize;
-				bufferPtr = nctl::makeUnique<uint8_t[]>(bufferSize);
-			}
+				const long int fileSize = mappedFile->size();
+				if (bufferSize < fileSize)
+				{
+					bufferSize = fileSize;
+					bufferPtr = nctl::makeUnique<uint8_t[]>(bufferSize);
+				}
 
-			fileHandle->read(bufferPtr.get(), fileSize);
-			fileHandle->close();
+				mappedFile->read(bufferPtr.get(), fileSize);
+				mappedFile->close();
+				binaryPtr = bufferPtr.get();
+			}
 
 			LOGI_X("Loaded binary shader \"%s\" from cache", fileBaseName.data());
 			statistics_.LoadedShaders++;
-			fileRead = true;
 		}
 	}
 
-	return (fileRead) ? bufferPtr.get() : nullptr;
+	return binaryPtr;
 }
 
 bool BinaryShaderCache::saveToCache(int length, const void *buffer, uint32_t binaryFormat, uint64_t hash)
@@ -188,6 +260,9 @@ bool BinaryShaderCache::saveToCache(int length, const void *buffer, uint32_t bin
 	if (isEnabled_ == false || isAvailable_ == false || length <= 0)
 		return false;
 
+	if (isPacked_)
+		return (hasBinary(binaryFormat, hash) == false) ? appendToPackedFile(length, buffer, binaryFormat, hash) : false;
+
 	bool fileWritten = false;
 	fileBaseName.format(ShaderFilenameFormat, platformHash_, binaryFormat, hash);
 	filePath = fs::joinPath(directory_, fileBaseName);
@@ -237,10 +312,9 @@ bool BinaryShaderCache::registerShaderInfo(uint64_t shaderHashName, uint32_t bin
 		return false;
 
 	fileBaseName.format(ShaderFilenameFormat, platformHash_, binaryFormat, shaderHashName);
-	filePath = fs::joinPath(directory_, fileBaseName);
 
 	bool inserted = false;
-	if (fs::isReadableFile(filePath.data()))
+	if (hasBinary(binaryFormat, shaderHashName))
 	{
 		ShaderInfo shaderInfo;
 		shaderInfo.binaryFilename = fileBaseName.data();
@@ -273,7 +347,8 @@ void BinaryShaderCache::prune()
 	fs::Directory dir(directory_.data());
 	while (const char *entryName = dir.readNext())
 	{
-		if (parseShaderFilename(entryName, &platformHash, nullptr, nullptr))
+		// In packed mode the statistics only count the binaries inside the packed file
+		if (isPacked_ == false && parseShaderFilename(entryName, &platformHash, nullptr, nullptr))
 		{
 			// Deleting only binary shaders with different platform hashes
 			if (platformHash != platformHash_)
@@ -299,10 +374,24 @@ void BinaryShaderCache::prune()
 			}
 		}
 	}
+	dir.close();
+
+	if (isPacked_)
+		prunePackedFile();
 }
 
 void BinaryShaderCache::clear()
 {
+	if (isPacked_)
+	{
+		// The file needs to be unmapped before being deleted
+		packedFile_.reset(nullptr);
+		packedIndex_.clear();
+		filePath = fs::joinPath(directory_, PackedFilename);
+		if (fs::isFile(filePath.data()))
+			fs::deleteFile(filePath.data());
+	}
+
 	fs::Directory dir(directory_.data());
 	while (const char *entryName = dir.readNext())
 	{
@@ -395,6 +484,12 @@ void BinaryShaderCache::collectStatistics()
 	ASSERT(platformHash_ != 0);
 
 	clearStatistics();
+	if (isPacked_)
+	{
+		loadPackedIndex();
+		return;
+	}
+
 	uint64_t platformHash = 0;
 
 	fs::Directory dir(directory_.data());
@@ -427,6 +522,237 @@ void BinaryShaderCache::clearStatistics()
 	statistics_.TotalBytesCount = 0;
 }
 
+bool BinaryShaderCache::hasBinary(uint32_t binaryFormat, uint64_t hash) const
+{
+	if (isPacked_)
+	{
+		const PackedEntry *entry = packedIndex_.find(hash);
+		return (entry != nullptr && entry->binaryFormat == binaryFormat);
+	}
+
+	const ShaderFilename binaryFilename = formatShaderFilename(binaryFormat, hash);
+	return fs::isReadableFile(fs::joinPath(directory_, binaryFilename.data()).data());
+}
+
+void BinaryShaderCache::mapPackedFile()
+{
+	packedFile_.reset(nullptr);
+
+	filePath = fs::joinPath(directory_, PackedFilename);
+	if (fs::isReadableFile(filePath.data()) == false)
+		return;
+
+	packedFile_ = IFile::createMappedFileHandle(filePath.data());
+	packedFile_->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
+	if (packedFile_->isOpened() == false || packedFile_->data() == nullptr ||
+	    static_cast<unsigned long int>(packedFile_->size()) < sizeof(PackedHeader))
+	{
+		packedFile_.reset(nullptr);
+	}
+}
+
+void BinaryShaderCache::loadPackedIndex()
+{
+	packedIndex_.clear();
+	statistics_.PlatformFilesCount = 0;
+	statistics_.PlatformBytesCount = 0;
+	statistics_.TotalFilesCount = 0;
+	statistics_.TotalBytesCount = 0;
+
+	mapPackedFile();
+	if (packedFile_ == nullptr)
+		return;
+
+	const uint8_t *data = static_cast<const uint8_t *>(packedFile_->data());
+	const unsigned long int fileSize = packedFile_->size();
+
+	PackedHeader header;
+	memcpy(&header, data, sizeof(PackedHeader));
+	if (isValidHeader(header) == false || header.dataSize > fileSize - sizeof(PackedHeader))
+	{
+		LOGW_X("The packed binary shader file \"%s\" is not valid and will be rewritten", PackedFilename);
+		packedFile_.reset(nullptr);
+		return;
+	}
+
+	// Bytes past the committed data size belong to an interrupted append and are ignored
+	const unsigned long int dataEnd = sizeof(PackedHeader) + header.dataSize;
+	unsigned long int offset = sizeof(PackedHeader);
+	for (unsigned int i = 0; i < header.numEntries && offset + sizeof(PackedRecord) <= dataEnd; i++)
+	{
+		PackedRecord record;
+		memcpy(&record, data + offset, sizeof(PackedRecord));
+		const unsigned long int recordSize = sizeof(PackedRecord) + paddedLength(record.length);
+		if (offset + recordSize > dataEnd)
+			break;
+
+		if (record.platformHash == platformHash_)
+		{
+			PackedEntry entry;
+			entry.binaryFormat = record.binaryFormat;
+			entry.length = record.length;
+			entry.offset = offset + sizeof(PackedRecord);
+
+			if (packedIndex_.loadFactor() >= 0.8f)
+				packedIndex_.rehash(packedIndex_.capacity() * 2);
+			packedIndex_.insert(record.shaderHash, entry);
+
+			statistics_.PlatformFilesCount++;
+			statistics_.PlatformBytesCount += record.length;
+		}
+		statistics_.TotalFilesCount++;
+		statistics_.TotalBytesCount += record.length;
+
+		offset += recordSize;
+	}
+
+	LOGI_X("Loaded packed binary shader file \"%s\" (%u binaries for this platform, %u total)",
+	       PackedFilename, statistics_.PlatformFilesCount, statistics_.TotalFilesCount);
+}
+
+bool BinaryShaderCache::appendToPackedFile(int length, const void *buffer, uint32_t binaryFormat, uint64_t hash)
+{
+	filePath = fs::joinPath(directory_, PackedFilename);
+
+	PackedHeader header;
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(filePath.data());
+	if (fs::isFile(filePath.data()))
+	{
+		fileHandle->open(IFile::OpenMode::READ | IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+		if (fileHandle->isOpened() == false)
+			return false;
+
+		const unsigned long int bytesRead = fileHandle->read(&header, sizeof(PackedHeader));
+		if (bytesRead != sizeof(PackedHeader) || isValidHeader(header) == false)
+			fileHandle->close();
+	}
+
+	if (fileHandle->isOpened() == false)
+	{
+		// The mapping of a file that is going to be truncated cannot be accessed anymore
+		packedFile_.reset(nullptr);
+		packedIndex_.clear();
+
+		fileHandle->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+		if (fileHandle->isOpened() == false)
+			return false;
+
+		header.magic = PackedMagic;
+		header.version = PackedVersion;
+		header.numEntries = 0;
+		header.dataSize = 0;
+		fileHandle->write(&header, sizeof(PackedHeader));
+	}
+
+	PackedRecord record;
+	record.platformHash = platformHash_;
+	record.shaderHash = hash;
+	record.binaryFormat = binaryFormat;
+	record.length = static_cast<uint32_t>(length);
+	const uint64_t padding = 0;
+
+	const unsigned long int recordOffset = sizeof(PackedHeader) + header.dataSize;
+	fileHandle->seek(recordOffset, SEEK_SET);
+	unsigned long int bytesWritten = fileHandle->write(&record, sizeof(PackedRecord));
+	bytesWritten += fileHandle->write(buffer, length);
+	bytesWritten += fileHandle->write(&padding, paddedLength(record.length) - record.length);
+
+	const bool recordWritten = (bytesWritten == sizeof(PackedRecord) + paddedLength(record.length));
+	if (recordWritten)
+	{
+		// The record is committed only now, an interrupted write leaves the previous header valid
+		header.numEntries++;
+		header.dataSize += sizeof(PackedRecord) + paddedLength(record.length);
+		fileHandle->seek(0, SEEK_SET);
+		fileHandle->write(&header, sizeof(PackedHeader));
+	}
+	fileHandle->close();
+
+	if (recordWritten)
+	{
+		PackedEntry entry;
+		entry.binaryFormat = binaryFormat;
+		entry.length = record.length;
+		entry.offset = recordOffset + sizeof(PackedRecord);
+
+		if (packedIndex_.loadFactor() >= 0.8f)
+			packedIndex_.rehash(packedIndex_.capacity() * 2);
+		packedIndex_.insert(hash, entry);
+
+		LOGI_X("Saved binary shader 0x%016llx to the packed cache", hash);
+		statistics_.SavedShaders++;
+		statistics_.PlatformFilesCount++;
+		statistics_.PlatformBytesCount += length;
+		statistics_.TotalFilesCount++;
+		statistics_.TotalBytesCount += length;
+	}
+
+	return recordWritten;
+}
+
+void BinaryShaderCache::prunePackedFile()
+{
+	mapPackedFile();
+	if (packedFile_ == nullptr || statistics_.TotalFilesCount == statistics_.PlatformFilesCount)
+		return;
+
+	const uint8_t *data = static_cast<const uint8_t *>(packedFile_->data());
+	PackedHeader header;
+	memcpy(&header, data, sizeof(PackedHeader));
+	if (isValidHeader(header) == false)
+		return;
+
+	nctl::String tempFilePath = fs::joinPath(directory_, PackedFilename);
+	tempFilePath.formatAppend(".tmp");
+	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(tempFilePath.data());
+	fileHandle->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+	if (fileHandle->isOpened() == false)
+		return;
+
+	PackedHeader prunedHeader;
+	prunedHeader.magic = PackedMagic;
+	prunedHeader.version = PackedVersion;
+	prunedHeader.numEntries = 0;
+	prunedHeader.dataSize = 0;
+	fileHandle->write(&prunedHeader, sizeof(PackedHeader));
+
+	const unsigned long int dataEnd = sizeof(PackedHeader) + header.dataSize;
+	unsigned long int offset = sizeof(PackedHeader);
+	for (unsigned int i = 0; i < header.numEntries && offset + sizeof(PackedRecord) <= dataEnd; i++)
+	{
+		PackedRecord record;
+		memcpy(&record, data + offset, sizeof(PackedRecord));
+		const unsigned long int recordSize = sizeof(PackedRecord) + paddedLength(record.length);
+		if (offset + recordSize > dataEnd)
+			break;
+
+		// Keeping only binary shaders with the same platform hash
+		if (record.platformHash == platformHash_)
+		{
+			fileHandle->write(data + offset, recordSize);
+			prunedHeader.numEntries++;
+			prunedHeader.dataSize += recordSize;
+		}
+		offset += recordSize;
+	}
+
+	fileHandle->seek(0, SEEK_SET);
+	fileHandle->write(&prunedHeader, sizeof(PackedHeader));
+	fileHandle->close();
+
+	// The file needs to be unmapped before being replaced
+	packedFile_.reset(nullptr);
+	filePath = fs::joinPath(directory_, PackedFilename);
+	// `MoveFile()` on Windows does not replace an existing file
+	if (fs::rename(tempFilePath.data(), filePath.data()) == false)
+	{
+		fs::deleteFile(filePath.data());
+		fs::rename(tempFilePath.data(), filePath.data());
+	}
+
+	loadPackedIndex();
+}
+
 bool BinaryShaderCache::loadShaderInfoFromCache(uint32_t binaryFormat)
 {
 	if (isAvailable_ == false)
@@ -464,8 +790,8 @@ bool BinaryShaderCache::loadShaderInfoFromCache(uint32_t binaryFormat)
 					// Generate the binary shader filename from its shader hash name
 					shaderInfo.binaryFilename.format(ShaderFilenameFormat, platformHash_, binaryFormat, shaderHashName);
 
-					// Insert in the hashmap only if the binary shader file exists
-					if (fs::isReadableFile(fs::joinPath(directory_, shaderInfo.binaryFilename.data()).data()))
+					// Insert in the hashmap only if the binary shader exists
+					if (hasBinary(binaryFormat, shaderHashName))
 					{
 						LOGD_X("Shader information entry (file found): \"%s\", \"%s\", %d",
 						       shaderInfo.binaryFilename.data(), shaderInfo.objectLabel.data(), shaderInfo.batchSize);
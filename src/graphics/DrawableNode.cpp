@@ -6,6 +6,7 @@
 #include "Viewport.h"
 #include "Application.h"
 #include "RenderStatistics.h"
+#include "TransformRect.h"
 #include "tracy.h"
 
 namespace ncine {
@@ -113,7 +114,8 @@ bool DrawableNode::draw(RenderQueue &renderQueue)
 	if (width_ == 0.0f || height_ == 0.0f)
 		return false;
 
-	const bool cullingEnabled = theApplication().renderingSettings().cullingEnabled;
+	const Application::RenderingSettings &settings = theApplication().renderingSettings();
+	const bool cullingEnabled = settings.cullingEnabled;
 
 	bool overlaps = false;
 	if (cullingEnabled && lastFrameRendered_ == theApplication().numFrames())
@@ -129,6 +131,13 @@ bool DrawableNode::draw(RenderQueue &renderQueue)
 		renderCommand_->setLayer(absLayer_);
 		renderCommand_->setVisitOrder(withVisitOrder_ ? visitOrderIndex_ : 0);
 		updateRenderCommand();
+		// The bounding box is only kept updated by the culling check
+		if (cullingEnabled == false && settings.reorderingEnabled && dirtyBits_.test(DirtyBitPositions::AabbBit))
+		{
+			updateAabb();
+			dirtyBits_.reset(DirtyBitPositions::AabbBit);
+		}
+		renderCommand_->setAabb(aabb_);
 		renderQueue.addCommand(renderCommand_.get());
 	}
 	else
@@ -146,7 +155,7 @@ void DrawableNode::setAnchorPoint(float xx, float yy)
 {
 	const float clampedX = nctl::clamp(xx, 0.0f, 1.0f);
 	const float clampedY = nctl::clamp(yy, 0.0f, 1.0f);
-	anchorPoint_.set((clampedX - 0.5f) * width(), (clampedY - 0.5f) * height());
+	setAbsAnchorPoint((clampedX - 0.5f) * width(), (clampedY - 0.5f) * height());
 }
 
 bool DrawableNode::isBlendingEnabled() const
@@ -204,20 +213,8 @@ void DrawableNode::updateAabb()
 {
 	ZoneScoped;
 
-	const float width = absWidth();
-	const float height = absHeight();
-	float rotatedWidth = width;
-	float rotatedHeight = height;
-
-	if (absRotation_ > MinRotation || absRotation_ < -MinRotation)
-	{
-		const float sinRot = sinf(absRotation_ * fDegToRad);
-		const float cosRot = cosf(absRotation_ * fDegToRad);
-		rotatedWidth = fabsf(width * cosRot) + fabsf(height * sinRot);
-		rotatedHeight = fabsf(width * sinRot) + fabsf(height * cosRot);
-	}
-
-	aabb_ = Rectf::fromCenterSize(absPosition_.x, absPosition_.y, rotatedWidth, rotatedHeight);
+	// The world matrix includes the anchor point offset, the drawable is centered on the local origin
+	aabb_ = transformRect(worldMatrix_, Rectf::fromCenterSize(0.0f, 0.0f, width_, height_));
 }
 
 void DrawableNode::updateCulling()
@@ -11,7 +11,7 @@ namespace ncine {
 
 Geometry::Geometry()
     : primitiveType_(GL_TRIANGLES), firstVertex_(0), numVertices_(0),
-      numElementsPerVertex_(2), firstIndex_(0), numIndices_(0),
+      numElementsPerVertex_(2), firstIndex_(0), numIndices_(0), indexType_(GL_UNSIGNED_SHORT),
       hostVertexPointer_(nullptr), hostIndexPointer_(nullptr),
       vboUsageFlags_(0), sharedVboParams_(nullptr),
       iboUsageFlags_(0), sharedIboParams_(nullptr),
@@ -114,10 +114,13 @@ void Geometry::shareVbo(const Geometry *geometry)
 	}
 }
 
-void Geometry::createCustomIbo(unsigned int numIndices, GLenum usage)
+void Geometry::createCustomIbo(unsigned int numIndices, GLenum usage, GLenum indexType)
 {
+	ASSERT(indexType == GL_UNSIGNED_SHORT || indexType == GL_UNSIGNED_INT);
+	indexType_ = indexType;
+
 	ibo_ = nctl::makeUnique<GLBufferObject>(GL_ELEMENT_ARRAY_BUFFER);
-	ibo_->bufferData(numIndices * sizeof(GLushort), nullptr, usage);
+	ibo_->bufferData(numIndices * indexSize(), nullptr, usage);
 
 	iboUsageFlags_ = usage;
 	iboParams_.object = ibo_.get();
@@ -128,39 +131,6 @@ void Geometry::createCustomIbo(unsigned int numIndices, GLenum usage)
 	RenderStatistics::addCustomIbo(ibo_->size());
 }
 
-GLushort *Geometry::acquireIndexPointer(unsigned int numIndices)
-{
-	ASSERT(ibo_ == nullptr);
-	hasDirtyIndices_ = true;
-
-	if (sharedIboParams_)
-		iboParams_ = *sharedIboParams_;
-	else
-	{
-		const RenderBuffersManager::BufferTypes::Enum bufferType = RenderBuffersManager::BufferTypes::ELEMENT_ARRAY;
-		if (iboParams_.mapBase == nullptr)
-			iboParams_ = RenderResources::buffersManager().acquireMemory(bufferType, numIndices * sizeof(GLushort));
-	}
-
-	return reinterpret_cast<GLushort *>(iboParams_.mapBase + iboParams_.offset);
-}
-
-/*! This method can only be used when mapping of OpenGL buffers is available */
-GLushort *Geometry::acquireIndexPointer()
-{
-	ASSERT(ibo_);
-	hasDirtyIndices_ = true;
-
-	if (iboParams_.mapBase == nullptr)
-	{
-		const GLenum mapFlags = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::ELEMENT_ARRAY).mapFlags;
-		FATAL_ASSERT_MSG(mapFlags, "Mapping of OpenGL buffers is not available");
-		iboParams_.mapBase = static_cast<GLubyte *>(ibo_->mapBufferRange(0, ibo_->size(), mapFlags));
-	}
-
-	return reinterpret_cast<GLushort *>(iboParams_.mapBase);
-}
-
 void Geometry::releaseIndexPointer()
 {
 	// Don't flush and unmap if the IBO is not custom
@@ -174,7 +144,18 @@ void Geometry::releaseIndexPointer()
 
 void Geometry::setHostIndexPointer(const GLushort *indexPointer)
 {
+	// A custom IBO can only store indices of the type it has been created with
+	ASSERT(ibo_ == nullptr || indexType_ == GL_UNSIGNED_SHORT);
+	hasDirtyIndices_ = true;
+	indexType_ = GL_UNSIGNED_SHORT;
+	hostIndexPointer_ = indexPointer;
+}
+
+void Geometry::setHostIndexPointer(const GLuint *indexPointer)
+{
+	ASSERT(ibo_ == nullptr || indexType_ == GL_UNSIGNED_INT);
 	hasDirtyIndices_ = true;
+	indexType_ = GL_UNSIGNED_INT;
 	hostIndexPointer_ = indexPointer;
 }
 
@@ -205,15 +186,15 @@ void Geometry::draw(GLsizei numInstances)
 
 	void *iboOffsetPtr = nullptr;
 	if (numIndices_ > 0)
-		iboOffsetPtr = reinterpret_cast<void *>(iboParams().offset + firstIndex_ * sizeof(GLushort));
+		iboOffsetPtr = reinterpret_cast<void *>(iboParams().offset + firstIndex_ * indexSize());
 
 	if (numInstances == 0)
 	{
 		if (numIndices_ > 0)
 #if (defined(WITH_OPENGLES) && !GL_ES_VERSION_3_2) || defined(__EMSCRIPTEN__)
-			glDrawElements(primitiveType_, numIndices_, GL_UNSIGNED_SHORT, iboOffsetPtr);
+			glDrawElements(primitiveType_, numIndices_, indexType_, iboOffsetPtr);
 #else
-			glDrawElementsBaseVertex(primitiveType_, numIndices_, GL_UNSIGNED_SHORT, iboOffsetPtr, vboOffset);
+			glDrawElementsBaseVertex(primitiveType_, numIndices_, indexType_, iboOffsetPtr, vboOffset);
 #endif
 		else
 			glDrawArrays(primitiveType_, vboOffset, numVertices_);
@@ -222,9 +203,9 @@ void Geometry::draw(GLsizei numInstances)
 	{
 		if (numIndices_ > 0)
 #if (defined(WITH_OPENGLES) && !GL_ES_VERSION_3_2) || defined(__EMSCRIPTEN__)
-			glDrawElementsInstanced(primitiveType_, numIndices_, GL_UNSIGNED_SHORT, iboOffsetPtr, numInstances);
+			glDrawElementsInstanced(primitiveType_, numIndices_, indexType_, iboOffsetPtr, numInstances);
 #else
-			glDrawElementsInstancedBaseVertex(primitiveType_, numIndices_, GL_UNSIGNED_SHORT, iboOffsetPtr, numInstances, vboOffset);
+			glDrawElementsInstancedBaseVertex(primitiveType_, numIndices_, indexType_, iboOffsetPtr, numInstances, vboOffset);
 #endif
 		else
 			glDrawArraysInstanced(primitiveType_, vboOffset, numVertices_, numInstances);
@@ -273,8 +254,8 @@ void Geometry::commitIndices()
 		}
 		else
 		{
-			GLushort *indices = ibo_ ? acquireIndexPointer() : acquireIndexPointer(numIndices_);
-			memcpy(indices, hostIndexPointer_, numIndices_ * sizeof(GLushort));
+			GLubyte *indices = ibo_ ? acquireIndexData(indexType_) : acquireIndexData(numIndices_, indexType_);
+			memcpy(indices, hostIndexPointer_, numIndices_ * indexSize());
 			releaseIndexPointer();
 		}
 
@@ -284,4 +265,42 @@ void Geometry::commitIndices()
 	}
 }
 
+GLubyte *Geometry::acquireIndexData(unsigned int numIndices, GLenum indexType)
+{
+	ASSERT(ibo_ == nullptr);
+	ASSERT(indexType == GL_UNSIGNED_SHORT || indexType == GL_UNSIGNED_INT);
+	hasDirtyIndices_ = true;
+	indexType_ = indexType;
+
+	if (sharedIboParams_)
+		iboParams_ = *sharedIboParams_;
+	else
+	{
+		const RenderBuffersManager::BufferTypes::Enum bufferType = RenderBuffersManager::BufferTypes::ELEMENT_ARRAY;
+		// The common IBO is shared by 16-bit and 32-bit indices, the offset needs to be aligned to the index size
+		if (iboParams_.mapBase == nullptr)
+			iboParams_ = RenderResources::buffersManager().acquireMemory(bufferType, numIndices * indexSize(), indexSize());
+	}
+
+	return iboParams_.mapBase + iboParams_.offset;
+}
+
+/*! This method can only be used when mapping of OpenGL buffers is available */
+GLubyte *Geometry::acquireIndexData(GLenum indexType)
+{
+	ASSERT(ibo_);
+	// A custom IBO can only store indices of the type it has been created with
+	ASSERT(indexType == indexType_);
+	hasDirtyIndices_ = true;
+
+	if (iboParams_.mapBase == nullptr)
+	{
+		const GLenum mapFlags = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::ELEMENT_ARRAY).mapFlags;
+		FATAL_ASSERT_MSG(mapFlags, "Mapping of OpenGL buffers is not available");
+		iboParams_.mapBase = static_cast<GLubyte *>(ibo_->mapBufferRange(0, ibo_->size(), mapFlags));
+	}
+
+	return iboParams_.mapBase;
+}
+
 }
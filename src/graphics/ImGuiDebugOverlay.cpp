@@ -13,15 +13,20 @@
 #include "MeshSprite.h"
 #include "ParticleSystem.h"
 #include "TextNode.h"
+#include "StaticBatchNode.h"
+#include "TileMapNode.h"
 
 #ifdef WITH_AUDIO
 	#include "IAudioPlayer.h"
+	#include "AudioBufferCache.h"
 #endif
 
 #include "IFrameTimer.h"
+#include "FileSystem.h"
 #include "RenderStatistics.h"
 #include "RenderResources.h"
 #include "BinaryShaderCache.h"
+#include "RenderCapture.h"
 #include "Hash64.h"
 
 #ifdef WITH_LUA
@@ -34,6 +39,8 @@
 
 #ifdef WITH_ALLOCATORS
 	#include "allocators_config.h"
+	#include <nctl/FrameAllocator.h>
+	#include <nctl/AllocTelemetry.h>
 #endif
 
 #include "version.h"
@@ -66,6 +73,8 @@ namespace {
 			case Object::ObjectType::PARTICLE: return "Particle";
 			case Object::ObjectType::PARTICLE_SYSTEM: return "ParticleSystem";
 			case Object::ObjectType::TEXTNODE: return "TextNode";
+			case Object::ObjectType::STATIC_BATCH_NODE: return "StaticBatchNode";
+			case Object::ObjectType::TILEMAP_NODE: return "TileMapNode";
 			default: return "N/A";
 		}
 	}
@@ -713,8 +722,10 @@ void ImGuiDebugOverlay::guiApplicationConfiguration()
 		ImGui::Text("Fixed batch size: %u", appCfg.fixedBatchSize);
 #endif
 		ImGui::Text("Binary shader cache: %s", appCfg.useBinaryShaderCache ? "true" : "false");
+		ImGui::Text("Packed shader cache: %s", appCfg.usePackedShaderCache ? "true" : "false");
 		ImGui::Text("Shader cache directory name: \"%s\"", appCfg.shaderCacheDirname.data());
 		ImGui::Text("Compile batched shaders twice: %s", appCfg.compileBatchedShadersTwice ? "true" : "false");
+		ImGui::Text("Packed text vertices: %s", appCfg.packedTextVertices ? "true" : "false");
 		ImGui::Text("VBO size: %lu", appCfg.vboSize);
 		ImGui::Text("IBO size: %lu", appCfg.iboSize);
 		ImGui::Text("Vao pool size: %u", appCfg.vaoPoolSize);
@@ -733,6 +744,7 @@ void ImGuiDebugOverlay::guiApplicationConfiguration()
 		ImGui::Text("VSync: %s", appCfg.withVSync ? "true" : "false");
 		ImGui::Text("%s Debug Context: %s", openglApiName, appCfg.withGlDebugContext ? "true" : "false");
 		ImGui::Text("Console Colors: %s", appCfg.withConsoleColors ? "true" : "false");
+		ImGui::Text("Log Crash Handlers: %s", appCfg.withLogCrashHandlers ? "true" : "false");
 	}
 }
 
@@ -762,6 +774,23 @@ void ImGuiDebugOverlay::guiRenderingSettings()
 #endif
 		settings.minBatchSize = minBatchSize;
 		settings.maxBatchSize = maxBatchSize;
+
+		ImGui::Checkbox("Transparent reordering", &settings.reorderingEnabled);
+		int reorderingWindowSize = settings.reorderingWindowSize;
+		ImGui::SliderInt("Look-ahead window", &reorderingWindowSize, 1, 256);
+		settings.reorderingWindowSize = reorderingWindowSize;
+		const RenderStatistics::Reordering &reordering = RenderStatistics::reordering();
+		ImGui::Text("Moved commands: %u, material changes saved: %u", reordering.movedCommands, reordering.savedSplits);
+
+		static int numCaptureFrames = 60;
+		ImGui::BeginDisabled(RenderCapture::isCapturing());
+		ImGui::SliderInt("Frames", &numCaptureFrames, 1, 600);
+		ImGui::SameLine();
+		if (ImGui::Button("Capture render queues"))
+			RenderCapture::start(fs::joinPath(fs::savePath(), "render_capture.bin").data(), numCaptureFrames);
+		ImGui::EndDisabled();
+		if (RenderCapture::isCapturing())
+			ImGui::Text("Capturing: %u queues", RenderCapture::numCapturedQueues());
 	}
 }
 
@@ -955,6 +984,20 @@ void ImGuiDebugOverlay::guiAudioPlayers()
 				audioDevice.pausePlayers();
 		}
 
+		if (ImGui::TreeNode("Buffer Cache"))
+		{
+			AudioBufferCache &cache = theAudioBufferCache();
+			const AudioBufferCache::Statistics &stats = cache.statistics();
+			ImGui::Text("Entries: %u", cache.numEntries());
+			ImGui::Text("Resident: %lu / %lu bytes", cache.residentBytes(), cache.memoryBudget());
+			ImGui::Text("Compressed: %lu bytes", cache.compressedBytes());
+			ImGui::Text("Hits: %u, Misses: %u, Evictions: %u", stats.hits, stats.misses, stats.evictions);
+			ImGui::Text("Decodes: %u (%u asynchronous)", stats.decodes, stats.asyncDecodes);
+			if (ImGui::Button("Purge"))
+				cache.purge();
+			ImGui::TreePop();
+		}
+
 		// Stopping or pausing players change the number of active ones
 		numPlayers = audioDevice.numPlayers();
 		for (unsigned int i = 0; i < numPlayers; i++)
@@ -1193,6 +1236,8 @@ void ImGuiDebugOverlay::guiBinaryShaderCache()
 			ImGui::BeginDisabled(isEnabled == false);
 
 			ImGui::Text("Directory: %s", cache.directory().data());
+			if (cache.isPacked())
+				ImGui::Text("Packed file: %s", BinaryShaderCache::PackedFilename);
 			// Reporting statistics for shaders hashing
 			const Hash64::Statistics &hash64Stats = RenderResources::hash64().statistics();
 			ImGui::Text("Hashed: %u sources (%u strings, %u characters), %u files, %u scanned",
@@ -1502,6 +1547,70 @@ void ImGuiDebugOverlay::guiAllocators()
 			else
 				ImGui::Text("The %s allocator is the default one", allocatorNames[i]);
 		}
+
+		const nctl::FrameAllocator &frameAllocator = nctl::theFrameAllocator();
+		widgetName_.format("Frame Allocator \"%s\" (%d allocations, %lu bytes)###FrameAllocator",
+		                   frameAllocator.name(), frameAllocator.numAllocations(), frameAllocator.usedMemory());
+		if (ImGui::TreeNode(widgetName_.data()))
+		{
+			ImGui::Text("Last frame: %lu bytes, %lu fallbacks", frameAllocator.lastFrameUsedMemory(), frameAllocator.lastFrameNumFallbacks());
+			ImGui::Text("High water mark: %lu of %lu bytes per frame", frameAllocator.highWaterMark(), frameAllocator.size() / 2);
+			if (ImGui::Button("Reset"))
+				nctl::theFrameAllocator().resetHighWaterMark();
+			ImGui::TreePop();
+		}
+
+		const nctl::AllocTelemetry &telemetry = nctl::theAllocTelemetry();
+		if (telemetry.numEntries() > 0 && ImGui::TreeNode("Telemetry"))
+		{
+			if (ImGui::BeginTable("allocatorTelemetry", 7, ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingStretchProp))
+			{
+				ImGui::TableSetupColumn("Allocator");
+				ImGui::TableSetupColumn("Used");
+				ImGui::TableSetupColumn("Peak");
+				ImGui::TableSetupColumn("Frame Peak");
+				ImGui::TableSetupColumn("Allocations/Frame");
+				ImGui::TableSetupColumn("Fragmentation");
+				ImGui::TableSetupColumn("Budget");
+				ImGui::TableHeadersRow();
+
+				for (unsigned int i = 0; i < telemetry.numEntries(); i++)
+				{
+					const nctl::AllocTelemetry::Entry &e = telemetry.entry(i);
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(e.allocator->name());
+					ImGui::TableNextColumn();
+					ImGui::Text("%lu", e.allocator->usedMemory());
+					ImGui::TableNextColumn();
+					ImGui::Text("%lu", e.peakMemory);
+					ImGui::TableNextColumn();
+					ImGui::Text("%lu", e.framePeakMemory);
+					ImGui::TableNextColumn();
+					ImGui::Text("%lu", e.numFrameAllocations);
+					ImGui::TableNextColumn();
+					if (e.freeList)
+						ImGui::Text("%.1f%%", e.fragmentation * 100.0f);
+					else
+						ImGui::TextUnformatted("n/a");
+					ImGui::TableNextColumn();
+					if (e.budget == 0)
+						ImGui::TextUnformatted("none");
+					else if (e.isOverBudget)
+						ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "%lu", e.budget);
+					else
+						ImGui::Text("%lu", e.budget);
+				}
+
+				ImGui::EndTable();
+			}
+
+			if (ImGui::Button("Reset Peaks"))
+				nctl::theAllocTelemetry().resetPeaks();
+			ImGui::SameLine();
+			ImGui::Text("CSV recording: %s", telemetry.isRecordingCsv() ? "on" : "off");
+			ImGui::TreePop();
+		}
 	}
 #endif
 }
@@ -1537,7 +1646,9 @@ void ImGuiDebugOverlay::guiRecursiveChildrenNodes(SceneNode *node, unsigned int
 {
 	DrawableNode *drawable = nullptr;
 	if (node->type() != Object::ObjectType::SCENENODE &&
-	    node->type() != Object::ObjectType::PARTICLE_SYSTEM)
+	    node->type() != Object::ObjectType::PARTICLE_SYSTEM &&
+	    node->type() != Object::ObjectType::STATIC_BATCH_NODE &&
+	    node->type() != Object::ObjectType::TILEMAP_NODE)
 	{
 		drawable = reinterpret_cast<DrawableNode *>(node);
 	}
@@ -1562,6 +1673,14 @@ void ImGuiDebugOverlay::guiRecursiveChildrenNodes(SceneNode *node, unsigned int
 	if (node->type() == Object::ObjectType::TEXTNODE)
 		textnode = reinterpret_cast<TextNode *>(node);
 
+	StaticBatchNode *staticBatch = nullptr;
+	if (node->type() == Object::ObjectType::STATIC_BATCH_NODE)
+		staticBatch = reinterpret_cast<StaticBatchNode *>(node);
+
+	TileMapNode *tileMap = nullptr;
+	if (node->type() == Object::ObjectType::TILEMAP_NODE)
+		tileMap = reinterpret_cast<TileMapNode *>(node);
+
 	widgetName_.format("#%u ", childId);
 	if (node->name() != nullptr)
 		widgetName_.formatAppend("\"%s\" ", node->name());
@@ -1681,6 +1800,18 @@ void ImGuiDebugOverlay::guiRecursiveChildrenNodes(SceneNode *node, unsigned int
 			if (ImGui::Button("Kill All##Particles"))
 				particleSys->killParticles();
 		}
+		else if (staticBatch)
+		{
+			ImGui::Text("Baked children: %u, Chunks: %u, Bakes: %u", staticBatch->numBakedChildren(), staticBatch->numChunks(), staticBatch->numBakes());
+			ImGui::SameLine();
+			if (ImGui::Button("Bake##StaticBatch"))
+				staticBatch->invalidateBake();
+		}
+		else if (tileMap)
+		{
+			ImGui::Text("Map size: %d x %d, Resident chunks: %u / %u", tileMap->mapSize().x, tileMap->mapSize().y,
+			            tileMap->numResidentChunks(), tileMap->numChunks());
+		}
 		if (textnode)
 		{
 			nctl::String textnodeString(textnode->string());
@@ -12,24 +12,24 @@ namespace ncine {
 // STATIC DEFINITIONS
 ///////////////////////////////////////////////////////////
 
-const char *Material::InstanceBlockName = "InstanceBlock";
-const char *Material::InstancesBlockName = "InstancesBlock";
-const char *Material::ModelMatrixUniformName = "modelMatrix";
-
-const char *Material::GuiProjectionMatrixUniformName = "uGuiProjection";
-const char *Material::DepthUniformName = "uDepth";
-const char *Material::ProjectionMatrixUniformName = "uProjectionMatrix";
-const char *Material::ViewMatrixUniformName = "uViewMatrix";
+const nctl::HashedName Material::InstanceBlockName("InstanceBlock");
+const nctl::HashedName Material::InstancesBlockName("InstancesBlock");
+const nctl::HashedName Material::ModelMatrixUniformName("modelMatrix");
+
+const nctl::HashedName Material::GuiProjectionMatrixUniformName("uGuiProjection");
+const nctl::HashedName Material::DepthUniformName("uDepth");
+const nctl::HashedName Material::ProjectionMatrixUniformName("uProjectionMatrix");
+const nctl::HashedName Material::ViewMatrixUniformName("uViewMatrix");
 const char *Material::ProjectionViewMatrixExcludeString = "uProjectionMatrix\0uViewMatrix\0";
 
-const char *Material::TextureUniformName = "uTexture";
-const char *Material::ColorUniformName = "color";
-const char *Material::SpriteSizeUniformName = "spriteSize";
-const char *Material::TexRectUniformName = "texRect";
-const char *Material::PositionAttributeName = "aPosition";
-const char *Material::TexCoordsAttributeName = "aTexCoords";
-const char *Material::MeshIndexAttributeName = "aMeshIndex";
-const char *Material::ColorAttributeName = "aColor";
+const nctl::HashedName Material::TextureUniformName("uTexture");
+const nctl::HashedName Material::ColorUniformName("color");
+const nctl::HashedName Material::SpriteSizeUniformName("spriteSize");
+const nctl::HashedName Material::TexRectUniformName("texRect");
+const nctl::HashedName Material::PositionAttributeName("aPosition");
+const nctl::HashedName Material::TexCoordsAttributeName("aTexCoords");
+const nctl::HashedName Material::MeshIndexAttributeName("aMeshIndex");
+const nctl::HashedName Material::ColorAttributeName("aColor");
 
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
@@ -93,6 +93,11 @@ void Material::setDefaultAttributesParameters()
 	RenderResources::setDefaultAttributesParameters(*shaderProgram_);
 }
 
+void Material::setPackedAttributesParameters()
+{
+	RenderResources::setPackedAttributesParameters(*shaderProgram_);
+}
+
 void Material::reserveUniformsDataMemory()
 {
 	ASSERT(shaderProgram_);
@@ -28,7 +28,7 @@ MeshSprite::MeshSprite(Texture *texture)
 MeshSprite::MeshSprite(SceneNode *parent, Texture *texture, float xx, float yy)
     : BaseSprite(parent, texture, xx, yy),
       vertices_(16), vertexDataPointer_(nullptr), bytesPerVertex_(0), numVertices_(0),
-      indices_(16), indexDataPointer_(nullptr), numIndices_(0)
+      indices_(16), indexDataPointer_(nullptr), indexDataPointer32_(nullptr), numIndices_(0)
 {
 	init();
 }
@@ -65,6 +65,7 @@ void MeshSprite::copyVertices(unsigned int numVertices, unsigned int bytesPerVer
 	renderCommand_->geometry().setNumVertices(numVertices);
 	renderCommand_->geometry().setNumElementsPerVertex(floatsPerVertex);
 	renderCommand_->geometry().setHostVertexPointer(vertexDataPointer_);
+	markSubtreeDirty();
 }
 
 void MeshSprite::copyVertices(unsigned int numVertices, const Vertex *vertices)
@@ -103,6 +104,7 @@ void MeshSprite::setVertices(unsigned int numVertices, unsigned int bytesPerVert
 	renderCommand_->geometry().setNumVertices(numVertices);
 	renderCommand_->geometry().setNumElementsPerVertex(floatsPerVertex);
 	renderCommand_->geometry().setHostVertexPointer(vertexDataPointer_);
+	markSubtreeDirty();
 }
 
 void MeshSprite::setVertices(unsigned int numVertices, const Vertex *vertices)
@@ -143,6 +145,7 @@ float *MeshSprite::emplaceVertices(unsigned int numElements, unsigned int bytesP
 	renderCommand_->geometry().setNumVertices(numVertices);
 	renderCommand_->geometry().setNumElementsPerVertex(floatsPerVertex);
 	renderCommand_->geometry().setHostVertexPointer(vertexDataPointer_);
+	markSubtreeDirty();
 
 	return vertices_.data();
 }
@@ -214,6 +217,7 @@ void MeshSprite::createVerticesFromTexels(unsigned int numVertices, const Vector
 	renderCommand_->geometry().setNumVertices(numVertices);
 	renderCommand_->geometry().setNumElementsPerVertex(numFloats);
 	renderCommand_->geometry().setHostVertexPointer(vertexDataPointer_);
+	markSubtreeDirty();
 
 	dirtyBits_.set(DirtyBitPositions::SizeBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
@@ -228,31 +232,70 @@ void MeshSprite::copyIndices(unsigned int numIndices, const unsigned short *indi
 {
 	indices_.setSize(numIndices);
 	memcpy(indices_.data(), indices, numIndices * sizeof(unsigned short));
+	indices32_.clear();
+	indexDataPointer32_ = nullptr;
 
 	indexDataPointer_ = indices_.data();
 	numIndices_ = numIndices;
 	renderCommand_->geometry().setNumIndices(numIndices_);
 	renderCommand_->geometry().setHostIndexPointer(indexDataPointer_);
+	markSubtreeDirty();
+}
+
+void MeshSprite::copyIndices(unsigned int numIndices, const unsigned int *indices)
+{
+	indices32_.setSize(numIndices);
+	memcpy(indices32_.data(), indices, numIndices * sizeof(unsigned int));
+	indices_.clear();
+	indexDataPointer_ = nullptr;
+
+	indexDataPointer32_ = indices32_.data();
+	numIndices_ = numIndices;
+	renderCommand_->geometry().setNumIndices(numIndices_);
+	renderCommand_->geometry().setHostIndexPointer(indexDataPointer32_);
+	markSubtreeDirty();
 }
 
 void MeshSprite::copyIndices(const MeshSprite &meshSprite)
 {
-	copyIndices(meshSprite.numIndices_, meshSprite.indexDataPointer_);
+	if (meshSprite.uses32BitIndices())
+		copyIndices(meshSprite.numIndices_, meshSprite.indexDataPointer32_);
+	else
+		copyIndices(meshSprite.numIndices_, meshSprite.indexDataPointer_);
 }
 
 void MeshSprite::setIndices(unsigned int numIndices, const unsigned short *indices)
 {
 	indices_.clear();
+	indices32_.clear();
+	indexDataPointer32_ = nullptr;
 
 	indexDataPointer_ = indices;
 	numIndices_ = numIndices;
 	renderCommand_->geometry().setNumIndices(numIndices_);
 	renderCommand_->geometry().setHostIndexPointer(indexDataPointer_);
+	markSubtreeDirty();
+}
+
+void MeshSprite::setIndices(unsigned int numIndices, const unsigned int *indices)
+{
+	indices_.clear();
+	indices32_.clear();
+	indexDataPointer_ = nullptr;
+
+	indexDataPointer32_ = indices;
+	numIndices_ = numIndices;
+	renderCommand_->geometry().setNumIndices(numIndices_);
+	renderCommand_->geometry().setHostIndexPointer(indexDataPointer32_);
+	markSubtreeDirty();
 }
 
 void MeshSprite::setIndices(const MeshSprite &meshSprite)
 {
-	setIndices(meshSprite.numIndices_, meshSprite.indexDataPointer_);
+	if (meshSprite.uses32BitIndices())
+		setIndices(meshSprite.numIndices_, meshSprite.indexDataPointer32_);
+	else
+		setIndices(meshSprite.numIndices_, meshSprite.indexDataPointer_);
 }
 
 unsigned short *MeshSprite::emplaceIndices(unsigned int numIndices)
@@ -262,15 +305,37 @@ unsigned short *MeshSprite::emplaceIndices(unsigned int numIndices)
 
 	indices_.clear();
 	indices_.setSize(numIndices);
+	indices32_.clear();
+	indexDataPointer32_ = nullptr;
 
 	indexDataPointer_ = indices_.data();
 	numIndices_ = numIndices;
 	renderCommand_->geometry().setNumIndices(numIndices_);
 	renderCommand_->geometry().setHostIndexPointer(indexDataPointer_);
+	markSubtreeDirty();
 
 	return indices_.data();
 }
 
+unsigned int *MeshSprite::emplaceIndices32(unsigned int numIndices)
+{
+	if (numIndices == 0)
+		return nullptr;
+
+	indices32_.clear();
+	indices32_.setSize(numIndices);
+	indices_.clear();
+	indexDataPointer_ = nullptr;
+
+	indexDataPointer32_ = indices32_.data();
+	numIndices_ = numIndices;
+	renderCommand_->geometry().setNumIndices(numIndices_);
+	renderCommand_->geometry().setHostIndexPointer(indexDataPointer32_);
+	markSubtreeDirty();
+
+	return indices32_.data();
+}
+
 ///////////////////////////////////////////////////////////
 // PROTECTED FUNCTIONS
 ///////////////////////////////////////////////////////////
@@ -281,7 +346,10 @@ MeshSprite::MeshSprite(const MeshSprite &other)
 	init();
 	setTexRect(other.texRect_);
 	copyVertices(other.numVertices_, other.bytesPerVertex_, other.vertices_.data());
-	copyIndices(other.numIndices_, other.indices_.data());
+	if (other.uses32BitIndices())
+		copyIndices(other.numIndices_, other.indices32_.data());
+	else
+		copyIndices(other.numIndices_, other.indices_.data());
 }
 
 ///////////////////////////////////////////////////////////
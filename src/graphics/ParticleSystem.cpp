@@ -32,7 +32,7 @@ ParticleSystem::ParticleSystem(SceneNode *parent, unsigned int count, Texture *t
     : SceneNode(parent, 0, 0), poolSize_(count), poolTop_(count - 1),
       particlePool_(poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
       particleArray_(poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
-      affectors_(4), inLocalSpace_(false),
+      inLocalSpace_(false),
       particlesUpdateEnabled_(true), affectorsEnabled_(true)
 {
 	ZoneScoped;
@@ -78,39 +78,54 @@ void ParticleSystem::emitParticles(const ParticleInitializer &init)
 	tracyInfoString.format("Count: %d", amount);
 	ZoneText(tracyInfoString.data(), tracyInfoString.length());
 #endif
-	Vector2f position(0.0f, 0.0f);
-	Vector2f velocity(0.0f, 0.0f);
-
-	for (unsigned int i = 0; i < amount; i++)
+	// The random values of each property are generated in bulk for a batch of particles
+	const unsigned int BatchSize = 64;
+	float lifes[BatchSize];
+	float positionsX[BatchSize];
+	float positionsY[BatchSize];
+	float velocitiesX[BatchSize];
+	float velocitiesY[BatchSize];
+	float rotations[BatchSize];
+
+	// No more than the unused particles in the pool
+	const unsigned int numUnused = static_cast<unsigned int>(poolTop_ + 1);
+	unsigned int remaining = (amount < numUnused) ? amount : numUnused;
+	while (remaining > 0)
 	{
-		// No more unused particles in the pool
-		if (poolTop_ < 0)
-			break;
-
-		const float life = random().real(init.rndLife.x, init.rndLife.y);
-		position.x = random().real(init.rndPositionX.x, init.rndPositionX.y);
-		position.y = random().real(init.rndPositionY.x, init.rndPositionY.y);
-		velocity.x = random().real(init.rndVelocityX.x, init.rndVelocityX.y);
-		velocity.y = random().real(init.rndVelocityY.x, init.rndVelocityY.y);
-
-		float rotation = 0.0f;
-		if (init.emitterRotation)
+		const unsigned int batchSize = (remaining < BatchSize) ? remaining : BatchSize;
+		random().reals(lifes, batchSize, init.rndLife.x, init.rndLife.y);
+		random().reals(positionsX, batchSize, init.rndPositionX.x, init.rndPositionX.y);
+		random().reals(positionsY, batchSize, init.rndPositionY.x, init.rndPositionY.y);
+		random().reals(velocitiesX, batchSize, init.rndVelocityX.x, init.rndVelocityX.y);
+		random().reals(velocitiesY, batchSize, init.rndVelocityY.x, init.rndVelocityY.y);
+		if (init.emitterRotation == false)
+			random().reals(rotations, batchSize, init.rndRotation.x, init.rndRotation.y);
+
+		for (unsigned int i = 0; i < batchSize; i++)
 		{
-			// Particles are rotated towards the emission vector
-			rotation = (atan2f(velocity.y, velocity.x) - atan2f(1.0f, 0.0f)) * 180.0f / fPi;
-			if (rotation < 0.0f)
-				rotation += 360.0f;
-		}
-		else
-			rotation = random().real(init.rndRotation.x, init.rndRotation.y);
+			Vector2f position(positionsX[i], positionsY[i]);
+			const Vector2f velocity(velocitiesX[i], velocitiesY[i]);
+
+			float rotation = 0.0f;
+			if (init.emitterRotation)
+			{
+				// Particles are rotated towards the emission vector
+				rotation = (atan2f(velocity.y, velocity.x) - atan2f(1.0f, 0.0f)) * 180.0f / fPi;
+				if (rotation < 0.0f)
+					rotation += 360.0f;
+			}
+			else
+				rotation = rotations[i];
 
-		if (inLocalSpace_ == false)
-			position += absPosition();
+			if (inLocalSpace_ == false)
+				position += absPosition();
 
-		// Acquiring a particle from the pool
-		particlePool_[poolTop_]->init(life, position, velocity, rotation, inLocalSpace_);
-		addChildNode(particlePool_[poolTop_]);
-		poolTop_--;
+			// Acquiring a particle from the pool
+			particlePool_[poolTop_]->init(lifes[i], position, velocity, rotation, inLocalSpace_);
+			addChildNode(particlePool_[poolTop_]);
+			poolTop_--;
+		}
+		remaining -= batchSize;
 	}
 }
 
@@ -192,7 +207,8 @@ void ParticleSystem::update(float interval)
 		return;
 
 	ZoneScoped;
-	// Overridden `update()` method should call `transform()` like `SceneNode::update()` does
+	// Overridden `update()` method should reset the dirty subtree flag and call `transform()` like `SceneNode::update()` does
+	resetSubtreeDirty();
 	SceneNode::transform();
 
 	for (int i = children_.size() - 1; i >= 0; i--)
@@ -249,7 +265,7 @@ ParticleSystem::ParticleSystem(const ParticleSystem &other)
     : SceneNode(other), poolSize_(other.poolSize_), poolTop_(other.poolSize_ - 1),
       particlePool_(other.poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
       particleArray_(other.poolSize_, nctl::ArrayMode::FIXED_CAPACITY),
-      affectors_(4), inLocalSpace_(other.inLocalSpace_),
+      inLocalSpace_(other.inLocalSpace_),
       particlesUpdateEnabled_(other.particlesUpdateEnabled_),
       affectorsEnabled_(other.affectorsEnabled_)
 {
@@ -1,14 +1,60 @@
 #include <cstring> // for memcpy()
 #include "GLShaderProgram.h"
 #include "RenderBatcher.h"
+#include "RenderQueueRules.h"
+#include "RenderCommandTraits.h"
 #include "RenderCommand.h"
 #include "RenderCommandPool.h"
 #include "RenderResources.h"
 #include "Application.h"
 #include <nctl/StaticHashMapIterator.h>
+#include <nctl/algorithms.h>
 
 namespace ncine {
 
+namespace {
+	/// The std140 layout of a sprite instance for the default batched sprites shaders
+	/*! The texture rectangle is the last member so that it can be skipped for sprites without a texture. */
+	struct CompactSpriteInstance
+	{
+		/// The two columns of the 2x2 part of the model matrix, scaled by the sprite size
+		float transform[4];
+		/// The translation of the model matrix, including the depth
+		float position[3];
+		/// The color packed as RGBA8
+		uint32_t color;
+		float texRect[4];
+	};
+	static_assert(sizeof(CompactSpriteInstance) == 48, "The compact sprite instance should match the std140 layout");
+
+	uint32_t packColor(const float *color)
+	{
+		uint32_t packedColor = 0;
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			const float component = nctl::clamp(color[i], 0.0f, 1.0f);
+			packedColor |= static_cast<uint32_t>(component * 255.0f + 0.5f) << (i * 8);
+		}
+		return packedColor;
+	}
+
+	/// Appends the indices of a command to a batch, offset by the first vertex of the command in the batch
+	/*! Indices are generated when the command has none. Degenerate triangles are added at the start and at the end when requested. */
+	template <class DestIndexType, class SrcIndexType>
+	DestIndexType *appendIndices(DestIndexType *destIdx, const SrcIndexType *srcIdx, unsigned int numIndices,
+	                             unsigned int firstVertexId, bool startDegenerate, bool endDegenerate)
+	{
+		if (startDegenerate)
+			*destIdx++ = static_cast<DestIndexType>(firstVertexId + (srcIdx ? srcIdx[0] : 0));
+		for (unsigned int i = 0; i < numIndices; i++)
+			*destIdx++ = static_cast<DestIndexType>(firstVertexId + (srcIdx ? srcIdx[i] : i));
+		if (endDegenerate)
+			*destIdx++ = static_cast<DestIndexType>(firstVertexId + (srcIdx ? srcIdx[numIndices - 1] : numIndices - 1));
+
+		return destIdx;
+	}
+}
+
 ///////////////////////////////////////////////////////////
 // STATIC DEFINITIONS
 ///////////////////////////////////////////////////////////
@@ -50,66 +96,13 @@ void RenderBatcher::createBatches(const nctl::Array<RenderCommand *> &srcQueue,
 	minBatchSize = maxBatchSize;
 #endif
 
-	// Validating batch size values
-	maxBatchSize = (maxBatchSize == 0) ? 1 : maxBatchSize;
-	minBatchSize = (minBatchSize == 0) ? 1 : minBatchSize;
-	minBatchSize = (minBatchSize > maxBatchSize) ? maxBatchSize : minBatchSize;
-
-	unsigned int lastSplit = 0;
-	for (unsigned int i = 1; i < srcQueue.size(); i++)
-	{
-		const RenderCommand *command = srcQueue[i];
-		const GLenum primitive = command->geometry().primitiveType();
-
-		const RenderCommand *prevCommand = srcQueue[i - 1];
-		const GLenum prevPrimitive = prevCommand->geometry().primitiveType();
-
-		// Should split if the lower part of a material's sort key or the primitive type differ
-		const bool shouldSplit = command->lowerMaterialSortKey() != prevCommand->lowerMaterialSortKey() || prevPrimitive != primitive;
+	RenderQueueRules::validateBatchSizes(minBatchSize, maxBatchSize);
 
-		// Also collect the very last command if it can be batched with the previous one
-		unsigned int endSplit = (i == srcQueue.size() - 1 && !shouldSplit) ? i + 1 : i;
-
-		// Split point if last command or split condition
-		if (i == srcQueue.size() - 1 || shouldSplit)
-		{
-			const GLShaderProgram *batchedShader = RenderResources::batchedShader(prevCommand->material().shaderProgram());
-			if (batchedShader && (endSplit - lastSplit) >= minBatchSize)
-			{
-				// Split point for the maximum batch size
-				while (lastSplit < endSplit)
-				{
-					const unsigned int batchSize = endSplit - lastSplit;
-					unsigned int nextSplit = endSplit;
-					if (batchSize > maxBatchSize)
-						nextSplit = lastSplit + maxBatchSize;
-					else if (batchSize < minBatchSize)
-						break;
-
-					nctl::Array<RenderCommand *>::ConstIterator start = srcQueue.cBegin() + lastSplit;
-					nctl::Array<RenderCommand *>::ConstIterator end = srcQueue.cBegin() + nextSplit;
-
-					// Handling early splits while collecting (not enough UBO free space)
-					RenderCommand *batchCommand = collectCommands(start, end, start);
-					destQueue.pushBack(batchCommand);
-					lastSplit = start - srcQueue.cBegin();
-				}
-			}
-
-			// Also collect the very last command
-			endSplit = (i == srcQueue.size() - 1) ? i + 1 : i;
-
-			// Passthrough for unsupported command types and for the last few commands that are less than the minimum batch size
-			for (unsigned int j = lastSplit; j < endSplit; j++)
-				destQueue.pushBack(srcQueue[j]);
-
-			lastSplit = endSplit;
-		}
-	}
-
-	// If the queue has only one command the for loop didn't execute, the command has to passthrough
-	if (srcQueue.size() == 1)
-		destQueue.pushBack(srcQueue[0]);
+	nctl::Array<RenderCommand *>::ConstIterator queueBegin = srcQueue.cBegin();
+	RenderQueueRules::createBatches<RenderCommandTraits>(
+	    srcQueue.data(), srcQueue.size(), minBatchSize, maxBatchSize,
+	    [this, queueBegin, &destQueue](unsigned int start, unsigned int end) { return collectCommands(queueBegin + start, queueBegin + end, destQueue); },
+	    [&srcQueue, &destQueue](unsigned int index) { destQueue.pushBack(srcQueue[index]); });
 }
 
 void RenderBatcher::reset()
@@ -123,10 +116,11 @@ void RenderBatcher::reset()
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
 
-RenderCommand *RenderBatcher::collectCommands(
+/*! \return The number of commands collected by the batch appended to the destination queue, zero if none fits in it */
+unsigned int RenderBatcher::collectCommands(
     nctl::Array<RenderCommand *>::ConstIterator start,
     nctl::Array<RenderCommand *>::ConstIterator end,
-    nctl::Array<RenderCommand *>::ConstIterator &nextStart)
+    nctl::Array<RenderCommand *> &destQueue)
 {
 	ASSERT(end > start);
 
@@ -134,11 +128,6 @@ RenderCommand *RenderBatcher::collectCommands(
 	RenderCommand *batchCommand = nullptr;
 	GLUniformBlockCache *instancesBlock = nullptr;
 
-	// Tracking the amount of memory required by uniform blocks, vertices and indices of all instances
-	unsigned long instancesBlockSize = 0;
-	unsigned long instancesVertexDataSize = 0;
-	unsigned int instancesIndicesAmount = 0;
-
 	const GLShaderProgram *refShader = refCommand->material().shaderProgram();
 	GLShaderProgram *batchedShader = RenderResources::batchedShader(refShader);
 	// The following check should never fail as it is already checked by the calling function
@@ -147,14 +136,31 @@ RenderCommand *RenderBatcher::collectCommands(
 	batchCommand = RenderResources::renderCommandPool().retrieveOrAdd(batchedShader, commandAdded);
 
 	// Retrieving the original block instance size without the uniform buffer offset alignment
-	const GLUniformBlockCache *singleInstanceBlock = (*start)->material().uniformBlock(Material::InstanceBlockName);
+	GLUniformBlockCache *singleInstanceBlock = (*start)->material().uniformBlock(Material::InstanceBlockName);
 	const int singleInstanceBlockSizePacked = singleInstanceBlock->size() - singleInstanceBlock->alignAmount(); // remove the uniform buffer offset alignment
-	const int singleInstanceBlockSize = singleInstanceBlockSizePacked + (16 - singleInstanceBlockSizePacked % 16) % 16; // but add the std140 vec4 layout alignment
+	int singleInstanceBlockSize = RenderQueueRules::instanceBlockStride(singleInstanceBlockSizePacked); // but add the std140 vec4 layout alignment
+
+	// The compact layout is built from the uniforms of the single instance block, at the same offsets for every command
+	const bool compactInstances = RenderResources::hasCompactInstances(batchedShader);
+	int colorOffset = -1;
+	int spriteSizeOffset = -1;
+	int texRectOffset = -1;
+	if (compactInstances)
+	{
+		const GLUniformCache *colorUniform = singleInstanceBlock->uniform(Material::ColorUniformName);
+		const GLUniformCache *spriteSizeUniform = singleInstanceBlock->uniform(Material::SpriteSizeUniformName);
+		const GLUniformCache *texRectUniform = singleInstanceBlock->uniform(Material::TexRectUniformName);
+		FATAL_ASSERT_MSG(colorUniform != nullptr && spriteSizeUniform != nullptr, "Unsupported shader for a compact batch element");
+		colorOffset = colorUniform->uniform()->offset();
+		spriteSizeOffset = spriteSizeUniform->uniform()->offset();
+		texRectOffset = texRectUniform ? texRectUniform->uniform()->offset() : -1;
+		singleInstanceBlockSize = RenderQueueRules::compactInstanceStride(texRectUniform != nullptr);
+	}
 
 	if (commandAdded)
 		batchCommand->setType(refCommand->type());
 	instancesBlock = batchCommand->material().uniformBlock(Material::InstancesBlockName);
-	FATAL_ASSERT_MSG_X(instancesBlock != nullptr, "Batched shader does not have an \"%s\" uniform block", Material::InstancesBlockName);
+	FATAL_ASSERT_MSG_X(instancesBlock != nullptr, "Batched shader does not have an \"%s\" uniform block", Material::InstancesBlockName.data());
 
 	const unsigned long nonBlockUniformsSize = batchCommand->material().shaderProgram()->uniformsSize();
 	nctl::StaticString<GLUniformBlock::MaxNameLength> uniformBlockName;
@@ -173,27 +179,25 @@ RenderCommand *RenderBatcher::collectCommands(
 			nonInstancesBlocksSize += uniformBlockCache.size() - uniformBlockCache.alignAmount();
 	}
 
-	// Set to true if at least one command in the batch has indices or forced by a rendering settings
-	bool batchingWithIndices = theApplication().renderingSettings().batchingWithIndices;
-	// Sum the amount of UBO memory required by the batch and determine if indices are needed
-	nctl::Array<RenderCommand *>::ConstIterator it = start;
-	while (it != end)
-	{
-		if ((*it)->geometry().numIndices() > 0)
-			batchingWithIndices = true;
-
-		// Don't request more bytes than an instances block or an UBO can hold (also protects against big `RenderingSettings::maxBatchSize` values)
-		const unsigned long currentSize = nonBlockUniformsSize + nonInstancesBlocksSize + instancesBlockSize;
-		if (instancesBlockSize + singleInstanceBlockSize > instancesBlock->size() || currentSize + singleInstanceBlockSize > UboMaxSize)
-			break;
-		else
-			instancesBlockSize += singleInstanceBlockSize;
-
-		++it;
-	}
-	nextStart = it;
-
-	batchCommand->material().setUniformsDataPointer(acquireMemory(nonBlockUniformsSize + nonInstancesBlocksSize + instancesBlockSize));
+	RenderQueueRules::BatchLimits limits;
+	limits.uboMaxSize = UboMaxSize;
+	limits.instancesBlockMaxSize = instancesBlock->size();
+	limits.nonInstancesSize = nonBlockUniformsSize + nonInstancesBlocksSize;
+	limits.maxVertexDataSize = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::ARRAY).maxSize;
+	limits.maxIndexDataSize = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::ELEMENT_ARRAY).maxSize;
+
+	// Indices are used if at least one command in the batch has them or if forced by a rendering setting
+	const RenderQueueRules::BatchSizes sizes = RenderQueueRules::collectBatch<RenderCommandTraits>(
+	    start, end, theApplication().renderingSettings().batchingWithIndices, singleInstanceBlockSize, refShader->numAttributes() > 0, limits);
+	if (sizes.numCommands == 0)
+		return 0;
+
+	const nctl::Array<RenderCommand *>::ConstIterator nextStart = start + sizes.numCommands;
+	const bool batchingWithIndices = sizes.withIndices;
+	const unsigned long instancesVertexDataSize = sizes.vertexDataSize;
+	const unsigned int instancesIndicesAmount = sizes.numIndices;
+
+	batchCommand->material().setUniformsDataPointer(acquireMemory(limits.nonInstancesSize + sizes.instancesBlockSize));
 	// Copying data for non-instances uniform blocks from the first command in the batch
 	for (const GLUniformBlockCache &uniformBlockCache : allUniformBlocks)
 	{
@@ -223,50 +227,6 @@ RenderCommand *RenderBatcher::collectCommands(
 		}
 	}
 
-	const unsigned long maxVertexDataSize = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::ARRAY).maxSize;
-	const unsigned long maxIndexDataSize = RenderResources::buffersManager().specs(RenderBuffersManager::BufferTypes::ELEMENT_ARRAY).maxSize;
-	// Sum the amount of VBO and IBO memory required by the batch
-	it = start;
-	const bool refShaderHasAttributes = (refShader->numAttributes() > 0);
-	while (it != nextStart)
-	{
-		unsigned int vertexDataSize = 0;
-		unsigned int numIndices = (*it)->geometry().numIndices();
-
-		if (refShaderHasAttributes)
-		{
-			unsigned int numVertices = (*it)->geometry().numVertices();
-			if (batchingWithIndices == false)
-				numVertices += 2; // plus two degenerates if indices are not used
-			const unsigned int numElementsPerVertex = (*it)->geometry().numElementsPerVertex() + 1; // plus the mesh index
-			vertexDataSize = numVertices * numElementsPerVertex * sizeof(GLfloat);
-
-			if (batchingWithIndices)
-				numIndices = (numIndices > 0) ? numIndices + 2 : numVertices + 2;
-		}
-
-		// Don't request more bytes than a common VBO or IBO can hold
-		if (instancesVertexDataSize + vertexDataSize > maxVertexDataSize ||
-		    (instancesIndicesAmount + numIndices) * sizeof(GLushort) > maxIndexDataSize ||
-		    instancesIndicesAmount + numIndices > 65535)
-			break;
-		else
-		{
-			instancesVertexDataSize += vertexDataSize;
-			instancesIndicesAmount += numIndices;
-		}
-
-		++it;
-	}
-	nextStart = it;
-
-	// Remove the two missing degenerate vertices or indices from first and last elements
-	const unsigned long twoVerticesDataSize = 2 * (refCommand->geometry().numElementsPerVertex() + 1) * sizeof(GLfloat);
-	if (instancesIndicesAmount >= 2)
-		instancesIndicesAmount -= 2;
-	else if (instancesVertexDataSize >= twoVerticesDataSize)
-		instancesVertexDataSize -= twoVerticesDataSize;
-
 	const unsigned int NumFloatsVertexFormat = refCommand->geometry().numElementsPerVertex();
 	const unsigned int NumFloatsVertexFormatAndIndex = NumFloatsVertexFormat + 1; // index is an `int`, same size as a `float`
 	const unsigned int SizeVertexFormat = NumFloatsVertexFormat * 4;
@@ -274,27 +234,60 @@ RenderCommand *RenderBatcher::collectCommands(
 
 	float *destVtx = nullptr;
 	GLushort *destIdx = nullptr;
+	GLuint *destIdx32 = nullptr;
+	const bool use32BitIndices = (RenderQueueRules::batchIndexSize(sizes.numVertices) == sizeof(GLuint));
 
 	const bool batchedShaderHasAttributes = (batchedShader->numAttributes() > 1);
+	// Packed text vertices are copied as they are, the batched shader needs to read the same format plus the mesh index
+	if (batchedShaderHasAttributes && refCommand->type() == RenderCommand::CommandTypes::TEXT && theApplication().appConfiguration().packedTextVertices)
+		RenderResources::setPackedAttributesParameters(*batchedShader);
+
 	if (batchedShaderHasAttributes)
 	{
 		const unsigned int numFloats = instancesVertexDataSize / sizeof(GLfloat);
 		destVtx = batchCommand->geometry().acquireVertexPointer(numFloats, NumFloatsVertexFormat + 1); // aligned to vertex format with index
 
 		if (instancesIndicesAmount > 0)
-			destIdx = batchCommand->geometry().acquireIndexPointer(instancesIndicesAmount);
+		{
+			if (use32BitIndices)
+				destIdx32 = batchCommand->geometry().acquireIndexPointer32(instancesIndicesAmount);
+			else
+				destIdx = batchCommand->geometry().acquireIndexPointer(instancesIndicesAmount);
+		}
 	}
 
-	it = start;
+	nctl::Array<RenderCommand *>::ConstIterator it = start;
 	unsigned int instancesBlockOffset = 0;
-	unsigned short batchFirstVertexId = 0;
+	unsigned int batchFirstVertexId = 0;
 	while (it != nextStart)
 	{
 		RenderCommand *command = *it;
 		command->commitNodeTransformation();
 
 		const GLUniformBlockCache *singleInstanceBlock = command->material().uniformBlock(Material::InstanceBlockName);
-		const bool dataCopied = instancesBlock->copyData(instancesBlockOffset, singleInstanceBlock->dataPointer(), singleInstanceBlockSize);
+		bool dataCopied = false;
+		if (compactInstances)
+		{
+			const GLubyte *srcData = singleInstanceBlock->dataPointer();
+			const float *spriteSize = reinterpret_cast<const float *>(srcData + spriteSizeOffset);
+			const Matrix4x4f &modelMatrix = command->transformation();
+
+			CompactSpriteInstance instance;
+			instance.transform[0] = modelMatrix[0][0] * spriteSize[0];
+			instance.transform[1] = modelMatrix[0][1] * spriteSize[0];
+			instance.transform[2] = modelMatrix[1][0] * spriteSize[1];
+			instance.transform[3] = modelMatrix[1][1] * spriteSize[1];
+			instance.position[0] = modelMatrix[3][0];
+			instance.position[1] = modelMatrix[3][1];
+			instance.position[2] = modelMatrix[3][2];
+			instance.color = packColor(reinterpret_cast<const float *>(srcData + colorOffset));
+			if (texRectOffset >= 0)
+				memcpy(instance.texRect, srcData + texRectOffset, sizeof(instance.texRect));
+
+			dataCopied = instancesBlock->copyData(instancesBlockOffset, reinterpret_cast<const GLubyte *>(&instance), singleInstanceBlockSize);
+		}
+		else
+			dataCopied = instancesBlock->copyData(instancesBlockOffset, singleInstanceBlock->dataPointer(), singleInstanceBlockSize);
 		ASSERT(dataCopied);
 		instancesBlockOffset += singleInstanceBlockSize;
 
@@ -330,34 +323,27 @@ RenderCommand *RenderBatcher::collectCommands(
 
 			if (instancesIndicesAmount > 0)
 			{
-				unsigned short vertexId = 0;
-				const unsigned int numIndices = command->geometry().numIndices() ? command->geometry().numIndices() : numVertices;
-				const GLushort *srcIdx = command->geometry().hostIndexPointer();
+				const Geometry &geometry = command->geometry();
+				const unsigned int numIndices = geometry.numIndices() ? geometry.numIndices() : numVertices;
+				const bool startDegenerate = (it != start && nextStart - start > 1);
+				const bool endDegenerate = (it != nextStart - 1 && nextStart - start > 1);
 
-				// Index of a degenerate triangle, if not a starting element and there are more than one in the batch
-				if (it != start && nextStart - start > 1)
-				{
-					*destIdx = batchFirstVertexId + (srcIdx ? *srcIdx : vertexId);
-					destIdx++;
-				}
-				for (unsigned int i = 0; i < numIndices; i++)
+				if (use32BitIndices)
 				{
-					*destIdx = batchFirstVertexId + (srcIdx ? *srcIdx : vertexId);
-					destIdx++;
-					vertexId++;
-					if (srcIdx)
-						srcIdx++;
+					if (geometry.indexType() == GL_UNSIGNED_INT)
+						destIdx32 = appendIndices(destIdx32, geometry.hostIndexPointer32(), numIndices, batchFirstVertexId, startDegenerate, endDegenerate);
+					else
+						destIdx32 = appendIndices(destIdx32, geometry.hostIndexPointer(), numIndices, batchFirstVertexId, startDegenerate, endDegenerate);
 				}
-				// Index of a degenerate triangle, if not an ending element and there are more than one in the batch
-				if (it != nextStart - 1 && nextStart - start > 1)
+				else
 				{
-					if (srcIdx)
-						srcIdx--;
-					*destIdx = batchFirstVertexId + (srcIdx ? *srcIdx : vertexId - 1);
-					destIdx++;
+					if (geometry.indexType() == GL_UNSIGNED_INT)
+						destIdx = appendIndices(destIdx, geometry.hostIndexPointer32(), numIndices, batchFirstVertexId, startDegenerate, endDegenerate);
+					else
+						destIdx = appendIndices(destIdx, geometry.hostIndexPointer(), numIndices, batchFirstVertexId, startDegenerate, endDegenerate);
 				}
 
-				batchFirstVertexId += srcIdx ? numVertices : vertexId;
+				batchFirstVertexId += numVertices;
 			}
 		}
 
@@ -368,7 +354,7 @@ RenderCommand *RenderBatcher::collectCommands(
 	if (batchedShaderHasAttributes)
 	{
 		batchCommand->geometry().releaseVertexPointer();
-		if (destIdx)
+		if (destIdx || destIdx32)
 			batchCommand->geometry().releaseIndexPointer();
 	}
 
@@ -390,7 +376,8 @@ RenderCommand *RenderBatcher::collectCommands(
 	else
 		batchCommand->geometry().setDrawParameters(GL_TRIANGLES, 0, 6 * (nextStart - start));
 
-	return batchCommand;
+	destQueue.pushBack(batchCommand);
+	return sizes.numCommands;
 }
 
 unsigned char *RenderBatcher::acquireMemory(unsigned int bytes)
@@ -0,0 +1,209 @@
+#include <cstring> // for `memcpy()`
+#include <nctl/algorithms.h>
+#include <nctl/StaticHashMapIterator.h>
+#include <nctl/StaticString.h>
+#include "RenderCapture.h"
+#include "RenderCaptureFormat.h"
+#include "RenderCommand.h"
+#include "RenderResources.h"
+#include "RenderBuffersManager.h"
+#include "GLShaderProgram.h"
+#include "IGfxCapabilities.h"
+#include "Application.h"
+#include "IFile.h"
+
+namespace ncine {
+
+namespace format = RenderCaptureFormat;
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+nctl::UniquePtr<IFile> RenderCapture::fileHandle_;
+unsigned long int RenderCapture::firstFrame_ = 0;
+unsigned int RenderCapture::numFrames_ = 0;
+unsigned int RenderCapture::numCapturedQueues_ = 0;
+nctl::HashMap<const void *, uint32_t> RenderCapture::objectIds_(64);
+nctl::Array<uint8_t> RenderCapture::buffer_;
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \return True if the file has been opened for writing */
+bool RenderCapture::start(const char *filename, unsigned int numFrames)
+{
+	ASSERT(filename);
+	ASSERT(numFrames > 0);
+	if (filename == nullptr || numFrames == 0)
+		return false;
+
+	stop();
+
+	fileHandle_ = IFile::createFileHandle(filename);
+	fileHandle_->open(IFile::OpenMode::WRITE | IFile::OpenMode::BINARY);
+	if (fileHandle_->isOpened() == false)
+	{
+		fileHandle_.reset(nullptr);
+		return false;
+	}
+
+	const IGfxCapabilities &gfxCaps = theServiceLocator().gfxCapabilities();
+	format::Header header;
+	memcpy(header.signature, format::Signature, sizeof(format::Signature));
+	header.version = format::Version;
+	header.uboMaxSize = static_cast<uint32_t>(gfxCaps.value(IGfxCapabilities::GLIntValues::MAX_UNIFORM_BLOCK_SIZE));
+	fileHandle_->write(&header, sizeof(format::Header));
+
+	firstFrame_ = theApplication().numFrames();
+	numFrames_ = numFrames;
+	numCapturedQueues_ = 0;
+	objectIds_.clear();
+
+	LOGI_X("Capturing the render queues of %u frames to \"%s\"", numFrames, filename);
+	return true;
+}
+
+void RenderCapture::stop()
+{
+	if (fileHandle_ == nullptr)
+		return;
+
+	fileHandle_->close();
+	LOGI_X("Captured %u render queues to \"%s\"", numCapturedQueues_, fileHandle_->filename());
+	fileHandle_.reset(nullptr);
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void RenderCapture::captureQueues(const nctl::Array<RenderCommand *> &opaqueQueue, const nctl::Array<RenderCommand *> &transparentQueue)
+{
+	const unsigned long int frame = theApplication().numFrames() - firstFrame_;
+	if (frame >= numFrames_)
+	{
+		stop();
+		return;
+	}
+
+	const Application::RenderingSettings &settings = theApplication().renderingSettings();
+	const RenderBuffersManager &buffersManager = RenderResources::buffersManager();
+
+	format::Queue queue = {};
+	queue.frame = static_cast<uint32_t>(frame);
+	queue.viewportId = objectId(RenderResources::currentViewport());
+	queue.numOpaques = opaqueQueue.size();
+	queue.numTransparents = transparentQueue.size();
+	queue.minBatchSize = settings.minBatchSize;
+	queue.maxBatchSize = settings.maxBatchSize;
+	queue.maxVertexDataSize = static_cast<uint32_t>(buffersManager.specs(RenderBuffersManager::BufferTypes::ARRAY).maxSize);
+	queue.maxIndexDataSize = static_cast<uint32_t>(buffersManager.specs(RenderBuffersManager::BufferTypes::ELEMENT_ARRAY).maxSize);
+	queue.batchingEnabled = settings.batchingEnabled ? 1 : 0;
+	queue.batchingWithIndices = settings.batchingWithIndices ? 1 : 0;
+	queue.reorderingEnabled = settings.reorderingEnabled ? 1 : 0;
+	queue.reorderingWindowSize = settings.reorderingWindowSize;
+
+	buffer_.clear();
+	buffer_.setSize(sizeof(format::Queue));
+	memcpy(buffer_.data(), &queue, sizeof(format::Queue));
+
+	for (const RenderCommand *command : opaqueQueue)
+		captureCommand(*command);
+	for (const RenderCommand *command : transparentQueue)
+		captureCommand(*command);
+
+	// A queue is written with a single call, so that the capture can be stopped at any time
+	fileHandle_->write(buffer_.data(), buffer_.size());
+	numCapturedQueues_++;
+}
+
+void RenderCapture::captureCommand(const RenderCommand &command)
+{
+	const Material &material = command.material();
+	const Geometry &geometry = command.geometry();
+	const GLShaderProgram *shader = material.shaderProgram();
+	const GLShaderProgram *batchedShader = (shader && geometry.hasCustomVbo() == false) ? RenderResources::batchedShader(shader) : nullptr;
+
+	format::Command record = {};
+	record.materialSortKey = command.materialSortKey();
+	record.idSortKey = command.idSortKey();
+	record.layer = command.layer();
+	record.visitOrder = command.visitOrder();
+	record.shaderId = shader ? objectId(shader) : 0;
+	record.batchedShaderId = batchedShader ? objectId(batchedShader) : 0;
+	record.textureId = material.texture(0) ? objectId(material.texture(0)) : 0;
+	record.numVertices = static_cast<uint32_t>(geometry.numVertices());
+	record.numIndices = geometry.numIndices();
+	record.primitiveType = static_cast<uint16_t>(geometry.primitiveType());
+	record.srcBlendingFactor = static_cast<uint16_t>(material.srcBlendingFactor());
+	record.destBlendingFactor = static_cast<uint16_t>(material.destBlendingFactor());
+	record.numElementsPerVertex = static_cast<uint8_t>(geometry.numElementsPerVertex());
+	record.type = static_cast<uint8_t>(command.type());
+
+	record.flags = material.isBlendingEnabled() ? format::CommandFlags::BLENDING : 0;
+	if (geometry.hasCustomVbo())
+		record.flags |= format::CommandFlags::CUSTOM_VBO;
+	if (shader && shader->numAttributes() > 0)
+		record.flags |= format::CommandFlags::SHADER_ATTRIBUTES;
+	if (batchedShader && batchedShader->numAttributes() > 1)
+		record.flags |= format::CommandFlags::BATCHED_SHADER_ATTRIBUTES;
+	if (batchedShader && RenderResources::hasCompactInstances(batchedShader))
+		record.flags |= format::CommandFlags::COMPACT_INSTANCES;
+	if (command.hasAabb())
+	{
+		record.flags |= format::CommandFlags::AABB;
+		record.aabb[0] = command.aabb().x;
+		record.aabb[1] = command.aabb().y;
+		record.aabb[2] = command.aabb().w;
+		record.aabb[3] = command.aabb().h;
+	}
+
+	const GLUniformBlockCache *instanceBlock = nullptr;
+	nctl::StaticString<GLUniformBlock::MaxNameLength> uniformBlockName;
+	uint32_t nonInstanceUniformsSize = batchedShader ? batchedShader->uniformsSize() : 0;
+	const GLShaderUniformBlocks::UniformHashMapType allUniformBlocks = material.allUniformBlocks();
+	for (const GLUniformBlockCache &uniformBlockCache : allUniformBlocks)
+	{
+		uniformBlockName = uniformBlockCache.uniformBlock()->name();
+		if (uniformBlockName == Material::InstanceBlockName)
+			instanceBlock = &uniformBlockCache;
+		else
+			nonInstanceUniformsSize += uniformBlockCache.size() - uniformBlockCache.alignAmount();
+	}
+	record.nonInstanceUniformsSize = nonInstanceUniformsSize;
+	const GLUniformBlock *instancesBlock = batchedShader ? batchedShader->uniformBlock(Material::InstancesBlockName.data()) : nullptr;
+	record.batchedInstancesBlockSize = instancesBlock ? static_cast<uint32_t>(instancesBlock->size()) : 0;
+
+	const unsigned int instanceBlockSize = (instanceBlock && instanceBlock->dataPointer()) ? instanceBlock->size() - instanceBlock->alignAmount() : 0;
+	record.instanceBlockSize = static_cast<uint16_t>(instanceBlockSize);
+
+	const unsigned int offset = buffer_.size();
+	const unsigned int newSize = offset + sizeof(format::Command) + format::paddedBlockSize(instanceBlockSize);
+	if (newSize > buffer_.capacity())
+		buffer_.setCapacity(nctl::max(newSize, buffer_.capacity() * 2));
+	buffer_.setSize(newSize);
+	memcpy(buffer_.data() + offset, &record, sizeof(format::Command));
+	if (instanceBlockSize > 0)
+	{
+		uint8_t *blockData = buffer_.data() + offset + sizeof(format::Command);
+		memcpy(blockData, instanceBlock->dataPointer(), instanceBlockSize);
+		memset(blockData + instanceBlockSize, 0, format::paddedBlockSize(instanceBlockSize) - instanceBlockSize);
+	}
+}
+
+uint32_t RenderCapture::objectId(const void *object)
+{
+	const uint32_t *id = objectIds_.find(object);
+	if (id != nullptr)
+		return *id;
+
+	const uint32_t newId = objectIds_.size() + 1;
+	if (objectIds_.loadFactor() >= 0.8f)
+		objectIds_.rehash(objectIds_.capacity() * 2);
+	objectIds_.insert(object, newId);
+	return newId;
+}
+
+}
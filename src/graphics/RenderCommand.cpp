@@ -21,7 +21,7 @@ const float RenderCommand::LayerStep = 1.0f / static_cast<float>(0xFFFF);
 RenderCommand::RenderCommand(CommandTypes::Enum profilingType)
     : materialSortKey_(0), layer_(0),
       numInstances_(0), batchSize_(0), transformationCommitted_(false),
-      profilingType_(profilingType), modelMatrix_(Matrix4x4f::Identity)
+      profilingType_(profilingType), hasAabb_(false), modelMatrix_(Matrix4x4f::Identity)
 {
 }
 
@@ -1,7 +1,10 @@
 #include <nctl/algorithms.h>
 #include <nctl/StaticString.h>
 #include "RenderQueue.h"
+#include "RenderQueueRules.h"
+#include "RenderCommandTraits.h"
 #include "RenderBatcher.h"
+#include "RenderCapture.h"
 #include "RenderResources.h"
 #include "RenderStatistics.h"
 #include "GLDebug.h"
@@ -53,16 +56,12 @@ namespace {
 
 	bool descendingOrder(const RenderCommand *a, const RenderCommand *b)
 	{
-		return (a->materialSortKey() != b->materialSortKey())
-		           ? a->materialSortKey() > b->materialSortKey()
-		           : a->idSortKey() > b->idSortKey();
+		return RenderQueueRules::opaqueOrder(a->materialSortKey(), a->idSortKey(), b->materialSortKey(), b->idSortKey());
 	}
 
 	bool ascendingOrder(const RenderCommand *a, const RenderCommand *b)
 	{
-		return (a->materialSortKey() != b->materialSortKey())
-		           ? a->materialSortKey() < b->materialSortKey()
-		           : a->idSortKey() < b->idSortKey();
+		return RenderQueueRules::transparentOrder(a->materialSortKey(), a->idSortKey(), b->materialSortKey(), b->idSortKey());
 	}
 
 	const char *commandTypeString(const RenderCommand &command)
@@ -90,9 +89,18 @@ void RenderQueue::sortAndCommit()
 {
 	const bool batchingEnabled = theApplication().renderingSettings().batchingEnabled;
 
+	// The queues are captured before sorting, as collected by the visit
+	if (RenderCapture::isCapturing())
+		RenderCapture::captureQueues(opaqueQueue_, transparentQueue_);
+
 	// Sorting the queues with the relevant orders
 	nctl::quicksort(opaqueQueue_.begin(), opaqueQueue_.end(), descendingOrder);
 	nctl::quicksort(transparentQueue_.begin(), transparentQueue_.end(), ascendingOrder);
+	if (theApplication().renderingSettings().reorderingEnabled)
+	{
+		ZoneScopedN("Reordering");
+		reorderTransparents();
+	}
 
 	nctl::Array<RenderCommand *> *opaques = batchingEnabled ? &opaqueBatchedQueue_ : &opaqueQueue_;
 	nctl::Array<RenderCommand *> *transparents = batchingEnabled ? &transparentBatchedQueue_ : &transparentQueue_;
@@ -206,4 +214,20 @@ void RenderQueue::clear()
 	RenderResources::renderBatcher().reset();
 }
 
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void RenderQueue::reorderTransparents()
+{
+	const unsigned int windowSize = theApplication().renderingSettings().reorderingWindowSize;
+	if (windowSize == 0 || transparentQueue_.size() < 3)
+		return;
+
+	const unsigned int numSplitsBefore = RenderQueueRules::countSplits<RenderCommandTraits>(transparentQueue_.data(), transparentQueue_.size());
+	const unsigned int numMovedCommands = RenderQueueRules::reorderTransparents<RenderCommandTraits>(transparentQueue_.data(), transparentQueue_.size(), windowSize);
+	const unsigned int numSplitsAfter = (numMovedCommands > 0) ? RenderQueueRules::countSplits<RenderCommandTraits>(transparentQueue_.data(), transparentQueue_.size()) : numSplitsBefore;
+	RenderStatistics::addReorderedCommands(numMovedCommands, numSplitsBefore - numSplitsAfter);
+}
+
 }
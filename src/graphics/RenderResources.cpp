@@ -41,6 +41,7 @@ RenderResources::ShaderProgramCompileInfo::ShaderCompileInfo RenderResources::de
 RenderResources::ShaderProgramCompileInfo::ShaderCompileInfo RenderResources::defaultFragmentShaderInfos_[NumDefaultFragmentShaders];
 nctl::UniquePtr<GLShaderProgram> RenderResources::defaultShaderPrograms_[NumDefaultShaderPrograms];
 nctl::HashMap<const GLShaderProgram *, GLShaderProgram *> RenderResources::batchedShaders_(32);
+nctl::HashSet<const GLShaderProgram *> RenderResources::compactInstancesShaders_(16);
 
 unsigned char RenderResources::cameraUniformsBuffer_[UniformsBufferSize];
 nctl::HashMap<GLShaderProgram *, RenderResources::CameraUniformData> RenderResources::cameraUniformDataMap_(32);
@@ -289,6 +290,24 @@ bool RenderResources::unregisterBatchedShader(const GLShaderProgram *shader)
 	return removed;
 }
 
+bool RenderResources::registerCompactInstancesShader(const GLShaderProgram *batchedShader)
+{
+	FATAL_ASSERT(batchedShader != nullptr);
+
+	if (compactInstancesShaders_.loadFactor() >= 0.8f)
+		compactInstancesShaders_.rehash(compactInstancesShaders_.capacity() * 2);
+	const bool inserted = compactInstancesShaders_.insert(batchedShader);
+
+	return inserted;
+}
+
+bool RenderResources::unregisterCompactInstancesShader(const GLShaderProgram *batchedShader)
+{
+	ASSERT(batchedShader != nullptr);
+	const bool removed = compactInstancesShaders_.remove(batchedShader);
+	return removed;
+}
+
 RenderResources::CameraUniformData *RenderResources::findCameraUniformData(GLShaderProgram *shaderProgram)
 {
 	return cameraUniformDataMap_.find(shaderProgram);
@@ -358,6 +377,36 @@ void RenderResources::setDefaultAttributesParameters(GLShaderProgram &shaderProg
 	}
 }
 
+void RenderResources::setPackedAttributesParameters(GLShaderProgram &shaderProgram)
+{
+	if (shaderProgram.numAttributes() > 0)
+	{
+		GLVertexFormat::Attribute *positionAttribute = shaderProgram.attribute(Material::PositionAttributeName);
+		GLVertexFormat::Attribute *texCoordsAttribute = shaderProgram.attribute(Material::TexCoordsAttributeName);
+		GLVertexFormat::Attribute *meshIndexAttribute = shaderProgram.attribute(Material::MeshIndexAttributeName);
+
+		if (positionAttribute == nullptr || texCoordsAttribute == nullptr)
+			return;
+
+		positionAttribute->setType(GL_HALF_FLOAT);
+		positionAttribute->setNormalized(false);
+		texCoordsAttribute->setType(GL_UNSIGNED_SHORT);
+		texCoordsAttribute->setNormalized(true);
+
+		if (meshIndexAttribute != nullptr)
+		{
+			positionAttribute->setVboParameters(sizeof(VertexFormatPos2Tex2IndexPacked), reinterpret_cast<void *>(offsetof(VertexFormatPos2Tex2IndexPacked, position)));
+			texCoordsAttribute->setVboParameters(sizeof(VertexFormatPos2Tex2IndexPacked), reinterpret_cast<void *>(offsetof(VertexFormatPos2Tex2IndexPacked, texcoords)));
+			meshIndexAttribute->setVboParameters(sizeof(VertexFormatPos2Tex2IndexPacked), reinterpret_cast<void *>(offsetof(VertexFormatPos2Tex2IndexPacked, drawindex)));
+		}
+		else
+		{
+			positionAttribute->setVboParameters(sizeof(VertexFormatPos2Tex2Packed), reinterpret_cast<void *>(offsetof(VertexFormatPos2Tex2Packed, position)));
+			texCoordsAttribute->setVboParameters(sizeof(VertexFormatPos2Tex2Packed), reinterpret_cast<void *>(offsetof(VertexFormatPos2Tex2Packed, texcoords)));
+		}
+	}
+}
+
 ///////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
 ///////////////////////////////////////////////////////////
@@ -413,7 +462,7 @@ void RenderResources::createMinimal()
 	ASSERT(hash64_ == nullptr);
 
 	const AppConfiguration &appCfg = theApplication().appConfiguration();
-	binaryShaderCache_ = nctl::makeUnique<BinaryShaderCache>(appCfg.useBinaryShaderCache, appCfg.shaderCacheDirname.data());
+	binaryShaderCache_ = nctl::makeUnique<BinaryShaderCache>(appCfg.useBinaryShaderCache, appCfg.usePackedShaderCache, appCfg.shaderCacheDirname.data());
 	buffersManager_ = nctl::makeUnique<RenderBuffersManager>(appCfg.useBufferMapping, appCfg.vboSize, appCfg.iboSize);
 	vaoPool_ = nctl::makeUnique<RenderVaoPool>(appCfg.vaoPoolSize);
 	hash64_ = nctl::makeUnique<Hash64>();
@@ -430,7 +479,7 @@ void RenderResources::create()
 
 	const AppConfiguration &appCfg = theApplication().appConfiguration();
 	if (binaryShaderCache_ == nullptr)
-		binaryShaderCache_ = nctl::makeUnique<BinaryShaderCache>(appCfg.useBinaryShaderCache, appCfg.shaderCacheDirname.data());
+		binaryShaderCache_ = nctl::makeUnique<BinaryShaderCache>(appCfg.useBinaryShaderCache, appCfg.usePackedShaderCache, appCfg.shaderCacheDirname.data());
 	if (buffersManager_ == nullptr)
 		buffersManager_ = nctl::makeUnique<RenderBuffersManager>(appCfg.useBufferMapping, appCfg.vboSize, appCfg.iboSize);
 	if (vaoPool_ == nullptr)
@@ -538,6 +587,7 @@ void RenderResources::dispose()
 {
 	for (nctl::UniquePtr<GLShaderProgram> &shaderProgram : defaultShaderPrograms_)
 		shaderProgram.reset(nullptr);
+	compactInstancesShaders_.clear();
 
 	ASSERT(cameraUniformDataMap_.isEmpty());
 
@@ -603,6 +653,10 @@ void RenderResources::registerDefaultBatchedShaders()
 	batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::TEXTNODE_ALPHA)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_ALPHA)].get());
 	batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::TEXTNODE_RED)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_RED)].get());
 	batchedShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::TEXTNODE_SPRITE)].get(), defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_TEXTNODES_SPRITE)].get());
+
+	compactInstancesShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_SPRITES)].get());
+	compactInstancesShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_SPRITES_GRAY)].get());
+	compactInstancesShaders_.insert(defaultShaderPrograms_[static_cast<int>(Material::ShaderProgramType::BATCHED_SPRITES_NO_TEXTURE)].get());
 }
 
 }
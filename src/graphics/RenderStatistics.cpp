@@ -18,6 +18,7 @@ unsigned int RenderStatistics::index_ = 0;
 unsigned int RenderStatistics::culledNodes_[2] = { 0, 0 };
 RenderStatistics::VaoPool RenderStatistics::vaoPool_;
 RenderStatistics::CommandPool RenderStatistics::commandPool_;
+RenderStatistics::Reordering RenderStatistics::reordering_;
 
 ///////////////////////////////////////////////////////////
 // PRIVATE FUNCTIONS
@@ -41,6 +42,7 @@ void RenderStatistics::reset()
 
 	vaoPool_.reset();
 	commandPool_.reset();
+	reordering_.reset();
 }
 
 void RenderStatistics::gatherStatistics(const RenderCommand &command)
@@ -24,7 +24,8 @@ SceneNode::SceneNode(SceneNode *parent, float x, float y)
       color_(Color::White), layer_(0), absPosition_(0.0f, 0.0f), absScaleFactor_(1.0f, 1.0f),
       absRotation_(0.0f), absColor_(Color::White), absLayer_(0),
       worldMatrix_(Matrix4x4f::Identity), localMatrix_(Matrix4x4f::Identity),
-      shouldDeleteChildrenOnDestruction_(true), dirtyBits_(0xFF), lastFrameUpdated_(0)
+      shouldDeleteChildrenOnDestruction_(true), dirtyBits_(0xFF), lastFrameUpdated_(0),
+      updateMode_(UpdateMode::ALWAYS), subtreeDirty_(true)
 {
 	setParent(parent);
 }
@@ -70,11 +71,13 @@ SceneNode::SceneNode(SceneNode &&other)
       position_(other.position_), anchorPoint_(other.anchorPoint_),
       scaleFactor_(other.scaleFactor_), rotation_(other.rotation_), color_(other.color_),
       layer_(other.layer_), shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_),
-      dirtyBits_(other.dirtyBits_), lastFrameUpdated_(other.lastFrameUpdated_)
+      dirtyBits_(other.dirtyBits_), lastFrameUpdated_(other.lastFrameUpdated_),
+      updateMode_(other.updateMode_), subtreeDirty_(true)
 {
 	swapChildPointer(this, &other);
 	for (SceneNode *child : children_)
 		child->parent_ = this;
+	markSubtreeDirty();
 }
 
 SceneNode &SceneNode::operator=(SceneNode &&other)
@@ -95,10 +98,12 @@ SceneNode &SceneNode::operator=(SceneNode &&other)
 	shouldDeleteChildrenOnDestruction_ = other.shouldDeleteChildrenOnDestruction_;
 	dirtyBits_ = other.dirtyBits_;
 	lastFrameUpdated_ = other.lastFrameUpdated_;
+	updateMode_ = other.updateMode_;
 
 	swapChildPointer(this, &other);
 	for (SceneNode *child : children_)
 		child->parent_ = this;
+	markSubtreeDirty();
 
 	return *this;
 }
@@ -125,6 +130,7 @@ bool SceneNode::setParent(SceneNode *parentNode)
 
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 
 	return true;
 }
@@ -144,6 +150,7 @@ bool SceneNode::addChildNode(SceneNode *childNode)
 	childNode->parent_ = this;
 	childNode->dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	childNode->dirtyBits_.set(DirtyBitPositions::AabbBit);
+	childNode->markSubtreeDirty();
 
 	return true;
 }
@@ -183,6 +190,7 @@ bool SceneNode::removeChildNodeAt(unsigned int index)
 	children_[index]->parent_ = nullptr;
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::AabbBit);
+	markSubtreeDirty();
 	// Fast removal without preserving the order
 	children_.unorderedRemoveAt(index);
 	// The last child has been moved to this index position
@@ -204,6 +212,7 @@ bool SceneNode::removeAllChildrenNodes()
 		dirtyBits_.set(DirtyBitPositions::AabbBit);
 	}
 	children_.clear();
+	markSubtreeDirty();
 
 	return true;
 }
@@ -258,6 +267,7 @@ bool SceneNode::swapChildrenNodes(unsigned int firstIndex, unsigned int secondIn
 
 	nctl::swap(children_[firstIndex], children_[secondIndex]);
 	nctl::swap(children_[firstIndex]->childOrderIndex_, children_[secondIndex]->childOrderIndex_);
+	markSubtreeDirty();
 	return true;
 }
 
@@ -285,9 +295,25 @@ void SceneNode::update(float interval)
 
 	if (updateEnabled_)
 	{
+		resetSubtreeDirty();
+
+		const uint16_t prevAbsLayer = absLayer_;
+		const bool prevWithVisitOrder = withVisitOrder_;
 		transform();
-		for (SceneNode *child : children_)
-			child->update(interval);
+
+		// Children inherit the transformation, the color, the layer and the visit order state
+		const bool childrenInheritChanges = dirtyBits_.test(DirtyBitPositions::TransformationBit) ||
+		                                    dirtyBits_.test(DirtyBitPositions::ColorBit) ||
+		                                    absLayer_ != prevAbsLayer || withVisitOrder_ != prevWithVisitOrder;
+		if (childrenInheritChanges || updateMode_ != UpdateMode::STATIC)
+		{
+			for (SceneNode *child : children_)
+			{
+				// Clean subtrees are skipped
+				if (childrenInheritChanges || child->subtreeDirty_)
+					child->update(interval);
+			}
+		}
 
 		// A non drawable scenenode does not have the `updateRenderCommand()` method to reset the flags
 		if (type_ == ObjectType::SCENENODE)
@@ -322,6 +348,16 @@ void SceneNode::visit(RenderQueue &renderQueue, unsigned int &visitOrderIndex)
 	}
 }
 
+/*! \note Switching away from the static mode updates the descendants that have changed in the meantime */
+void SceneNode::setUpdateMode(UpdateMode updateMode)
+{
+	if (updateMode_ != updateMode)
+	{
+		updateMode_ = updateMode;
+		markSubtreeDirty();
+	}
+}
+
 ///////////////////////////////////////////////////////////
 // PROTECTED FUNCTIONS
 ///////////////////////////////////////////////////////////
@@ -334,7 +370,8 @@ SceneNode::SceneNode(const SceneNode &other)
       scaleFactor_(other.scaleFactor_), rotation_(other.rotation_), color_(other.color_),
       layer_(other.layer_), absPosition_(0.0f, 0.0f), absScaleFactor_(1.0f, 1.0f), absRotation_(0.0f),
       absColor_(Color::White), absLayer_(0), worldMatrix_(Matrix4x4f::Identity), localMatrix_(Matrix4x4f::Identity),
-      shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_), dirtyBits_(0xFF)
+      shouldDeleteChildrenOnDestruction_(other.shouldDeleteChildrenOnDestruction_), dirtyBits_(0xFF),
+      lastFrameUpdated_(0), updateMode_(other.updateMode_), subtreeDirty_(true)
 {
 	setParent(other.parent_);
 }
@@ -360,6 +397,17 @@ void SceneNode::swapChildPointer(SceneNode *first, SceneNode *second)
 	}
 }
 
+/*! \note The walk stops at the first ancestor that is already dirty, as its own ancestors are dirty too */
+void SceneNode::propagateSubtreeDirty()
+{
+	SceneNode *node = this;
+	while (node != nullptr && node->subtreeDirty_ == false && node->updateMode_ != UpdateMode::STATIC)
+	{
+		node->subtreeDirty_ = true;
+		node = node->parent_;
+	}
+}
+
 void SceneNode::transform()
 {
 	ZoneScoped;
@@ -33,6 +33,12 @@ namespace {
 		return GLShaderProgram::Introspection::ENABLED;
 	}
 
+	/// The default batched sprites vertex shaders expect the compact instance layout built by the `RenderBatcher`
+	bool isCompactInstancesVertex(Shader::DefaultVertex defaultVertex)
+	{
+		return (defaultVertex == Shader::DefaultVertex::BATCHED_SPRITES || defaultVertex == Shader::DefaultVertex::BATCHED_SPRITES_NOTEXTURE);
+	}
+
 	bool isBatchedVertex(Shader::DefaultVertex defaultVertex)
 	{
 		switch (defaultVertex)
@@ -191,6 +197,8 @@ Shader::~Shader()
 {
 	// In case there is a batched version of this shader
 	RenderResources::unregisterBatchedShader(glShaderProgram_.get());
+	// In case this is a batched shader with the compact instance layout
+	RenderResources::unregisterCompactInstancesShader(glShaderProgram_.get());
 }
 
 ///////////////////////////////////////////////////////////
@@ -448,6 +456,11 @@ bool Shader::load(LoadMode loadMode, const char *shaderName, Introspection intro
 	RenderResources::compileShader(shaderProgramInfo);
 	// The shader info hashmap with the custom shader hashes will be saved at application shutdown
 
+	if (vertex == nullptr && isCompactInstancesVertex(defaultVertex))
+		RenderResources::registerCompactInstancesShader(glShaderProgram_.get());
+	else
+		RenderResources::unregisterCompactInstancesShader(glShaderProgram_.get());
+
 	return isLinked();
 }
 
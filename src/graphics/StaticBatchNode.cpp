@@ -0,0 +1,542 @@
+#include <cmath>
+#include <nctl/algorithms.h>
+#include <nctl/SmallArray.h>
+#include "StaticBatchNode.h"
+#include "Sprite.h"
+#include "MeshSprite.h"
+#include "RenderQueue.h"
+#include "RenderCommand.h"
+#include "RenderResources.h"
+#include "RenderStatistics.h"
+#include "TriangleStrip.h"
+#include "TransformRect.h"
+#include "Viewport.h"
+#include "Application.h"
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+
+	/// The maximum number of vertices addressable by the 16 bits indices of a chunk
+	const unsigned int MaxChunkVertices = 65536;
+
+	/// The state shared by all baked sprites that can be drawn with the same render command
+	struct BakeGroup
+	{
+		const Texture *texture;
+		Material::ShaderProgramType shaderProgramType;
+		bool blendingEnabled;
+		GLenum srcBlendingFactor;
+		GLenum destBlendingFactor;
+		Color color;
+	};
+
+	struct BakeEntry
+	{
+		unsigned int groupIndex;
+		int cellX;
+		int cellY;
+		unsigned int childIndex;
+	};
+
+	bool isEntryLess(const BakeEntry &a, const BakeEntry &b)
+	{
+		if (a.groupIndex != b.groupIndex)
+			return a.groupIndex < b.groupIndex;
+		if (a.cellY != b.cellY)
+			return a.cellY < b.cellY;
+		if (a.cellX != b.cellX)
+			return a.cellX < b.cellX;
+		return a.childIndex < b.childIndex;
+	}
+
+	bool isSameChunk(const BakeEntry &a, const BakeEntry &b)
+	{
+		return (a.groupIndex == b.groupIndex && a.cellX == b.cellX && a.cellY == b.cellY);
+	}
+
+	bool isSameGroup(const BakeGroup &a, const BakeGroup &b)
+	{
+		return (a.texture == b.texture && a.shaderProgramType == b.shaderProgramType &&
+		        a.blendingEnabled == b.blendingEnabled && a.srcBlendingFactor == b.srcBlendingFactor &&
+		        a.destBlendingFactor == b.destBlendingFactor && a.color == b.color);
+	}
+
+	Material::ShaderProgramType toMeshSpriteShaderProgramType(Material::ShaderProgramType shaderProgramType)
+	{
+		if (shaderProgramType == Material::ShaderProgramType::SPRITE_GRAY ||
+		    shaderProgramType == Material::ShaderProgramType::MESH_SPRITE_GRAY)
+		{
+			return Material::ShaderProgramType::MESH_SPRITE_GRAY;
+		}
+		return Material::ShaderProgramType::MESH_SPRITE;
+	}
+
+}
+
+/// A bake group portion with its own buffers and render command
+struct StaticBatchNode::Chunk
+{
+	Chunk()
+	    : renderCommand(nctl::makeUnique<RenderCommand>(RenderCommand::CommandTypes::MESH_SPRITE)),
+	      vertices(64), indices(64), color(Color::White), localAabb(0.0f, 0.0f, 0.0f, 0.0f), aabb(0.0f, 0.0f, 0.0f, 0.0f) {}
+
+	nctl::UniquePtr<RenderCommand> renderCommand;
+	/// Vertex data, kept to upload it again if the buffer needs to be recreated
+	nctl::Array<float> vertices;
+	/// Triangle list indices
+	nctl::Array<GLushort> indices;
+	/// The group color, relative to this node
+	Color color;
+	/// Bounding box of the chunk vertices in node space
+	Rectf localAabb;
+	/// Bounding box of the chunk vertices in world space
+	Rectf aabb;
+
+	/// Appends the vertices, transformed in node space, and the triangle list indices of a sprite
+	void addSprite(const BaseSprite &sprite, float width, float height);
+
+	/// Transforms a vertex in node space and appends it
+	void addVertex(const Matrix4x4f &localMatrix, float x, float y, float u, float v);
+};
+
+void StaticBatchNode::Chunk::addVertex(const Matrix4x4f &localMatrix, float x, float y, float u, float v)
+{
+	const float nodeX = localMatrix[0][0] * x + localMatrix[1][0] * y + localMatrix[3][0];
+	const float nodeY = localMatrix[0][1] * x + localMatrix[1][1] * y + localMatrix[3][1];
+
+	if (vertices.isEmpty())
+		localAabb = Rectf(nodeX, nodeY, 0.0f, 0.0f);
+	else
+	{
+		const float minX = (nodeX < localAabb.x) ? nodeX : localAabb.x;
+		const float minY = (nodeY < localAabb.y) ? nodeY : localAabb.y;
+		const float maxX = (nodeX > localAabb.x + localAabb.w) ? nodeX : localAabb.x + localAabb.w;
+		const float maxY = (nodeY > localAabb.y + localAabb.h) ? nodeY : localAabb.y + localAabb.h;
+		localAabb = Rectf::fromMinMax(minX, minY, maxX, maxY);
+	}
+
+	vertices.pushBack(nodeX);
+	vertices.pushBack(nodeY);
+	vertices.pushBack(u);
+	vertices.pushBack(v);
+}
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+const float StaticBatchNode::DefaultChunkSize = 1024.0f;
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+StaticBatchNode::StaticBatchNode(SceneNode *parent, float xx, float yy)
+    : SceneNode(parent, xx, yy), chunkSize_(DefaultChunkSize), needsBake_(true),
+      numBakedChildren_(0), numBakes_(0), bakedChildrenSnapshot_(16),
+      bakedChildrenMask_(16), unbakedIndices_(4), chunks_(4)
+{
+	type_ = ObjectType::STATIC_BATCH_NODE;
+}
+
+StaticBatchNode::StaticBatchNode(SceneNode *parent, const Vector2f &position)
+    : StaticBatchNode(parent, position.x, position.y)
+{
+}
+
+StaticBatchNode::StaticBatchNode(SceneNode *parent)
+    : StaticBatchNode(parent, 0.0f, 0.0f)
+{
+}
+
+StaticBatchNode::StaticBatchNode()
+    : StaticBatchNode(nullptr, 0.0f, 0.0f)
+{
+}
+
+StaticBatchNode::~StaticBatchNode() = default;
+
+StaticBatchNode::StaticBatchNode(StaticBatchNode &&) = default;
+
+StaticBatchNode &StaticBatchNode::operator=(StaticBatchNode &&) = default;
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+/*! \note Children are baked again, after being updated, if any of them has changed since the last bake */
+void StaticBatchNode::update(float interval)
+{
+	if (updateEnabled_ == false)
+		return;
+
+	// The flags of the children are checked before their own update resets them
+	const bool wasSubtreeDirty = subtreeDirty_;
+	if (wasSubtreeDirty && needsBake_ == false)
+		needsBake_ = isBakeOutdated();
+
+	resetSubtreeDirty();
+
+	const uint16_t prevAbsLayer = absLayer_;
+	const bool prevWithVisitOrder = withVisitOrder_;
+	transform();
+
+	const bool childrenInheritChanges = dirtyBits_.test(DirtyBitPositions::TransformationBit) ||
+	                                    dirtyBits_.test(DirtyBitPositions::ColorBit) ||
+	                                    absLayer_ != prevAbsLayer || withVisitOrder_ != prevWithVisitOrder;
+	if (needsBake_)
+	{
+		// Any child could be part of the next bake and needs an up to date local matrix
+		for (SceneNode *child : children_)
+		{
+			if (childrenInheritChanges || child->isSubtreeDirty())
+				child->update(interval);
+		}
+		bake();
+	}
+	else if (childrenInheritChanges || wasSubtreeDirty)
+	{
+		// Baked children only need their local matrix, which does not depend on inherited changes
+		for (unsigned int index : unbakedIndices_)
+		{
+			SceneNode *child = children_[index];
+			if (childrenInheritChanges || child->isSubtreeDirty())
+				child->update(interval);
+		}
+	}
+
+	lastFrameUpdated_ = theApplication().numFrames();
+}
+
+void StaticBatchNode::visit(RenderQueue &renderQueue, unsigned int &visitOrderIndex)
+{
+	if (drawEnabled_ == false)
+		return;
+
+	// All chunks share the same visit order, as a single drawable node would do
+	visitOrderIndex_ = visitOrderIndex + 1;
+	const bool rendered = draw(renderQueue);
+	visitOrderIndex_ = rendered ? visitOrderIndex++ : visitOrderIndex;
+
+	for (unsigned int index : unbakedIndices_)
+	{
+		// The children array might have changed after the last bake
+		if (index < children_.size())
+			children_[index]->visit(renderQueue, visitOrderIndex);
+	}
+}
+
+bool StaticBatchNode::draw(RenderQueue &renderQueue)
+{
+	if (chunks_.isEmpty())
+		return false;
+
+	updateRenderCommands();
+
+	const bool cullingEnabled = theApplication().renderingSettings().cullingEnabled;
+	const Rectf cullingRect = RenderResources::currentViewport()->cullingRect();
+
+	bool rendered = false;
+	for (nctl::UniquePtr<Chunk> &chunk : chunks_)
+	{
+		if (cullingEnabled && chunk->aabb.overlaps(cullingRect) == false)
+		{
+			RenderStatistics::addCulledNode();
+			continue;
+		}
+
+		RenderCommand *renderCommand = chunk->renderCommand.get();
+		renderCommand->setLayer(absLayer_);
+		renderCommand->setVisitOrder(withVisitOrder_ ? visitOrderIndex_ : 0);
+		renderCommand->setAabb(chunk->aabb);
+		renderQueue.addCommand(renderCommand);
+		rendered = true;
+	}
+
+	return rendered;
+}
+
+void StaticBatchNode::setChunkSize(float chunkSize)
+{
+	ASSERT(chunkSize > 0.0f);
+	if (chunkSize > 0.0f && chunkSize_ != chunkSize)
+	{
+		chunkSize_ = chunkSize;
+		invalidateBake();
+	}
+}
+
+void StaticBatchNode::invalidateBake()
+{
+	needsBake_ = true;
+	markSubtreeDirty();
+}
+
+///////////////////////////////////////////////////////////
+// PROTECTED FUNCTIONS
+///////////////////////////////////////////////////////////
+
+StaticBatchNode::StaticBatchNode(const StaticBatchNode &other)
+    : SceneNode(other), chunkSize_(other.chunkSize_), needsBake_(true),
+      numBakedChildren_(0), numBakes_(0), bakedChildrenSnapshot_(16),
+      bakedChildrenMask_(16), unbakedIndices_(4), chunks_(4)
+{
+	type_ = ObjectType::STATIC_BATCH_NODE;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool StaticBatchNode::isBakeable(const SceneNode &child)
+{
+	if (child.type() != ObjectType::SPRITE && child.type() != ObjectType::MESH_SPRITE)
+		return false;
+
+	// Children that are not enabled or that have their own subtree are kept out of the bake
+	if (child.isEnabled() == false || child.children().isEmpty() == false)
+		return false;
+
+	// A child updated every frame would always be dirty and would trigger a bake every frame
+	if (child.updateMode() != UpdateMode::ON_CHANGE)
+		return false;
+
+	const DrawableNode &drawable = static_cast<const DrawableNode &>(child);
+	const BaseSprite &sprite = static_cast<const BaseSprite &>(child);
+	if (sprite.texture() == nullptr || drawable.width_ == 0.0f || drawable.height_ == 0.0f)
+		return false;
+
+	// Custom shaders might not understand the baked vertex format
+	const Material::ShaderProgramType shaderProgramType = drawable.renderCommand_->material().shaderProgramType();
+	if (child.type() == ObjectType::SPRITE)
+	{
+		return (shaderProgramType == Material::ShaderProgramType::SPRITE ||
+		        shaderProgramType == Material::ShaderProgramType::SPRITE_GRAY);
+	}
+
+	const MeshSprite &meshSprite = static_cast<const MeshSprite &>(child);
+	return ((shaderProgramType == Material::ShaderProgramType::MESH_SPRITE ||
+	         shaderProgramType == Material::ShaderProgramType::MESH_SPRITE_GRAY) &&
+	        drawable.renderCommand_->geometry().primitiveType() == GL_TRIANGLE_STRIP &&
+	        meshSprite.bytesPerVertex() == MeshSprite::VertexBytes &&
+	        meshSprite.numVertices() >= 3 && meshSprite.numVertices() <= MaxChunkVertices);
+}
+
+bool StaticBatchNode::isBakeOutdated() const
+{
+	if (children_.size() != bakedChildrenSnapshot_.size())
+		return true;
+
+	for (unsigned int i = 0; i < children_.size(); i++)
+	{
+		const SceneNode *child = children_[i];
+		if (child != bakedChildrenSnapshot_[i])
+			return true;
+		// Unbaked children can change freely, unless they have become bakeable
+		if (child->isSubtreeDirty() && (bakedChildrenMask_[i] || isBakeable(*child)))
+			return true;
+	}
+
+	return false;
+}
+
+void StaticBatchNode::bake()
+{
+	ZoneScoped;
+
+	chunks_.clear();
+	unbakedIndices_.clear();
+	bakedChildrenSnapshot_.clear();
+	bakedChildrenMask_.clear();
+	numBakedChildren_ = 0;
+
+	nctl::SmallArray<BakeGroup, 4> groups;
+	nctl::Array<BakeEntry> entries(children_.size());
+	for (unsigned int i = 0; i < children_.size(); i++)
+	{
+		SceneNode *child = children_[i];
+		bakedChildrenSnapshot_.pushBack(child);
+
+		const bool bakeable = isBakeable(*child);
+		bakedChildrenMask_.pushBack(bakeable);
+		if (bakeable == false)
+		{
+			unbakedIndices_.pushBack(i);
+			continue;
+		}
+		numBakedChildren_++;
+
+		const DrawableNode &drawable = static_cast<const DrawableNode &>(*child);
+		const Material &material = drawable.renderCommand_->material();
+		BakeGroup group;
+		group.texture = static_cast<const BaseSprite *>(child)->texture();
+		group.shaderProgramType = toMeshSpriteShaderProgramType(material.shaderProgramType());
+		group.blendingEnabled = material.isBlendingEnabled();
+		group.srcBlendingFactor = material.srcBlendingFactor();
+		group.destBlendingFactor = material.destBlendingFactor();
+		group.color = child->color();
+
+		unsigned int groupIndex = 0;
+		while (groupIndex < groups.size() && isSameGroup(groups[groupIndex], group) == false)
+			groupIndex++;
+		if (groupIndex == groups.size())
+			groups.pushBack(group);
+
+		BakeEntry entry;
+		entry.groupIndex = groupIndex;
+		entry.cellX = static_cast<int>(floorf(child->position().x / chunkSize_));
+		entry.cellY = static_cast<int>(floorf(child->position().y / chunkSize_));
+		entry.childIndex = i;
+		entries.pushBack(entry);
+	}
+
+	nctl::quicksort(entries.begin(), entries.end(), isEntryLess);
+
+	nctl::SmallArray<unsigned int, 8> chunkGroups;
+	Chunk *chunk = nullptr;
+	for (unsigned int i = 0; i < entries.size(); i++)
+	{
+		const BakeEntry &entry = entries[i];
+		const DrawableNode &child = static_cast<const DrawableNode &>(*children_[entry.childIndex]);
+		const unsigned int numVertices = (child.type() == ObjectType::SPRITE) ? 4 : static_cast<const MeshSprite &>(child).numVertices();
+
+		// A new chunk is started for every cell of a group or when its indices would overflow
+		if (i == 0 || isSameChunk(entry, entries[i - 1]) == false ||
+		    chunk->vertices.size() / MeshSprite::VertexFloats + numVertices > MaxChunkVertices)
+		{
+			chunks_.pushBack(nctl::makeUnique<Chunk>());
+			chunkGroups.pushBack(entry.groupIndex);
+			chunk = chunks_.back().get();
+			chunk->color = groups[entry.groupIndex].color;
+		}
+
+		chunk->addSprite(static_cast<const BaseSprite &>(child), child.width_, child.height_);
+	}
+
+	for (unsigned int i = 0; i < chunks_.size(); i++)
+	{
+		Chunk &chunk = *chunks_[i];
+		const BakeGroup &group = groups[chunkGroups[i]];
+		RenderCommand &renderCommand = *chunk.renderCommand;
+		renderCommand.setIdSortKey(id());
+
+		Material &material = renderCommand.material();
+		material.setShaderProgramType(group.shaderProgramType);
+		material.reserveUniformsDataMemory();
+		material.setDefaultAttributesParameters();
+		GLUniformCache *textureUniform = material.uniform(Material::TextureUniformName);
+		if (textureUniform && textureUniform->intValue(0) != 0)
+			textureUniform->setIntValue(0); // GL_TEXTURE0
+		material.setTexture(*group.texture);
+		material.setBlendingEnabled(group.blendingEnabled);
+		material.setBlendingFactors(group.srcBlendingFactor, group.destBlendingFactor);
+
+		// Vertices are already in node space and have final texture coordinates
+		GLUniformBlockCache *instanceBlock = material.uniformBlock(Material::InstanceBlockName);
+		GLUniformCache *texRectUniform = instanceBlock->uniform(Material::TexRectUniformName);
+		if (texRectUniform)
+			texRectUniform->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
+		GLUniformCache *spriteSizeUniform = instanceBlock->uniform(Material::SpriteSizeUniformName);
+		if (spriteSizeUniform)
+			spriteSizeUniform->setFloatValue(1.0f, 1.0f);
+		GLUniformCache *colorUniform = instanceBlock->uniform(Material::ColorUniformName);
+		if (colorUniform)
+			colorUniform->setFloatVector(Colorf(chunk.color * absColor_).data());
+
+		// The buffers are uploaded once, on the first commit
+		Geometry &geometry = renderCommand.geometry();
+		geometry.setPrimitiveType(GL_TRIANGLES);
+		geometry.setNumElementsPerVertex(MeshSprite::VertexFloats);
+		geometry.setNumVertices(chunk.vertices.size() / MeshSprite::VertexFloats);
+		geometry.createCustomVbo(chunk.vertices.size(), GL_STATIC_DRAW);
+		geometry.setHostVertexPointer(chunk.vertices.data());
+		geometry.setNumIndices(chunk.indices.size());
+		geometry.createCustomIbo(chunk.indices.size(), GL_STATIC_DRAW);
+		geometry.setHostIndexPointer(chunk.indices.data());
+
+		renderCommand.setTransformation(worldMatrix_);
+		chunk.aabb = transformRect(worldMatrix_, chunk.localAabb);
+	}
+
+	needsBake_ = false;
+	numBakes_++;
+}
+
+void StaticBatchNode::updateRenderCommands()
+{
+	if (dirtyBits_.test(DirtyBitPositions::TransformationBit))
+	{
+		for (nctl::UniquePtr<Chunk> &chunk : chunks_)
+		{
+			chunk->renderCommand->setTransformation(worldMatrix_);
+			chunk->aabb = transformRect(worldMatrix_, chunk->localAabb);
+		}
+		dirtyBits_.reset(DirtyBitPositions::TransformationBit);
+		dirtyBits_.reset(DirtyBitPositions::AabbBit);
+	}
+
+	if (dirtyBits_.test(DirtyBitPositions::ColorBit))
+	{
+		for (nctl::UniquePtr<Chunk> &chunk : chunks_)
+		{
+			GLUniformBlockCache *instanceBlock = chunk->renderCommand->material().uniformBlock(Material::InstanceBlockName);
+			GLUniformCache *colorUniform = instanceBlock->uniform(Material::ColorUniformName);
+			if (colorUniform)
+				colorUniform->setFloatVector(Colorf(chunk->color * absColor_).data());
+		}
+		dirtyBits_.reset(DirtyBitPositions::ColorBit);
+	}
+}
+
+void StaticBatchNode::Chunk::addSprite(const BaseSprite &sprite, float width, float height)
+{
+	const Matrix4x4f &localMatrix = sprite.localMatrix();
+	const Recti texRect = sprite.texRect();
+	const Vector2i texSize = sprite.texture()->size();
+	const float texScaleX = texRect.w / float(texSize.x);
+	const float texBiasX = texRect.x / float(texSize.x);
+	const float texScaleY = texRect.h / float(texSize.y);
+	const float texBiasY = texRect.y / float(texSize.y);
+
+	const unsigned int firstVertex = vertices.size() / MeshSprite::VertexFloats;
+	if (sprite.type() == ObjectType::SPRITE)
+	{
+		// Same quad as the one generated from the vertex id in the sprite shader
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			const float x = (0.5f - float(i >> 1)) * width;
+			const float y = (-0.5f + float(i % 2)) * height;
+			const float u = (1.0f - float(i >> 1)) * texScaleX + texBiasX;
+			const float v = (1.0f - float(i % 2)) * texScaleY + texBiasY;
+			addVertex(localMatrix, x, y, u, v);
+		}
+
+		const GLushort first = static_cast<GLushort>(firstVertex);
+		const GLushort quadIndices[6] = { first, GLushort(first + 1), GLushort(first + 2),
+			                              GLushort(first + 2), GLushort(first + 1), GLushort(first + 3) };
+		for (unsigned int i = 0; i < 6; i++)
+			indices.pushBack(quadIndices[i]);
+		return;
+	}
+
+	const MeshSprite &meshSprite = static_cast<const MeshSprite &>(sprite);
+	const MeshSprite::Vertex *meshVertices = reinterpret_cast<const MeshSprite::Vertex *>(meshSprite.vertices());
+	for (unsigned int i = 0; i < meshSprite.numVertices(); i++)
+	{
+		const MeshSprite::Vertex &vertex = meshVertices[i];
+		addVertex(localMatrix, vertex.x * width, vertex.y * height,
+		          vertex.u * texScaleX + texBiasX, vertex.v * texScaleY + texBiasY);
+	}
+
+	// Converting the triangle strip into a list, the indices of a mesh can be either 16 or 32 bits
+	if (meshSprite.numIndices() == 0)
+		TriangleStrip::appendAsList(meshSprite.numVertices(), firstVertex, indices);
+	else if (meshSprite.uses32BitIndices())
+		TriangleStrip::appendAsList(meshSprite.indices32(), meshSprite.numIndices(), firstVertex, indices);
+	else
+		TriangleStrip::appendAsList(meshSprite.indices(), meshSprite.numIndices(), firstVertex, indices);
+}
+
+}
@@ -1,11 +1,44 @@
+#include <cstring> // for `memcpy()`
+#include <nctl/SmallArray.h>
 #include "TextNode.h"
 #include "FontGlyph.h"
 #include "Texture.h"
 #include "RenderCommand.h"
+#include "Application.h"
 #include "tracy.h"
 
 namespace ncine {
 
+namespace {
+
+	/// Converts a float to a half-float, rounding to the nearest even value
+	/*! \note Values too small to be represented as normalized half-floats are flushed to zero */
+	uint16_t floatToHalf(float value)
+	{
+		uint32_t bits = 0;
+		memcpy(&bits, &value, sizeof(float));
+
+		const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+		uint32_t absBits = bits & 0x7FFFFFFF;
+		if (absBits >= 0x47800000) // overflow, infinity or NaN
+			return sign | (absBits > 0x7F800000 ? 0x7E00 : 0x7C00);
+		if (absBits < 0x38800000) // below the smallest normalized half-float
+			return sign;
+
+		// Rebias the exponent from 127 to 15 and round the mantissa from 23 to 10 bits
+		absBits += 0xC8000FFF + ((absBits >> 13) & 1);
+		return sign | static_cast<uint16_t>(absBits >> 13);
+	}
+
+	/// Converts a float in the [0.0, 1.0] range to a normalized unsigned short
+	uint16_t floatToUnorm16(float value)
+	{
+		const float clamped = (value < 0.0f) ? 0.0f : (value > 1.0f ? 1.0f : value);
+		return static_cast<uint16_t>(clamped * 65535.0f + 0.5f);
+	}
+
+}
+
 Material::ShaderProgramType fontRenderModeToShaderProgram(const Font::RenderMode renderMode)
 {
 	switch (renderMode)
@@ -39,9 +72,11 @@ TextNode::TextNode(SceneNode *parent, Font *font)
 }
 
 TextNode::TextNode(SceneNode *parent, Font *font, unsigned int maxStringLength)
-    : DrawableNode(parent, 0.0f, 0.0f), string_(maxStringLength), dirtyDraw_(true),
+    : DrawableNode(parent, 0.0f, 0.0f), string_(maxStringLength), codePoints_(maxStringLength), dirtyDraw_(true),
       dirtyBoundaries_(true), withKerning_(true), font_(font),
       interleavedVertices_(maxStringLength * 4 + (maxStringLength - 1) * 2),
+      usePackedVertices_(theApplication().appConfiguration().packedTextVertices),
+      packedVertices_(usePackedVertices_ ? maxStringLength * 4 + (maxStringLength - 1) * 2 : 0),
       xAdvance_(0.0f), yAdvance_(0.0f), lineLengths_(4), alignment_(Alignment::LEFT),
       lineHeight_(font ? font->lineHeight() : 0.0f), instanceBlock_(nullptr)
 {
@@ -106,6 +141,7 @@ void TextNode::setFont(Font *font)
 
 		dirtyDraw_ = true;
 		dirtyBoundaries_ = true;
+		markSubtreeDirty();
 	}
 	else
 	{
@@ -145,6 +181,7 @@ void TextNode::enableKerning(bool withKerning)
 		withKerning_ = withKerning;
 		dirtyDraw_ = true;
 		dirtyBoundaries_ = true;
+		markSubtreeDirty();
 	}
 }
 
@@ -155,6 +192,7 @@ void TextNode::setAlignment(Alignment alignment)
 		alignment_ = alignment;
 		dirtyDraw_ = true;
 		dirtyBoundaries_ = true;
+		markSubtreeDirty();
 	}
 }
 
@@ -165,6 +203,7 @@ void TextNode::setString(const nctl::String &string)
 		string_ = string;
 		dirtyDraw_ = true;
 		dirtyBoundaries_ = true;
+		markSubtreeDirty();
 	}
 }
 
@@ -175,6 +214,7 @@ void TextNode::setString(const char *string)
 		string_.assign(string);
 		dirtyDraw_ = true;
 		dirtyBoundaries_ = true;
+		markSubtreeDirty();
 	}
 }
 
@@ -185,37 +225,29 @@ Vector2f TextNode::calculateBoundaries(const Font &font, bool withKerning, const
 	float yAdvance = 0.0f;
 
 	const float lineHeight = static_cast<float>(font.lineHeight());
-	const unsigned int length = string.length();
-	for (unsigned int i = 0; i < length;) // increments handled by UTF-8 decoding
+	nctl::SmallArray<unsigned int, 256> codePoints(string.length());
+	codePoints.setSize(string.length());
+	const unsigned int numCodePoints = string.utf8ToCodePoints(codePoints.data());
+	for (unsigned int i = 0; i < numCodePoints; i++)
 	{
-		if (string[i] == '\n')
+		const unsigned int codePoint = codePoints[i];
+		if (codePoint == '\n')
 		{
 			if (xAdvance > xAdvanceMax)
 				xAdvanceMax = xAdvance;
 			xAdvance = 0.0f;
 			yAdvance += lineHeight;
-			i++; // manual increment as newline character is not decoded
 		}
 		else
 		{
-			unsigned int codepoint = nctl::Utf8::InvalidUnicode;
-			const int codePointLength = string.utf8ToCodePoint(i, codepoint);
-			const FontGlyph *glyph = (codepoint != nctl::Utf8::InvalidUnicode) ? font.glyph(codepoint) : nullptr;
+			const FontGlyph *glyph = (codePoint != nctl::Utf8::InvalidUnicode) ? font.glyph(codePoint) : nullptr;
 			if (glyph)
 			{
 				xAdvance += glyph->xAdvance();
-				if (withKerning)
-				{
-					// font kerning
-					if (i + codePointLength < length)
-					{
-						unsigned int nextCodepoint = nctl::Utf8::InvalidUnicode;
-						string.utf8ToCodePoint(i + codePointLength, nextCodepoint);
-						xAdvance += glyph->kerning(nextCodepoint);
-					}
-				}
+				// font kerning
+				if (withKerning && i + 1 < numCodePoints)
+					xAdvance += glyph->kerning(codePoints[i + 1]);
 			}
-			i += codePointLength; // manual increment to next codepoint
 		}
 	}
 
@@ -239,6 +271,9 @@ void TextNode::transform()
 
 bool TextNode::draw(RenderQueue &renderQueue)
 {
+	// The node might not have been transformed since the string changed, as when its update is skipped
+	calculateBoundaries();
+
 	// Early-out if the string is empty
 	if (string_.isEmpty())
 		return false;
@@ -252,53 +287,53 @@ bool TextNode::draw(RenderQueue &renderQueue)
 		unsigned int currentLine = 0;
 		xAdvance_ = calculateAlignment(currentLine) - width_ * 0.5f;
 		yAdvance_ = 0.0f - height_ * 0.5f;
-		const unsigned int length = string_.length();
-		for (unsigned int i = 0; i < length;) // increments handled by UTF-8 decoding
+		// The code points have been decoded by `calculateBoundaries()`
+		const unsigned int numCodePoints = codePoints_.size();
+		for (unsigned int i = 0; i < numCodePoints; i++)
 		{
-			if (string_[i] == '\n')
+			const unsigned int codePoint = codePoints_[i];
+			if (codePoint == '\n')
 			{
 				currentLine++;
 				xAdvance_ = calculateAlignment(currentLine) - width_ * 0.5f;
 				yAdvance_ += lineHeight_;
-				i++; // manual increment as newline character is not decoded
 			}
 			else
 			{
-				unsigned int codepoint = nctl::Utf8::InvalidUnicode;
-				const int codePointLength = string_.utf8ToCodePoint(i, codepoint);
-				const FontGlyph *glyph = (codepoint != nctl::Utf8::InvalidUnicode) ? font_->glyph(codepoint) : nullptr;
+				const FontGlyph *glyph = (codePoint != nctl::Utf8::InvalidUnicode) ? font_->glyph(codePoint) : nullptr;
 				if (glyph)
 				{
 					Degenerate degen = Degenerate::NONE;
-					if (length > 1)
+					if (numCodePoints > 1)
 					{
 						if (i == 0)
 							degen = Degenerate::END;
-						else if (i == length - 1)
+						else if (i == numCodePoints - 1)
 							degen = Degenerate::START;
 						else
 							degen = Degenerate::START_END;
 					}
 					processGlyph(glyph, degen);
 
-					if (withKerning_)
-					{
-						// font kerning
-						if (i + codePointLength < length)
-						{
-							unsigned int nextCodepoint = nctl::Utf8::InvalidUnicode;
-							string_.utf8ToCodePoint(i + codePointLength, nextCodepoint);
-							xAdvance_ += glyph->kerning(nextCodepoint);
-						}
-					}
+					// font kerning
+					if (withKerning_ && i + 1 < numCodePoints)
+						xAdvance_ += glyph->kerning(codePoints_[i + 1]);
 				}
-				i += codePointLength; // manual increment to next codepoint
 			}
 		}
 
 		// Vertices are updated only if the string changes
-		renderCommand_->geometry().setNumVertices(interleavedVertices_.size());
-		renderCommand_->geometry().setHostVertexPointer(reinterpret_cast<const float *>(interleavedVertices_.data()));
+		if (usePackedVertices_)
+		{
+			packVertices();
+			renderCommand_->geometry().setNumVertices(packedVertices_.size());
+			renderCommand_->geometry().setHostVertexPointer(reinterpret_cast<const float *>(packedVertices_.data()));
+		}
+		else
+		{
+			renderCommand_->geometry().setNumVertices(interleavedVertices_.size());
+			renderCommand_->geometry().setHostVertexPointer(reinterpret_cast<const float *>(interleavedVertices_.data()));
+		}
 		dirtyDraw_ = false;
 	}
 
@@ -311,9 +346,11 @@ bool TextNode::draw(RenderQueue &renderQueue)
 
 TextNode::TextNode(const TextNode &other)
     : DrawableNode(other),
-      string_(other.string_), dirtyDraw_(true), dirtyBoundaries_(true),
+      string_(other.string_), codePoints_(other.codePoints_), dirtyDraw_(true), dirtyBoundaries_(true),
       withKerning_(other.withKerning_), font_(other.font_),
       interleavedVertices_(string_.capacity() * 4 + (string_.capacity() - 1) * 2),
+      usePackedVertices_(other.usePackedVertices_),
+      packedVertices_(usePackedVertices_ ? string_.capacity() * 4 + (string_.capacity() - 1) * 2 : 0),
       xAdvance_(0.0f), yAdvance_(0.0f), lineLengths_(4), alignment_(other.alignment_),
       lineHeight_(font_ ? font_->lineHeight() : 0.0f), instanceBlock_(nullptr)
 {
@@ -348,7 +385,8 @@ void TextNode::init()
 		renderCommand_->material().setTexture(*font_->texture());
 
 	renderCommand_->geometry().setPrimitiveType(GL_TRIANGLE_STRIP);
-	renderCommand_->geometry().setNumElementsPerVertex(sizeof(Vertex) / sizeof(float));
+	const unsigned int vertexSize = usePackedVertices_ ? sizeof(PackedVertex) : sizeof(Vertex);
+	renderCommand_->geometry().setNumElementsPerVertex(vertexSize / sizeof(float));
 }
 
 void TextNode::calculateBoundaries() const
@@ -363,38 +401,32 @@ void TextNode::calculateBoundaries() const
 		float xAdvanceMax = 0.0f; // longest line
 		xAdvance_ = 0.0f;
 		yAdvance_ = 0.0f;
-		const unsigned int length = string_.length();
-		for (unsigned int i = 0; i < length;) // increments handled by UTF-8 decoding
+
+		// The string is decoded only once, the code points are reused when drawing
+		codePoints_.setSize(string_.length());
+		codePoints_.setSize(string_.utf8ToCodePoints(codePoints_.data()));
+		const unsigned int numCodePoints = codePoints_.size();
+		for (unsigned int i = 0; i < numCodePoints; i++)
 		{
-			if (string_[i] == '\n')
+			const unsigned int codePoint = codePoints_[i];
+			if (codePoint == '\n')
 			{
 				lineLengths_.pushBack(xAdvance_);
 				if (xAdvance_ > xAdvanceMax)
 					xAdvanceMax = xAdvance_;
 				xAdvance_ = 0.0f;
 				yAdvance_ += lineHeight_;
-				i++; // manual increment as newline character is not decoded
 			}
 			else
 			{
-				unsigned int codepoint = nctl::Utf8::InvalidUnicode;
-				const int codePointLength = string_.utf8ToCodePoint(i, codepoint);
-				const FontGlyph *glyph = (codepoint != nctl::Utf8::InvalidUnicode) ? font_->glyph(codepoint) : nullptr;
+				const FontGlyph *glyph = (codePoint != nctl::Utf8::InvalidUnicode) ? font_->glyph(codePoint) : nullptr;
 				if (glyph)
 				{
 					xAdvance_ += glyph->xAdvance();
-					if (withKerning_)
-					{
-						// font kerning
-						if (i + codePointLength < length)
-						{
-							unsigned int nextCodepoint = nctl::Utf8::InvalidUnicode;
-							string_.utf8ToCodePoint(i + codePointLength, nextCodepoint);
-							xAdvance_ += glyph->kerning(nextCodepoint);
-						}
-					}
+					// font kerning
+					if (withKerning_ && i + 1 < numCodePoints)
+						xAdvance_ += glyph->kerning(codePoints_[i + 1]);
 				}
-				i += codePointLength; // manual increment to next codepoint
 			}
 		}
 
@@ -477,6 +509,23 @@ void TextNode::processGlyph(const FontGlyph *glyph, Degenerate degen)
 	xAdvance_ += glyph->xAdvance();
 }
 
+void TextNode::packVertices()
+{
+	static_assert(sizeof(PackedVertex) % sizeof(float) == 0, "The size of a packed vertex should be a multiple of the size of a float");
+
+	const unsigned int numVertices = interleavedVertices_.size();
+	packedVertices_.setSize(numVertices);
+	for (unsigned int i = 0; i < numVertices; i++)
+	{
+		const Vertex &vertex = interleavedVertices_[i];
+		PackedVertex &packedVertex = packedVertices_[i];
+		packedVertex.x = floatToHalf(vertex.x);
+		packedVertex.y = floatToHalf(vertex.y);
+		packedVertex.u = floatToUnorm16(vertex.u);
+		packedVertex.v = floatToUnorm16(vertex.v);
+	}
+}
+
 void TextNode::shaderHasChanged()
 {
 	renderCommand_->material().reserveUniformsDataMemory();
@@ -488,7 +537,10 @@ void TextNode::shaderHasChanged()
 	dirtyBits_.set(DirtyBitPositions::TransformationBit);
 	dirtyBits_.set(DirtyBitPositions::ColorBit);
 
-	renderCommand_->material().setDefaultAttributesParameters();
+	if (usePackedVertices_)
+		renderCommand_->material().setPackedAttributesParameters();
+	else
+		renderCommand_->material().setDefaultAttributesParameters();
 }
 
 void TextNode::updateRenderCommand()
@@ -8,6 +8,11 @@
 #include "RenderStatistics.h"
 #include "tracy.h"
 
+#ifdef WITH_ALLOCATORS
+	#include <nctl/AllocManager.h>
+	#include <nctl/FrameAllocator.h>
+#endif
+
 namespace ncine {
 
 GLenum ncFormatToInternal(Texture::Format format)
@@ -78,6 +83,33 @@ uint32_t *chromaKeyPixels(uint32_t *destBuffer, const unsigned char *srcBuffer,
 	return destBuffer;
 }
 
+#ifdef WITH_ALLOCATORS
+/// Chroma keyed pixels only live until they are uploaded, they are served by the frame allocator
+using ChromaPixels = nctl::UniquePtr<uint32_t[], nctl::AllocDelete<uint32_t[]>>;
+
+ChromaPixels emptyChromaPixels()
+{
+	return ChromaPixels(nullptr, nctl::AllocDelete<uint32_t[]>(&nctl::theFrameAllocator()));
+}
+
+ChromaPixels allocateChromaPixels(unsigned int numPixels)
+{
+	return nctl::allocateUnique<uint32_t[]>(nctl::theFrameAllocator(), numPixels);
+}
+#else
+using ChromaPixels = nctl::UniquePtr<uint32_t[]>;
+
+ChromaPixels emptyChromaPixels()
+{
+	return ChromaPixels();
+}
+
+ChromaPixels allocateChromaPixels(unsigned int numPixels)
+{
+	return nctl::makeUnique<uint32_t[]>(numPixels);
+}
+#endif
+
 ///////////////////////////////////////////////////////////
 // CONSTRUCTORS and DESTRUCTOR
 ///////////////////////////////////////////////////////////
@@ -256,13 +288,13 @@ bool Texture::loadFromTexels(const unsigned char *bufferPtr, Recti region)
 bool Texture::loadFromTexels(const unsigned char *bufferPtr, unsigned int level, unsigned int x, unsigned int y, unsigned int width, unsigned int height)
 {
 	const unsigned char *data = bufferPtr;
-	nctl::UniquePtr<uint32_t[]> chromaPixels;
+	ChromaPixels chromaPixels = emptyChromaPixels();
 
 	if (format_ == Format::RGB8 && isChromaKeyEnabled_)
 	{
 		format_ = Format::RGBA8;
 		const unsigned int numPixels = width * height - (y * width + x);
-		chromaPixels = nctl::makeUnique<uint32_t[]>(numPixels);
+		chromaPixels = allocateChromaPixels(numPixels);
 		chromaKeyPixels(chromaPixels.get(), bufferPtr, numPixels, chromaKeyColor_);
 		data = reinterpret_cast<const unsigned char *>(chromaPixels.get());
 	}
@@ -487,7 +519,7 @@ void Texture::load(const ITextureLoader &texLoader)
 	int levelHeight = height_;
 
 	GLenum format = texFormat.format();
-	nctl::UniquePtr<uint32_t[]> chromaPixels;
+	ChromaPixels chromaPixels = emptyChromaPixels();
 
 	for (int mipIdx = 0; mipIdx < texLoader.mipMapCount(); mipIdx++)
 	{
@@ -496,7 +528,7 @@ void Texture::load(const ITextureLoader &texLoader)
 		{
 			format = GL_RGBA;
 			const unsigned int numPixels = levelWidth * levelHeight;
-			chromaPixels = nctl::makeUnique<uint32_t[]>(numPixels);
+			chromaPixels = allocateChromaPixels(numPixels);
 			chromaKeyPixels(chromaPixels.get(), texLoader.pixels(mipIdx), numPixels, chromaKeyColor_);
 			data = reinterpret_cast<const unsigned char *>(chromaPixels.get());
 		}
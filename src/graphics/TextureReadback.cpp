@@ -0,0 +1,413 @@
+#define NCINE_INCLUDE_OPENGL
+#include "common_headers.h"
+#include "common_macros.h"
+#include <cstring> // for `memcpy()`
+#include <nctl/String.h>
+#include <nctl/SharedPtr.h>
+#include <nctl/Atomic.h>
+#include "TextureReadback.h"
+#include "Texture.h"
+#include "GLTexture.h"
+#include "GLBufferObject.h"
+#include "GLFramebufferObject.h"
+#include "FileSystem.h"
+#include "Application.h"
+#include "ServiceLocator.h"
+#include "IThreadCommand.h"
+#include "tracy.h"
+
+#ifdef WITH_PNG
+	#include "TextureSaverPng.h"
+#endif
+#ifdef WITH_WEBP
+	#include "TextureSaverWebP.h"
+#endif
+
+namespace ncine {
+
+namespace {
+
+	const unsigned int BytesPerPixel = 4;
+
+	/// The data shared between the main thread and the worker thread encoding the pixels of a save request
+	struct EncodeState
+	{
+		enum Status
+		{
+			ENCODING = 0,
+			SUCCEEDED,
+			FAILED
+		};
+
+		EncodeState(int w, int h, const nctl::String &name)
+		    : width(w), height(h), filename(name), status(ENCODING) {}
+
+		int width;
+		int height;
+		nctl::UniquePtr<unsigned char[]> pixels;
+		nctl::String filename;
+		nctl::Atomic32 status;
+	};
+
+	bool hasSupportedExtension(const char *filename)
+	{
+#ifdef WITH_PNG
+		if (fs::hasExtension(filename, "png"))
+			return true;
+#endif
+#ifdef WITH_WEBP
+		if (fs::hasExtension(filename, "webp"))
+			return true;
+#endif
+		return false;
+	}
+
+	void encodePixels(EncodeState &state)
+	{
+		ZoneScoped;
+		ITextureSaver::Properties properties;
+		properties.width = state.width;
+		properties.height = state.height;
+		properties.format = ITextureSaver::Format::RGBA8;
+		// The first row read back from OpenGL is the bottom one
+		properties.verticalFlip = true;
+		properties.pixels = state.pixels.get();
+
+		bool saved = false;
+#ifdef WITH_PNG
+		if (fs::hasExtension(state.filename.data(), "png"))
+		{
+			TextureSaverPng saver;
+			saved = saver.saveToFile(properties, state.filename.data());
+		}
+#endif
+#ifdef WITH_WEBP
+		if (fs::hasExtension(state.filename.data(), "webp"))
+		{
+			TextureSaverWebP saver;
+			saved = saver.saveToFile(properties, state.filename.data());
+		}
+#endif
+
+		state.pixels.reset(nullptr);
+		state.status.store(saved ? EncodeState::SUCCEEDED : EncodeState::FAILED);
+	}
+
+	/// The worker thread command that encodes and saves the pixels of a save request
+	class EncodeCommand : public IThreadCommand
+	{
+	  public:
+		explicit EncodeCommand(const nctl::SharedPtr<EncodeState> &state)
+		    : state_(state) {}
+
+		void execute() override { encodePixels(*state_); }
+
+	  private:
+		/// The state is shared so that it outlives the request if the readback class is disposed while encoding
+		nctl::SharedPtr<EncodeState> state_;
+	};
+
+}
+
+struct TextureReadback::Request
+{
+	Request()
+	    : x(0), y(0), width(0), height(0), fromScreen(false),
+	      callback(nullptr), userData(nullptr), fence(nullptr) {}
+
+	int x;
+	int y;
+	int width;
+	int height;
+	/// The flag is `true` if the pixels are read from the screen at the end of the frame
+	bool fromScreen;
+	/// The name of the file to save, empty for a readback request
+	nctl::String filename;
+	CompletionCallback callback;
+	void *userData;
+
+	nctl::UniquePtr<GLBufferObject> pbo;
+	/// The fence inserted after the copy, `nullptr` until the request has been issued
+	GLsync fence;
+	/// The encoding state, only allocated for save requests whose pixels have been read back
+	nctl::SharedPtr<EncodeState> encodeState;
+};
+
+///////////////////////////////////////////////////////////
+// STATIC DEFINITIONS
+///////////////////////////////////////////////////////////
+
+nctl::Array<nctl::UniquePtr<TextureReadback::Request>> TextureReadback::requests_(4);
+nctl::UniquePtr<GLFramebufferObject> TextureReadback::fbo_;
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool TextureReadback::readTexture(const Texture &texture, CompletionCallback callback, void *userData)
+{
+	ASSERT(callback);
+	if (callback == nullptr)
+		return false;
+
+	if (texture.isCompressed() || texture.numChannels() == 0)
+	{
+		LOGW_X("Texture \"%s\" cannot be read back as it is compressed or has an unknown format", texture.name());
+		return false;
+	}
+
+	Request *request = createRequest(texture.width(), texture.height(), nullptr, callback, userData);
+	if (request == nullptr)
+		return false;
+
+	return issueTextureRequest(*request, texture);
+}
+
+bool TextureReadback::readScreen(const Recti &region, CompletionCallback callback, void *userData)
+{
+	ASSERT(callback);
+	if (callback == nullptr)
+		return false;
+
+	Request *request = createRequest(region.w, region.h, nullptr, callback, userData);
+	if (request == nullptr)
+		return false;
+
+	request->x = region.x;
+	request->y = region.y;
+	request->fromScreen = true;
+	return true;
+}
+
+bool TextureReadback::saveTexture(const Texture &texture, const char *filename, CompletionCallback callback, void *userData)
+{
+	ASSERT(filename);
+	if (filename == nullptr)
+		return false;
+
+	if (texture.isCompressed() || texture.numChannels() == 0)
+	{
+		LOGW_X("Texture \"%s\" cannot be saved as it is compressed or has an unknown format", texture.name());
+		return false;
+	}
+
+	Request *request = createRequest(texture.width(), texture.height(), filename, callback, userData);
+	if (request == nullptr)
+		return false;
+
+	return issueTextureRequest(*request, texture);
+}
+
+bool TextureReadback::saveScreenshot(const char *filename, CompletionCallback callback, void *userData)
+{
+	ASSERT(filename);
+	if (filename == nullptr)
+		return false;
+
+	Request *request = createRequest(theApplication().widthInt(), theApplication().heightInt(), filename, callback, userData);
+	if (request == nullptr)
+		return false;
+
+	request->fromScreen = true;
+	return true;
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+TextureReadback::Request *TextureReadback::createRequest(int width, int height, const char *filename, CompletionCallback callback, void *userData)
+{
+	if (width <= 0 || height <= 0)
+	{
+		LOGW_X("Cannot read back an area of %d x %d pixels", width, height);
+		return nullptr;
+	}
+
+	if (filename && hasSupportedExtension(filename) == false)
+	{
+		LOGW_X("Cannot save \"%s\" as its extension is not supported", filename);
+		return nullptr;
+	}
+
+	nctl::UniquePtr<Request> request = nctl::makeUnique<Request>();
+	request->width = width;
+	request->height = height;
+	if (filename)
+		request->filename = filename;
+	request->callback = callback;
+	request->userData = userData;
+
+	requests_.pushBack(nctl::move(request));
+	return requests_.back().get();
+}
+
+void TextureReadback::issueRequest(Request &request, int x, int y)
+{
+	ZoneScoped;
+	const GLsizeiptr size = static_cast<GLsizeiptr>(request.width) * request.height * BytesPerPixel;
+	request.pbo = nctl::makeUnique<GLBufferObject>(GL_PIXEL_PACK_BUFFER);
+	request.pbo->bufferData(size, nullptr, GL_STREAM_READ);
+
+	// With a pixel pack buffer bound the pixels are copied asynchronously, at the buffer offset passed as a pointer
+	request.pbo->bind();
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(x, y, request.width, request.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	request.pbo->unbind();
+
+	request.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/*! \return False if the texture cannot be attached to a complete framebuffer, in which case the request is removed */
+bool TextureReadback::issueTextureRequest(Request &request, const Texture &texture)
+{
+	if (fbo_ == nullptr)
+		fbo_ = nctl::makeUnique<GLFramebufferObject>();
+
+	// Attaching binds the texture but it does not modify it
+	fbo_->attachTexture(const_cast<GLTexture &>(*texture.glTexture_), GL_COLOR_ATTACHMENT0);
+	const bool isStatusComplete = fbo_->isStatusComplete();
+	if (isStatusComplete)
+		issueRequest(request, 0, 0);
+	else
+		LOGE_X("Texture \"%s\" cannot be read back as its format cannot be attached to a framebuffer", texture.name());
+	fbo_->detachTexture(GL_COLOR_ATTACHMENT0);
+	GLFramebufferObject::unbind();
+
+	if (isStatusComplete == false)
+	{
+		ASSERT(requests_.back().get() == &request);
+		requests_.popBack();
+	}
+	return isStatusComplete;
+}
+
+void TextureReadback::update()
+{
+	if (requests_.isEmpty())
+		return;
+
+	ZoneScoped;
+	bool readsFromScreen = false;
+	for (nctl::UniquePtr<Request> &request : requests_)
+	{
+		if (request->fromScreen && request->fence == nullptr)
+		{
+			if (readsFromScreen == false)
+			{
+				GLFramebufferObject::unbind(GL_READ_FRAMEBUFFER);
+				readsFromScreen = true;
+			}
+			issueRequest(*request, request->x, request->y);
+		}
+	}
+	if (readsFromScreen)
+		GLFramebufferObject::unbind();
+
+	for (unsigned int i = 0; i < requests_.size();)
+	{
+		Request &request = *requests_[i];
+		bool completed = false;
+
+		if (request.encodeState != nullptr)
+		{
+			// The pixels have already been read back and are being encoded
+			const int32_t status = request.encodeState->status.load();
+			if (status != EncodeState::ENCODING)
+			{
+				if (request.callback)
+				{
+					Result result;
+					result.success = (status == EncodeState::SUCCEEDED);
+					result.width = request.width;
+					result.height = request.height;
+					result.filename = request.filename.data();
+					request.callback(result, request.userData);
+				}
+				completed = true;
+			}
+		}
+		else if (request.fence != nullptr)
+			completed = retrievePixels(request);
+
+		if (completed)
+			requests_.removeAt(i);
+		else
+			i++;
+	}
+}
+
+bool TextureReadback::retrievePixels(Request &request)
+{
+	const GLenum waitResult = glClientWaitSync(request.fence, 0, 0);
+	if (waitResult == GL_TIMEOUT_EXPIRED)
+		return false;
+
+	ZoneScoped;
+	glDeleteSync(request.fence);
+	request.fence = nullptr;
+
+	const unsigned long size = static_cast<unsigned long>(request.width) * request.height * BytesPerPixel;
+	nctl::UniquePtr<unsigned char[]> pixels = nctl::makeUnique<unsigned char[]>(size);
+	bool success = (waitResult != GL_WAIT_FAILED);
+	if (success)
+	{
+#if defined(__EMSCRIPTEN__)
+		request.pbo->bind();
+		glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, size, pixels.get());
+		request.pbo->unbind();
+#else
+		const void *mappedPixels = request.pbo->mapBufferRange(0, size, GL_MAP_READ_BIT);
+		success = (mappedPixels != nullptr);
+		if (success)
+		{
+			memcpy(pixels.get(), mappedPixels, size);
+			request.pbo->unmap();
+		}
+#endif
+	}
+	request.pbo.reset(nullptr);
+
+	if (success && request.filename.isEmpty() == false)
+	{
+		// Encoding happens on a worker thread when they are available, the request completes when it has finished
+		request.encodeState = nctl::makeShared<EncodeState>(request.width, request.height, request.filename);
+		request.encodeState->pixels = nctl::move(pixels);
+#ifdef WITH_THREADS
+		if (theApplication().appConfiguration().withThreads)
+		{
+			theServiceLocator().threadPool().enqueueCommand(nctl::makeUnique<EncodeCommand>(request.encodeState));
+			return false;
+		}
+#endif
+		encodePixels(*request.encodeState);
+		return false;
+	}
+
+	if (request.callback)
+	{
+		Result result;
+		result.success = success;
+		result.width = request.width;
+		result.height = request.height;
+		result.pixels = success ? pixels.get() : nullptr;
+		result.filename = request.filename.isEmpty() ? nullptr : request.filename.data();
+		request.callback(result, request.userData);
+	}
+
+	return true;
+}
+
+void TextureReadback::dispose()
+{
+	for (nctl::UniquePtr<Request> &request : requests_)
+	{
+		if (request->fence != nullptr)
+			glDeleteSync(request->fence);
+	}
+	// Requests that are still encoding share their state with the worker thread command
+	requests_.clear();
+	fbo_.reset(nullptr);
+}
+
+}
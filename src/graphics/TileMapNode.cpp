@@ -0,0 +1,392 @@
+#include <cmath>
+#include <nctl/algorithms.h>
+#include "TileMapNode.h"
+#include "Texture.h"
+#include "RenderQueue.h"
+#include "RenderCommand.h"
+#include "RenderResources.h"
+#include "TransformRect.h"
+#include "Viewport.h"
+#include "Application.h"
+#include "tracy.h"
+
+namespace ncine {
+
+namespace {
+
+	const unsigned int VertexFloats = 4;
+	const unsigned int MaxChunkTiles = TileMapNode::ChunkSize * TileMapNode::ChunkSize;
+	const unsigned int MaxChunkFloats = MaxChunkTiles * 4 * VertexFloats;
+	const unsigned int MaxChunkIndices = MaxChunkTiles * 6;
+
+}
+
+/// The vertices and the render command of a chunk
+struct TileMapNode::ChunkMesh
+{
+	ChunkMesh()
+	    : renderCommand(nctl::makeUnique<RenderCommand>(RenderCommand::CommandTypes::MESH_SPRITE)),
+	      vertices(MaxChunkFloats, nctl::ArrayMode::FIXED_CAPACITY) {}
+
+	nctl::UniquePtr<RenderCommand> renderCommand;
+	/// Vertex data, the whole custom VBO size is allocated
+	nctl::Array<float> vertices;
+};
+
+TileMapNode::Chunk::Chunk()
+    : numTiles(0), isDirty(false), lastFrameVisible(0)
+{
+}
+
+///////////////////////////////////////////////////////////
+// CONSTRUCTORS and DESTRUCTOR
+///////////////////////////////////////////////////////////
+
+TileMapNode::TileMapNode(SceneNode *parent, Texture *atlas, const Vector2i &tileSize, const Vector2i &mapSize)
+    : SceneNode(parent), atlas_(nullptr), tileSize_(tileSize), mapSize_(mapSize),
+      atlasSize_(0, 0), numChunks_(0, 0), residentChunks_(16), freeMeshes_(16),
+      indices_(MaxChunkIndices, nctl::ArrayMode::FIXED_CAPACITY), lastFrameEvicted_(0)
+{
+	ZoneScoped;
+	FATAL_ASSERT(tileSize.x > 0 && tileSize.y > 0);
+	FATAL_ASSERT(mapSize.x > 0 && mapSize.y > 0);
+
+	type_ = ObjectType::TILEMAP_NODE;
+
+	numChunks_.x = (mapSize_.x + ChunkSize - 1) / ChunkSize;
+	numChunks_.y = (mapSize_.y + ChunkSize - 1) / ChunkSize;
+	chunks_.setCapacity(numChunks_.x * numChunks_.y);
+	for (int i = 0; i < numChunks_.x * numChunks_.y; i++)
+		chunks_.emplaceBack();
+
+	// Every mesh draws its tiles as a list of independent quads
+	for (unsigned int i = 0; i < MaxChunkTiles; i++)
+	{
+		const unsigned short first = static_cast<unsigned short>(i * 4);
+		indices_.pushBack(first);
+		indices_.pushBack(first + 1);
+		indices_.pushBack(first + 2);
+		indices_.pushBack(first + 2);
+		indices_.pushBack(first + 1);
+		indices_.pushBack(first + 3);
+	}
+
+	setAtlas(atlas);
+}
+
+TileMapNode::TileMapNode(Texture *atlas, const Vector2i &tileSize, const Vector2i &mapSize)
+    : TileMapNode(nullptr, atlas, tileSize, mapSize)
+{
+}
+
+TileMapNode::~TileMapNode() = default;
+
+TileMapNode::TileMapNode(TileMapNode &&) = default;
+
+TileMapNode &TileMapNode::operator=(TileMapNode &&) = default;
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+bool TileMapNode::draw(RenderQueue &renderQueue)
+{
+	ZoneScoped;
+
+	const unsigned long int numFrames = theApplication().numFrames();
+	if (lastFrameEvicted_ != numFrames)
+	{
+		evictChunks();
+		lastFrameEvicted_ = numFrames;
+	}
+
+	if (dirtyBits_.test(DirtyBitPositions::TransformationBit) || dirtyBits_.test(DirtyBitPositions::ColorBit))
+	{
+		for (unsigned int index : residentChunks_)
+			updateMeshRenderCommand(*chunks_[index].mesh);
+		dirtyBits_.reset(DirtyBitPositions::TransformationBit);
+		dirtyBits_.reset(DirtyBitPositions::ColorBit);
+		dirtyBits_.reset(DirtyBitPositions::AabbBit);
+	}
+
+	if (atlas_ == nullptr)
+		return false;
+
+	// Only the chunks overlapping the culling rectangle, brought in node space, are considered
+	const float chunkWidth = static_cast<float>(tileSize_.x * ChunkSize);
+	const float chunkHeight = static_cast<float>(tileSize_.y * ChunkSize);
+	Vector2i firstChunk(0, 0);
+	Vector2i lastChunk(numChunks_.x - 1, numChunks_.y - 1);
+	if (theApplication().renderingSettings().cullingEnabled)
+	{
+		const Rectf cullingRect = RenderResources::currentViewport()->cullingRect();
+		const Rectf localRect = transformRect(worldMatrix_.inverse(), cullingRect);
+		if (localRect.x + localRect.w < 0.0f || localRect.y + localRect.h < 0.0f ||
+		    localRect.x > numChunks_.x * chunkWidth || localRect.y > numChunks_.y * chunkHeight)
+		{
+			return false;
+		}
+
+		firstChunk.x = nctl::max(static_cast<int>(floorf(localRect.x / chunkWidth)), 0);
+		firstChunk.y = nctl::max(static_cast<int>(floorf(localRect.y / chunkHeight)), 0);
+		lastChunk.x = nctl::min(static_cast<int>(floorf((localRect.x + localRect.w) / chunkWidth)), numChunks_.x - 1);
+		lastChunk.y = nctl::min(static_cast<int>(floorf((localRect.y + localRect.h) / chunkHeight)), numChunks_.y - 1);
+	}
+
+	bool rendered = false;
+	for (int y = firstChunk.y; y <= lastChunk.y; y++)
+	{
+		for (int x = firstChunk.x; x <= lastChunk.x; x++)
+		{
+			const unsigned int chunkIndex = static_cast<unsigned int>(y * numChunks_.x + x);
+			Chunk &chunk = chunks_[chunkIndex];
+			if (chunk.numTiles == 0)
+				continue;
+
+			// Streaming in a chunk that has just become visible
+			if (chunk.mesh == nullptr)
+			{
+				chunk.mesh = acquireMesh();
+				updateMeshRenderCommand(*chunk.mesh);
+				residentChunks_.pushBack(chunkIndex);
+				chunk.isDirty = true;
+			}
+			if (chunk.isDirty)
+				fillMesh(chunkIndex);
+			chunk.lastFrameVisible = numFrames;
+
+			RenderCommand *renderCommand = chunk.mesh->renderCommand.get();
+			renderCommand->setLayer(absLayer_);
+			renderCommand->setVisitOrder(withVisitOrder_ ? visitOrderIndex_ : 0);
+			renderCommand->setAabb(transformRect(worldMatrix_, Rectf(x * chunkWidth, y * chunkHeight, chunkWidth, chunkHeight)));
+			renderQueue.addCommand(renderCommand);
+			rendered = true;
+		}
+	}
+
+	return rendered;
+}
+
+/*! \note The meshes of all chunks are released and generated again when they become visible */
+void TileMapNode::setAtlas(Texture *atlas)
+{
+	while (residentChunks_.isEmpty() == false)
+		releaseMesh(residentChunks_.back());
+	// The free meshes have been set up for the previous atlas
+	freeMeshes_.clear();
+
+	atlas_ = atlas;
+	if (atlas_)
+	{
+		atlasSize_.x = atlas_->width() / tileSize_.x;
+		atlasSize_.y = atlas_->height() / tileSize_.y;
+	}
+	else
+		atlasSize_.set(0, 0);
+}
+
+/*! \return The tile index or `EmptyTile` if the coordinates are outside the map */
+uint16_t TileMapNode::tile(int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= mapSize_.x || y >= mapSize_.y)
+		return EmptyTile;
+
+	const Chunk &chunk = chunkAt(x, y);
+	if (chunk.tiles.isEmpty())
+		return EmptyTile;
+
+	return chunk.tiles[(y % ChunkSize) * ChunkSize + (x % ChunkSize)];
+}
+
+void TileMapNode::setTile(int x, int y, uint16_t tileIndex)
+{
+	ASSERT(x >= 0 && y >= 0 && x < mapSize_.x && y < mapSize_.y);
+	if (x < 0 || y < 0 || x >= mapSize_.x || y >= mapSize_.y)
+		return;
+
+	Chunk &chunk = chunkAt(x, y);
+	if (chunk.tiles.isEmpty())
+	{
+		if (tileIndex == EmptyTile)
+			return;
+
+		chunk.tiles.setSize(MaxChunkTiles);
+		for (unsigned int i = 0; i < MaxChunkTiles; i++)
+			chunk.tiles[i] = EmptyTile;
+	}
+
+	uint16_t &chunkTile = chunk.tiles[(y % ChunkSize) * ChunkSize + (x % ChunkSize)];
+	if (chunkTile == tileIndex)
+		return;
+
+	if (chunkTile == EmptyTile)
+		chunk.numTiles++;
+	else if (tileIndex == EmptyTile)
+		chunk.numTiles--;
+	chunkTile = tileIndex;
+	chunk.isDirty = true;
+}
+
+void TileMapNode::copyTiles(const uint16_t *tiles)
+{
+	ZoneScoped;
+
+	for (int y = 0; y < mapSize_.y; y++)
+	{
+		for (int x = 0; x < mapSize_.x; x++)
+			setTile(x, y, tiles[y * mapSize_.x + x]);
+	}
+}
+
+void TileMapNode::clearTiles()
+{
+	while (residentChunks_.isEmpty() == false)
+		releaseMesh(residentChunks_.back());
+
+	for (Chunk &chunk : chunks_)
+	{
+		chunk.tiles.clear();
+		chunk.tiles.shrinkToFit();
+		chunk.numTiles = 0;
+		chunk.isDirty = false;
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+nctl::UniquePtr<TileMapNode::ChunkMesh> TileMapNode::acquireMesh()
+{
+	if (freeMeshes_.isEmpty() == false)
+	{
+		nctl::UniquePtr<ChunkMesh> mesh(nctl::move(freeMeshes_.back()));
+		freeMeshes_.popBack();
+		return mesh;
+	}
+
+	nctl::UniquePtr<ChunkMesh> mesh = nctl::makeUnique<ChunkMesh>();
+	mesh->vertices.setSize(MaxChunkFloats);
+	RenderCommand &renderCommand = *mesh->renderCommand;
+	renderCommand.setIdSortKey(id());
+
+	Material &material = renderCommand.material();
+	const Material::ShaderProgramType shaderProgramType = (atlas_->numChannels() >= 3) ? Material::ShaderProgramType::MESH_SPRITE
+	                                                                                    : Material::ShaderProgramType::MESH_SPRITE_GRAY;
+	material.setShaderProgramType(shaderProgramType);
+	material.reserveUniformsDataMemory();
+	material.setDefaultAttributesParameters();
+	GLUniformCache *textureUniform = material.uniform(Material::TextureUniformName);
+	if (textureUniform && textureUniform->intValue(0) != 0)
+		textureUniform->setIntValue(0); // GL_TEXTURE0
+	material.setTexture(*atlas_);
+	material.setBlendingEnabled(true);
+
+	// Vertices are generated in node space and have final texture coordinates
+	GLUniformBlockCache *instanceBlock = material.uniformBlock(Material::InstanceBlockName);
+	GLUniformCache *texRectUniform = instanceBlock->uniform(Material::TexRectUniformName);
+	if (texRectUniform)
+		texRectUniform->setFloatValue(1.0f, 0.0f, 1.0f, 0.0f);
+	GLUniformCache *spriteSizeUniform = instanceBlock->uniform(Material::SpriteSizeUniformName);
+	if (spriteSizeUniform)
+		spriteSizeUniform->setFloatValue(1.0f, 1.0f);
+
+	Geometry &geometry = renderCommand.geometry();
+	geometry.setPrimitiveType(GL_TRIANGLES);
+	geometry.setNumElementsPerVertex(VertexFloats);
+	geometry.createCustomVbo(MaxChunkFloats, GL_DYNAMIC_DRAW);
+	geometry.setHostVertexPointer(mesh->vertices.data());
+	geometry.createCustomIbo(MaxChunkIndices, GL_STATIC_DRAW);
+	geometry.setHostIndexPointer(indices_.data());
+
+	return mesh;
+}
+
+void TileMapNode::releaseMesh(unsigned int chunkIndex)
+{
+	Chunk &chunk = chunks_[chunkIndex];
+	freeMeshes_.pushBack(nctl::move(chunk.mesh));
+	chunk.mesh.reset(nullptr);
+
+	for (unsigned int i = 0; i < residentChunks_.size(); i++)
+	{
+		if (residentChunks_[i] == chunkIndex)
+		{
+			residentChunks_.unorderedRemoveAt(i);
+			break;
+		}
+	}
+}
+
+void TileMapNode::evictChunks()
+{
+	const unsigned long int numFrames = theApplication().numFrames();
+	for (int i = static_cast<int>(residentChunks_.size()) - 1; i >= 0; i--)
+	{
+		const unsigned int chunkIndex = residentChunks_[i];
+		const Chunk &chunk = chunks_[chunkIndex];
+		if (chunk.numTiles == 0 || chunk.lastFrameVisible + ChunkEvictionFrames < numFrames)
+			releaseMesh(chunkIndex);
+	}
+}
+
+void TileMapNode::fillMesh(unsigned int chunkIndex)
+{
+	ZoneScoped;
+
+	Chunk &chunk = chunks_[chunkIndex];
+	ChunkMesh &mesh = *chunk.mesh;
+	const int firstX = (chunkIndex % numChunks_.x) * ChunkSize;
+	const int firstY = (chunkIndex / numChunks_.x) * ChunkSize;
+
+	const float texWidth = static_cast<float>(atlas_->width());
+	const float texHeight = static_cast<float>(atlas_->height());
+	const unsigned int numAtlasTiles = this->numAtlasTiles();
+
+	float *vertices = mesh.vertices.data();
+	unsigned int numQuads = 0;
+	for (unsigned int i = 0; i < MaxChunkTiles; i++)
+	{
+		const uint16_t tileIndex = chunk.tiles[i];
+		if (tileIndex == EmptyTile || tileIndex >= numAtlasTiles)
+			continue;
+
+		const float x0 = static_cast<float>((firstX + static_cast<int>(i % ChunkSize)) * tileSize_.x);
+		const float y0 = static_cast<float>((firstY + static_cast<int>(i / ChunkSize)) * tileSize_.y);
+		const float x1 = x0 + tileSize_.x;
+		const float y1 = y0 + tileSize_.y;
+
+		const int column = tileIndex % atlasSize_.x;
+		const int row = tileIndex / atlasSize_.x;
+		const float u0 = (column * tileSize_.x) / texWidth;
+		const float u1 = ((column + 1) * tileSize_.x) / texWidth;
+		const float vTop = (row * tileSize_.y) / texHeight;
+		const float vBottom = ((row + 1) * tileSize_.y) / texHeight;
+
+		const float quad[16] = { x0, y0, u0, vBottom, x1, y0, u1, vBottom,
+			                     x0, y1, u0, vTop, x1, y1, u1, vTop };
+		for (unsigned int j = 0; j < 16; j++)
+			vertices[numQuads * 16 + j] = quad[j];
+		numQuads++;
+	}
+
+	Geometry &geometry = mesh.renderCommand->geometry();
+	geometry.setNumVertices(numQuads * 4);
+	geometry.setNumIndices(numQuads * 6);
+	// Flagging the vertices to be uploaded again
+	geometry.setHostVertexPointer(mesh.vertices.data());
+
+	chunk.isDirty = false;
+}
+
+void TileMapNode::updateMeshRenderCommand(ChunkMesh &mesh)
+{
+	mesh.renderCommand->setTransformation(worldMatrix_);
+
+	GLUniformBlockCache *instanceBlock = mesh.renderCommand->material().uniformBlock(Material::InstanceBlockName);
+	GLUniformCache *colorUniform = instanceBlock->uniform(Material::ColorUniformName);
+	if (colorUniform)
+		colorUniform->setFloatVector(Colorf(absColor_).data());
+}
+
+}
@@ -5,6 +5,7 @@
 #include "Application.h"
 #include "IAppEventHandler.h"
 #include "DrawableNode.h"
+#include "StaticBatchNode.h"
 #include "Camera.h"
 #include "GLFramebufferObject.h"
 #include "Texture.h"
@@ -500,11 +501,24 @@ void Viewport::draw(unsigned int nextIndex)
 
 void Viewport::updateCulling(SceneNode *node)
 {
+	if (node->type() == Object::ObjectType::STATIC_BATCH_NODE)
+	{
+		// Baked children are culled by the static batch node at chunk granularity
+		StaticBatchNode *staticBatch = static_cast<StaticBatchNode *>(node);
+		for (unsigned int index : staticBatch->unbakedIndices_)
+		{
+			if (index < node->children().size())
+				updateCulling(node->children()[index]);
+		}
+		return;
+	}
+
 	for (SceneNode *child : node->children())
 		updateCulling(child);
 
 	if (node->type() != Object::ObjectType::SCENENODE &&
-	    node->type() != Object::ObjectType::PARTICLE_SYSTEM)
+	    node->type() != Object::ObjectType::PARTICLE_SYSTEM &&
+	    node->type() != Object::ObjectType::TILEMAP_NODE)
 	{
 		DrawableNode *drawable = static_cast<DrawableNode *>(node);
 		drawable->updateCulling();
@@ -1,3 +1,4 @@
+#include <cstring> // for strncmp()
 #include <nctl/StaticHashMapIterator.h>
 #include "GLShaderProgram.h"
 #include "GLShader.h"
@@ -302,6 +303,31 @@ GLVertexFormat::Attribute *GLShaderProgram::attribute(const char *name)
 	return vertexAttribute;
 }
 
+GLVertexFormat::Attribute *GLShaderProgram::attribute(const nctl::HashedName &name)
+{
+	GLVertexFormat::Attribute *vertexAttribute = nullptr;
+
+	int location = -1;
+	const bool attributeFound = attributeLocations_.contains(name.data(), name.length(), name.hash(), location);
+
+	if (attributeFound)
+		vertexAttribute = &vertexFormat_[location];
+
+	return vertexAttribute;
+}
+
+const GLUniformBlock *GLShaderProgram::uniformBlock(const char *name) const
+{
+	ASSERT(name);
+	for (const GLUniformBlock &uniformBlock : uniformBlocks_)
+	{
+		if (strncmp(uniformBlock.name(), name, GLUniformBlock::MaxNameLength) == 0)
+			return &uniformBlock;
+	}
+
+	return nullptr;
+}
+
 void GLShaderProgram::defineVertexFormat(const GLBufferObject *vbo, const GLBufferObject *ibo, unsigned int vboOffset)
 {
 	if (vbo)
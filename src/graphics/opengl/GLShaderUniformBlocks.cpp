@@ -93,6 +93,18 @@ GLUniformBlockCache *GLShaderUniformBlocks::uniformBlock(const char *name)
 	return uniformBlockCache;
 }
 
+GLUniformBlockCache *GLShaderUniformBlocks::uniformBlock(const nctl::HashedName &name)
+{
+	GLUniformBlockCache *uniformBlockCache = nullptr;
+
+	if (shaderProgram_)
+		uniformBlockCache = uniformBlockCaches_.find(name.data(), name.length(), name.hash());
+	else
+		LOGE_X("Cannot find uniform block \"%s\", no shader program associated", name.data());
+
+	return uniformBlockCache;
+}
+
 void GLShaderUniformBlocks::commitUniformBlocks()
 {
 	if (shaderProgram_)
@@ -81,6 +81,18 @@ GLUniformCache *GLShaderUniforms::uniform(const char *name)
 	return uniformCache;
 }
 
+GLUniformCache *GLShaderUniforms::uniform(const nctl::HashedName &name)
+{
+	GLUniformCache *uniformCache = nullptr;
+
+	if (shaderProgram_)
+		uniformCache = uniformCaches_.find(name.data(), name.length(), name.hash());
+	else
+		LOGE_X("Cannot find uniform \"%s\", no shader program associated", name.data());
+
+	return uniformCache;
+}
+
 void GLShaderUniforms::commitUniforms()
 {
 	if (shaderProgram_)
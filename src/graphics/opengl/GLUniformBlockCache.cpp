@@ -101,6 +101,11 @@ GLUniformCache *GLUniformBlockCache::uniform(const char *name)
 	return uniformCaches_.find(name);
 }
 
+GLUniformCache *GLUniformBlockCache::uniform(const nctl::HashedName &name)
+{
+	return uniformCaches_.find(name.data(), name.length(), name.hash());
+}
+
 void GLUniformBlockCache::setBlockBinding(GLuint blockBinding)
 {
 	if (uniformBlock_)
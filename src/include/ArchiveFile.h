@@ -0,0 +1,55 @@
+#ifndef CLASS_NCINE_ARCHIVEFILE
+#define CLASS_NCINE_ARCHIVEFILE
+
+#include "IFile.h"
+
+namespace ncine {
+
+/// The class reading an entry of an asset archive
+/*! Entry contents are either viewed directly from the mapped archive, owned after decompression
+ *  or streamed from a dedicated handle to the archive file. */
+class ArchiveFile : public IFile
+{
+  public:
+	/// Constructs a file around the contents of an entry already in memory
+	ArchiveFile(const char *filename, const unsigned char *dataPtr, unsigned long int size);
+	/// Constructs a file around a decompressed entry, taking ownership of its buffer
+	/*! \note A `nullptr` buffer marks an entry that could not be decompressed */
+	ArchiveFile(const char *filename, nctl::UniquePtr<unsigned char[]> buffer, unsigned long int size);
+	/// Constructs a file that streams an entry from an archive file handle
+	ArchiveFile(const char *filename, nctl::UniquePtr<IFile> archiveHandle, unsigned long int offset, unsigned long int size);
+
+	/// Opens the entry, only the read mode is supported
+	void open(unsigned char mode) override;
+	void close() override;
+	long int seek(long int offset, int whence) const override;
+	long int tell() const override;
+	unsigned long int read(void *buffer, unsigned long int bytes) const override;
+	unsigned long int write(const void *buffer, unsigned long int bytes) override;
+
+	bool isOpened() const override;
+	inline const void *data() const override { return isOpened_ ? dataPtr_ : nullptr; }
+
+  private:
+	/// The entry contents in memory, or `nullptr` if streamed
+	const unsigned char *dataPtr_;
+	/// The buffer holding the decompressed entry contents
+	nctl::UniquePtr<unsigned char[]> buffer_;
+	/// The handle to the archive file when streaming
+	nctl::UniquePtr<IFile> archiveHandle_;
+	/// The offset of the entry contents in the archive file when streaming
+	unsigned long int archiveOffset_;
+
+	bool isOpened_;
+	/// \note Modified by `seek` and `tell` constant methods
+	mutable unsigned long int seekOffset_;
+
+	/// Deleted copy constructor
+	ArchiveFile(const ArchiveFile &) = delete;
+	/// Deleted assignment operator
+	ArchiveFile &operator=(const ArchiveFile &) = delete;
+};
+
+}
+
+#endif
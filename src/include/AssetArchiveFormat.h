@@ -0,0 +1,85 @@
+#ifndef NCINE_ASSETARCHIVEFORMAT
+#define NCINE_ASSETARCHIVEFORMAT
+
+#include <cstdint>
+
+namespace ncine {
+
+/// The on-disk layout of an asset archive, shared between the engine and the packing tool
+/*! An archive starts with a header, followed by the aligned entry data, the index and the names table.
+ *  The index is sorted by name hash, then by name, to be searched with a binary search.
+ *  All values are stored in little endian order. */
+namespace AssetArchiveFormat {
+
+	/// The signature at the beginning of every archive
+	static const char Signature[8] = { 'n', 'C', 'i', 'n', 'e', 'P', 'a', 'k' };
+	/// The current version of the format
+	static const uint32_t Version = 1;
+	/// The default alignment of entry data, suitable for memory mapping
+	static const uint32_t DefaultAlignment = 16;
+	/// The maximum length of an entry name, terminator included
+	static const unsigned int MaxNameLength = 1024;
+
+	/// The compression method of an entry
+	enum Compression : uint8_t
+	{
+		NONE = 0,
+		LZ4 = 1
+	};
+
+	/// The archive header
+	struct Header
+	{
+		char signature[8];
+		uint32_t version;
+		uint32_t numEntries;
+		/// Offset of the index from the beginning of the archive
+		uint64_t indexOffset;
+		/// Offset of the names table from the beginning of the archive
+		uint64_t namesOffset;
+		/// Size in bytes of the names table
+		uint32_t namesSize;
+		/// Alignment in bytes of entry data
+		uint32_t alignment;
+	};
+	static_assert(sizeof(Header) == 40, "The archive header should be 40 bytes long");
+
+	/// An index entry
+	struct Entry
+	{
+		/// Hash of the entry name
+		uint64_t hash;
+		/// Offset of the entry data from the beginning of the archive
+		uint64_t offset;
+		/// Size in bytes of the uncompressed entry
+		uint32_t size;
+		/// Size in bytes of the entry data as stored in the archive
+		uint32_t storedSize;
+		/// Offset of the null terminated entry name in the names table
+		uint32_t nameOffset;
+		/// Length of the entry name, terminator excluded
+		uint16_t nameLength;
+		/// One of the `Compression` values
+		uint8_t compression;
+		uint8_t padding;
+	};
+	static_assert(sizeof(Entry) == 32, "An archive index entry should be 32 bytes long");
+
+	/// Returns the FNV-1a hash of an entry name
+	/*! Entry names are relative paths using forward slashes as separators. */
+	inline uint64_t hashName(const char *name, unsigned int length)
+	{
+		uint64_t hash = 0xcbf29ce484222325ULL;
+		for (unsigned int i = 0; i < length; i++)
+		{
+			hash ^= static_cast<unsigned char>(name[i]);
+			hash *= 0x100000001b3ULL;
+		}
+		return hash;
+	}
+
+}
+
+}
+
+#endif
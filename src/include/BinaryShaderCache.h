@@ -5,13 +5,23 @@
 #include <nctl/String.h>
 #include <nctl/StaticString.h>
 #include <nctl/HashMap.h>
+#include <nctl/UniquePtr.h>
 
 namespace ncine {
 
+class IFile;
+
 /// The class that manages the cache of binary OpenGL shader programs
+/*! In packed mode all the binaries are stored in a single file, made of a header followed by
+ *  records with the platform hash, format, shader hash and size of a binary before its data.
+ *  The file is mapped in memory and indexed once, new binaries are appended and committed
+ *  by updating the header, so that an interrupted write leaves the previous records valid. */
 class BinaryShaderCache
 {
   public:
+	/// The name of the single file containing all binary shaders in packed mode
+	static const char *PackedFilename;
+
 	/// A static string that can holds the contents of the `ShaderFilenameFormat` string
 	using ShaderFilename = nctl::StaticString<47>;
 
@@ -39,7 +49,7 @@ class BinaryShaderCache
 		unsigned int TotalBytesCount = 0;
 	};
 
-	BinaryShaderCache(bool enable, const char *dirname);
+	BinaryShaderCache(bool enable, bool packed, const char *dirname);
 	~BinaryShaderCache();
 
 	/// Returns true if the binary shader cache is supported and can be enabled
@@ -48,6 +58,8 @@ class BinaryShaderCache
 	inline bool isEnabled() const { return isEnabled_; }
 	/// Enables or disables the binary shader cache (it can be enabled only if available)
 	void setEnabled(bool enabled);
+	/// Returns true if the binary shaders are stored in a single packed file
+	inline bool isPacked() const { return isPacked_; }
 
 	/// Returns the hash for the current platform
 	inline uint64_t platformHash() const { return platformHash_; }
@@ -90,6 +102,7 @@ class BinaryShaderCache
 	inline const ShaderInfoHashMapType &shaderInfoHashMap() const { return shaderInfos_; }
 
 	/// Deletes all binary shaders that don't belong to this platform from the cache directory (and the corresponding shader info text file)
+	/*! \note In packed mode the single file is rewritten with the binaries of this platform only */
 	void prune();
 	/// Deletes all binary shaders and shader info text files from the cache directory
 	void clear();
@@ -109,6 +122,8 @@ class BinaryShaderCache
 	bool isInitialized_;
 	/// A flag that indicates that the binary shader cache is enabled and should be used if available
 	bool isEnabled_;
+	/// A flag that indicates that the binary shaders are stored in a single packed file
+	bool isPacked_;
 
 	/// The first symbolic constant in the `GL_PROGRAM_BINARY_FORMATS` list
 	uint32_t binaryFormat_;
@@ -125,6 +140,20 @@ class BinaryShaderCache
 	/// The hash map containing the information for registered shaders
 	ShaderInfoHashMapType shaderInfos_;
 
+	/// The location of a binary shader of this platform inside the packed file
+	struct PackedEntry
+	{
+		uint32_t binaryFormat = 0;
+		uint32_t length = 0;
+		/// The offset of the binary data from the beginning of the file
+		unsigned long int offset = 0;
+	};
+
+	/// The index of the packed file binaries for this platform, by shader hash
+	nctl::HashMap<uint64_t, PackedEntry> packedIndex_;
+	/// The packed file mapped in memory
+	nctl::UniquePtr<IFile> packedFile_;
+
 	/// Initializes the cache the first time it is enabled
 	bool initialize();
 
@@ -133,6 +162,18 @@ class BinaryShaderCache
 	/// Resets all statistics to the initial values
 	void clearStatistics();
 
+	/// Returns true if a binary shader with the given format and hash id is in the cache
+	bool hasBinary(uint32_t binaryFormat, uint64_t hash) const;
+
+	/// Maps the packed file in memory, or maps it again to include the appended binaries
+	void mapPackedFile();
+	/// Maps the packed file in memory, builds the index of its binaries for this platform and counts them in the statistics
+	void loadPackedIndex();
+	/// Appends a binary shader to the packed file and commits it by updating the header
+	bool appendToPackedFile(int length, const void *buffer, uint32_t binaryFormat, uint64_t hash);
+	/// Rewrites the packed file keeping only the binaries for this platform
+	void prunePackedFile();
+
 	/// Loads the shader information file from the cache directory
 	bool loadShaderInfoFromCache(uint32_t binaryFormat);
 	/// Loads the shader information file from the cache directory (using the first available binary format)
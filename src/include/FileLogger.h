@@ -5,9 +5,20 @@
 #include "ILogger.h"
 #include "IFile.h"
 
+#ifdef WITH_THREADS
+	#include <csignal>
+	#include <nctl/Atomic.h>
+	#include <nctl/MpmcQueue.h>
+	#include "Thread.h"
+	#include "ThreadSync.h"
+#endif
+
 namespace ncine {
 
 /// The standard console and file logger
+/*! When threads are available, file entries are queued in a lock-free queue
+ *  and written in batches by a background thread. Fatal errors drain the queue
+ *  synchronously from the calling thread, and so can crash signals if the handlers are enabled. */
 class FileLogger : public ILogger
 {
   public:
@@ -20,6 +31,14 @@ class FileLogger : public ILogger
 	bool openLogFile(const char *filename);
 
 	unsigned int write(LogLevel level, const char *fmt, ...) override;
+	/// Writes every queued entry to the log file from the calling thread
+	void flush();
+
+	/// Returns the number of file entries dropped because the queue was full
+	unsigned int numDroppedEntries();
+	/// Installs or removes the process-wide handlers that write the queued entries when a crash signal is raised
+	/*! \note Only one logger at a time can install them, the handlers that were set before are invoked afterwards */
+	void setCrashHandlersEnabled(bool enabled);
 
 #ifdef WITH_IMGUI
 	inline const char *logString() const override { return logString_.data(); }
@@ -39,18 +58,75 @@ class FileLogger : public ILogger
 	bool canUseColors_;
 
 	static const unsigned int MaxEntryLength = 1024;
-	char logEntry_[MaxEntryLength];
-	char logEntryWithColors_[MaxEntryLength];
 
 #ifdef WITH_IMGUI
 	static const unsigned int LogStringCapacity = 16 * 1024;
 	nctl::String logString_;
 #endif
 
+#ifdef WITH_THREADS
+	/// Number of entries in the queue, it must be a power of two
+	static const unsigned int QueueCapacity = 256;
+
+	/// A formatted entry waiting in the queue
+	struct QueuedEntry
+	{
+		QueuedEntry()
+		    : length(0) {}
+		QueuedEntry(const char *logEntry, unsigned int entryLength);
+
+		unsigned int length;
+		char entry[MaxEntryLength];
+	};
+
+	nctl::MpmcQueue<QueuedEntry> queue_;
+	/// Number of entries written by producers but not yet by the writer thread
+	nctl::Atomic32 numPending_;
+	/// Number of entries dropped because the queue was full, not yet reported in the file
+	nctl::Atomic32 numDropped_;
+	/// Total number of entries dropped because the queue was full
+	nctl::Atomic32 totalDropped_;
+	/// A duplicate descriptor of the log file opened in advance, crash handlers write to it without using `stdio`
+	int crashFd_;
+
+	/// Entries are written by the thread holding this mutex, it also guards the file handle
+	Mutex fileMutex_;
+	/// Set while the writer thread is running, it is started by the first opened log file and stopped by the destructor
+	nctl::Atomic32 writerRunning_;
+	Thread writerThread_;
+	Mutex writerMutex_;
+	CondVariable writerCV_;
+	nctl::Atomic32 writerSleeping_;
+	nctl::Atomic32 writerShouldQuit_;
+	#ifdef WITH_IMGUI
+	Mutex logStringMutex_;
+	#endif
+#endif
+
 	// Declared at the end to prevent a `heap-use-after-free` AddressSanitizer error
 	nctl::UniquePtr<IFile> fileHandle_;
 
-	unsigned int writeWithColors(LogLevel level, const char *timeMsg, unsigned int timeMsgLength, const char *logMsg, unsigned int logMsgLength);
+	unsigned int writeWithColors(LogLevel level, const char *timeMsg, unsigned int timeMsgLength, const char *logMsg, unsigned int logMsgLength, char *logEntryWithColors);
+	/// Writes an entry to the log file, directly or through the writer thread
+	void writeToFile(LogLevel level, const char *logEntry, unsigned int length);
+
+#ifdef WITH_THREADS
+	/// Tries to copy an entry in the queue, returns false if the queue is full
+	bool enqueueEntry(const char *logEntry, unsigned int length);
+	/// Writes all the queued entries to the file and flushes it once, the file mutex should be locked
+	void drainEntries();
+	/// Writes all the queued entries to the crash descriptor using only async-signal-safe calls
+	void drainEntriesOnCrash();
+	void startWriterThread();
+	void stopWriterThread();
+	static void writerFunction(void *arg);
+	/// Drains the queue and then invokes the handler that was set before for the signal
+	#ifdef _WIN32
+	static void crashSignalHandler(int signum);
+	#else
+	static void crashSignalHandler(int signum, siginfo_t *info, void *context);
+	#endif
+#endif
 
 	/// Deleted copy constructor
 	FileLogger(const FileLogger &) = delete;
@@ -1,7 +1,7 @@
 #ifndef CLASS_NCINE_FONTGLYPH
 #define CLASS_NCINE_FONTGLYPH
 
-#include <nctl/Array.h>
+#include <nctl/SmallArray.h>
 #include "Rect.h"
 
 namespace ncine {
@@ -55,7 +55,7 @@ class FontGlyph
 	int xOffset_;
 	int yOffset_;
 	int xAdvance_;
-	nctl::Array<Kerning> kernings_;
+	nctl::SmallArray<Kerning, 4> kernings_;
 };
 
 }
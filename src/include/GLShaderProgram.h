@@ -4,6 +4,7 @@
 #include <nctl/Array.h>
 #include <nctl/StaticHashMap.h>
 #include <nctl/String.h>
+#include <nctl/HashedName.h>
 
 #include "GLUniform.h"
 #include "GLUniformBlock.h"
@@ -85,6 +86,9 @@ class GLShaderProgram
 	inline unsigned int numAttributes() const { return attributeLocations_.size(); }
 	inline bool hasAttribute(const char *name) const { return (attributeLocations_.find(name) != nullptr); }
 	GLVertexFormat::Attribute *attribute(const char *name);
+	GLVertexFormat::Attribute *attribute(const nctl::HashedName &name);
+	/// Returns the uniform block with the specified name, or `nullptr` if the program does not have it
+	const GLUniformBlock *uniformBlock(const char *name) const;
 
 	inline void defineVertexFormat(const GLBufferObject *vbo) { defineVertexFormat(vbo, nullptr, 0); }
 	inline void defineVertexFormat(const GLBufferObject *vbo, const GLBufferObject *ibo) { defineVertexFormat(vbo, ibo, 0); }
@@ -3,6 +3,7 @@
 
 #include <nctl/StaticHashMap.h>
 #include <nctl/String.h>
+#include <nctl/HashedName.h>
 #include "GLUniformBlockCache.h"
 #include "RenderBuffersManager.h"
 
@@ -28,6 +29,7 @@ class GLShaderUniformBlocks
 	inline unsigned int numUniformBlocks() const { return uniformBlockCaches_.size(); }
 	inline bool hasUniformBlock(const char *name) const { return (uniformBlockCaches_.find(name) != nullptr); }
 	GLUniformBlockCache *uniformBlock(const char *name);
+	GLUniformBlockCache *uniformBlock(const nctl::HashedName &name);
 	inline const UniformHashMapType allUniformBlocks() const { return uniformBlockCaches_; }
 	void commitUniformBlocks();
 
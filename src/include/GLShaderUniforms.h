@@ -3,6 +3,7 @@
 
 #include <nctl/StaticHashMap.h>
 #include <nctl/String.h>
+#include <nctl/HashedName.h>
 #include "GLUniformCache.h"
 
 namespace ncine {
@@ -27,6 +28,7 @@ class GLShaderUniforms
 	inline unsigned int numUniforms() const { return uniformCaches_.size(); }
 	inline bool hasUniform(const char *name) const { return (uniformCaches_.find(name) != nullptr); }
 	GLUniformCache *uniform(const char *name);
+	GLUniformCache *uniform(const nctl::HashedName &name);
 	inline const UniformHashMapType allUniforms() const { return uniformCaches_; }
 	void commitUniforms();
 
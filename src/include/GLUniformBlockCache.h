@@ -6,6 +6,7 @@
 #include "GLUniformCache.h"
 #include <nctl/StaticHashMap.h>
 #include <nctl/String.h>
+#include <nctl/HashedName.h>
 
 namespace ncine {
 
@@ -40,6 +41,7 @@ class GLUniformBlockCache
 	inline bool copyData(const GLubyte *src) { return copyData(0, src, usedSize_); }
 
 	GLUniformCache *uniform(const char *name);
+	GLUniformCache *uniform(const nctl::HashedName &name);
 	/// Wrapper around `GLUniformBlock::setBlockBinding()`
 	void setBlockBinding(GLuint blockBinding);
 
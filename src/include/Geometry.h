@@ -36,6 +36,8 @@ class Geometry
 	inline void setNumElementsPerVertex(unsigned int numElements) { numElementsPerVertex_ = numElements; }
 	/// Creates a custom VBO that is unique to this `Geometry` object
 	void createCustomVbo(unsigned int numFloats, GLenum usage);
+	/// Returns true if the geometry owns a custom VBO
+	inline bool hasCustomVbo() const { return vbo_ != nullptr; }
 	/// Retrieves a pointer that can be used to write vertex data from a custom VBO owned by this object
 	/*! This overloaded version allows a custom alignment specification */
 	GLfloat *acquireVertexPointer(unsigned int numFloats, unsigned int numFloatsAlignment);
@@ -56,23 +58,39 @@ class Geometry
 
 	/// Returns the number of indices used to render the geometry
 	inline unsigned int numIndices() const { return numIndices_; }
+	/// Returns the type of the indices, either `GL_UNSIGNED_SHORT` or `GL_UNSIGNED_INT`
+	inline GLenum indexType() const { return indexType_; }
+	/// Returns the size in bytes of a single index
+	inline unsigned int indexSize() const { return (indexType_ == GL_UNSIGNED_INT) ? sizeof(GLuint) : sizeof(GLushort); }
 	/// Sets the index number of the first index to draw
-	inline void setFirstIndex(GLushort firstIndex) { firstIndex_ = firstIndex; }
+	inline void setFirstIndex(GLuint firstIndex) { firstIndex_ = firstIndex; }
 	/// Sets the number of indices used to render the geometry
 	inline void setNumIndices(unsigned int numIndices) { numIndices_ = numIndices; }
 	/// Creates a custom IBO that is unique to this `Geometry` object
-	void createCustomIbo(unsigned int numIndices, GLenum usage);
-	/// Retrieves a pointer that can be used to write index data from a custom IBO owned by this object
-	GLushort *acquireIndexPointer(unsigned int numIndices);
-	/// Retrieves a pointer that can be used to write index data from a IBO owned by the buffers manager
-	GLushort *acquireIndexPointer();
+	inline void createCustomIbo(unsigned int numIndices, GLenum usage) { createCustomIbo(numIndices, usage, GL_UNSIGNED_SHORT); }
+	/// Creates a custom IBO that is unique to this `Geometry` object, with the specified index type
+	void createCustomIbo(unsigned int numIndices, GLenum usage, GLenum indexType);
+	/// Retrieves a pointer that can be used to write 16-bit index data from a IBO owned by the buffers manager
+	inline GLushort *acquireIndexPointer(unsigned int numIndices) { return reinterpret_cast<GLushort *>(acquireIndexData(numIndices, GL_UNSIGNED_SHORT)); }
+	/// Retrieves a pointer that can be used to write 16-bit index data from a custom IBO owned by this object
+	inline GLushort *acquireIndexPointer() { return reinterpret_cast<GLushort *>(acquireIndexData(GL_UNSIGNED_SHORT)); }
+	/// Retrieves a pointer that can be used to write 32-bit index data from a IBO owned by the buffers manager
+	inline GLuint *acquireIndexPointer32(unsigned int numIndices) { return reinterpret_cast<GLuint *>(acquireIndexData(numIndices, GL_UNSIGNED_INT)); }
+	/// Retrieves a pointer that can be used to write 32-bit index data from a custom IBO owned by this object
+	inline GLuint *acquireIndexPointer32() { return reinterpret_cast<GLuint *>(acquireIndexData(GL_UNSIGNED_INT)); }
 	/// Releases the pointer used to write index data
 	void releaseIndexPointer();
 
-	/// Returns a pointer into host memory containing index data to be copied into a IBO
-	inline const GLushort *hostIndexPointer() const { return hostIndexPointer_; }
-	/// Sets a pointer into host memory containing index data to be copied into a IBO
+	/// Returns a pointer into host memory containing 16-bit index data to be copied into a IBO
+	inline const GLushort *hostIndexPointer() const { return (indexType_ == GL_UNSIGNED_SHORT) ? static_cast<const GLushort *>(hostIndexPointer_) : nullptr; }
+	/// Returns a pointer into host memory containing 32-bit index data to be copied into a IBO
+	inline const GLuint *hostIndexPointer32() const { return (indexType_ == GL_UNSIGNED_INT) ? static_cast<const GLuint *>(hostIndexPointer_) : nullptr; }
+	/// Returns true if a pointer into host memory containing index data of any type has been set
+	inline bool hasHostIndexPointer() const { return hostIndexPointer_ != nullptr; }
+	/// Sets a pointer into host memory containing 16-bit index data to be copied into a IBO
 	void setHostIndexPointer(const GLushort *indexPointer);
+	/// Sets a pointer into host memory containing 32-bit index data to be copied into a IBO
+	void setHostIndexPointer(const GLuint *indexPointer);
 
 	/// Shares the IBO of another `Geometry` object
 	void shareIbo(const Geometry *geometry);
@@ -82,10 +100,11 @@ class Geometry
 	GLint firstVertex_;
 	GLsizei numVertices_;
 	unsigned int numElementsPerVertex_;
-	GLushort firstIndex_;
+	GLuint firstIndex_;
 	unsigned int numIndices_;
+	GLenum indexType_;
 	const float *hostVertexPointer_;
-	const GLushort *hostIndexPointer_;
+	const void *hostIndexPointer_;
 
 	nctl::UniquePtr<GLBufferObject> vbo_;
 	GLenum vboUsageFlags_;
@@ -105,6 +124,11 @@ class Geometry
 	void commitVertices();
 	void commitIndices();
 
+	/// Retrieves a pointer to index data of the specified type from a IBO owned by the buffers manager
+	GLubyte *acquireIndexData(unsigned int numIndices, GLenum indexType);
+	/// Retrieves a pointer to index data of the specified type from a custom IBO owned by this object
+	GLubyte *acquireIndexData(GLenum indexType);
+
 	inline const RenderBuffersManager::Parameters &vboParams() const { return sharedVboParams_ ? *sharedVboParams_ : vboParams_; }
 	inline const RenderBuffersManager::Parameters &iboParams() const { return sharedIboParams_ ? *sharedIboParams_ : iboParams_; }
 
@@ -0,0 +1,59 @@
+#ifndef NCINE_LUACALLBACKS
+#define NCINE_LUACALLBACKS
+
+namespace ncine {
+
+/// The script functions of the `ncine` table called by the event handlers
+/*! They are plain fields of the table, looked up by the `LuaStateManager` through registry references
+ *  to the table and to the field names, which are resolved again on script reload. */
+namespace LuaCallbacks {
+
+	enum Id : unsigned int
+	{
+		ON_PRE_INIT = 0,
+		ON_INIT,
+		ON_FRAME_START,
+		ON_POST_UPDATE,
+		ON_DRAW_VIEWPORT,
+		ON_FRAME_END,
+		ON_RESIZE_WINDOW,
+		ON_CHANGE_SCALING_FACTOR,
+		ON_SHUTDOWN,
+		ON_SUSPEND,
+		ON_RESUME,
+
+		ON_KEY_PRESSED,
+		ON_KEY_RELEASED,
+		ON_TEXT_INPUT,
+		ON_TOUCH_DOWN,
+		ON_TOUCH_UP,
+		ON_TOUCH_MOVE,
+		ON_POINTER_DOWN,
+		ON_POINTER_UP,
+		ON_ACCELERATION,
+		ON_MOUSE_BUTTON_PRESSED,
+		ON_MOUSE_BUTTON_RELEASED,
+		ON_MOUSE_MOVED,
+		ON_SCROLL_INPUT,
+		ON_JOY_BUTTON_PRESSED,
+		ON_JOY_BUTTON_RELEASED,
+		ON_JOY_HAT_MOVED,
+		ON_JOY_AXIS_MOVED,
+		ON_JOYMAPPED_BUTTON_PRESSED,
+		ON_JOYMAPPED_BUTTON_RELEASED,
+		ON_JOYMAPPED_AXIS_MOVED,
+		ON_JOY_CONNECTED,
+		ON_JOY_DISCONNECTED,
+		ON_QUIT_REQUEST,
+
+		COUNT
+	};
+
+	/// Returns the name of the function in the `ncine` table
+	const char *name(Id id);
+
+}
+
+}
+
+#endif
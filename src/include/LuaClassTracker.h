@@ -65,16 +65,16 @@ int LuaClassTracker<T>::deleteObject(lua_State *L)
 		LuaStateManager *stateManager = LuaStateManager::manager(L);
 
 		// A tracked object might also end up among untracked data
-		stateManager->untrackedUserDatas().remove(pointer);
+		stateManager->removeUntrackedUserData(pointer);
 
 		const LuaTypes::UserDataType type = stateManager->trackedType(pointer);
 		ASSERT(type == LuaTypes::classToUserDataType(object));
-		const bool isTracked = (stateManager->trackedUserDatas().find(pointer) != nullptr);
+		const bool isTracked = (type != LuaTypes::UNKNOWN);
 		ASSERT(isTracked == true);
 
 		if (isTracked)
 		{
-			stateManager->trackedUserDatas().remove(pointer);
+			stateManager->removeTrackedUserData(pointer);
 #if !defined(WITH_ALLOCATORS)
 			delete object;
 #else
@@ -104,10 +104,7 @@ void LuaClassTracker<T>::storeTrackedUserData(lua_State *L, T *object)
 
 	LuaStateManager *stateManager = LuaStateManager::manager(L);
 
-	nctl::HashMap<void *, LuaTypes::UserDataType> &hashMap = stateManager->trackedUserDatas();
-	if (hashMap.loadFactor() >= 0.8f)
-		hashMap.rehash(hashMap.capacity() * 2);
-	hashMap.insert(object, LuaTypes::classToUserDataType(object));
+	stateManager->addTrackedUserData(object, LuaTypes::classToUserDataType(object));
 
 	lua_pushlightuserdata(L, reinterpret_cast<void *>(object));
 }
@@ -0,0 +1,27 @@
+#ifndef CLASS_NCINE_LUATEXTUREREADBACK
+#define CLASS_NCINE_LUATEXTUREREADBACK
+
+struct lua_State;
+
+namespace ncine {
+
+/// Lua bindings around the `TextureReadback` class
+class LuaTextureReadback
+{
+  public:
+	static void expose(lua_State *L);
+	/// Drops the callbacks of the pending requests issued by a Lua state that is going to be closed
+	static void release(lua_State *L);
+
+  private:
+	static int readTexture(lua_State *L);
+	static int readScreen(lua_State *L);
+	static int saveTexture(lua_State *L);
+	static int saveScreenshot(lua_State *L);
+
+	static int numPendingRequests(lua_State *L);
+};
+
+}
+
+#endif
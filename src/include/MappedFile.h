@@ -0,0 +1,50 @@
+#ifndef CLASS_NCINE_MAPPEDFILE
+#define CLASS_NCINE_MAPPEDFILE
+
+#include "IFile.h"
+
+namespace ncine {
+
+/// The class mapping a read-only standard file in memory
+/*! The file contents can be accessed directly through `data()` without copying them. */
+class MappedFile : public IFile
+{
+  public:
+	/// Constructs a memory mapped file object
+	/*! \param filename File name including its path */
+	explicit MappedFile(const char *filename);
+	~MappedFile() override;
+
+	/// Tries to open and map the file, only the read mode is supported
+	void open(unsigned char mode) override;
+	/// Unmaps and closes the file
+	void close() override;
+	long int seek(long int offset, int whence) const override;
+	long int tell() const override;
+	unsigned long int read(void *buffer, unsigned long int bytes) const override;
+	unsigned long int write(const void *buffer, unsigned long int bytes) override;
+
+	bool isOpened() const override;
+	inline const void *data() const override { return mappedPtr_; }
+
+  private:
+	/// The address of the mapped file contents, `nullptr` for an empty file
+	const unsigned char *mappedPtr_;
+	bool isOpened_;
+	/// \note Modified by `seek` and `tell` constant methods
+	mutable unsigned long int seekOffset_;
+
+#if defined(_WIN32)
+	void *fileHandle_;
+	void *mappingHandle_;
+#endif
+
+	/// Deleted copy constructor
+	MappedFile(const MappedFile &) = delete;
+	/// Deleted assignment operator
+	MappedFile &operator=(const MappedFile &) = delete;
+};
+
+}
+
+#endif
@@ -59,27 +59,27 @@ class Material
 		CUSTOM
 	};
 
-	// Shader uniform block and model matrix uniform names
-	static const char *InstanceBlockName;
-	static const char *InstancesBlockName; // for batched shaders
-	static const char *ModelMatrixUniformName;
+	// Shader uniform block and model matrix uniform names, hashed at compile time
+	static const nctl::HashedName InstanceBlockName;
+	static const nctl::HashedName InstancesBlockName; // for batched shaders
+	static const nctl::HashedName ModelMatrixUniformName;
 
 	// Camera related shader uniform names
-	static const char *GuiProjectionMatrixUniformName;
-	static const char *DepthUniformName;
-	static const char *ProjectionMatrixUniformName;
-	static const char *ViewMatrixUniformName;
+	static const nctl::HashedName GuiProjectionMatrixUniformName;
+	static const nctl::HashedName DepthUniformName;
+	static const nctl::HashedName ProjectionMatrixUniformName;
+	static const nctl::HashedName ViewMatrixUniformName;
 	static const char *ProjectionViewMatrixExcludeString;
 
 	// Shader uniform and attribute names
-	static const char *TextureUniformName;
-	static const char *ColorUniformName;
-	static const char *SpriteSizeUniformName;
-	static const char *TexRectUniformName;
-	static const char *PositionAttributeName;
-	static const char *TexCoordsAttributeName;
-	static const char *MeshIndexAttributeName;
-	static const char *ColorAttributeName;
+	static const nctl::HashedName TextureUniformName;
+	static const nctl::HashedName ColorUniformName;
+	static const nctl::HashedName SpriteSizeUniformName;
+	static const nctl::HashedName TexRectUniformName;
+	static const nctl::HashedName PositionAttributeName;
+	static const nctl::HashedName TexCoordsAttributeName;
+	static const nctl::HashedName MeshIndexAttributeName;
+	static const nctl::HashedName ColorAttributeName;
 
 	/// Default constructor
 	Material();
@@ -98,6 +98,7 @@ class Material
 	void setShaderProgram(GLShaderProgram *program);
 
 	void setDefaultAttributesParameters();
+	void setPackedAttributesParameters();
 	void reserveUniformsDataMemory();
 	void setUniformsDataPointer(GLubyte *dataPointer);
 
@@ -110,6 +111,10 @@ class Material
 	inline GLUniformCache *uniform(const char *name) { return shaderUniforms_.uniform(name); }
 	/// Wrapper around `GLShaderUniformBlocks::uniformBlock()`
 	inline GLUniformBlockCache *uniformBlock(const char *name) { return shaderUniformBlocks_.uniformBlock(name); }
+	/// Wrapper around `GLShaderUniforms::uniform()` with a precomputed hash
+	inline GLUniformCache *uniform(const nctl::HashedName &name) { return shaderUniforms_.uniform(name); }
+	/// Wrapper around `GLShaderUniformBlocks::uniformBlock()` with a precomputed hash
+	inline GLUniformBlockCache *uniformBlock(const nctl::HashedName &name) { return shaderUniformBlocks_.uniformBlock(name); }
 
 	/// Wrapper around `GLShaderUniforms::allUniforms()`
 	inline const GLShaderUniforms::UniformHashMapType allUniforms() const { return shaderUniforms_.allUniforms(); }
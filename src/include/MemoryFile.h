@@ -21,6 +21,8 @@ class MemoryFile : public IFile
 	unsigned long int read(void *buffer, unsigned long int bytes) const override;
 	unsigned long int write(const void *buffer, unsigned long int bytes) override;
 
+	inline const void *data() const override { return (fileDescriptor_ >= 0) ? bufferPtr_ : nullptr; }
+
   private:
 	unsigned char *bufferPtr_;
 	/// \note Modified by `seek` and `tell` constant methods
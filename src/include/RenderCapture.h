@@ -0,0 +1,51 @@
+#ifndef CLASS_NCINE_RENDERCAPTURE
+#define CLASS_NCINE_RENDERCAPTURE
+
+#include <nctl/Array.h>
+#include <nctl/HashMap.h>
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+class IFile;
+class RenderCommand;
+
+/// A class that captures the render queues of a number of frames to a binary file
+/*! The capture can be fed to the `ncine_replay` tool to benchmark and test the sorting and batching of commands offline.
+ *  \note Only the data needed by sorting and batching is captured, not the vertices or the textures. */
+class RenderCapture
+{
+  public:
+	/// Starts capturing the queues of the specified number of frames to a file
+	static bool start(const char *filename, unsigned int numFrames);
+	/// Stops capturing and closes the file
+	static void stop();
+
+	/// Returns true if the queues of the current frame are being captured
+	static inline bool isCapturing() { return fileHandle_ != nullptr; }
+	/// Returns the number of queues captured since the last start
+	static inline unsigned int numCapturedQueues() { return numCapturedQueues_; }
+
+  private:
+	static nctl::UniquePtr<IFile> fileHandle_;
+	static unsigned long int firstFrame_;
+	static unsigned int numFrames_;
+	static unsigned int numCapturedQueues_;
+	/// Sequential ids of the shaders, textures and viewports seen during the capture
+	static nctl::HashMap<const void *, uint32_t> objectIds_;
+	/// The buffer used to serialize a queue before writing it
+	static nctl::Array<uint8_t> buffer_;
+
+	/// Writes the opaque and transparent queues of a viewport, before they are sorted
+	static void captureQueues(const nctl::Array<RenderCommand *> &opaqueQueue, const nctl::Array<RenderCommand *> &transparentQueue);
+	/// Serializes a command and its instance block to the buffer
+	static void captureCommand(const RenderCommand &command);
+	/// Returns the capture id of an object, assigning a new one the first time
+	static uint32_t objectId(const void *object);
+
+	friend class RenderQueue;
+};
+
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef NCINE_RENDERCAPTUREFORMAT
+#define NCINE_RENDERCAPTUREFORMAT
+
+#include <cstdint>
+
+namespace ncine {
+
+/// The on-disk layout of a render queue capture, shared between the engine and the replay tool
+/*! A capture starts with a header, followed by a sequence of queues, one for every viewport queue sorted in a frame.
+ *  Every queue is followed by its opaque commands and then by its transparent ones, in the order they were collected.
+ *  Every command is followed by the bytes of its instance uniform block, padded to eight bytes.
+ *  Shaders and textures are identified by sequential ids assigned in order of appearance, zero means none.
+ *  All values are stored in the native byte order of the capturing machine. */
+namespace RenderCaptureFormat {
+
+	/// The signature at the beginning of every capture
+	static const char Signature[8] = { 'n', 'C', 'i', 'n', 'e', 'R', 'C', 'p' };
+	/// The current version of the format
+	static const uint32_t Version = 3;
+
+	/// The capture header
+	struct Header
+	{
+		char signature[8];
+		uint32_t version;
+		/// The maximum size in bytes of a uniform block on the capturing device
+		uint32_t uboMaxSize;
+	};
+	static_assert(sizeof(Header) == 16, "The capture header should be 16 bytes long");
+
+	/// The header of a captured queue
+	struct Queue
+	{
+		/// The frame number, relative to the first captured frame
+		uint32_t frame;
+		/// The id of the viewport owning the queue
+		uint32_t viewportId;
+		uint32_t numOpaques;
+		uint32_t numTransparents;
+		uint32_t minBatchSize;
+		uint32_t maxBatchSize;
+		/// The maximum size in bytes of the vertex data of a batch
+		uint32_t maxVertexDataSize;
+		/// The maximum size in bytes of the index data of a batch
+		uint32_t maxIndexDataSize;
+		uint8_t batchingEnabled;
+		uint8_t batchingWithIndices;
+		uint8_t reorderingEnabled;
+		uint8_t padding;
+		/// The maximum number of transparent commands to look ahead when reordering
+		uint32_t reorderingWindowSize;
+	};
+	static_assert(sizeof(Queue) == 40, "A captured queue header should be 40 bytes long");
+
+	/// The flags of a captured command
+	enum CommandFlags : uint8_t
+	{
+		BLENDING = 1,
+		CUSTOM_VBO = 2,
+		/// The shader program of the command has vertex attributes
+		SHADER_ATTRIBUTES = 4,
+		/// The batched version of the shader program has vertex attributes other than the mesh index
+		BATCHED_SHADER_ATTRIBUTES = 8,
+		/// The batched version of the shader program uses the compact sprite instance layout
+		COMPACT_INSTANCES = 16,
+		/// The command has a bounding box of its drawing area and can be reordered
+		AABB = 32
+	};
+
+	/// A captured render command
+	struct Command
+	{
+		uint64_t materialSortKey;
+		uint32_t idSortKey;
+		uint16_t layer;
+		uint16_t visitOrder;
+		uint32_t shaderId;
+		/// The id of the batched version of the shader program, zero if the command cannot be batched
+		uint32_t batchedShaderId;
+		/// The id of the texture bound to the first unit
+		uint32_t textureId;
+		uint32_t numVertices;
+		uint32_t numIndices;
+		/// The size in bytes of the uniforms outside of the instance block, as needed by a batch
+		uint32_t nonInstanceUniformsSize;
+		/// The size in bytes of the instances uniform block of the batched shader program
+		uint32_t batchedInstancesBlockSize;
+		uint16_t primitiveType;
+		uint16_t srcBlendingFactor;
+		uint16_t destBlendingFactor;
+		/// The size in bytes of the instance block data following the command, without alignment
+		uint16_t instanceBlockSize;
+		uint8_t numElementsPerVertex;
+		/// One of the `RenderCommand::CommandTypes` values
+		uint8_t type;
+		/// A combination of `CommandFlags` values
+		uint8_t flags;
+		uint8_t padding;
+		/// The axis-aligned bounding box of the drawing area as `x`, `y`, `w` and `h`, only valid with the `AABB` flag
+		float aabb[4];
+	};
+	static_assert(sizeof(Command) == 72, "A captured command should be 72 bytes long");
+
+	/// Returns the size of the instance block data following a command, padded to eight bytes
+	inline unsigned int paddedBlockSize(unsigned int instanceBlockSize)
+	{
+		return (instanceBlockSize + 7) & ~7U;
+	}
+
+}
+
+}
+
+#endif
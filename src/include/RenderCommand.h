@@ -85,6 +85,17 @@ class RenderCommand
 	inline void setScissor(Recti scissorRect) { scissorRect_ = scissorRect; }
 	void setScissor(GLint x, GLint y, GLsizei width, GLsizei height);
 
+	/// Returns true if the command has an axis-aligned bounding box of its drawing area
+	inline bool hasAabb() const { return hasAabb_; }
+	/// Returns the axis-aligned bounding box of the command drawing area
+	inline const Rectf &aabb() const { return aabb_; }
+	/// Sets the axis-aligned bounding box of the command drawing area, used to reorder transparent commands
+	inline void setAabb(const Rectf &aabb)
+	{
+		aabb_ = aabb;
+		hasAabb_ = true;
+	}
+
 	inline const Matrix4x4f &transformation() const { return modelMatrix_; }
 	void setTransformation(const Matrix4x4f &modelMatrix);
 	inline const Material &material() const { return material_; }
@@ -125,6 +136,9 @@ class RenderCommand
 	CommandTypes::Enum profilingType_;
 
 	Recti scissorRect_;
+	/// Commands without a bounding box are never reordered with other transparent commands
+	bool hasAabb_;
+	Rectf aabb_;
 
 	Matrix4x4f modelMatrix_;
 	Material material_;
@@ -0,0 +1,29 @@
+#ifndef CLASS_NCINE_RENDERCOMMANDTRAITS
+#define CLASS_NCINE_RENDERCOMMANDTRAITS
+
+#include "RenderCommand.h"
+#include "RenderResources.h"
+
+namespace ncine {
+
+/// Exposes the render commands in a queue to the rules of `RenderQueueRules`
+struct RenderCommandTraits
+{
+	static inline uint32_t lowerMaterialSortKey(const RenderCommand *command) { return command->lowerMaterialSortKey(); }
+	static inline unsigned int primitiveType(const RenderCommand *command) { return command->geometry().primitiveType(); }
+	static inline bool hasCustomVbo(const RenderCommand *command) { return command->geometry().hasCustomVbo(); }
+	/// Commands with a custom VBO, like the baked ones, already store their vertices on the GPU
+	static inline bool isBatchable(const RenderCommand *command)
+	{
+		return (command->geometry().hasCustomVbo() == false && RenderResources::batchedShader(command->material().shaderProgram()) != nullptr);
+	}
+	static inline unsigned int numVertices(const RenderCommand *command) { return command->geometry().numVertices(); }
+	static inline unsigned int numIndices(const RenderCommand *command) { return command->geometry().numIndices(); }
+	static inline unsigned int numElementsPerVertex(const RenderCommand *command) { return command->geometry().numElementsPerVertex(); }
+	static inline bool hasAabb(const RenderCommand *command) { return command->hasAabb(); }
+	static inline const Rectf &aabb(const RenderCommand *command) { return command->aabb(); }
+};
+
+}
+
+#endif
@@ -36,6 +36,9 @@ class RenderQueue
 	nctl::Array<RenderCommand *> transparentQueue_;
 	/// Array of transparent batched render command pointers
 	nctl::Array<RenderCommand *> transparentBatchedQueue_;
+
+	/// Moves sorted transparent commands ahead of non-overlapping ones to group compatible materials
+	void reorderTransparents();
 };
 
 }
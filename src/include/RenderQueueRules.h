@@ -0,0 +1,325 @@
+#ifndef NCINE_RENDERQUEUERULES
+#define NCINE_RENDERQUEUERULES
+
+#include <cstdint>
+#include "Rect.h"
+
+namespace ncine {
+
+/// The sorting, reordering and batching rules of the render queue, shared between the engine and the replay tool
+/*! The rules only depend on plain values or on traits of the queue elements, so that captured render commands
+ *  can be replayed without a graphics context. */
+namespace RenderQueueRules {
+
+	/// Returns true if the first opaque command should be drawn before the second one (front to back)
+	inline bool opaqueOrder(uint64_t materialSortKeyA, uint32_t idSortKeyA, uint64_t materialSortKeyB, uint32_t idSortKeyB)
+	{
+		return (materialSortKeyA != materialSortKeyB)
+		           ? materialSortKeyA > materialSortKeyB
+		           : idSortKeyA > idSortKeyB;
+	}
+
+	/// Returns true if the first transparent command should be drawn before the second one (back to front)
+	inline bool transparentOrder(uint64_t materialSortKeyA, uint32_t idSortKeyA, uint64_t materialSortKeyB, uint32_t idSortKeyB)
+	{
+		return (materialSortKeyA != materialSortKeyB)
+		           ? materialSortKeyA < materialSortKeyB
+		           : idSortKeyA < idSortKeyB;
+	}
+
+	/// Returns true if two consecutive sorted commands cannot be part of the same batch
+	/*! Batches are split when the lower part of the material sort keys or the primitive types differ,
+	 *  or when only one of the commands stores its vertices in a custom buffer. */
+	inline bool shouldSplitBatch(uint32_t lowerMaterialSortKey, unsigned int primitiveType, bool hasCustomVbo,
+	                             uint32_t prevLowerMaterialSortKey, unsigned int prevPrimitiveType, bool prevHasCustomVbo)
+	{
+		return lowerMaterialSortKey != prevLowerMaterialSortKey || primitiveType != prevPrimitiveType || hasCustomVbo != prevHasCustomVbo;
+	}
+
+	/// Returns true if two consecutive sorted queue elements cannot be part of the same batch
+	/*! `Traits` provides static `lowerMaterialSortKey()`, `primitiveType()` and `hasCustomVbo()` functions for a queue element. */
+	template <class Traits, class Element>
+	inline bool shouldSplitBatch(const Element &command, const Element &prevCommand)
+	{
+		return shouldSplitBatch(Traits::lowerMaterialSortKey(command), Traits::primitiveType(command), Traits::hasCustomVbo(command),
+		                        Traits::lowerMaterialSortKey(prevCommand), Traits::primitiveType(prevCommand), Traits::hasCustomVbo(prevCommand));
+	}
+
+	/// Returns the number of points where a sorted queue would be split in different batches
+	template <class Traits, class Element>
+	unsigned int countSplits(const Element *queue, unsigned int size)
+	{
+		unsigned int numSplits = 0;
+		for (unsigned int i = 1; i < size; i++)
+			numSplits += shouldSplitBatch<Traits>(queue[i], queue[i - 1]) ? 1 : 0;
+		return numSplits;
+	}
+
+	/// Returns true if the drawing areas of two transparent commands overlap, so that their relative order matters
+	inline bool aabbsOverlap(const Rectf &aabb, const Rectf &otherAabb)
+	{
+		return aabb.overlaps(otherAabb);
+	}
+
+	/// Moves sorted transparent commands back to group them with the ones they can be batched with
+	/*! A command is moved back to the end of the current run of compatible commands only if its bounding box
+	 *  does not overlap the one of any command it overtakes, so the blended result does not change.
+	 *  Commands without a bounding box, like the ImGui ones, can never be overtaken.
+	 *  `Traits` provides the functions needed by `shouldSplitBatch()` and static `hasAabb()` and `aabb()` functions.
+	 *  \return The number of moved commands */
+	template <class Traits, class Element>
+	unsigned int reorderTransparents(Element *queue, unsigned int size, unsigned int windowSize)
+	{
+		if (windowSize == 0 || size < 3)
+			return 0;
+
+		unsigned int numMovedCommands = 0;
+		unsigned int runStart = 0;
+		while (runStart < size)
+		{
+			const Element runCommand = queue[runStart];
+			// The index after the last command of the current run
+			unsigned int runEnd = runStart + 1;
+			const unsigned int windowEnd = (runEnd + windowSize < size) ? runEnd + windowSize : size;
+
+			for (unsigned int i = runEnd; i < windowEnd; i++)
+			{
+				const Element command = queue[i];
+				if (shouldSplitBatch<Traits>(command, runCommand))
+				{
+					if (Traits::hasAabb(command) == false)
+						break;
+					continue;
+				}
+
+				if (i == runEnd)
+				{
+					runEnd++;
+					continue;
+				}
+				else if (Traits::hasAabb(command) == false)
+					break;
+
+				// The commands between the run and this one are the ones that would be overtaken
+				bool overlaps = false;
+				for (unsigned int j = runEnd; j < i; j++)
+				{
+					if (aabbsOverlap(Traits::aabb(command), Traits::aabb(queue[j])))
+					{
+						overlaps = true;
+						break;
+					}
+				}
+
+				if (overlaps == false)
+				{
+					for (unsigned int j = i; j > runEnd; j--)
+						queue[j] = queue[j - 1];
+					queue[runEnd] = command;
+					runEnd++;
+					numMovedCommands++;
+				}
+			}
+
+			runStart = runEnd;
+		}
+
+		return numMovedCommands;
+	}
+
+	/// Returns the size in bytes of the indices of a batch, from the number of vertices they address
+	/*! Batches use 16-bit indices unless they collect more vertices than those indices can address. */
+	inline unsigned int batchIndexSize(unsigned int numVertices)
+	{
+		return (numVertices > 65536) ? 4 : 2;
+	}
+
+	/// Returns the size of an instance block inside a batch, from its size without the uniform buffer offset alignment
+	/*! The size is padded to the `std140` vec4 layout alignment. */
+	inline unsigned int instanceBlockStride(unsigned int packedInstanceBlockSize)
+	{
+		return packedInstanceBlockSize + (16 - packedInstanceBlockSize % 16) % 16;
+	}
+
+	/// Returns the size of an instance inside a batch for shaders with the compact sprite layout
+	/*! The layout stores the 2x2 transformation scaled by the sprite size, the position with depth,
+	 *  an RGBA8 color and, only for textured sprites, the texture rectangle. */
+	inline unsigned int compactInstanceStride(bool hasTexRect)
+	{
+		return hasTexRect ? 48 : 32;
+	}
+
+	/// Clamps the minimum and maximum batch sizes to valid values
+	inline void validateBatchSizes(unsigned int &minBatchSize, unsigned int &maxBatchSize)
+	{
+		maxBatchSize = (maxBatchSize == 0) ? 1 : maxBatchSize;
+		minBatchSize = (minBatchSize == 0) ? 1 : minBatchSize;
+		minBatchSize = (minBatchSize > maxBatchSize) ? maxBatchSize : minBatchSize;
+	}
+
+	/// The limits on the memory that a single batch can use
+	struct BatchLimits
+	{
+		/// The maximum size in bytes of a uniform buffer
+		unsigned long int uboMaxSize;
+		/// The size in bytes of the instances uniform block of the batched shader
+		unsigned long int instancesBlockMaxSize;
+		/// The size in bytes of the uniforms and of the uniform blocks of the batch that are not for instances
+		unsigned long int nonInstancesSize;
+		/// The maximum size in bytes of the vertex data of a batch
+		unsigned long int maxVertexDataSize;
+		/// The maximum size in bytes of the index data of a batch
+		unsigned long int maxIndexDataSize;
+	};
+
+	/// The number of commands collected by a batch and the memory they need
+	struct BatchSizes
+	{
+		unsigned int numCommands;
+		/// True if the batch uses indices instead of degenerate vertices to separate the commands
+		bool withIndices;
+		unsigned long int instancesBlockSize;
+		unsigned long int vertexDataSize;
+		unsigned int numVertices;
+		unsigned int numIndices;
+	};
+
+	/// Returns how many commands from `start` can be collected by a batch before reaching `end` or one of the limits
+	/*! `Traits` provides static `numVertices()`, `numIndices()` and `numElementsPerVertex()` functions for a queue element.
+	 *  \note The number of collected commands is zero if not even the first one fits in the limits. */
+	template <class Traits, class Iterator>
+	BatchSizes collectBatch(Iterator start, Iterator end, bool batchingWithIndices, unsigned int instanceBlockStride,
+	                        bool shaderHasAttributes, const BatchLimits &limits)
+	{
+		BatchSizes sizes = {};
+
+		// Sum the amount of UBO memory required by the batch and determine if indices are needed
+		Iterator next = start;
+		while (next != end)
+		{
+			if (Traits::numIndices(*next) > 0)
+				batchingWithIndices = true;
+
+			// Don't request more bytes than an instances block or an UBO can hold (also protects against big maximum batch sizes)
+			const unsigned long int currentSize = limits.nonInstancesSize + sizes.instancesBlockSize;
+			if (sizes.instancesBlockSize + instanceBlockStride > limits.instancesBlockMaxSize || currentSize + instanceBlockStride > limits.uboMaxSize)
+				break;
+			sizes.instancesBlockSize += instanceBlockStride;
+			++next;
+		}
+		sizes.withIndices = batchingWithIndices;
+
+		// Sum the amount of VBO and IBO memory required by the batch
+		Iterator it = start;
+		while (it != next)
+		{
+			unsigned int vertexDataSize = 0;
+			unsigned int numVertices = 0;
+			unsigned int numIndices = Traits::numIndices(*it);
+
+			if (shaderHasAttributes)
+			{
+				numVertices = Traits::numVertices(*it);
+				if (batchingWithIndices == false)
+					numVertices += 2; // plus two degenerates if indices are not used
+				const unsigned int numElementsPerVertex = Traits::numElementsPerVertex(*it) + 1; // plus the mesh index
+				vertexDataSize = numVertices * numElementsPerVertex * sizeof(float);
+
+				if (batchingWithIndices)
+					numIndices = (numIndices > 0) ? numIndices + 2 : numVertices + 2;
+			}
+
+			// Don't request more bytes than a common VBO or IBO can hold, indices become 32-bit when the batch needs them
+			const unsigned int indexSize = batchIndexSize(sizes.numVertices + numVertices);
+			if (sizes.vertexDataSize + vertexDataSize > limits.maxVertexDataSize ||
+			    (sizes.numIndices + numIndices) * indexSize > limits.maxIndexDataSize)
+				break;
+
+			sizes.vertexDataSize += vertexDataSize;
+			sizes.numVertices += numVertices;
+			sizes.numIndices += numIndices;
+			++it;
+		}
+		sizes.numCommands = static_cast<unsigned int>(it - start);
+
+		// Remove the two missing degenerate vertices or indices from first and last elements
+		const unsigned long int twoVerticesDataSize = 2 * (Traits::numElementsPerVertex(*start) + 1) * sizeof(float);
+		if (sizes.numIndices >= 2)
+			sizes.numIndices -= 2;
+		else if (sizes.vertexDataSize >= twoVerticesDataSize)
+			sizes.vertexDataSize -= twoVerticesDataSize;
+
+		return sizes;
+	}
+
+	/// Splits a sorted queue in batches and in commands that are drawn on their own
+	/*! `Traits` provides static `lowerMaterialSortKey()`, `primitiveType()`, `hasCustomVbo()` and `isBatchable()` functions for a queue element.
+	 *  The `collect(start, end)` function creates a batch from the commands in the range and returns how many it has collected,
+	 *  while the `passthrough(index)` function is called for every command that is not batched.
+	 *  \note A run of compatible commands is also split where batchable and non-batchable commands meet,
+	 *  and a command that does not fit in an empty batch is passed through on its own while the rest of its run is still batched. */
+	template <class Traits, class Element, class CollectFunc, class PassthroughFunc>
+	void createBatches(const Element *queue, unsigned int size, unsigned int minBatchSize, unsigned int maxBatchSize,
+	                   CollectFunc collect, PassthroughFunc passthrough)
+	{
+		unsigned int lastSplit = 0;
+		for (unsigned int i = 1; i < size; i++)
+		{
+			const Element &command = queue[i];
+			const Element &prevCommand = queue[i - 1];
+
+			// Should split if the lower part of a material's sort key or the primitive type differ, or if only one command can be batched
+			const bool shouldSplit = shouldSplitBatch<Traits>(command, prevCommand) ||
+			                         Traits::isBatchable(command) != Traits::isBatchable(prevCommand);
+
+			// Also collect the very last command if it can be batched with the previous one
+			unsigned int endSplit = (i == size - 1 && !shouldSplit) ? i + 1 : i;
+
+			// Split point if last command or split condition
+			if (i == size - 1 || shouldSplit)
+			{
+				if (Traits::isBatchable(prevCommand) && (endSplit - lastSplit) >= minBatchSize)
+				{
+					// Split point for the maximum batch size
+					while (lastSplit < endSplit)
+					{
+						const unsigned int batchSize = endSplit - lastSplit;
+						unsigned int nextSplit = endSplit;
+						if (batchSize > maxBatchSize)
+							nextSplit = lastSplit + maxBatchSize;
+						else if (batchSize < minBatchSize)
+							break;
+
+						// Handling early splits while collecting, a command that does not fit in an empty batch is drawn on its own
+						const unsigned int numCollected = collect(lastSplit, nextSplit);
+						if (numCollected == 0)
+						{
+							passthrough(lastSplit);
+							lastSplit++;
+						}
+						else
+							lastSplit += numCollected;
+					}
+				}
+
+				// Also collect the very last command
+				endSplit = (i == size - 1) ? i + 1 : i;
+
+				// Passthrough for unsupported command types and for the last few commands that are less than the minimum batch size
+				for (unsigned int j = lastSplit; j < endSplit; j++)
+					passthrough(j);
+
+				lastSplit = endSplit;
+			}
+		}
+
+		// If the queue has only one command the for loop didn't execute, the command has to passthrough
+		if (size == 1)
+			passthrough(0);
+	}
+
+}
+
+}
+
+#endif
@@ -6,6 +6,7 @@
 
 #include <nctl/UniquePtr.h>
 #include <nctl/HashMap.h>
+#include <nctl/HashSet.h>
 #include "Material.h"
 #include "GLShaderProgram.h" // For the UniquePtr to invoke the destructor
 #include "GLShaderUniforms.h"
@@ -53,6 +54,21 @@ class RenderResources
 		int drawindex;
 	};
 
+	/// A packed vertex format structure for vertices with half-float positions and normalized texture coordinates
+	struct VertexFormatPos2Tex2Packed
+	{
+		GLhalf position[2];
+		GLushort texcoords[2];
+	};
+
+	/// A packed vertex format structure for vertices with half-float positions, normalized texture coordinates and draw indices
+	struct VertexFormatPos2Tex2IndexPacked
+	{
+		GLhalf position[2];
+		GLushort texcoords[2];
+		int drawindex;
+	};
+
 	/// A structure used by the `compileShader()` method to load and compile a shader program
 	struct ShaderProgramCompileInfo
 	{
@@ -170,6 +186,10 @@ class RenderResources
 	static GLShaderProgram *batchedShader(const GLShaderProgram *shader);
 	static bool registerBatchedShader(const GLShaderProgram *shader, ncine::GLShaderProgram *batchedShader);
 	static bool unregisterBatchedShader(const GLShaderProgram *shader);
+	/// Returns true if the batched shader uses the compact sprite instance layout
+	static inline bool hasCompactInstances(const GLShaderProgram *batchedShader) { return compactInstancesShaders_.contains(batchedShader); }
+	static bool registerCompactInstancesShader(const GLShaderProgram *batchedShader);
+	static bool unregisterCompactInstancesShader(const GLShaderProgram *batchedShader);
 
 	static inline unsigned char *cameraUniformsBuffer() { return cameraUniformsBuffer_; }
 	static CameraUniformData *findCameraUniformData(GLShaderProgram *shaderProgram);
@@ -180,6 +200,9 @@ class RenderResources
 	static inline const Viewport *currentViewport() { return currentViewport_; }
 
 	static void setDefaultAttributesParameters(GLShaderProgram &shaderProgram);
+	/// Sets the attributes of a shader program with positions and texture coordinates to read packed vertices
+	/*! \note Unlike the default parameters, the packed ones always overwrite the previous attributes values */
+	static void setPackedAttributesParameters(GLShaderProgram &shaderProgram);
 
   private:
 	static nctl::UniquePtr<BinaryShaderCache> binaryShaderCache_;
@@ -199,6 +222,8 @@ class RenderResources
 	static nctl::UniquePtr<GLShaderProgram> defaultShaderPrograms_[NumDefaultShaderPrograms];
 	/// Hash map from a shader program pointer to the pointer of its batched version
 	static nctl::HashMap<const GLShaderProgram *, GLShaderProgram *> batchedShaders_;
+	/// Hash set of the batched shader programs compiled from the default compact sprite vertex shaders
+	static nctl::HashSet<const GLShaderProgram *> compactInstancesShaders_;
 
 	static const unsigned int UniformsBufferSize = 128; // two 4x4 float matrices
 	static unsigned char cameraUniformsBuffer_[UniformsBufferSize];
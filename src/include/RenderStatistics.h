@@ -132,6 +132,26 @@ class RenderStatistics
 		friend RenderStatistics;
 	};
 
+	class Reordering
+	{
+	  public:
+		/// Number of transparent commands moved ahead of non-overlapping ones
+		unsigned int movedCommands;
+		/// Number of material changes between adjacent transparent commands avoided by reordering
+		unsigned int savedSplits;
+
+		Reordering()
+		    : movedCommands(0), savedSplits(0) {}
+
+	  private:
+		void reset()
+		{
+			movedCommands = 0;
+			savedSplits = 0;
+		}
+		friend RenderStatistics;
+	};
+
 	/// Returns the aggregated command statistics for all types
 	static inline const Commands &allCommands() { return allCommands_; }
 	/// Returns the commnad statistics for the specified type
@@ -158,6 +178,9 @@ class RenderStatistics
 	/// Returns statistics about the render command pools
 	static inline const CommandPool &commandPool() { return commandPool_; }
 
+	/// Returns statistics about the reordering of transparent commands
+	static inline const Reordering &reordering() { return reordering_; }
+
   private:
 	/// The string used to output OpenGL debug group information
 	static nctl::String debugString_;
@@ -172,6 +195,7 @@ class RenderStatistics
 	static unsigned int culledNodes_[2];
 	static VaoPool vaoPool_;
 	static CommandPool commandPool_;
+	static Reordering reordering_;
 
 	static void reset();
 	static void gatherStatistics(const RenderCommand &command);
@@ -216,6 +240,11 @@ class RenderStatistics
 		customIbos_.count--;
 		customIbos_.dataSize -= datasize;
 	}
+	static inline void addReorderedCommands(unsigned int movedCommands, unsigned int savedSplits)
+	{
+		reordering_.movedCommands += movedCommands;
+		reordering_.savedSplits += savedSplits;
+	}
 	static inline void addCulledNode() { culledNodes_[index_]++; }
 	static inline void addVaoPoolReuse() { vaoPool_.reuses++; }
 	static inline void addVaoPoolBinding() { vaoPool_.bindings++; }
@@ -227,6 +256,7 @@ class RenderStatistics
 	friend class Texture;
 	friend class Geometry;
 	friend class DrawableNode;
+	friend class StaticBatchNode;
 	friend class RenderVaoPool;
 	friend class RenderCommandPool;
 };
@@ -0,0 +1,32 @@
+#ifndef NCINE_TRANSFORMRECT
+#define NCINE_TRANSFORMRECT
+
+#include "Rect.h"
+#include "Matrix4x4.h"
+
+namespace ncine {
+
+/// Returns the axis-aligned bounding box of a rectangle transformed by a matrix on the XY plane
+inline Rectf transformRect(const Matrix4x4f &matrix, const Rectf &rect)
+{
+	const Vector2f corners[4] = { Vector2f(rect.x, rect.y), Vector2f(rect.x + rect.w, rect.y),
+		                          Vector2f(rect.x, rect.y + rect.h), Vector2f(rect.x + rect.w, rect.y + rect.h) };
+
+	Vector2f min(0.0f, 0.0f);
+	Vector2f max(0.0f, 0.0f);
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		const float x = matrix[0][0] * corners[i].x + matrix[1][0] * corners[i].y + matrix[3][0];
+		const float y = matrix[0][1] * corners[i].x + matrix[1][1] * corners[i].y + matrix[3][1];
+		min.x = (i == 0 || x < min.x) ? x : min.x;
+		min.y = (i == 0 || y < min.y) ? y : min.y;
+		max.x = (i == 0 || x > max.x) ? x : max.x;
+		max.y = (i == 0 || y > max.y) ? y : max.y;
+	}
+
+	return Rectf::fromMinMax(min, max);
+}
+
+}
+
+#endif
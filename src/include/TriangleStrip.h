@@ -0,0 +1,44 @@
+#ifndef NCINE_TRIANGLESTRIP
+#define NCINE_TRIANGLESTRIP
+
+#include <nctl/Array.h>
+#include <nctl/utility.h>
+
+namespace ncine {
+
+/// Helper functions to convert the indices of a triangle strip
+namespace TriangleStrip {
+
+	/// Appends the indices of a triangle strip as a triangle list, skipping the degenerate triangles
+	/*! Strip indices can be either 16 or 32 bits, the list ones are offset by the first vertex of the strip.
+	 *  Odd triangles of a strip have the opposite winding, so they are flipped to keep the same orientation. */
+	template <class DestIndexType, class SrcIndexType>
+	void appendAsList(const SrcIndexType *stripIndices, unsigned int numStripIndices, unsigned int firstVertex, nctl::Array<DestIndexType> &listIndices)
+	{
+		for (unsigned int i = 0; i + 2 < numStripIndices; i++)
+		{
+			unsigned int triangle[3];
+			for (unsigned int j = 0; j < 3; j++)
+				triangle[j] = stripIndices ? stripIndices[i + j] : i + j;
+			if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2])
+				continue;
+
+			if (i % 2 == 1)
+				nctl::swap(triangle[0], triangle[1]);
+			for (unsigned int j = 0; j < 3; j++)
+				listIndices.pushBack(static_cast<DestIndexType>(firstVertex + triangle[j]));
+		}
+	}
+
+	/// Appends the indices of a non-indexed triangle strip as a triangle list
+	template <class DestIndexType>
+	void appendAsList(unsigned int numStripVertices, unsigned int firstVertex, nctl::Array<DestIndexType> &listIndices)
+	{
+		appendAsList(static_cast<const unsigned int *>(nullptr), numStripVertices, firstVertex, listIndices);
+	}
+
+}
+
+}
+
+#endif
@@ -33,8 +33,10 @@ namespace AppConfiguration {
 	static const char *deferShaderQueries = "defer_shader_queries";
 	static const char *fixedBatchSize = "fixed_batch_size";
 	static const char *useBinaryShaderCache = "binary_shader_cache";
+	static const char *usePackedShaderCache = "packed_shader_cache";
 	static const char *shaderCacheDirname = "shader_cache_dirname";
 	static const char *compileBatchedShadersTwice = "compile_batched_shaders_twice";
+	static const char *packedTextVertices = "packed_text_vertices";
 	static const char *vboSize = "vbo_size";
 	static const char *iboSize = "ibo_size";
 	static const char *vaoPoolSize = "vao_pool_size";
@@ -51,6 +53,7 @@ namespace AppConfiguration {
 	static const char *withVSync = "vsync";
 	static const char *withGlDebugContext = "gl_debug_context";
 	static const char *withConsoleColors = "console_colors";
+	static const char *withLogCrashHandlers = "log_crash_handlers";
 
 	static const char *glCoreProfile = "opengl_core_profile";
 	static const char *glForwardCompatible = "opengl_forward_compatible";
@@ -73,7 +76,7 @@ void LuaAppConfiguration::exposeConstants(lua_State *L)
 
 void LuaAppConfiguration::push(lua_State *L, const AppConfiguration &appCfg)
 {
-	lua_createtable(L, 0, 40);
+	lua_createtable(L, 0, 41);
 
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::dataPath, appCfg.dataPath().data());
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::logFile, appCfg.logFile.data());
@@ -96,8 +99,10 @@ void LuaAppConfiguration::push(lua_State *L, const AppConfiguration &appCfg)
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::deferShaderQueries, appCfg.deferShaderQueries);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::fixedBatchSize, appCfg.fixedBatchSize);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::useBinaryShaderCache, appCfg.useBinaryShaderCache);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::usePackedShaderCache, appCfg.usePackedShaderCache);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::shaderCacheDirname, appCfg.shaderCacheDirname.data());
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::compileBatchedShadersTwice, appCfg.compileBatchedShadersTwice);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::packedTextVertices, appCfg.packedTextVertices);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::vboSize, static_cast<int64_t>(appCfg.vboSize));
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::iboSize, static_cast<int64_t>(appCfg.iboSize));
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::vaoPoolSize, appCfg.vaoPoolSize);
@@ -114,6 +119,7 @@ void LuaAppConfiguration::push(lua_State *L, const AppConfiguration &appCfg)
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::withVSync, appCfg.withVSync);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::withGlDebugContext, appCfg.withGlDebugContext);
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::withConsoleColors, appCfg.withConsoleColors);
+	LuaUtils::pushField(L, LuaNames::AppConfiguration::withLogCrashHandlers, appCfg.withLogCrashHandlers);
 
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::glCoreProfile, appCfg.glCoreProfile());
 	LuaUtils::pushField(L, LuaNames::AppConfiguration::glForwardCompatible, appCfg.glForwardCompatible());
@@ -181,10 +187,14 @@ void LuaAppConfiguration::retrieveAndSet(lua_State *L, AppConfiguration &appCfg)
 	appCfg.fixedBatchSize = fixedBatchSize;
 	const bool useBinaryShaderCache = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::useBinaryShaderCache);
 	appCfg.useBinaryShaderCache = useBinaryShaderCache;
+	const bool usePackedShaderCache = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::usePackedShaderCache);
+	appCfg.usePackedShaderCache = usePackedShaderCache;
 	const char *shaderCacheDirname = LuaUtils::retrieveField<const char *>(L, -1, LuaNames::AppConfiguration::shaderCacheDirname);
 	appCfg.shaderCacheDirname = shaderCacheDirname;
 	const bool compileBatchedShadersTwice = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::compileBatchedShadersTwice);
 	appCfg.compileBatchedShadersTwice = compileBatchedShadersTwice;
+	const bool packedTextVertices = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::packedTextVertices);
+	appCfg.packedTextVertices = packedTextVertices;
 	const unsigned long vboSize = LuaUtils::retrieveField<uint64_t>(L, -1, LuaNames::AppConfiguration::vboSize);
 	appCfg.vboSize = vboSize;
 	const unsigned long iboSize = LuaUtils::retrieveField<uint64_t>(L, -1, LuaNames::AppConfiguration::iboSize);
@@ -215,6 +225,8 @@ void LuaAppConfiguration::retrieveAndSet(lua_State *L, AppConfiguration &appCfg)
 	appCfg.withGlDebugContext = withGlDebugContext;
 	const bool withConsoleColors = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::withConsoleColors);
 	appCfg.withConsoleColors = withConsoleColors;
+	const bool withLogCrashHandlers = LuaUtils::retrieveField<bool>(L, -1, LuaNames::AppConfiguration::withLogCrashHandlers);
+	appCfg.withLogCrashHandlers = withLogCrashHandlers;
 }
 
 }
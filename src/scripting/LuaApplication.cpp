@@ -48,6 +48,8 @@ namespace Application {
 		static const char *cullingEnabled = "culling";
 		static const char *minBatchSize = "min_batch_size";
 		static const char *maxBatchSize = "max_batch_size";
+		static const char *reorderingEnabled = "reordering";
+		static const char *reorderingWindowSize = "reordering_window_size";
 	}
 
 	namespace DebugOverlaySettings {
@@ -120,12 +122,14 @@ int LuaApplication::renderingSettings(lua_State *L)
 {
 	const Application::RenderingSettings &settings = theApplication().renderingSettings();
 
-	lua_createtable(L, 0, 5);
+	lua_createtable(L, 0, 7);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::batchingEnabled, settings.batchingEnabled);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::batchingWithIndices, settings.batchingWithIndices);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::cullingEnabled, settings.cullingEnabled);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::minBatchSize, settings.minBatchSize);
 	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::maxBatchSize, settings.maxBatchSize);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::reorderingEnabled, settings.reorderingEnabled);
+	LuaUtils::pushField(L, LuaNames::Application::RenderingSettings::reorderingWindowSize, settings.reorderingWindowSize);
 
 	return 1;
 }
@@ -145,6 +149,8 @@ int LuaApplication::setRenderingSettings(lua_State *L)
 	settings.cullingEnabled = LuaUtils::retrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::cullingEnabled);
 	settings.minBatchSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::minBatchSize);
 	settings.maxBatchSize = LuaUtils::retrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::maxBatchSize);
+	LuaUtils::tryRetrieveField<bool>(L, -1, LuaNames::Application::RenderingSettings::reorderingEnabled, settings.reorderingEnabled);
+	LuaUtils::tryRetrieveField<uint32_t>(L, -1, LuaNames::Application::RenderingSettings::reorderingWindowSize, settings.reorderingWindowSize);
 
 	return 0;
 }
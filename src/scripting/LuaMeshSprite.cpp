@@ -402,11 +402,15 @@ int LuaMeshSprite::indices(lua_State *L)
 	{
 		const unsigned int numIndices = sprite->numIndices();
 		const unsigned short *indices = sprite->indices();
+		const unsigned int *indices32 = sprite->indices32();
 
 		LuaUtils::createTable(L, 0, numIndices);
 		for (unsigned int i = 0; i < numIndices; i++)
 		{
-			LuaUtils::push(L, indices[i]);
+			if (indices32)
+				LuaUtils::push(L, indices32[i]);
+			else
+				LuaUtils::push(L, indices[i]);
 			lua_rawseti(L, -2, i + 1); // Lua arrays start from index 1
 		}
 	}
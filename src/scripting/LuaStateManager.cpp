@@ -9,6 +9,7 @@
 #include "LuaDebug.h"
 #include "LuaStatistics.h"
 #include "LuaNames.h"
+#include "LuaCallbacks.h"
 
 #ifdef WITH_SCRIPTING_API
 	#include "LuaRect.h"
@@ -37,6 +38,7 @@
 	#include "LuaApplication.h"
 	#include "LuaIGfxDevice.h"
 	#include "LuaTexture.h"
+	#include "LuaTextureReadback.h"
 	#include "LuaSceneNode.h"
 	#include "LuaSprite.h"
 	#include "LuaMeshSprite.h"
@@ -112,6 +114,52 @@ namespace LuaNames {
 #endif
 }
 
+namespace LuaCallbacks {
+	const char *name(Id id)
+	{
+		static const char *names[COUNT] = {
+			"on_pre_init",
+			"on_init",
+			"on_frame_start",
+			"on_post_update",
+			"on_draw_viewport",
+			"on_frame_end",
+			"on_resize_window",
+			"on_change_scaling_factor",
+			"on_shutdown",
+			"on_suspend",
+			"on_resume",
+
+			"on_key_pressed",
+			"on_key_released",
+			"on_text_input",
+			"on_touch_down",
+			"on_touch_up",
+			"on_touch_move",
+			"on_pointer_down",
+			"on_pointer_up",
+			"on_acceleration",
+			"on_mouse_button_pressed",
+			"on_mouse_button_released",
+			"on_mouse_moved",
+			"on_scroll_input",
+			"on_joy_button_pressed",
+			"on_joy_button_released",
+			"on_joy_hat_moved",
+			"on_joy_axis_moved",
+			"on_joymapped_button_pressed",
+			"on_joymapped_button_released",
+			"on_joymapped_axis_moved",
+			"on_joy_connected",
+			"on_joy_disconnected",
+			"on_quit_request"
+		};
+
+		ASSERT(id < COUNT);
+		return names[id];
+	}
+}
+
 ///////////////////////////////////////////////////////////
 // STATIC DEFINITIONS
 ///////////////////////////////////////////////////////////
@@ -131,9 +179,14 @@ LuaStateManager::LuaStateManager(ApiType apiType, StatisticsTracking statsTracki
 
 LuaStateManager::LuaStateManager(lua_State *L, ApiType apiType, StatisticsTracking statsTracking, StandardLibraries stdLibraries)
     : L_(L), apiType_(apiType), statsTracking_(statsTracking), stdLibraries_(stdLibraries),
-      trackedUserDatas_(apiType == ApiType::FULL ? 32 : 2), untrackedUserDatas_(32), closeOnDestruction_(false)
+      trackedUserDatas_(apiType == ApiType::FULL ? 32 : 2), untrackedUserDatas_(32), ncineTableRef_(LUA_NOREF), closeOnDestruction_(false)
 {
 	ASSERT(L_);
+	// Scripts can create any number of objects, the maps grow without stalling a frame to rehash them all at once
+	trackedUserDatas_.setMaxLoadFactor(0.8f);
+	trackedUserDatas_.setIncrementalRehash(true);
+	untrackedUserDatas_.setMaxLoadFactor(0.8f);
+	untrackedUserDatas_.setIncrementalRehash(true);
 
 #ifndef WITH_SCRIPTING_API
 	apiType = ApiType::NONE;
@@ -169,7 +222,7 @@ void LuaStateManager::reopen()
 
 bool LuaStateManager::loadFromFile(const char *filename, const char *chunkName, nctl::String *errorMsg, int *status)
 {
-	nctl::UniquePtr<IFile> fileHandle = IFile::createFileHandle(filename);
+	nctl::UniquePtr<IFile> fileHandle = IFile::createMappedFileHandle(filename);
 	LOGI_X("Loading file: \"%s\"", fileHandle->filename());
 
 	fileHandle->open(IFile::OpenMode::READ | IFile::OpenMode::BINARY);
@@ -177,6 +230,10 @@ bool LuaStateManager::loadFromFile(const char *filename, const char *chunkName,
 		return false;
 
 	const unsigned long fileSize = fileHandle->size();
+	// The script is loaded directly from the mapped file if possible
+	if (fileHandle->data() != nullptr)
+		return loadFromMemory(chunkName, static_cast<const char *>(fileHandle->data()), fileSize, errorMsg, status);
+
 	nctl::UniquePtr<char[]> buffer = nctl::makeUnique<char[]>(fileSize);
 	fileHandle->read(buffer.get(), fileSize);
 
@@ -203,6 +260,9 @@ bool LuaStateManager::loadFromMemory(const char *bufferName, const char *bufferP
 	if (apiType_ == ApiType::FULL)
 		releaseTrackedMemory();
 	untrackedUserDatas_.clear();
+	clearUserDataTypeCache();
+	// The new script might define different callbacks
+	invalidateCallbacks();
 
 	const char *bufferRead = bufferPtr;
 
@@ -319,6 +379,98 @@ LuaTypes::UserDataType LuaStateManager::untrackedType(void *pointer) const
 	return type;
 }
 
+/*! \note Binding functions check the type of their arguments on every call, the cache avoids the hashmap lookups for recently used objects */
+LuaTypes::UserDataType LuaStateManager::userDataType(void *pointer)
+{
+	UserDataTypeEntry &entry = userDataTypeCache_[userDataTypeCacheIndex(pointer)];
+	if (entry.pointer == pointer && pointer != nullptr)
+		return entry.type;
+
+	LuaTypes::UserDataType type = trackedType(pointer);
+	if (type == LuaTypes::UNKNOWN)
+		type = untrackedType(pointer);
+
+	if (type != LuaTypes::UNKNOWN)
+	{
+		entry.pointer = pointer;
+		entry.type = type;
+	}
+
+	return type;
+}
+
+void LuaStateManager::addTrackedUserData(void *pointer, LuaTypes::UserDataType type)
+{
+	trackedUserDatas_.insert(pointer, type);
+
+	UserDataTypeEntry &entry = userDataTypeCache_[userDataTypeCacheIndex(pointer)];
+	if (entry.pointer == pointer)
+		entry.pointer = nullptr;
+}
+
+void LuaStateManager::removeTrackedUserData(void *pointer)
+{
+	trackedUserDatas_.remove(pointer);
+
+	UserDataTypeEntry &entry = userDataTypeCache_[userDataTypeCacheIndex(pointer)];
+	if (entry.pointer == pointer)
+		entry.pointer = nullptr;
+}
+
+void LuaStateManager::addUntrackedUserData(void *pointer, LuaTypes::UserDataType type)
+{
+	UserDataTypeEntry &entry = userDataTypeCache_[userDataTypeCacheIndex(pointer)];
+	// Objects pushed every frame are already known with the same type
+	if (entry.pointer == pointer && entry.type == type)
+		return;
+
+	untrackedUserDatas_.insert(pointer, type);
+
+	if (entry.pointer == pointer)
+		entry.pointer = nullptr;
+}
+
+void LuaStateManager::removeUntrackedUserData(void *pointer)
+{
+	untrackedUserDatas_.remove(pointer);
+
+	UserDataTypeEntry &entry = userDataTypeCache_[userDataTypeCacheIndex(pointer)];
+	if (entry.pointer == pointer)
+		entry.pointer = nullptr;
+}
+
+bool LuaStateManager::pushCallback(unsigned int callbackId)
+{
+	ASSERT(callbackId < LuaCallbacks::COUNT);
+
+	if (callbackNameRefs_.isEmpty())
+		resolveCallbacks();
+	if (ncineTableRef_ == LUA_NOREF)
+		return false;
+
+	// Callbacks stay plain fields of the `ncine` table, they are read again at every call
+	lua_rawgeti(L_, LUA_REGISTRYINDEX, ncineTableRef_);
+	lua_rawgeti(L_, LUA_REGISTRYINDEX, callbackNameRefs_[callbackId]);
+	const int type = lua_gettable(L_, -2);
+	lua_remove(L_, -2);
+	if (type != LUA_TFUNCTION)
+	{
+		lua_pop(L_, 1);
+		return false;
+	}
+
+	return true;
+}
+
+void LuaStateManager::invalidateCallbacks()
+{
+	luaL_unref(L_, LUA_REGISTRYINDEX, ncineTableRef_);
+	ncineTableRef_ = LUA_NOREF;
+	for (const int ref : callbackNameRefs_)
+		luaL_unref(L_, LUA_REGISTRYINDEX, ref);
+	callbackNameRefs_.clear();
+}
+
 LuaStateManager *LuaStateManager::manager(lua_State *L)
 {
 	LuaStateManager *stateManager = nullptr;
@@ -416,12 +568,17 @@ void LuaStateManager::init(ApiType apiType, StatisticsTracking statsTracking, St
 void LuaStateManager::shutdown()
 {
 	unregisterState();
+	invalidateCallbacks();
+	clearUserDataTypeCache();
 
 	if (statsTracking_ == StatisticsTracking::ENABLED)
 		LuaStatistics::unregisterState(this);
 
 	if (apiType_ == ApiType::FULL)
 		releaseTrackedMemory();
+#ifdef WITH_SCRIPTING_API
+	LuaTextureReadback::release(L_);
+#endif
 
 	if (closeOnDestruction_)
 		lua_close(L_);
@@ -451,6 +608,8 @@ void LuaStateManager::releaseTrackedMemory()
 	if (trackedUserDatas_.isEmpty() == false)
 		LOGW_X("Lua array of tracked userdata is not empty: %d elements", trackedUserDatas_.size());
 
+	// Removing elements while iterating should not migrate any bucket of an incremental rehash
+	trackedUserDatas_.finishRehash();
 	for (nctl::HashMap<void *, LuaTypes::UserDataType>::Iterator i = trackedUserDatas_.begin(); i != trackedUserDatas_.end(); ++i)
 	{
 		const LuaTypes::UserDataType type = i.value();
@@ -569,9 +728,31 @@ void LuaStateManager::releaseTrackedMemory()
 		trackedUserDatas_.remove(object);
 	}
 	trackedUserDatas_.clear();
+	clearUserDataTypeCache();
 #endif
 }
 
+void LuaStateManager::resolveCallbacks()
+{
+	callbackNameRefs_.setSize(LuaCallbacks::COUNT);
+	for (unsigned int i = 0; i < LuaCallbacks::COUNT; i++)
+	{
+		lua_pushstring(L_, LuaCallbacks::name(static_cast<LuaCallbacks::Id>(i)));
+		callbackNameRefs_[i] = luaL_ref(L_, LUA_REGISTRYINDEX);
+	}
+
+	if (lua_getglobal(L_, LuaNames::ncine) == LUA_TTABLE)
+		ncineTableRef_ = luaL_ref(L_, LUA_REGISTRYINDEX);
+	else
+		lua_pop(L_, 1);
+}
+
+void LuaStateManager::clearUserDataTypeCache()
+{
+	for (unsigned int i = 0; i < UserDataTypeCacheSize; i++)
+		userDataTypeCache_[i].pointer = nullptr;
+}
+
 void LuaStateManager::exposeScriptApi()
 {
 	if (apiType_ != ApiType::NONE)
@@ -622,6 +803,7 @@ void LuaStateManager::exposeApi()
 		LuaShaderState::expose(this);
 
 		LuaTexture::expose(this);
+		LuaTextureReadback::expose(L_);
 		LuaSceneNode::expose(this);
 		LuaSprite::expose(this);
 		LuaMeshSprite::expose(this);
@@ -0,0 +1,220 @@
+#define NCINE_INCLUDE_LUA
+#include "common_headers.h"
+#include <nctl/UniquePtr.h>
+
+#include "LuaTextureReadback.h"
+#include "LuaUntrackedUserData.h"
+#include "LuaRectUtils.h"
+#include "LuaUtils.h"
+#include "TextureReadback.h"
+#include "Texture.h"
+
+namespace ncine {
+
+namespace LuaNames {
+namespace TextureReadback {
+	static const char *TextureReadback = "texture_readback";
+
+	static const char *readTexture = "read_texture";
+	static const char *readScreen = "read_screen";
+	static const char *saveTexture = "save_texture";
+	static const char *saveScreenshot = "save_screenshot";
+
+	static const char *numPendingRequests = "num_pending_requests";
+
+	static const char *success = "success";
+	static const char *width = "width";
+	static const char *height = "height";
+	static const char *pixels = "pixels";
+	static const char *filename = "filename";
+}}
+
+namespace {
+
+	/// The Lua function to invoke when a request completes, stored in the registry of the state that issued the request
+	struct CallbackData
+	{
+		lua_State *L;
+		int functionRef;
+	};
+
+	nctl::Array<nctl::UniquePtr<CallbackData>> pendingCallbacks;
+
+	void removeCallbackData(const CallbackData *callbackData)
+	{
+		for (unsigned int i = 0; i < pendingCallbacks.size(); i++)
+		{
+			if (pendingCallbacks[i].get() == callbackData)
+			{
+				pendingCallbacks.unorderedRemoveAt(i);
+				break;
+			}
+		}
+	}
+
+	void completionCallback(const TextureReadback::Result &result, void *userData)
+	{
+		CallbackData *callbackData = static_cast<CallbackData *>(userData);
+		lua_State *L = callbackData->L;
+
+		// The state that issued the request might have been closed in the meantime
+		if (L != nullptr)
+		{
+			lua_rawgeti(L, LUA_REGISTRYINDEX, callbackData->functionRef);
+			luaL_unref(L, LUA_REGISTRYINDEX, callbackData->functionRef);
+
+			LuaUtils::createTable(L, 0, 5);
+			LuaUtils::pushField(L, LuaNames::TextureReadback::success, result.success);
+			LuaUtils::pushField(L, LuaNames::TextureReadback::width, static_cast<int32_t>(result.width));
+			LuaUtils::pushField(L, LuaNames::TextureReadback::height, static_cast<int32_t>(result.height));
+			// Pixels are exposed as a string of RGBA8 bytes as they are only valid during the callback
+			if (result.pixels != nullptr)
+				LuaUtils::pushField(L, LuaNames::TextureReadback::pixels, reinterpret_cast<const char *>(result.pixels), size_t(result.width) * size_t(result.height) * 4);
+			if (result.filename != nullptr)
+				LuaUtils::pushField(L, LuaNames::TextureReadback::filename, result.filename);
+
+			LuaUtils::pcallFunction(L, "texture readback callback", 1, 0);
+		}
+
+		removeCallbackData(callbackData);
+	}
+
+	/// Stores the function at the specified index, returns `nullptr` if there is no function to invoke
+	CallbackData *storeCallback(lua_State *L, int index)
+	{
+		if (LuaUtils::isFunction(L, index) == false)
+			return nullptr;
+
+		lua_pushvalue(L, index);
+		nctl::UniquePtr<CallbackData> callbackData = nctl::makeUnique<CallbackData>();
+		callbackData->L = L;
+		callbackData->functionRef = luaL_ref(L, LUA_REGISTRYINDEX);
+		pendingCallbacks.pushBack(nctl::move(callbackData));
+
+		return pendingCallbacks.back().get();
+	}
+
+	/// Releases a stored function when its request could not be issued and the callback will never be invoked
+	void discardCallback(CallbackData *callbackData)
+	{
+		if (callbackData == nullptr)
+			return;
+
+		luaL_unref(callbackData->L, LUA_REGISTRYINDEX, callbackData->functionRef);
+		removeCallbackData(callbackData);
+	}
+
+}
+
+///////////////////////////////////////////////////////////
+// PUBLIC FUNCTIONS
+///////////////////////////////////////////////////////////
+
+void LuaTextureReadback::expose(lua_State *L)
+{
+	lua_createtable(L, 0, 5);
+
+	LuaUtils::addFunction(L, LuaNames::TextureReadback::readTexture, readTexture);
+	LuaUtils::addFunction(L, LuaNames::TextureReadback::readScreen, readScreen);
+	LuaUtils::addFunction(L, LuaNames::TextureReadback::saveTexture, saveTexture);
+	LuaUtils::addFunction(L, LuaNames::TextureReadback::saveScreenshot, saveScreenshot);
+
+	LuaUtils::addFunction(L, LuaNames::TextureReadback::numPendingRequests, numPendingRequests);
+
+	lua_setfield(L, -2, LuaNames::TextureReadback::TextureReadback);
+}
+
+void LuaTextureReadback::release(lua_State *L)
+{
+	// The requests are still pending, their callbacks will skip the closed state and free the data
+	for (nctl::UniquePtr<CallbackData> &callbackData : pendingCallbacks)
+	{
+		if (callbackData->L == L)
+		{
+			luaL_unref(L, LUA_REGISTRYINDEX, callbackData->functionRef);
+			callbackData->L = nullptr;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////
+// PRIVATE FUNCTIONS
+///////////////////////////////////////////////////////////
+
+int LuaTextureReadback::readTexture(lua_State *L)
+{
+	const Texture *texture = LuaUntrackedUserData<Texture>::retrieve(L, -2);
+	CallbackData *callbackData = storeCallback(L, -1);
+
+	bool requestIssued = false;
+	if (callbackData == nullptr)
+		LOGE("A callback function is required to receive the pixels");
+	else if (texture)
+		requestIssued = TextureReadback::readTexture(*texture, completionCallback, callbackData);
+	if (requestIssued == false)
+		discardCallback(callbackData);
+	LuaUtils::push(L, requestIssued);
+
+	return 1;
+}
+
+int LuaTextureReadback::readScreen(lua_State *L)
+{
+	int rectIndex = 0;
+	const Recti region = LuaRectiUtils::retrieve(L, -2, rectIndex);
+	CallbackData *callbackData = storeCallback(L, -1);
+
+	bool requestIssued = false;
+	if (callbackData == nullptr)
+		LOGE("A callback function is required to receive the pixels");
+	else
+		requestIssued = TextureReadback::readScreen(region, completionCallback, callbackData);
+	if (requestIssued == false)
+		discardCallback(callbackData);
+	LuaUtils::push(L, requestIssued);
+
+	return 1;
+}
+
+int LuaTextureReadback::saveTexture(lua_State *L)
+{
+	// The callback is optional when saving, the arguments are read from the bottom of the stack
+	const int numArguments = lua_gettop(L);
+	const Texture *texture = LuaUntrackedUserData<Texture>::retrieve(L, 1);
+	const char *filename = LuaUtils::retrieve<const char *>(L, 2);
+
+	bool requestIssued = false;
+	if (texture)
+	{
+		CallbackData *callbackData = (numArguments >= 3) ? storeCallback(L, 3) : nullptr;
+		requestIssued = TextureReadback::saveTexture(*texture, filename, callbackData ? completionCallback : nullptr, callbackData);
+		if (requestIssued == false)
+			discardCallback(callbackData);
+	}
+	LuaUtils::push(L, requestIssued);
+
+	return 1;
+}
+
+int LuaTextureReadback::saveScreenshot(lua_State *L)
+{
+	// The callback is optional when saving, the arguments are read from the bottom of the stack
+	const int numArguments = lua_gettop(L);
+	const char *filename = LuaUtils::retrieve<const char *>(L, 1);
+
+	CallbackData *callbackData = (numArguments >= 2) ? storeCallback(L, 2) : nullptr;
+	const bool requestIssued = TextureReadback::saveScreenshot(filename, callbackData ? completionCallback : nullptr, callbackData);
+	if (requestIssued == false)
+		discardCallback(callbackData);
+	LuaUtils::push(L, requestIssued);
+
+	return 1;
+}
+
+int LuaTextureReadback::numPendingRequests(lua_State *L)
+{
+	LuaUtils::push(L, TextureReadback::numPendingRequests());
+	return 1;
+}
+
+}
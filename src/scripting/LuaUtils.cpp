@@ -101,6 +101,18 @@ int LuaUtils::pcall(lua_State *L, int nargs, int nresults)
 	return lua_pcall(L, nargs, nresults, 0);
 }
 
+bool LuaUtils::pcallFunction(lua_State *L, const char *functionName, int nargs, int nresults)
+{
+	const int status = lua_pcall(L, nargs, nresults, 0);
+	if (status != LUA_OK)
+	{
+		LOGE_X("Error running Lua function \"%s\" (%s):\n%s", functionName, LuaDebug::statusToString(status), lua_tostring(L, -1));
+		lua_pop(L, 1);
+		return false;
+	}
+	return true;
+}
+
 void LuaUtils::pop(lua_State *L, int n)
 {
 	lua_pop(L, n);
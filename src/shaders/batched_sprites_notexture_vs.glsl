@@ -3,15 +3,15 @@ uniform mat4 uViewMatrix;
 
 struct Instance
 {
-	mat4 modelMatrix;
-	vec4 color;
-	vec2 spriteSize;
+	vec4 transform; // the 2x2 part of the model matrix scaled by the sprite size
+	vec3 position;
+	uint color; // RGBA8
 };
 
 layout (std140) uniform InstancesBlock
 {
 #ifndef BATCH_SIZE
-	#define BATCH_SIZE (682) // 64 Kb / 96 b
+	#define BATCH_SIZE (2048) // 64 Kb / 32 b
 #endif
 	Instance[BATCH_SIZE] instances;
 } block;
@@ -23,8 +23,8 @@ out vec4 vColor;
 void main()
 {
 	vec2 aPosition = vec2(-0.5 + float(((gl_VertexID + 2) / 3) % 2), 0.5 - float(((gl_VertexID + 1) / 3) % 2));
-	vec4 position = vec4(aPosition.x * i.spriteSize.x, aPosition.y * i.spriteSize.y, 0.0, 1.0);
+	vec2 position = i.transform.xy * aPosition.x + i.transform.zw * aPosition.y + i.position.xy;
 
-	gl_Position = uProjectionMatrix * uViewMatrix * i.modelMatrix * position;
-	vColor = i.color;
+	gl_Position = uProjectionMatrix * uViewMatrix * vec4(position, i.position.z, 1.0);
+	vColor = vec4(uvec4(i.color, i.color >> 8, i.color >> 16, i.color >> 24) & 0xFFu) / 255.0;
 }
@@ -3,16 +3,16 @@ uniform mat4 uViewMatrix;
 
 struct Instance
 {
-	mat4 modelMatrix;
-	vec4 color;
+	vec4 transform; // the 2x2 part of the model matrix scaled by the sprite size
+	vec3 position;
+	uint color; // RGBA8
 	vec4 texRect;
-	vec2 spriteSize;
 };
 
 layout (std140) uniform InstancesBlock
 {
 #ifndef BATCH_SIZE
-	#define BATCH_SIZE (585) // 64 Kb / 112 b
+	#define BATCH_SIZE (1365) // 64 Kb / 48 b
 #endif
 	Instance[BATCH_SIZE] instances;
 } block;
@@ -26,9 +26,9 @@ void main()
 {
 	vec2 aPosition = vec2(-0.5 + float(((gl_VertexID + 2) / 3) % 2), 0.5 - float(((gl_VertexID + 1) / 3) % 2));
 	vec2 aTexCoords = vec2(float(((gl_VertexID + 2) / 3) % 2), float(((gl_VertexID + 1) / 3) % 2));
-	vec4 position = vec4(aPosition.x * i.spriteSize.x, aPosition.y * i.spriteSize.y, 0.0, 1.0);
+	vec2 position = i.transform.xy * aPosition.x + i.transform.zw * aPosition.y + i.position.xy;
 
-	gl_Position = uProjectionMatrix * uViewMatrix * i.modelMatrix * position;
+	gl_Position = uProjectionMatrix * uViewMatrix * vec4(position, i.position.z, 1.0);
 	vTexCoords = vec2(aTexCoords.x * i.texRect.x + i.texRect.y, aTexCoords.y * i.texRect.z + i.texRect.w);
-	vColor = i.color;
+	vColor = vec4(uvec4(i.color, i.color >> 8, i.color >> 16, i.color >> 24) & 0xFFu) / 255.0;
 }
@@ -0,0 +1,101 @@
+#include "apptest_readback.h"
+#include <ncine/common_macros.h>
+#include <ncine/Application.h>
+#include <ncine/Texture.h>
+#include <ncine/TextureReadback.h>
+
+namespace {
+
+const int TextureSize = 4;
+unsigned char texels[TextureSize * TextureSize * 4];
+
+unsigned int numCompleted = 0;
+unsigned int numFailed = 0;
+
+void textureCallback(const nc::TextureReadback::Result &result, void *userData)
+{
+	numCompleted++;
+	const bool hasExpectedSize = (result.width == TextureSize && result.height == TextureSize);
+	if (result.success == false || hasExpectedSize == false || result.pixels == nullptr)
+	{
+		LOGE("APPTEST_READBACK: texture readback failed");
+		numFailed++;
+		return;
+	}
+
+	for (unsigned int i = 0; i < sizeof(texels); i++)
+	{
+		if (result.pixels[i] != texels[i])
+		{
+			LOGE_X("APPTEST_READBACK: texel byte #%u is %u instead of %u", i, result.pixels[i], texels[i]);
+			numFailed++;
+			return;
+		}
+	}
+	LOGI("APPTEST_READBACK: texture readback matches the uploaded texels");
+}
+
+void screenCallback(const nc::TextureReadback::Result &result, void *userData)
+{
+	numCompleted++;
+	if (result.success == false || result.width != 1 || result.height != 1 || result.pixels == nullptr)
+	{
+		LOGE("APPTEST_READBACK: screen readback failed");
+		numFailed++;
+		return;
+	}
+	LOGI_X("APPTEST_READBACK: screen pixel is (%u, %u, %u, %u)", result.pixels[0], result.pixels[1], result.pixels[2], result.pixels[3]);
+}
+
+}
+
+nctl::UniquePtr<nc::IAppEventHandler> createAppEventHandler()
+{
+	return nctl::makeUnique<MyEventHandler>();
+}
+
+void MyEventHandler::onInit()
+{
+	for (unsigned int i = 0; i < sizeof(texels); i++)
+		texels[i] = static_cast<unsigned char>(i * 3);
+
+	texture_ = nctl::makeUnique<nc::Texture>("Readback", nc::Texture::Format::RGBA8, TextureSize, TextureSize);
+	texture_->loadFromTexels(texels);
+
+	if (nc::TextureReadback::readTexture(*texture_, textureCallback, nullptr) == false)
+	{
+		LOGE("APPTEST_READBACK: cannot issue the texture readback");
+		numFailed++;
+	}
+	if (nc::TextureReadback::readScreen(nc::Recti(0, 0, 1, 1), screenCallback, nullptr) == false)
+	{
+		LOGE("APPTEST_READBACK: cannot issue the screen readback");
+		numFailed++;
+	}
+	// A request with an unsupported file extension should be refused immediately
+	if (nc::TextureReadback::saveTexture(*texture_, "readback.unsupported", nullptr, nullptr))
+	{
+		LOGE("APPTEST_READBACK: a save request with an unsupported extension has been accepted");
+		numFailed++;
+	}
+}
+
+void MyEventHandler::onFrameStart()
+{
+	if (nc::TextureReadback::numPendingRequests() == 0)
+	{
+		LOGI_X("APPTEST_READBACK: %u request(s) completed, %u failure(s)", numCompleted, numFailed);
+		nc::theApplication().quit();
+	}
+}
+
+void MyEventHandler::onShutdown()
+{
+	texture_.reset(nullptr);
+}
+
+void MyEventHandler::onKeyReleased(const nc::KeyboardEvent &event)
+{
+	if (event.sym == nc::KeySym::ESCAPE)
+		nc::theApplication().quit();
+}
@@ -0,0 +1,32 @@
+#ifndef CLASS_MYEVENTHANDLER
+#define CLASS_MYEVENTHANDLER
+
+#include "IAppEventHandler.h"
+#include "IInputEventHandler.h"
+#include <nctl/UniquePtr.h>
+
+namespace ncine {
+
+class Texture;
+
+}
+
+namespace nc = ncine;
+
+/// My nCine event handler
+class MyEventHandler :
+    public nc::IAppEventHandler,
+    public nc::IInputEventHandler
+{
+  public:
+	void onInit() override;
+	void onFrameStart() override;
+	void onShutdown() override;
+
+	void onKeyReleased(const nc::KeyboardEvent &event) override;
+
+  private:
+	nctl::UniquePtr<nc::Texture> texture_;
+};
+
+#endif
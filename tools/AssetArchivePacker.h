@@ -0,0 +1,313 @@
+#ifndef NCINE_ASSETARCHIVEPACKER
+#define NCINE_ASSETARCHIVEPACKER
+
+#include <cstdio>
+#include <cstring>
+#include <ncine/FileSystem.h>
+#include <nctl/Array.h>
+#include <nctl/String.h>
+#include <nctl/UniquePtr.h>
+#include <nctl/algorithms.h>
+#include "AssetArchiveFormat.h"
+
+namespace ncine {
+
+/// The functions writing an asset archive, shared between the packing tool and the tests
+namespace AssetArchivePacker {
+
+	using fs = ncine::FileSystem;
+	namespace format = ncine::AssetArchiveFormat;
+
+	struct InputFile
+	{
+		/// The entry name, relative to the input directory
+		nctl::String name;
+		/// The file path used to read its contents
+		nctl::String path;
+		uint64_t hash;
+	};
+
+	inline bool isEntryLess(const InputFile &a, const InputFile &b)
+	{
+		if (a.hash != b.hash)
+			return a.hash < b.hash;
+		return a.name.compare(b.name) < 0;
+	}
+
+	inline void collectFiles(const nctl::String &directory, const nctl::String &prefix, nctl::Array<InputFile> &files)
+	{
+		fs::Directory dir(directory.data());
+		while (const char *entryName = dir.readNext())
+		{
+			if (strcmp(entryName, ".") == 0 || strcmp(entryName, "..") == 0)
+				continue;
+
+			const nctl::String path = fs::joinPath(directory, entryName);
+			nctl::String name(fs::MaxPathLength);
+			if (prefix.isEmpty() == false)
+				name.format("%s/%s", prefix.data(), entryName);
+			else
+				name = entryName;
+
+			if (fs::isDirectory(path.data()))
+				collectFiles(path, name, files);
+			else if (fs::isFile(path.data()))
+			{
+				if (name.length() >= format::MaxNameLength)
+				{
+					fprintf(stderr, "Skipping \"%s\", the name is too long\n", name.data());
+					continue;
+				}
+				files.emplaceBack();
+				InputFile &file = files.back();
+				file.name = name;
+				file.path = path;
+				file.hash = format::hashName(name.data(), name.length());
+			}
+		}
+	}
+
+	static const unsigned int MinMatch = 4;
+	/// The last literals of a block cannot be part of a match
+	static const unsigned long int LastLiterals = 5;
+	/// The last match of a block should start this many bytes before the end
+	static const unsigned long int MatchFindLimit = 12;
+	static const unsigned int HashLog = 16;
+	static const unsigned long int MaxOffset = 65535;
+
+	inline uint32_t read32(const unsigned char *ptr)
+	{
+		uint32_t value;
+		memcpy(&value, ptr, sizeof(uint32_t));
+		return value;
+	}
+
+	inline uint32_t hashSequence(uint32_t sequence)
+	{
+		return (sequence * 2654435761U) >> (32 - HashLog);
+	}
+
+	/// Writes a length extension, returns false if it does not fit in the destination
+	inline bool writeLength(unsigned long int length, unsigned char *&op, const unsigned char *opEnd)
+	{
+		while (length >= 255)
+		{
+			if (op >= opEnd)
+				return false;
+			*op++ = 255;
+			length -= 255;
+		}
+		if (op >= opEnd)
+			return false;
+		*op++ = static_cast<unsigned char>(length);
+		return true;
+	}
+
+	/// Writes a sequence of literals optionally followed by a match, returns false if it does not fit in the destination
+	inline bool writeSequence(const unsigned char *literals, unsigned long int literalLength, unsigned long int matchOffset,
+	                   unsigned long int matchLength, unsigned char *&op, const unsigned char *opEnd)
+	{
+		if (op >= opEnd)
+			return false;
+		unsigned char *token = op++;
+		*token = static_cast<unsigned char>((literalLength >= 15 ? 15 : literalLength) << 4);
+		if (literalLength >= 15 && writeLength(literalLength - 15, op, opEnd) == false)
+			return false;
+
+		if (literalLength > static_cast<unsigned long int>(opEnd - op))
+			return false;
+		memcpy(op, literals, literalLength);
+		op += literalLength;
+
+		if (matchLength > 0)
+		{
+			if (opEnd - op < 2)
+				return false;
+			*op++ = static_cast<unsigned char>(matchOffset & 0xff);
+			*op++ = static_cast<unsigned char>(matchOffset >> 8);
+
+			const unsigned long int length = matchLength - MinMatch;
+			*token |= static_cast<unsigned char>(length >= 15 ? 15 : length);
+			if (length >= 15 && writeLength(length - 15, op, opEnd) == false)
+				return false;
+		}
+
+		return true;
+	}
+
+	/// Compresses a buffer as a single LZ4 block with a greedy parser
+	/*! \returns The compressed size, or zero if it would not be smaller than the destination capacity */
+	inline unsigned long int compressLz4Block(const unsigned char *src, unsigned long int srcSize, unsigned char *dest, unsigned long int destCapacity)
+	{
+		nctl::UniquePtr<long int[]> table = nctl::makeUnique<long int[]>(1 << HashLog);
+		for (unsigned int i = 0; i < (1 << HashLog); i++)
+			table[i] = -1;
+
+		unsigned char *op = dest;
+		const unsigned char *opEnd = dest + destCapacity;
+		unsigned long int anchor = 0;
+		unsigned long int ip = 0;
+
+		while (srcSize > MatchFindLimit && ip < srcSize - MatchFindLimit)
+		{
+			const uint32_t sequence = read32(src + ip);
+			const uint32_t hash = hashSequence(sequence);
+			const long int ref = table[hash];
+			table[hash] = static_cast<long int>(ip);
+
+			if (ref < 0 || ip - ref > MaxOffset || read32(src + ref) != sequence)
+			{
+				ip++;
+				continue;
+			}
+
+			unsigned long int matchLength = MinMatch;
+			while (ip + matchLength < srcSize - LastLiterals && src[ref + matchLength] == src[ip + matchLength])
+				matchLength++;
+
+			if (writeSequence(src + anchor, ip - anchor, ip - ref, matchLength, op, opEnd) == false)
+				return 0;
+			ip += matchLength;
+			anchor = ip;
+		}
+
+		if (writeSequence(src + anchor, srcSize - anchor, 0, 0, op, opEnd) == false)
+			return 0;
+
+		return static_cast<unsigned long int>(op - dest);
+	}
+
+	inline bool writePadding(FILE *fp, unsigned long int alignment)
+	{
+		static const unsigned char zeroes[256] = {};
+		const unsigned long int position = static_cast<unsigned long int>(ftell(fp));
+		const unsigned long int padding = (alignment - position % alignment) % alignment;
+		return (fwrite(zeroes, 1, padding, fp) == padding);
+	}
+
+	/// Statistics about a packed archive
+	struct PackStats
+	{
+		unsigned int numEntries;
+		/// Total size in bytes of the uncompressed entries
+		unsigned long int totalSize;
+		/// Total size in bytes of the entries as stored in the archive
+		unsigned long int totalStoredSize;
+	};
+
+	/// Packs the files of a directory tree into an archive, printing errors on the standard error
+	inline bool pack(const char *inputDirectory, const char *outputFilename, bool compress, unsigned long int alignment, PackStats &stats)
+	{
+		nctl::Array<InputFile> files;
+		collectFiles(inputDirectory, nctl::String(), files);
+		nctl::quicksort(files.begin(), files.end(), isEntryLess);
+
+		FILE *fp = fopen(outputFilename, "wb");
+		if (fp == nullptr)
+		{
+			fprintf(stderr, "Cannot open the output archive \"%s\"\n", outputFilename);
+			return false;
+		}
+
+		format::Header header = {};
+		bool success = (fwrite(&header, sizeof(format::Header), 1, fp) == 1);
+
+		nctl::Array<format::Entry> entries(files.size());
+		unsigned long int namesSize = 0;
+		stats.numEntries = 0;
+		stats.totalSize = 0;
+		stats.totalStoredSize = 0;
+		for (unsigned int i = 0; i < files.size() && success; i++)
+		{
+			const InputFile &file = files[i];
+			const long int fileSize = fs::fileSize(file.path.data());
+			if (fileSize < 0 || static_cast<unsigned long long int>(fileSize) > 0xFFFFFFFFULL)
+			{
+				fprintf(stderr, "Cannot pack \"%s\", its size is not valid\n", file.path.data());
+				success = false;
+				break;
+			}
+			const unsigned long int size = static_cast<unsigned long int>(fileSize);
+
+			nctl::UniquePtr<unsigned char[]> data = nctl::makeUnique<unsigned char[]>(size > 0 ? size : 1);
+			FILE *inputFp = fopen(file.path.data(), "rb");
+			const bool readSuccess = (inputFp != nullptr && fread(data.get(), 1, size, inputFp) == size);
+			if (inputFp)
+				fclose(inputFp);
+			if (readSuccess == false)
+			{
+				fprintf(stderr, "Cannot read \"%s\"\n", file.path.data());
+				success = false;
+				break;
+			}
+
+			entries.emplaceBack();
+			format::Entry &entry = entries.back();
+			memset(&entry, 0, sizeof(format::Entry));
+			entry.hash = file.hash;
+			entry.size = static_cast<uint32_t>(size);
+			entry.storedSize = static_cast<uint32_t>(size);
+			entry.nameOffset = static_cast<uint32_t>(namesSize);
+			entry.nameLength = static_cast<uint16_t>(file.name.length());
+			entry.compression = format::Compression::NONE;
+			namesSize += file.name.length() + 1;
+
+			const unsigned char *storedData = data.get();
+			nctl::UniquePtr<unsigned char[]> compressedData;
+			if (compress && size > MatchFindLimit)
+			{
+				// Entries are only compressed if it makes them smaller
+				compressedData = nctl::makeUnique<unsigned char[]>(size);
+				const unsigned long int compressedSize = compressLz4Block(data.get(), size, compressedData.get(), size - 1);
+				if (compressedSize > 0)
+				{
+					entry.storedSize = static_cast<uint32_t>(compressedSize);
+					entry.compression = format::Compression::LZ4;
+					storedData = compressedData.get();
+				}
+			}
+
+			success = writePadding(fp, alignment);
+			entry.offset = static_cast<uint64_t>(ftell(fp));
+			success = success && (fwrite(storedData, 1, entry.storedSize, fp) == entry.storedSize);
+
+			stats.totalSize += entry.size;
+			stats.totalStoredSize += entry.storedSize;
+		}
+
+		if (success)
+		{
+			success = writePadding(fp, 8);
+			header.indexOffset = static_cast<uint64_t>(ftell(fp));
+			success = success && (entries.isEmpty() || fwrite(entries.data(), sizeof(format::Entry), entries.size(), fp) == entries.size());
+
+			header.namesOffset = static_cast<uint64_t>(ftell(fp));
+			for (unsigned int i = 0; i < files.size() && success; i++)
+				success = (fwrite(files[i].name.data(), 1, files[i].name.length() + 1, fp) == files[i].name.length() + 1);
+
+			memcpy(header.signature, format::Signature, sizeof(format::Signature));
+			header.version = format::Version;
+			header.numEntries = entries.size();
+			header.namesSize = static_cast<uint32_t>(namesSize);
+			header.alignment = static_cast<uint32_t>(alignment);
+			success = success && (fseek(fp, 0, SEEK_SET) == 0) && (fwrite(&header, sizeof(format::Header), 1, fp) == 1);
+		}
+
+		success = (fclose(fp) == 0) && success;
+		if (success == false)
+		{
+			fprintf(stderr, "Cannot write the output archive \"%s\"\n", outputFilename);
+			remove(outputFilename);
+			return false;
+		}
+
+		stats.numEntries = entries.size();
+		return true;
+
+	}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,67 @@
+/// Packs the files of a directory tree into an nCine asset archive
+/*! Usage: ncine_pack [-c] [-a alignment] <input directory> <output archive> */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "AssetArchivePacker.h"
+
+using fs = ncine::FileSystem;
+namespace format = ncine::AssetArchiveFormat;
+namespace packer = ncine::AssetArchivePacker;
+
+namespace {
+
+void printUsage(const char *programName)
+{
+	fprintf(stderr, "Usage: %s [-c] [-a alignment] <input directory> <output archive>\n", programName);
+	fprintf(stderr, "  -c            Compress entries with LZ4 when it reduces their size\n");
+	fprintf(stderr, "  -a alignment  Align entry data to a power of two number of bytes (default %u, max 256)\n", format::DefaultAlignment);
+}
+
+}
+
+int main(int argc, char **argv)
+{
+	bool compress = false;
+	unsigned long int alignment = format::DefaultAlignment;
+	const char *inputDirectory = nullptr;
+	const char *outputFilename = nullptr;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-c") == 0)
+			compress = true;
+		else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc)
+			alignment = strtoul(argv[++i], nullptr, 10);
+		else if (inputDirectory == nullptr)
+			inputDirectory = argv[i];
+		else if (outputFilename == nullptr)
+			outputFilename = argv[i];
+		else
+		{
+			printUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (inputDirectory == nullptr || outputFilename == nullptr ||
+	    alignment == 0 || alignment > 256 || (alignment & (alignment - 1)) != 0)
+	{
+		printUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (fs::isDirectory(inputDirectory) == false)
+	{
+		fprintf(stderr, "Cannot find the input directory \"%s\"\n", inputDirectory);
+		return EXIT_FAILURE;
+	}
+
+	packer::PackStats stats;
+	if (packer::pack(inputDirectory, outputFilename, compress, alignment, stats) == false)
+		return EXIT_FAILURE;
+
+	printf("Packed %u files in \"%s\" (%lu bytes, %lu stored)\n", stats.numEntries, outputFilename, stats.totalSize, stats.totalStoredSize);
+	return EXIT_SUCCESS;
+}
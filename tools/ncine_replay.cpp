@@ -0,0 +1,336 @@
+/// Replays render queue captures through the sorting and batching rules of the engine
+/*! Usage: ncine_replay [-v] [-n iterations] [-b min:max] [-r window] [-x] <capture file> */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ncine/TimeStamp.h>
+#include <ncine/Rect.h>
+#include <nctl/Array.h>
+#include <nctl/UniquePtr.h>
+#include <nctl/algorithms.h>
+#include "RenderCaptureFormat.h"
+#include "RenderQueueRules.h"
+
+namespace format = ncine::RenderCaptureFormat;
+namespace rules = ncine::RenderQueueRules;
+
+namespace {
+
+struct Queue
+{
+	const format::Queue *header;
+	/// The commands in the order they were collected, opaques first
+	nctl::Array<const format::Command *> commands;
+};
+
+/// A draw call issued by the replayed queue, either a single command or a batch of consecutive sorted commands
+struct DrawCall
+{
+	unsigned int first;
+	unsigned int count;
+	bool isBatch;
+};
+
+struct Settings
+{
+	bool overrideBatchSize = false;
+	unsigned int minBatchSize = 0;
+	unsigned int maxBatchSize = 0;
+	bool disableBatching = false;
+	bool overrideReorderingWindowSize = false;
+	unsigned int reorderingWindowSize = 0;
+};
+
+struct Totals
+{
+	unsigned long int commands = 0;
+	unsigned long int drawCalls = 0;
+	unsigned long int batches = 0;
+	unsigned long int batchedCommands = 0;
+	unsigned long int reorderedCommands = 0;
+	uint64_t checksum = 0xcbf29ce484222325ULL;
+};
+
+bool opaqueOrder(const format::Command *a, const format::Command *b)
+{
+	return rules::opaqueOrder(a->materialSortKey, a->idSortKey, b->materialSortKey, b->idSortKey);
+}
+
+bool transparentOrder(const format::Command *a, const format::Command *b)
+{
+	return rules::transparentOrder(a->materialSortKey, a->idSortKey, b->materialSortKey, b->idSortKey);
+}
+
+/// Exposes the captured commands to the batching rules
+struct CommandTraits
+{
+	static inline uint32_t lowerMaterialSortKey(const format::Command *command) { return static_cast<uint32_t>(command->materialSortKey); }
+	static inline unsigned int primitiveType(const format::Command *command) { return command->primitiveType; }
+	static inline bool hasCustomVbo(const format::Command *command) { return (command->flags & format::CommandFlags::CUSTOM_VBO) != 0; }
+	static inline bool isBatchable(const format::Command *command) { return command->batchedShaderId != 0; }
+	static inline unsigned int numVertices(const format::Command *command) { return command->numVertices; }
+	static inline unsigned int numIndices(const format::Command *command) { return command->numIndices; }
+	static inline unsigned int numElementsPerVertex(const format::Command *command) { return command->numElementsPerVertex; }
+	static inline bool hasAabb(const format::Command *command) { return (command->flags & format::CommandFlags::AABB) != 0; }
+	static inline ncine::Rectf aabb(const format::Command *command) { return ncine::Rectf(command->aabb[0], command->aabb[1], command->aabb[2], command->aabb[3]); }
+};
+
+void hashValue(uint64_t &hash, uint64_t value)
+{
+	for (unsigned int i = 0; i < sizeof(uint64_t); i++)
+	{
+		hash ^= (value >> (i * 8)) & 0xff;
+		hash *= 0x100000001b3ULL;
+	}
+}
+
+/// Returns how many commands from `start` are collected by a batch, with the same limits of `RenderBatcher::collectCommands()`
+unsigned int collectCommands(const nctl::Array<const format::Command *> &queue, unsigned int start, unsigned int end,
+                             uint32_t uboMaxSize, const format::Queue &header)
+{
+	const format::Command *refCommand = queue[start];
+	// Sprites without a texture, and without a texture rectangle, have a smaller compact layout
+	const unsigned int instanceBlockStride = (refCommand->flags & format::CommandFlags::COMPACT_INSTANCES)
+	                                             ? rules::compactInstanceStride(refCommand->textureId != 0)
+	                                             : rules::instanceBlockStride(refCommand->instanceBlockSize);
+
+	rules::BatchLimits limits;
+	limits.uboMaxSize = uboMaxSize;
+	limits.instancesBlockMaxSize = refCommand->batchedInstancesBlockSize;
+	limits.nonInstancesSize = refCommand->nonInstanceUniformsSize;
+	limits.maxVertexDataSize = header.maxVertexDataSize;
+	limits.maxIndexDataSize = header.maxIndexDataSize;
+
+	const bool refShaderHasAttributes = (refCommand->flags & format::CommandFlags::SHADER_ATTRIBUTES) != 0;
+	const rules::BatchSizes sizes = rules::collectBatch<CommandTraits>(queue.begin() + start, queue.begin() + end, header.batchingWithIndices != 0,
+	                                                                   instanceBlockStride, refShaderHasAttributes, limits);
+	return sizes.numCommands;
+}
+
+/// Splits a sorted queue in draw calls with the same rules of `RenderBatcher::createBatches()`
+void createBatches(const nctl::Array<const format::Command *> &queue, const format::Queue &header,
+                   const Settings &settings, uint32_t uboMaxSize, nctl::Array<DrawCall> &drawCalls)
+{
+	unsigned int maxBatchSize = settings.overrideBatchSize ? settings.maxBatchSize : header.maxBatchSize;
+	unsigned int minBatchSize = settings.overrideBatchSize ? settings.minBatchSize : header.minBatchSize;
+	rules::validateBatchSizes(minBatchSize, maxBatchSize);
+
+	rules::createBatches<CommandTraits>(
+	    queue.data(), queue.size(), minBatchSize, maxBatchSize,
+	    [&](unsigned int start, unsigned int end) {
+		    const unsigned int count = collectCommands(queue, start, end, uboMaxSize, header);
+		    if (count > 0)
+			    drawCalls.pushBack({ start, count, true });
+		    return count;
+	    },
+	    [&drawCalls](unsigned int index) { drawCalls.pushBack({ index, 1, false }); });
+}
+
+/// Sorts, reorders and batches one of the two queues, then accumulates its draw calls in the totals
+void replayQueue(nctl::Array<const format::Command *> &queue, bool transparent, const format::Queue &header, const Settings &settings,
+                 uint32_t uboMaxSize, nctl::Array<DrawCall> &drawCalls, Totals *totals)
+{
+	nctl::quicksort(queue.begin(), queue.end(), transparent ? transparentOrder : opaqueOrder);
+
+	unsigned int numReorderedCommands = 0;
+	const bool reorderingEnabled = settings.overrideReorderingWindowSize || header.reorderingEnabled != 0;
+	if (transparent && reorderingEnabled)
+	{
+		const unsigned int windowSize = settings.overrideReorderingWindowSize ? settings.reorderingWindowSize : header.reorderingWindowSize;
+		numReorderedCommands = rules::reorderTransparents<CommandTraits>(queue.data(), queue.size(), windowSize);
+	}
+
+	drawCalls.clear();
+	const bool batchingEnabled = header.batchingEnabled != 0 && settings.disableBatching == false;
+	if (batchingEnabled)
+		createBatches(queue, header, settings, uboMaxSize, drawCalls);
+	else
+	{
+		for (unsigned int i = 0; i < queue.size(); i++)
+			drawCalls.pushBack({ i, 1, false });
+	}
+
+	if (totals == nullptr)
+		return;
+
+	totals->commands += queue.size();
+	totals->reorderedCommands += numReorderedCommands;
+	totals->drawCalls += drawCalls.size();
+	for (const DrawCall &drawCall : drawCalls)
+	{
+		if (drawCall.isBatch)
+		{
+			totals->batches++;
+			totals->batchedCommands += drawCall.count;
+		}
+		// The checksum covers the draw order and the batch boundaries
+		hashValue(totals->checksum, (static_cast<uint64_t>(queue[drawCall.first]->idSortKey) << 32) | drawCall.count);
+		hashValue(totals->checksum, queue[drawCall.first]->materialSortKey);
+	}
+}
+
+bool parseCapture(const unsigned char *data, unsigned long int size, nctl::Array<Queue> &queues)
+{
+	unsigned long int offset = sizeof(format::Header);
+	while (offset + sizeof(format::Queue) <= size)
+	{
+		queues.emplaceBack();
+		Queue &queue = queues.back();
+		queue.header = reinterpret_cast<const format::Queue *>(data + offset);
+		offset += sizeof(format::Queue);
+
+		const unsigned int numCommands = queue.header->numOpaques + queue.header->numTransparents;
+		queue.commands.setCapacity(numCommands);
+		for (unsigned int i = 0; i < numCommands; i++)
+		{
+			if (offset + sizeof(format::Command) > size)
+				return false;
+			const format::Command *command = reinterpret_cast<const format::Command *>(data + offset);
+			offset += sizeof(format::Command) + format::paddedBlockSize(command->instanceBlockSize);
+			if (offset > size)
+				return false;
+			queue.commands.pushBack(command);
+		}
+	}
+
+	return (offset == size);
+}
+
+void printUsage(const char *programName)
+{
+	fprintf(stderr, "Usage: %s [-v] [-n iterations] [-b min:max] [-r window] [-x] <capture file>\n", programName);
+	fprintf(stderr, "  -v             Print the draw calls of every captured queue\n");
+	fprintf(stderr, "  -n iterations  Replay the capture a number of times to measure the sorting and batching time\n");
+	fprintf(stderr, "  -b min:max     Override the captured minimum and maximum batch sizes\n");
+	fprintf(stderr, "  -r window      Override the captured reordering window size, zero disables reordering\n");
+	fprintf(stderr, "  -x             Disable batching\n");
+}
+
+}
+
+int main(int argc, char **argv)
+{
+	bool verbose = false;
+	unsigned long int numIterations = 1;
+	Settings settings;
+	const char *inputFilename = nullptr;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-v") == 0)
+			verbose = true;
+		else if (strcmp(argv[i], "-x") == 0)
+			settings.disableBatching = true;
+		else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+		{
+			settings.overrideReorderingWindowSize = true;
+			settings.reorderingWindowSize = strtoul(argv[++i], nullptr, 10);
+		}
+		else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+			numIterations = strtoul(argv[++i], nullptr, 10);
+		else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+		{
+			settings.overrideBatchSize = (sscanf(argv[++i], "%u:%u", &settings.minBatchSize, &settings.maxBatchSize) == 2);
+			if (settings.overrideBatchSize == false)
+			{
+				printUsage(argv[0]);
+				return EXIT_FAILURE;
+			}
+		}
+		else if (inputFilename == nullptr)
+			inputFilename = argv[i];
+		else
+		{
+			printUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (inputFilename == nullptr || numIterations == 0)
+	{
+		printUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	FILE *fp = fopen(inputFilename, "rb");
+	if (fp == nullptr)
+	{
+		fprintf(stderr, "Cannot open the capture \"%s\"\n", inputFilename);
+		return EXIT_FAILURE;
+	}
+	fseek(fp, 0, SEEK_END);
+	const long int fileSize = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	// Command records are read in place, the buffer is allocated as 64 bits words to keep them aligned
+	const unsigned long int size = (fileSize > 0) ? static_cast<unsigned long int>(fileSize) : 0;
+	nctl::UniquePtr<uint64_t[]> buffer = nctl::makeUnique<uint64_t[]>(size / sizeof(uint64_t) + 1);
+	const unsigned char *data = reinterpret_cast<const unsigned char *>(buffer.get());
+	const bool readSuccess = (fread(buffer.get(), 1, size, fp) == size);
+	fclose(fp);
+
+	format::Header header;
+	if (readSuccess == false || size < sizeof(format::Header))
+	{
+		fprintf(stderr, "Cannot read the capture \"%s\"\n", inputFilename);
+		return EXIT_FAILURE;
+	}
+	memcpy(&header, data, sizeof(format::Header));
+	if (memcmp(header.signature, format::Signature, sizeof(format::Signature)) != 0 || header.version != format::Version)
+	{
+		fprintf(stderr, "The file \"%s\" is not a supported render capture\n", inputFilename);
+		return EXIT_FAILURE;
+	}
+
+	nctl::Array<Queue> queues;
+	if (parseCapture(data, size, queues) == false)
+		fprintf(stderr, "The capture \"%s\" is truncated, only complete queues are replayed\n", inputFilename);
+	if (queues.isEmpty() == false && queues.back().commands.size() < queues.back().header->numOpaques + queues.back().header->numTransparents)
+		queues.popBack();
+
+	nctl::Array<const format::Command *> opaques;
+	nctl::Array<const format::Command *> transparents;
+	nctl::Array<DrawCall> drawCalls;
+	Totals totals;
+	double elapsedMicroseconds = 0.0;
+
+	for (unsigned long int iteration = 0; iteration < numIterations; iteration++)
+	{
+		// Statistics and the checksum are only collected in the first iteration
+		Totals *iterationTotals = (iteration == 0) ? &totals : nullptr;
+		for (unsigned int i = 0; i < queues.size(); i++)
+		{
+			const Queue &queue = queues[i];
+			opaques.clear();
+			transparents.clear();
+			for (unsigned int j = 0; j < queue.header->numOpaques; j++)
+				opaques.pushBack(queue.commands[j]);
+			for (unsigned int j = queue.header->numOpaques; j < queue.commands.size(); j++)
+				transparents.pushBack(queue.commands[j]);
+
+			const ncine::TimeStamp startTime = ncine::TimeStamp::now();
+			replayQueue(opaques, false, *queue.header, settings, header.uboMaxSize, drawCalls, iterationTotals);
+			const unsigned int numOpaqueDrawCalls = drawCalls.size();
+			replayQueue(transparents, true, *queue.header, settings, header.uboMaxSize, drawCalls, iterationTotals);
+			elapsedMicroseconds += startTime.microsecondsDoubleSince();
+
+			if (verbose && iteration == 0)
+			{
+				printf("Frame %u, viewport %u: %u opaque and %u transparent commands, %u + %u draw calls\n",
+				       queue.header->frame, queue.header->viewportId, queue.header->numOpaques, queue.header->numTransparents,
+				       numOpaqueDrawCalls, drawCalls.size());
+			}
+		}
+	}
+
+	const unsigned int numFrames = queues.isEmpty() ? 0 : queues.back().header->frame + 1;
+	printf("Replayed %u queues from %u frames: %lu commands in %lu draw calls\n", queues.size(), numFrames, totals.commands, totals.drawCalls);
+	printf("Batches: %lu collecting %lu commands\n", totals.batches, totals.batchedCommands);
+	printf("Reordered transparent commands: %lu\n", totals.reorderedCommands);
+	printf("Checksum: %016llx\n", static_cast<unsigned long long>(totals.checksum));
+	if (queues.isEmpty() == false)
+		printf("Sorting and batching: %.3f us per queue\n", elapsedMicroseconds / (numIterations * queues.size()));
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+#include "gtest_allocators.h"
+#include <nctl/Array.h>
+
+namespace {
+
+class AllocatorFrameTest : public ::testing::Test
+{
+  public:
+	AllocatorFrameTest()
+	    : allocator_(BufferSize, &buffer_, fallback_) {}
+
+  protected:
+	uint8_t buffer_[BufferSize];
+	nctl::MallocAllocator fallback_;
+	nctl::FrameAllocator allocator_;
+};
+
+const size_t Bytes = NumElements * ElementSize;
+
+TEST_F(AllocatorFrameTest, DefaultConstructor)
+{
+	nctl::FrameAllocator allocator;
+	allocator.init(BufferSize, &buffer_, fallback_);
+
+	printf("Allocating from a FrameAllocator not initialized in the constructor\n");
+	ElementType *ptr = reinterpret_cast<ElementType *>(allocator.allocate(ElementSize));
+	ASSERT_NE(ptr, nullptr);
+	ASSERT_EQ(allocator.numAllocations(), 1);
+	ASSERT_EQ(allocator.fallback(), &fallback_);
+
+	printf("Clearing the FrameAllocator\n");
+	allocator.clear();
+	ASSERT_EQ(allocator.numAllocations(), 0);
+	ASSERT_EQ(allocator.usedMemory(), 0);
+}
+
+TEST_F(AllocatorFrameTest, AllocateDeallocate)
+{
+	printf("Allocating %lu bytes for %d elements with the FrameAllocator\n", Bytes, NumElements);
+	ElementType *ptr = reinterpret_cast<ElementType *>(allocator_.allocate(Bytes));
+	ASSERT_NE(ptr, nullptr);
+	ASSERT_EQ(allocator_.numAllocations(), 1);
+	ASSERT_GE(allocator_.usedMemory(), Bytes);
+	ASSERT_LE(allocator_.usedMemory(), Bytes + nctl::IAllocator::DefaultAlignment);
+
+	printf("Filling the memory with %d integers\n", NumElements);
+	fillElements(ptr, NumElements);
+
+	printf("Deallocating does not free arena memory\n");
+	allocator_.deallocate(ptr);
+	ASSERT_EQ(allocator_.numAllocations(), 1);
+	ASSERT_GE(allocator_.usedMemory(), Bytes);
+	ASSERT_EQ(fallback_.numAllocations(), 0);
+}
+
+TEST_F(AllocatorFrameTest, SurviveNextFrame)
+{
+	ElementType *ptr = reinterpret_cast<ElementType *>(allocator_.allocate(Bytes));
+	ASSERT_NE(ptr, nullptr);
+	fillElements(ptr, NumElements);
+
+	printf("Starting a new frame, the allocations of the previous one are still valid\n");
+	allocator_.nextFrame();
+	ASSERT_EQ(allocator_.numAllocations(), 1);
+	ASSERT_GE(allocator_.usedMemory(), Bytes);
+	ASSERT_EQ(allocator_.lastFrameUsedMemory(), allocator_.usedMemory());
+	for (unsigned int i = 0; i < NumElements; i++)
+		ASSERT_EQ(ptr[i].a, i);
+
+	ElementType *newPtr = reinterpret_cast<ElementType *>(allocator_.allocate(Bytes));
+	ASSERT_NE(newPtr, nullptr);
+	ASSERT_NE(newPtr, ptr);
+	ASSERT_EQ(allocator_.numAllocations(), 2);
+
+	printf("Starting another frame, the allocations of two frames ago are lost\n");
+	allocator_.nextFrame();
+	ASSERT_EQ(allocator_.numAllocations(), 1);
+	ASSERT_GE(allocator_.usedMemory(), Bytes);
+	ASSERT_LE(allocator_.usedMemory(), Bytes + nctl::IAllocator::DefaultAlignment);
+
+	ElementType *reusedPtr = reinterpret_cast<ElementType *>(allocator_.allocate(Bytes));
+	ASSERT_EQ(reusedPtr, ptr);
+}
+
+TEST_F(AllocatorFrameTest, Fallback)
+{
+	const size_t HalfBytes = BufferSize / 2;
+	printf("Allocating more than half of the FrameAllocator buffer (%lu bytes)\n", HalfBytes + 1);
+	void *ptr = allocator_.allocate(HalfBytes + 1);
+	ASSERT_NE(ptr, nullptr);
+	ASSERT_EQ(allocator_.numAllocations(), 0);
+	ASSERT_EQ(allocator_.usedMemory(), 0);
+	ASSERT_EQ(allocator_.numFallbacks(), 1);
+	ASSERT_EQ(fallback_.numAllocations(), 1);
+
+	allocator_.nextFrame();
+	ASSERT_EQ(allocator_.numFallbacks(), 0);
+	ASSERT_EQ(allocator_.lastFrameNumFallbacks(), 1);
+
+	printf("Deallocating the fallback allocation\n");
+	allocator_.deallocate(ptr);
+	ASSERT_EQ(fallback_.numAllocations(), 0);
+}
+
+TEST_F(AllocatorFrameTest, HighWaterMark)
+{
+	allocator_.allocate(Bytes);
+	allocator_.allocate(Bytes / 2);
+	const size_t firstFrameUsedMemory = allocator_.usedMemory();
+	allocator_.nextFrame();
+	allocator_.allocate(Bytes / 2);
+	allocator_.nextFrame();
+
+	printf("High water mark: %lu bytes\n", allocator_.highWaterMark());
+	ASSERT_EQ(allocator_.highWaterMark(), firstFrameUsedMemory);
+	ASSERT_LT(allocator_.lastFrameUsedMemory(), firstFrameUsedMemory);
+
+	allocator_.resetHighWaterMark();
+	ASSERT_EQ(allocator_.highWaterMark(), 0);
+}
+
+TEST_F(AllocatorFrameTest, ReallocateInPlace)
+{
+	void *ptr = allocator_.allocate(Bytes / 2);
+	ASSERT_NE(ptr, nullptr);
+
+	printf("Growing the last allocation of the frame in place\n");
+	void *newPtr = allocator_.reallocate(ptr, Bytes);
+	ASSERT_EQ(newPtr, ptr);
+	ASSERT_EQ(allocator_.numAllocations(), 1);
+	ASSERT_GE(allocator_.usedMemory(), Bytes);
+
+	printf("Allocations of the previous frame cannot be resized\n");
+	allocator_.nextFrame();
+	newPtr = allocator_.reallocate(ptr, Bytes + ElementSize);
+	ASSERT_EQ(newPtr, nullptr);
+}
+
+TEST_F(AllocatorFrameTest, GrowArray)
+{
+	const unsigned int Size = BufferSize;
+	printf("Growing an array with the FrameAllocator beyond its buffer\n");
+	{
+		nctl::Array<int> array(4, allocator_);
+		for (unsigned int i = 0; i < Size; i++)
+			array.pushBack(static_cast<int>(i));
+
+		ASSERT_EQ(array.size(), Size);
+		for (unsigned int i = 0; i < Size; i++)
+			ASSERT_EQ(array[i], static_cast<int>(i));
+		ASSERT_GT(allocator_.numFallbacks(), 0);
+	}
+	ASSERT_EQ(fallback_.numAllocations(), 0);
+}
+
+}
@@ -112,7 +112,6 @@ TEST_F(AllocatorLinearTest, AllocateTooMuch)
 	ASSERT_EQ(ptr, nullptr);
 }
 
-/*
 TEST_F(AllocatorLinearTest, ReallocateShrink)
 {
 	const size_t Bytes = NumElements * ElementSize;
@@ -170,6 +169,5 @@ TEST_F(AllocatorLinearTest, ReallocateTooMuch)
 	printf("Clearing the LinearAllocator\n");
 	allocator_.clear();
 }
-*/
 
 }
@@ -0,0 +1,152 @@
+#include "gtest_allocators.h"
+#include <nctl/AllocTelemetry.h>
+#include <ncine/FileSystem.h>
+#include <ncine/IFile.h>
+
+namespace {
+
+const char *CsvFilename = "gtest_allocator_telemetry.csv";
+
+class AllocatorTelemetryTest : public ::testing::Test
+{
+  public:
+	AllocatorTelemetryTest()
+	    : freelist_(BufferSize, &buffer_) {}
+
+  protected:
+	void SetUp() override
+	{
+		telemetry_.add(malloc_);
+		telemetry_.add(freelist_);
+	}
+
+	uint8_t buffer_[BufferSize];
+	nctl::MallocAllocator malloc_;
+	nctl::FreeListAllocator freelist_;
+	nctl::AllocTelemetry telemetry_;
+};
+
+TEST_F(AllocatorTelemetryTest, AddRemove)
+{
+	printf("Tracking %u allocators\n", telemetry_.numEntries());
+	ASSERT_EQ(telemetry_.numEntries(), 2);
+	ASSERT_FALSE(telemetry_.add(malloc_));
+	ASSERT_EQ(telemetry_.numEntries(), 2);
+
+	const nctl::AllocTelemetry::Entry *entry = telemetry_.find(freelist_);
+	ASSERT_NE(entry, nullptr);
+	ASSERT_EQ(entry->allocator, &freelist_);
+	ASSERT_EQ(entry->freeList, &freelist_);
+	ASSERT_EQ(telemetry_.find(malloc_)->freeList, nullptr);
+
+	printf("Removing an allocator from the telemetry\n");
+	ASSERT_TRUE(telemetry_.remove(malloc_));
+	ASSERT_FALSE(telemetry_.remove(malloc_));
+	ASSERT_EQ(telemetry_.numEntries(), 1);
+	ASSERT_EQ(telemetry_.find(malloc_), nullptr);
+}
+
+TEST_F(AllocatorTelemetryTest, PeakAndRate)
+{
+	void *pointers[NumElements];
+	for (unsigned int i = 0; i < NumElements; i++)
+		pointers[i] = malloc_.allocate(ElementSize);
+	const size_t usedMemory = malloc_.usedMemory();
+	for (unsigned int i = 0; i < NumElements; i++)
+		malloc_.deallocate(pointers[i]);
+
+	printf("Sampling a frame with %u allocations\n", NumElements);
+	telemetry_.update();
+	const nctl::AllocTelemetry::Entry *entry = telemetry_.find(malloc_);
+	ASSERT_EQ(entry->numFrameAllocations, NumElements);
+	ASSERT_EQ(entry->framePeakMemory, usedMemory);
+	ASSERT_EQ(entry->peakMemory, usedMemory);
+	ASSERT_EQ(malloc_.usedMemory(), 0);
+
+	printf("Sampling a frame without allocations\n");
+	telemetry_.update();
+	ASSERT_EQ(entry->numFrameAllocations, 0);
+	ASSERT_EQ(entry->framePeakMemory, 0);
+	ASSERT_EQ(entry->peakMemory, usedMemory);
+	ASSERT_EQ(telemetry_.numFrames(), 2);
+
+	telemetry_.resetPeaks();
+	ASSERT_EQ(entry->peakMemory, 0);
+}
+
+TEST_F(AllocatorTelemetryTest, Fragmentation)
+{
+	freelist_.setDefragOnDeallocation(true);
+	void *pointers[NumElements / 2];
+	for (unsigned int i = 0; i < NumElements / 2; i++)
+		pointers[i] = freelist_.allocate(ElementSize);
+
+	telemetry_.update();
+	const nctl::AllocTelemetry::Entry *entry = telemetry_.find(freelist_);
+	printf("Fragmentation with a single free block: %.2f\n", entry->fragmentation);
+	ASSERT_FLOAT_EQ(entry->fragmentation, 0.0f);
+
+	for (unsigned int i = 0; i < NumElements / 2; i += 2)
+		freelist_.deallocate(pointers[i]);
+	telemetry_.update();
+	printf("Fragmentation after freeing every other allocation: %.2f\n", entry->fragmentation);
+	ASSERT_GT(entry->fragmentation, 0.0f);
+	ASSERT_LT(entry->fragmentation, 1.0f);
+
+	for (unsigned int i = 1; i < NumElements / 2; i += 2)
+		freelist_.deallocate(pointers[i]);
+	telemetry_.update();
+	ASSERT_FLOAT_EQ(entry->fragmentation, 0.0f);
+}
+
+TEST_F(AllocatorTelemetryTest, Budget)
+{
+	ASSERT_FALSE(telemetry_.setBudget(nctl::theDefaultAllocator(), ElementSize));
+	ASSERT_TRUE(telemetry_.setBudget(malloc_, ElementSize));
+	const nctl::AllocTelemetry::Entry *entry = telemetry_.find(malloc_);
+	ASSERT_EQ(entry->budget, ElementSize);
+	ASSERT_EQ(entry->budgetPolicy, nctl::AllocTelemetry::BudgetPolicy::LOG);
+
+	printf("Exceeding the budget of %lu bytes\n", ElementSize);
+	void *ptr = malloc_.allocate(ElementSize * 2);
+	telemetry_.update();
+	ASSERT_TRUE(entry->isOverBudget);
+
+	printf("Going back under budget, the frame peak still includes the deallocated memory\n");
+	malloc_.deallocate(ptr);
+	telemetry_.update();
+	ASSERT_TRUE(entry->isOverBudget);
+	telemetry_.update();
+	ASSERT_FALSE(entry->isOverBudget);
+}
+
+TEST_F(AllocatorTelemetryTest, CsvRecording)
+{
+	ASSERT_FALSE(telemetry_.isRecordingCsv());
+	ASSERT_TRUE(telemetry_.startCsvRecording(CsvFilename));
+	ASSERT_TRUE(telemetry_.isRecordingCsv());
+
+	const unsigned int NumFrames = 3;
+	printf("Recording %u frames to a CSV file\n", NumFrames);
+	for (unsigned int i = 0; i < NumFrames; i++)
+		telemetry_.update();
+	telemetry_.stopCsvRecording();
+	ASSERT_FALSE(telemetry_.isRecordingCsv());
+
+	nctl::UniquePtr<ncine::IFile> file = ncine::IFile::createFileHandle(CsvFilename);
+	file->open(ncine::IFile::OpenMode::READ);
+	ASSERT_TRUE(file->isOpened());
+	char contents[4096];
+	const unsigned long int bytesRead = file->read(contents, sizeof(contents) - 1);
+	contents[bytesRead] = '\0';
+	file->close();
+	ncine::fs::deleteFile(CsvFilename);
+
+	unsigned int numLines = 0;
+	for (unsigned long int i = 0; i < bytesRead; i++)
+		numLines += (contents[i] == '\n') ? 1 : 0;
+	ASSERT_EQ(numLines, 1 + NumFrames * telemetry_.numEntries());
+	ASSERT_EQ(strncmp(contents, "frame,", 6), 0);
+}
+
+}
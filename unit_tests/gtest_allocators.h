@@ -7,6 +7,7 @@
 #include <nctl/PoolAllocator.h>
 #include <nctl/FreeListAllocator.h>
 #include <nctl/ProxyAllocator.h>
+#include <nctl/FrameAllocator.h>
 #include "gtest/gtest.h"
 
 namespace {
@@ -0,0 +1,116 @@
+#include "gtest_array.h"
+#include <nctl/UniquePtr.h>
+#include <nctl/SharedPtr.h>
+#include <nctl/String.h>
+
+namespace {
+
+static_assert(nctl::isTriviallyRelocatable<int>::value, "Trivially copyable types are relocatable");
+static_assert(nctl::isTriviallyRelocatable<nctl::UniquePtr<int>>::value, "Unique pointers are relocatable");
+static_assert(nctl::isTriviallyRelocatable<nctl::UniquePtr<int[]>>::value, "Unique pointers to arrays are relocatable");
+static_assert(nctl::isTriviallyRelocatable<nctl::SharedPtr<int>>::value, "Shared pointers are relocatable");
+static_assert(nctl::isTriviallyRelocatable<nctl::String>::value, "Strings are relocatable");
+static_assert(nctl::isTriviallyRelocatable<nctl::Array<nctl::String>>::value, "Arrays are relocatable");
+
+using UniqueArray = nctl::Array<nctl::UniquePtr<int>>;
+
+void initUniqueArray(UniqueArray &array, unsigned int size)
+{
+	for (unsigned int i = 0; i < size; i++)
+		array.pushBack(nctl::makeUnique<int>(i));
+}
+
+void assertUniqueArrayIsSequence(const UniqueArray &array, unsigned int size)
+{
+	ASSERT_EQ(array.size(), size);
+	for (unsigned int i = 0; i < size; i++)
+	{
+		ASSERT_NE(array[i].get(), nullptr);
+		ASSERT_EQ(*array[i], static_cast<int>(i));
+	}
+}
+
+TEST(ArrayRelocatableTest, GrowUniquePtr)
+{
+	printf("Growing an array of unique pointers from zero capacity\n");
+	UniqueArray array;
+	initUniqueArray(array, Capacity * 4);
+
+	assertUniqueArrayIsSequence(array, Capacity * 4);
+}
+
+TEST(ArrayRelocatableTest, ShrinkUniquePtr)
+{
+	UniqueArray array(Capacity);
+	initUniqueArray(array, Capacity);
+	printf("Shrinking an array of unique pointers below its size\n");
+	array.setCapacity(Capacity / 2);
+
+	assertUniqueArrayIsSequence(array, Capacity / 2);
+}
+
+TEST(ArrayRelocatableTest, InsertUniquePtr)
+{
+	UniqueArray array(Capacity);
+	initUniqueArray(array, Capacity);
+	printf("Inserting a unique pointer at the front and in the middle\n");
+	array.insertAt(0, nctl::makeUnique<int>(-1));
+	array.emplaceAt(Capacity / 2, nctl::makeUnique<int>(-2).release());
+
+	ASSERT_EQ(array.size(), Capacity + 2);
+	ASSERT_EQ(*array[0], -1);
+	ASSERT_EQ(*array[Capacity / 2], -2);
+	ASSERT_EQ(*array[1], 0);
+	ASSERT_EQ(*array[Capacity + 1], static_cast<int>(Capacity - 1));
+}
+
+TEST(ArrayRelocatableTest, RemoveUniquePtr)
+{
+	UniqueArray array(Capacity);
+	initUniqueArray(array, Capacity);
+	printf("Removing the first half of an array of unique pointers\n");
+	array.removeRange(0, Capacity / 2);
+
+	ASSERT_EQ(array.size(), Capacity / 2);
+	for (unsigned int i = 0; i < array.size(); i++)
+		ASSERT_EQ(*array[i], static_cast<int>(i + Capacity / 2));
+}
+
+TEST(ArrayRelocatableTest, InsertRemoveSharedPtr)
+{
+	nctl::SharedPtr<int> shared = nctl::makeShared<int>();
+	*shared = 1;
+
+	nctl::Array<nctl::SharedPtr<int>> array(Capacity);
+	for (unsigned int i = 0; i < Capacity; i++)
+		array.pushBack(shared);
+	ASSERT_EQ(shared.useCount(), static_cast<int>(Capacity + 1));
+
+	printf("Inserting and removing shared pointers without changing the counter more than needed\n");
+	array.insertAt(0, shared);
+	array.setCapacity(Capacity * 4);
+	ASSERT_EQ(shared.useCount(), static_cast<int>(Capacity + 2));
+	array.removeRange(0, Capacity / 2);
+	ASSERT_EQ(shared.useCount(), static_cast<int>(Capacity / 2 + 2));
+	array.clear();
+	ASSERT_EQ(shared.useCount(), 1);
+}
+
+TEST(ArrayRelocatableTest, GrowAndRemoveString)
+{
+	const char *longString = "A string too long for the local buffer";
+
+	nctl::Array<nctl::String> array;
+	for (unsigned int i = 0; i < Capacity; i++)
+		array.pushBack((i % 2) ? nctl::String(longString) : nctl::String("short"));
+	printf("Inserting and removing both local and heap strings\n");
+	array.insertAt(1, nctl::String("inserted"));
+	array.removeAt(0);
+
+	ASSERT_EQ(array.size(), Capacity);
+	ASSERT_STREQ(array[0].data(), "inserted");
+	for (unsigned int i = 1; i < Capacity; i++)
+		ASSERT_STREQ(array[i].data(), (i % 2) ? longString : "short");
+}
+
+}
@@ -0,0 +1,182 @@
+#include <ncine/AssetArchive.h>
+#include <ncine/FileSystem.h>
+#include <ncine/IFile.h>
+#include "AssetArchivePacker.h"
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const char *InputDirectory = "TestArchiveDir";
+const char *ArchiveName = "TestArchive.pak";
+const char *MountPoint = "TestMount";
+
+const char *TextEntry = "text.txt";
+const char *TextContents = "An entry stored in an asset archive";
+const char *RepeatedEntry = "data/repeated.bin";
+const unsigned int RepeatedSize = 4096;
+const char *SequenceEntry = "data/sequence.bin";
+const unsigned int SequenceSize = 256;
+
+void writeFile(const char *directory, const char *name, const unsigned char *data, unsigned long int size)
+{
+	const nctl::String path = nc::fs::joinPath(directory, name);
+	nctl::UniquePtr<nc::IFile> file = nc::IFile::createFileHandle(path.data());
+	file->open(nc::IFile::OpenMode::WRITE | nc::IFile::OpenMode::BINARY);
+	file->write(data, size);
+	file->close();
+}
+
+unsigned char repeatedByte(unsigned int index)
+{
+	return static_cast<unsigned char>("nCine"[index % 5]);
+}
+
+nctl::String readEntry(const nc::AssetArchive &archive, const char *name)
+{
+	const int index = archive.findEntry(name);
+	if (index < 0)
+		return nctl::String();
+
+	const unsigned long int size = archive.entrySize(index);
+	nctl::String contents(size + 1);
+	nctl::UniquePtr<nc::IFile> file = archive.openEntry(index, name);
+	file->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+	const unsigned long int bytesRead = file->read(contents.data(), size);
+	contents.data()[bytesRead] = '\0';
+	contents.setLength(bytesRead);
+	return contents;
+}
+
+class AssetArchiveTest : public ::testing::Test
+{
+  protected:
+	void SetUp() override
+	{
+		const nctl::String dataDirectory = nc::fs::joinPath(InputDirectory, "data");
+		nc::fs::createDir(InputDirectory);
+		nc::fs::createDir(dataDirectory.data());
+
+		unsigned char repeated[RepeatedSize];
+		for (unsigned int i = 0; i < RepeatedSize; i++)
+			repeated[i] = repeatedByte(i);
+		unsigned char sequence[SequenceSize];
+		for (unsigned int i = 0; i < SequenceSize; i++)
+			sequence[i] = static_cast<unsigned char>(i);
+
+		writeFile(InputDirectory, TextEntry, reinterpret_cast<const unsigned char *>(TextContents), strlen(TextContents));
+		writeFile(InputDirectory, RepeatedEntry, repeated, RepeatedSize);
+		writeFile(InputDirectory, SequenceEntry, sequence, SequenceSize);
+
+		nc::AssetArchivePacker::PackStats stats;
+		const bool packed = nc::AssetArchivePacker::pack(InputDirectory, ArchiveName, true, nc::AssetArchiveFormat::DefaultAlignment, stats);
+		printf("Packed %u files (%lu bytes, %lu stored)\n", stats.numEntries, stats.totalSize, stats.totalStoredSize);
+		ASSERT_TRUE(packed);
+
+		archive_ = nctl::makeUnique<nc::AssetArchive>(ArchiveName);
+	}
+
+	void TearDown() override
+	{
+		archive_.reset(nullptr);
+		nc::fs::deleteFile(ArchiveName);
+		nc::fs::deleteFile(nc::fs::joinPath(InputDirectory, TextEntry).data());
+		nc::fs::deleteFile(nc::fs::joinPath(InputDirectory, RepeatedEntry).data());
+		nc::fs::deleteFile(nc::fs::joinPath(InputDirectory, SequenceEntry).data());
+		nc::fs::deleteEmptyDir(nc::fs::joinPath(InputDirectory, "data").data());
+		nc::fs::deleteEmptyDir(InputDirectory);
+	}
+
+	nctl::UniquePtr<nc::AssetArchive> archive_;
+};
+
+TEST_F(AssetArchiveTest, OpenArchive)
+{
+	printf("Opening the archive \"%s\" with %u entries\n", archive_->filename(), archive_->numEntries());
+	ASSERT_TRUE(archive_->isValid());
+	ASSERT_EQ(archive_->numEntries(), 3u);
+
+	const int index = archive_->findEntry(SequenceEntry);
+	ASSERT_GE(index, 0);
+	ASSERT_STREQ(archive_->entryName(index), SequenceEntry);
+	ASSERT_EQ(archive_->entrySize(index), SequenceSize);
+	ASSERT_EQ(archive_->findEntry("missing.txt"), -1);
+	ASSERT_EQ(archive_->findEntry("sequence.bin"), -1);
+}
+
+TEST_F(AssetArchiveTest, ReadEntry)
+{
+	const nctl::String contents = readEntry(*archive_, TextEntry);
+	printf("Contents of \"%s\": \"%s\"\n", TextEntry, contents.data());
+	ASSERT_STREQ(contents.data(), TextContents);
+}
+
+TEST_F(AssetArchiveTest, SeekEntry)
+{
+	const int index = archive_->findEntry(SequenceEntry);
+	ASSERT_GE(index, 0);
+	nctl::UniquePtr<nc::IFile> file = archive_->openEntry(index, SequenceEntry);
+	file->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+	ASSERT_TRUE(file->isOpened());
+	ASSERT_EQ(file->size(), SequenceSize);
+
+	unsigned char byte = 0;
+	ASSERT_EQ(file->seek(100, SEEK_SET), 100);
+	ASSERT_EQ(file->read(&byte, 1), 1u);
+	printf("Byte at offset 100: %u\n", byte);
+	ASSERT_EQ(byte, 100);
+	ASSERT_EQ(file->tell(), 101);
+
+	ASSERT_EQ(file->seek(-11, SEEK_CUR), 90);
+	ASSERT_EQ(file->read(&byte, 1), 1u);
+	ASSERT_EQ(byte, 90);
+
+	ASSERT_EQ(file->seek(-1, SEEK_END), static_cast<long int>(SequenceSize - 1));
+	ASSERT_EQ(file->read(&byte, 1), 1u);
+	ASSERT_EQ(byte, 255);
+	printf("Reading beyond the end of the entry\n");
+	ASSERT_EQ(file->read(&byte, 1), 0u);
+}
+
+TEST_F(AssetArchiveTest, CompressedEntry)
+{
+	const int index = archive_->findEntry(RepeatedEntry);
+	ASSERT_GE(index, 0);
+	printf("Entry \"%s\" is %lu bytes, %lu stored\n", RepeatedEntry, archive_->entrySize(index), archive_->entryStoredSize(index));
+	ASSERT_LT(archive_->entryStoredSize(index), archive_->entrySize(index));
+
+	const nctl::String contents = readEntry(*archive_, RepeatedEntry);
+	ASSERT_EQ(contents.length(), RepeatedSize);
+	for (unsigned int i = 0; i < RepeatedSize; i++)
+		ASSERT_EQ(static_cast<unsigned char>(contents[i]), repeatedByte(i));
+
+	printf("Entries that do not shrink are stored uncompressed\n");
+	const int sequenceIndex = archive_->findEntry(SequenceEntry);
+	ASSERT_EQ(archive_->entryStoredSize(sequenceIndex), archive_->entrySize(sequenceIndex));
+}
+
+TEST_F(AssetArchiveTest, MountArchive)
+{
+	ASSERT_TRUE(nc::AssetArchive::mount(ArchiveName, MountPoint));
+	ASSERT_EQ(nc::AssetArchive::numMounted(), 1u);
+
+	const nctl::String path = nc::fs::joinPath(MountPoint, RepeatedEntry);
+	printf("Opening \"%s\" from the mounted archive\n", path.data());
+	nctl::UniquePtr<nc::IFile> file = nc::IFile::createFileHandle(path.data());
+	file->open(nc::IFile::OpenMode::READ | nc::IFile::OpenMode::BINARY);
+	ASSERT_TRUE(file->isOpened());
+	ASSERT_EQ(file->size(), RepeatedSize);
+
+	unsigned char bytes[8];
+	ASSERT_EQ(file->seek(RepeatedSize - 8, SEEK_SET), static_cast<long int>(RepeatedSize - 8));
+	ASSERT_EQ(file->read(bytes, 8), 8u);
+	for (unsigned int i = 0; i < 8; i++)
+		ASSERT_EQ(bytes[i], repeatedByte(RepeatedSize - 8 + i));
+	file.reset(nullptr);
+
+	ASSERT_TRUE(nc::AssetArchive::unmount(ArchiveName));
+	ASSERT_EQ(nc::AssetArchive::numMounted(), 0u);
+}
+
+}
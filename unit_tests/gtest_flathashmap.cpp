@@ -0,0 +1,438 @@
+#include "gtest_flathashmap.h"
+
+namespace {
+
+using GrowingFlatHashMapTestType = nctl::FlatHashMap<int, int>;
+
+class FlatHashMapTest : public ::testing::Test
+{
+  public:
+	FlatHashMapTest()
+	    : hashmap_(Capacity) {}
+
+  protected:
+	void SetUp() override { initFlatHashMap(hashmap_); }
+
+	FlatHashMapTestType hashmap_;
+};
+
+TEST(FlatHashMapZeroCapacityTest, InsertElements)
+{
+	printf("Creating a flat hashmap of zero capacity\n");
+	FlatHashMapTestType newHashmap(0);
+	ASSERT_EQ(newHashmap.capacity(), 0u);
+	ASSERT_TRUE(newHashmap.isEmpty());
+	ASSERT_EQ(newHashmap.find(0), nullptr);
+
+	printf("Inserting elements in the flat hashmap\n");
+	initFlatHashMap(newHashmap);
+	printFlatHashMap(newHashmap);
+
+	ASSERT_EQ(newHashmap.capacity(), nctl::FlatHash::GroupSize);
+	ASSERT_EQ(newHashmap.size(), Size);
+	ASSERT_EQ(calcSize(newHashmap), Size);
+}
+
+TEST(FlatHashMapCapacityTest, PowerOfTwo)
+{
+	printf("Creating flat hashmaps with a capacity that is not a power of two\n");
+	FlatHashMapTestType smallHashmap(3);
+	FlatHashMapTestType bigHashmap(Capacity + 1);
+
+	ASSERT_EQ(smallHashmap.capacity(), nctl::FlatHash::GroupSize);
+	ASSERT_EQ(bigHashmap.capacity(), Capacity * 2);
+}
+
+TEST_F(FlatHashMapTest, Capacity)
+{
+	const unsigned int capacity = hashmap_.capacity();
+	printf("Capacity: %u\n", capacity);
+
+	ASSERT_EQ(capacity, Capacity);
+}
+
+TEST_F(FlatHashMapTest, Size)
+{
+	const unsigned int size = hashmap_.size();
+	printf("Size: %u\n", size);
+
+	ASSERT_EQ(size, Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+}
+
+TEST_F(FlatHashMapTest, LoadFactor)
+{
+	const float loadFactor = hashmap_.loadFactor();
+	printf("Size: %u, Capacity: %u, Load Factor: %f\n", Size, Capacity, loadFactor);
+
+	ASSERT_FLOAT_EQ(loadFactor, Size / static_cast<float>(Capacity));
+}
+
+TEST_F(FlatHashMapTest, Clear)
+{
+	ASSERT_FALSE(hashmap_.isEmpty());
+	hashmap_.clear();
+	printFlatHashMap(hashmap_);
+	ASSERT_TRUE(hashmap_.isEmpty());
+	ASSERT_EQ(hashmap_.size(), 0u);
+	ASSERT_EQ(calcSize(hashmap_), 0u);
+	ASSERT_EQ(hashmap_.capacity(), Capacity);
+}
+
+TEST_F(FlatHashMapTest, RetrieveElements)
+{
+	printf("Retrieving the elements\n");
+	for (unsigned int i = 0; i < Size; i++)
+	{
+		printf("key: %u, value: %d\n", i, hashmap_[i]);
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+	}
+
+	ASSERT_EQ(hashmap_.size(), Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+}
+
+TEST_F(FlatHashMapTest, InsertElements)
+{
+	printf("Inserting elements\n");
+	for (unsigned int i = Size; i < Size * 2; i++)
+		hashmap_.insert(i, i + KeyValueDifference);
+
+	for (unsigned int i = 0; i < Size * 2; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+
+	ASSERT_EQ(hashmap_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashmap_), Size * 2);
+}
+
+TEST_F(FlatHashMapTest, FailInsertElements)
+{
+	printf("Trying to insert elements already in the hashmap\n");
+	for (unsigned int i = 0; i < Size * 2; i++)
+		hashmap_.insert(i, i + 2 * KeyValueDifference);
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+	for (unsigned int i = Size; i < Size * 2; i++)
+		ASSERT_EQ(hashmap_[i], i + 2 * KeyValueDifference);
+
+	ASSERT_EQ(hashmap_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashmap_), Size * 2);
+}
+
+TEST_F(FlatHashMapTest, EmplaceElements)
+{
+	printf("Emplacing elements\n");
+	for (unsigned int i = Size; i < Size * 2; i++)
+		hashmap_.emplace(i, i + KeyValueDifference);
+
+	for (unsigned int i = 0; i < Size * 2; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+
+	ASSERT_EQ(hashmap_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashmap_), Size * 2);
+}
+
+TEST_F(FlatHashMapTest, FailEmplaceElements)
+{
+	printf("Trying to emplace elements already in the hashmap\n");
+	for (unsigned int i = 0; i < Size * 2; i++)
+		hashmap_.emplace(i, i + 2 * KeyValueDifference);
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+	for (unsigned int i = Size; i < Size * 2; i++)
+		ASSERT_EQ(hashmap_[i], i + 2 * KeyValueDifference);
+
+	ASSERT_EQ(hashmap_.size(), Size * 2);
+	ASSERT_EQ(calcSize(hashmap_), Size * 2);
+}
+
+TEST_F(FlatHashMapTest, RemoveElements)
+{
+	printf("Original size: %u\n", hashmap_.size());
+	printf("Removing a couple elements\n");
+	hashmap_.remove(5);
+	hashmap_.remove(7);
+	printf("New size: %u\n", hashmap_.size());
+	printFlatHashMap(hashmap_);
+
+	int value = 0;
+	ASSERT_FALSE(hashmap_.contains(5, value));
+	ASSERT_FALSE(hashmap_.contains(7, value));
+	ASSERT_EQ(hashmap_.size(), Size - 2);
+	ASSERT_EQ(calcSize(hashmap_), Size - 2);
+}
+
+TEST_F(FlatHashMapTest, RehashExtend)
+{
+	const float loadFactor = hashmap_.loadFactor();
+	printf("Original size: %u, capacity: %u, load factor: %f\n", hashmap_.size(), hashmap_.capacity(), hashmap_.loadFactor());
+	ASSERT_EQ(hashmap_.capacity(), Capacity);
+
+	printf("Doubling capacity by rehashing\n");
+	hashmap_.rehash(hashmap_.capacity() * 2);
+	printf("New size: %u, capacity: %u, load factor: %f\n", hashmap_.size(), hashmap_.capacity(), hashmap_.loadFactor());
+	printFlatHashMap(hashmap_);
+
+	ASSERT_EQ(hashmap_.capacity(), Capacity * 2);
+	ASSERT_EQ(hashmap_.size(), Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+	ASSERT_FLOAT_EQ(hashmap_.loadFactor(), loadFactor * 0.5f);
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+}
+
+TEST_F(FlatHashMapTest, RehashShrink)
+{
+	printf("Original size: %u, capacity: %u, load factor: %f\n", hashmap_.size(), hashmap_.capacity(), hashmap_.loadFactor());
+	ASSERT_EQ(hashmap_.capacity(), Capacity);
+
+	printf("Set capacity to current size by rehashing\n");
+	hashmap_.rehash(hashmap_.size());
+	printf("New size: %u, capacity: %u, load factor: %f\n", hashmap_.size(), hashmap_.capacity(), hashmap_.loadFactor());
+	printFlatHashMap(hashmap_);
+
+	// The capacity is rounded up to the size of a group
+	ASSERT_EQ(hashmap_.capacity(), nctl::FlatHash::GroupSize);
+	ASSERT_EQ(hashmap_.size(), Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+
+	for (unsigned int i = 0; i < Size; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+}
+
+TEST_F(FlatHashMapTest, CopyConstruction)
+{
+	printf("Creating a new hashmap with copy construction\n");
+	FlatHashMapTestType newHashmap(hashmap_);
+	printFlatHashMap(newHashmap);
+
+	assertFlatHashMapsAreEqual(hashmap_, newHashmap);
+	ASSERT_EQ(hashmap_.size(), Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+	ASSERT_EQ(newHashmap.size(), Size);
+	ASSERT_EQ(calcSize(newHashmap), Size);
+}
+
+TEST_F(FlatHashMapTest, MoveConstruction)
+{
+	printf("Creating a new hashmap with move construction\n");
+	FlatHashMapTestType newHashmap = nctl::move(hashmap_);
+	printFlatHashMap(newHashmap);
+
+	ASSERT_EQ(hashmap_.size(), 0);
+	ASSERT_EQ(calcSize(hashmap_), 0);
+	ASSERT_EQ(newHashmap.capacity(), Capacity);
+	ASSERT_EQ(newHashmap.size(), Size);
+	ASSERT_EQ(calcSize(newHashmap), Size);
+}
+
+TEST_F(FlatHashMapTest, AssignmentOperator)
+{
+	printf("Creating a new hashmap with the assignment operator\n");
+	FlatHashMapTestType newHashmap(Capacity * 2);
+	newHashmap = hashmap_;
+	printFlatHashMap(newHashmap);
+
+	assertFlatHashMapsAreEqual(hashmap_, newHashmap);
+	ASSERT_EQ(newHashmap.capacity(), Capacity);
+	ASSERT_EQ(hashmap_.size(), Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+	ASSERT_EQ(newHashmap.size(), Size);
+	ASSERT_EQ(calcSize(newHashmap), Size);
+}
+
+TEST_F(FlatHashMapTest, MoveAssignmentOperator)
+{
+	printf("Creating a new hashmap with the move assignment operator\n");
+	FlatHashMapTestType newHashmap(Capacity);
+	newHashmap = nctl::move(hashmap_);
+	printFlatHashMap(newHashmap);
+
+	ASSERT_EQ(hashmap_.size(), 0);
+	ASSERT_EQ(newHashmap.capacity(), Capacity);
+	ASSERT_EQ(newHashmap.size(), Size);
+	ASSERT_EQ(calcSize(newHashmap), Size);
+}
+
+TEST_F(FlatHashMapTest, SelfAssignment)
+{
+	printf("Assigning the hashmap to itself with the assignment operator\n");
+	hashmap_ = hashmap_;
+	printFlatHashMap(hashmap_);
+
+	ASSERT_EQ(hashmap_.size(), Size);
+	ASSERT_EQ(calcSize(hashmap_), Size);
+}
+
+TEST_F(FlatHashMapTest, Contains)
+{
+	const int key = 1;
+	int value = 0;
+	const bool found = hashmap_.contains(key, value);
+	printf("Key %d is in the hashmap: %d - Value: %d\n", key, found, value);
+
+	ASSERT_TRUE(found);
+	ASSERT_EQ(value, key + KeyValueDifference);
+}
+
+TEST_F(FlatHashMapTest, DoesNotContain)
+{
+	const int key = 10;
+	int value = 0;
+	const bool found = hashmap_.contains(key, value);
+	printf("Key %d is in the hashmap: %d - Value: %d\n", key, found, value);
+
+	ASSERT_FALSE(found);
+}
+
+TEST_F(FlatHashMapTest, Find)
+{
+	const int key = 1;
+	const int *value = hashmap_.find(key);
+	printf("Key %d is in the hashmap: %d - Value: %d\n", key, value != nullptr, *value);
+
+	ASSERT_TRUE(value != nullptr);
+	ASSERT_EQ(*value, key + KeyValueDifference);
+}
+
+TEST_F(FlatHashMapTest, ConstFind)
+{
+	const FlatHashMapTestType &constHashmap = hashmap_;
+	const int key = 1;
+	const int *value = constHashmap.find(key);
+	printf("Key %d is in the hashmap: %d - Value: %d\n", key, value != nullptr, *value);
+
+	ASSERT_TRUE(value != nullptr);
+	ASSERT_EQ(*value, key + KeyValueDifference);
+}
+
+TEST_F(FlatHashMapTest, CannotFind)
+{
+	const int key = 10;
+	const int *value = hashmap_.find(key);
+	printf("Key %d is in the hashmap: %d\n", key, value != nullptr);
+
+	ASSERT_FALSE(value != nullptr);
+}
+
+TEST_F(FlatHashMapTest, GrowBeyondCapacity)
+{
+	printf("Inserting more elements than the initial capacity (%u)\n", Capacity);
+	for (unsigned int i = Size; i < Capacity * 2; i++)
+		hashmap_[i] = i + KeyValueDifference;
+	printf("New size: %u, capacity: %u, load factor: %f\n", hashmap_.size(), hashmap_.capacity(), hashmap_.loadFactor());
+
+	ASSERT_EQ(hashmap_.size(), Capacity * 2);
+	ASSERT_EQ(calcSize(hashmap_), Capacity * 2);
+	ASSERT_EQ(hashmap_.capacity(), Capacity * 4);
+	ASSERT_LE(hashmap_.loadFactor(), hashmap_.maxLoadFactor());
+	for (unsigned int i = 0; i < Capacity * 2; i++)
+		ASSERT_EQ(hashmap_[i], i + KeyValueDifference);
+}
+
+TEST_F(FlatHashMapTest, MaxLoadFactor)
+{
+	ASSERT_FLOAT_EQ(hashmap_.maxLoadFactor(), FlatHashMapTestType::DefaultMaxLoadFactor);
+
+	printf("Setting the maximum load factor to 0.5\n");
+	hashmap_.setMaxLoadFactor(0.5f);
+	for (unsigned int i = Size; i <= Capacity / 2; i++)
+		hashmap_[i] = i + KeyValueDifference;
+	printf("New size: %u, capacity: %u, load factor: %f\n", hashmap_.size(), hashmap_.capacity(), hashmap_.loadFactor());
+
+	ASSERT_FLOAT_EQ(hashmap_.maxLoadFactor(), 0.5f);
+	ASSERT_EQ(hashmap_.capacity(), Capacity * 2);
+	ASSERT_LE(hashmap_.loadFactor(), 0.5f);
+}
+
+TEST_F(FlatHashMapTest, ReuseRemovedBuckets)
+{
+	printf("Removing and inserting elements repeatedly\n");
+	GrowingFlatHashMapTestType newHashmap(Capacity);
+	for (unsigned int i = 0; i < Capacity * 16; i++)
+	{
+		newHashmap.insert(i, i + KeyValueDifference);
+		if (i >= Size)
+			newHashmap.remove(i - Size);
+	}
+	printf("New size: %u, capacity: %u, load factor: %f\n", newHashmap.size(), newHashmap.capacity(), newHashmap.loadFactor());
+
+	ASSERT_EQ(newHashmap.size(), Size);
+	ASSERT_EQ(calcSize(newHashmap), Size);
+	ASSERT_EQ(newHashmap.capacity(), Capacity);
+	for (unsigned int i = Capacity * 16 - Size; i < Capacity * 16; i++)
+		ASSERT_EQ(*newHashmap.find(i), i + KeyValueDifference);
+}
+
+const int BigCapacity = 512;
+const int LastElement = BigCapacity / 2;
+
+TEST_F(FlatHashMapTest, StressInsert)
+{
+	printf("Creating a new hashmap with a capacity of zero and filled up to %u elements\n", BigCapacity * 4);
+	GrowingFlatHashMapTestType newHashmap(0);
+
+	for (int i = 0; i < BigCapacity * 4; i++)
+		ASSERT_TRUE(newHashmap.insert(i, i + KeyValueDifference));
+	ASSERT_EQ(newHashmap.size(), BigCapacity * 4);
+	ASSERT_EQ(calcSize(newHashmap), BigCapacity * 4);
+
+	for (int i = 0; i < BigCapacity * 4; i++)
+		ASSERT_EQ(*newHashmap.find(i), i + KeyValueDifference);
+	ASSERT_EQ(newHashmap.find(BigCapacity * 4), nullptr);
+}
+
+TEST_F(FlatHashMapTest, StressRemove)
+{
+	printf("Creating a new hashmap with a capacity of %u and filled up to %u elements\n", BigCapacity, LastElement);
+	FlatHashMapTestType newHashmap(BigCapacity);
+
+	for (int i = 0; i < LastElement; i++)
+		newHashmap[i] = i + KeyValueDifference;
+	ASSERT_EQ(newHashmap.size(), LastElement);
+
+	printf("Removing all elements from the hashmap\n");
+	for (int i = 0; i < LastElement; i++)
+	{
+		newHashmap.remove(i);
+		ASSERT_EQ(newHashmap.size(), LastElement - i - 1);
+
+		int value = 0;
+		for (int j = i + 1; j < LastElement; j++)
+			ASSERT_TRUE(newHashmap.contains(j, value));
+		for (int j = 0; j < i + 1; j++)
+			ASSERT_FALSE(newHashmap.contains(j, value));
+	}
+
+	ASSERT_EQ(newHashmap.size(), 0);
+}
+
+TEST_F(FlatHashMapTest, StressReverseRemove)
+{
+	printf("Creating a new hashmap with a capacity of %u and filled up to %u elements\n", BigCapacity, LastElement);
+	FlatHashMapTestType newHashmap(BigCapacity);
+
+	for (int i = 0; i < LastElement; i++)
+		newHashmap[i] = i + KeyValueDifference;
+	ASSERT_EQ(newHashmap.size(), LastElement);
+
+	printf("Removing all elements from the hashmap\n");
+	for (int i = LastElement - 1; i >= 0; i--)
+	{
+		newHashmap.remove(i);
+		ASSERT_EQ(newHashmap.size(), i);
+
+		int value = 0;
+		for (int j = i - 1; j >= 0; j--)
+			ASSERT_TRUE(newHashmap.contains(j, value));
+		for (int j = LastElement; j >= i; j--)
+			ASSERT_FALSE(newHashmap.contains(j, value));
+	}
+
+	ASSERT_EQ(newHashmap.size(), 0);
+}
+
+}
@@ -0,0 +1,61 @@
+#ifndef GTEST_FLATHASHMAP_H
+#define GTEST_FLATHASHMAP_H
+
+#include <nctl/algorithms.h>
+#include <nctl/FlatHashMap.h>
+#include <nctl/FlatHashMapIterator.h>
+#include "gtest/gtest.h"
+
+namespace {
+
+const unsigned int Capacity = 32;
+const unsigned int Size = 10;
+const int KeyValueDifference = 10;
+using FlatHashMapTestType = nctl::FlatHashMap<int, int, nctl::FixedHashFunc<int>>;
+
+template <class HashFunc>
+void initFlatHashMap(nctl::FlatHashMap<int, int, HashFunc> &hashmap)
+{
+	for (unsigned int i = 0; i < Size; i++)
+		hashmap[i] = i + KeyValueDifference;
+}
+
+template <class HashFunc>
+void printFlatHashMap(const nctl::FlatHashMap<int, int, HashFunc> &hashmap)
+{
+	unsigned int n = 0;
+
+	for (typename nctl::FlatHashMap<int, int, HashFunc>::ConstIterator i = hashmap.begin(); i != hashmap.end(); ++i)
+		printf("[%u] hash: %u, key: %d, value: %d\n", n++, i.hash(), i.key(), i.value());
+	printf("\n");
+}
+
+template <class HashFunc>
+unsigned int calcSize(const nctl::FlatHashMap<int, int, HashFunc> &hashmap)
+{
+	unsigned int length = 0;
+
+	for (typename nctl::FlatHashMap<int, int, HashFunc>::ConstIterator i = hashmap.begin(); i != hashmap.end(); ++i)
+		length++;
+
+	return length;
+}
+
+template <class HashFunc>
+void assertFlatHashMapsAreEqual(const nctl::FlatHashMap<int, int, HashFunc> &hashmap1, const nctl::FlatHashMap<int, int, HashFunc> &hashmap2)
+{
+	typename nctl::FlatHashMap<int, int, HashFunc>::ConstIterator hashmap1It = hashmap1.begin();
+	typename nctl::FlatHashMap<int, int, HashFunc>::ConstIterator hashmap2It = hashmap2.begin();
+	while (hashmap1It != hashmap1.end())
+	{
+		ASSERT_EQ(hashmap1It.key(), hashmap2It.key());
+		ASSERT_EQ(*hashmap1It, *hashmap2It);
+
+		hashmap1It++;
+		hashmap2It++;
+	}
+}
+
+}
+
+#endif
@@ -412,4 +412,138 @@ TEST_F(HashMapTest, StressReverseRemove)
 	ASSERT_EQ(newHashmap.size(), 0);
 }
 
+
+TEST_F(HashMapTest, AutomaticGrowth)
+{
+	printf("Creating a new hashmap with a capacity of %u and a maximum load factor of 0.5\n", Capacity);
+	HashMapTestType newHashmap(Capacity);
+	newHashmap.setMaxLoadFactor(0.5f);
+	ASSERT_FLOAT_EQ(newHashmap.maxLoadFactor(), 0.5f);
+
+	for (int i = 0; i < LastElement; i++)
+	{
+		newHashmap[i] = i + KeyValueDifference;
+		ASSERT_LE(newHashmap.loadFactor(), 0.5f);
+	}
+	printf("Inserted %d elements, the capacity is now %u\n", LastElement, newHashmap.capacity());
+
+	ASSERT_FALSE(newHashmap.isRehashing());
+	ASSERT_EQ(newHashmap.capacity(), static_cast<unsigned int>(LastElement * 2));
+	ASSERT_EQ(newHashmap.size(), LastElement);
+	ASSERT_EQ(calcSize(newHashmap), LastElement);
+	for (int i = 0; i < LastElement; i++)
+		ASSERT_EQ(newHashmap[i], i + KeyValueDifference);
+}
+
+TEST_F(HashMapTest, NoGrowthByDefault)
+{
+	ASSERT_EQ(hashmap_.maxLoadFactor(), 0.0f);
+	for (unsigned int i = Size; i < Capacity; i++)
+		hashmap_.insert(i, i + KeyValueDifference);
+
+	ASSERT_EQ(hashmap_.size(), Capacity);
+	ASSERT_EQ(hashmap_.capacity(), Capacity);
+}
+
+TEST_F(HashMapTest, IncrementalGrowth)
+{
+	printf("Creating a new hashmap with a capacity of %u and incremental rehashing\n", Capacity);
+	HashMapTestType newHashmap(Capacity);
+	newHashmap.setMaxLoadFactor(0.75f);
+	newHashmap.setIncrementalRehash(true);
+	ASSERT_TRUE(newHashmap.incrementalRehash());
+
+	bool hasRehashed = false;
+	for (int i = 0; i < LastElement; i++)
+	{
+		ASSERT_TRUE(newHashmap.insert(i, i + KeyValueDifference));
+		ASSERT_FALSE(newHashmap.insert(i, i));
+		hasRehashed |= newHashmap.isRehashing();
+
+		ASSERT_EQ(newHashmap.size(), static_cast<unsigned int>(i + 1));
+		ASSERT_EQ(calcSize(newHashmap), static_cast<unsigned int>(i + 1));
+		for (int j = 0; j <= i; j++)
+			ASSERT_EQ(*newHashmap.find(j), j + KeyValueDifference);
+	}
+	ASSERT_TRUE(hasRehashed);
+
+	newHashmap.finishRehash();
+	printf("Inserted %d elements, the capacity is now %u\n", LastElement, newHashmap.capacity());
+	ASSERT_FALSE(newHashmap.isRehashing());
+	ASSERT_EQ(newHashmap.size(), LastElement);
+	ASSERT_LE(newHashmap.loadFactor(), 0.75f);
+	for (int i = 0; i < LastElement; i++)
+		ASSERT_EQ(newHashmap[i], i + KeyValueDifference);
+}
+
+TEST_F(HashMapTest, RemoveWhileRehashing)
+{
+	HashMapTestType newHashmap(Capacity);
+	newHashmap.setMaxLoadFactor(1.0f);
+	newHashmap.setIncrementalRehash(true);
+	for (unsigned int i = 0; i <= Capacity; i++)
+		newHashmap[i] = i + KeyValueDifference;
+	ASSERT_TRUE(newHashmap.isRehashing());
+
+	printf("Removing all elements from the hashmap while it is rehashing\n");
+	for (unsigned int i = 0; i <= Capacity; i++)
+	{
+		ASSERT_TRUE(newHashmap.remove(i));
+		ASSERT_FALSE(newHashmap.remove(i));
+		ASSERT_EQ(newHashmap.size(), Capacity - i);
+		ASSERT_EQ(calcSize(newHashmap), Capacity - i);
+
+		int value = 0;
+		for (unsigned int j = i + 1; j <= Capacity; j++)
+			ASSERT_TRUE(newHashmap.contains(j, value));
+	}
+
+	ASSERT_TRUE(newHashmap.isEmpty());
+	ASSERT_FALSE(newHashmap.isRehashing());
+}
+
+TEST_F(HashMapTest, CopyWhileRehashing)
+{
+	HashMapTestType newHashmap(Capacity);
+	newHashmap.setMaxLoadFactor(1.0f);
+	newHashmap.setIncrementalRehash(true);
+	for (unsigned int i = 0; i <= Capacity; i++)
+		newHashmap[i] = i + KeyValueDifference;
+	ASSERT_TRUE(newHashmap.isRehashing());
+
+	printf("Creating a new hashmap copying from the one that is rehashing\n");
+	HashMapTestType copiedHashmap(newHashmap);
+	ASSERT_TRUE(copiedHashmap.isRehashing());
+	ASSERT_EQ(copiedHashmap.size(), newHashmap.size());
+
+	printf("Assigning the rehashing hashmap to one with a different capacity\n");
+	HashMapTestType assignedHashmap(Capacity / 2);
+	assignedHashmap = newHashmap;
+	ASSERT_TRUE(assignedHashmap.isRehashing());
+	ASSERT_EQ(assignedHashmap.capacity(), newHashmap.capacity());
+
+	newHashmap.finishRehash();
+	for (unsigned int i = 0; i <= Capacity; i++)
+	{
+		ASSERT_EQ(copiedHashmap[i], static_cast<int>(i + KeyValueDifference));
+		ASSERT_EQ(assignedHashmap[i], static_cast<int>(i + KeyValueDifference));
+	}
+	assertHashMapsAreEqual(newHashmap, copiedHashmap);
+}
+
+TEST_F(HashMapTest, DisableIncrementalRehash)
+{
+	HashMapTestType newHashmap(Capacity);
+	newHashmap.setMaxLoadFactor(1.0f);
+	newHashmap.setIncrementalRehash(true);
+	for (unsigned int i = 0; i <= Capacity; i++)
+		newHashmap[i] = i + KeyValueDifference;
+	ASSERT_TRUE(newHashmap.isRehashing());
+
+	newHashmap.setIncrementalRehash(false);
+	ASSERT_FALSE(newHashmap.isRehashing());
+	ASSERT_EQ(newHashmap.size(), Capacity + 1);
+	ASSERT_EQ(calcSize(newHashmap), Capacity + 1);
+}
+
 }
@@ -4,6 +4,7 @@
 #include <nctl/HashMap.h>
 #include <nctl/HashMapIterator.h>
 #include <nctl/String.h>
+#include <nctl/HashedName.h>
 #include "gtest/gtest.h"
 
 namespace {
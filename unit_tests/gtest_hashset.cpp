@@ -361,4 +361,108 @@ TEST_F(HashSetTest, StressReverseRemove)
 	ASSERT_EQ(newHashset.size(), 0);
 }
 
+
+TEST_F(HashSetTest, AutomaticGrowth)
+{
+	printf("Creating a new hashset with a capacity of %u and a maximum load factor of 0.5\n", Capacity);
+	HashSetTestType newHashset(Capacity);
+	newHashset.setMaxLoadFactor(0.5f);
+	ASSERT_FLOAT_EQ(newHashset.maxLoadFactor(), 0.5f);
+
+	for (int i = 0; i < LastElement; i++)
+	{
+		newHashset.insert(i);
+		ASSERT_LE(newHashset.loadFactor(), 0.5f);
+	}
+	printf("Inserted %d elements, the capacity is now %u\n", LastElement, newHashset.capacity());
+
+	ASSERT_FALSE(newHashset.isRehashing());
+	ASSERT_EQ(newHashset.capacity(), static_cast<unsigned int>(LastElement * 2));
+	ASSERT_EQ(newHashset.size(), LastElement);
+	ASSERT_EQ(calcSize(newHashset), LastElement);
+	for (int i = 0; i < LastElement; i++)
+		ASSERT_TRUE(newHashset.contains(i));
+}
+
+TEST_F(HashSetTest, IncrementalGrowth)
+{
+	printf("Creating a new hashset with a capacity of %u and incremental rehashing\n", Capacity);
+	HashSetTestType newHashset(Capacity);
+	newHashset.setMaxLoadFactor(0.75f);
+	newHashset.setIncrementalRehash(true);
+	ASSERT_TRUE(newHashset.incrementalRehash());
+
+	bool hasRehashed = false;
+	for (int i = 0; i < LastElement; i++)
+	{
+		ASSERT_TRUE(newHashset.insert(i));
+		ASSERT_FALSE(newHashset.insert(i));
+		hasRehashed |= newHashset.isRehashing();
+
+		ASSERT_EQ(newHashset.size(), static_cast<unsigned int>(i + 1));
+		ASSERT_EQ(calcSize(newHashset), static_cast<unsigned int>(i + 1));
+		for (int j = 0; j <= i; j++)
+			ASSERT_EQ(*newHashset.find(j), j);
+	}
+	ASSERT_TRUE(hasRehashed);
+
+	newHashset.finishRehash();
+	printf("Inserted %d elements, the capacity is now %u\n", LastElement, newHashset.capacity());
+	ASSERT_FALSE(newHashset.isRehashing());
+	ASSERT_EQ(newHashset.size(), LastElement);
+	ASSERT_LE(newHashset.loadFactor(), 0.75f);
+}
+
+TEST_F(HashSetTest, RemoveWhileRehashing)
+{
+	HashSetTestType newHashset(Capacity);
+	newHashset.setMaxLoadFactor(1.0f);
+	newHashset.setIncrementalRehash(true);
+	for (unsigned int i = 0; i <= Capacity; i++)
+		newHashset.insert(i);
+	ASSERT_TRUE(newHashset.isRehashing());
+
+	printf("Removing all elements from the hashset while it is rehashing\n");
+	for (unsigned int i = 0; i <= Capacity; i++)
+	{
+		ASSERT_TRUE(newHashset.remove(i));
+		ASSERT_FALSE(newHashset.remove(i));
+		ASSERT_EQ(newHashset.size(), Capacity - i);
+		ASSERT_EQ(calcSize(newHashset), Capacity - i);
+
+		for (unsigned int j = i + 1; j <= Capacity; j++)
+			ASSERT_TRUE(newHashset.contains(j));
+	}
+
+	ASSERT_TRUE(newHashset.isEmpty());
+	ASSERT_FALSE(newHashset.isRehashing());
+}
+
+TEST_F(HashSetTest, CopyWhileRehashing)
+{
+	HashSetTestType newHashset(Capacity);
+	newHashset.setMaxLoadFactor(1.0f);
+	newHashset.setIncrementalRehash(true);
+	for (unsigned int i = 0; i <= Capacity; i++)
+		newHashset.insert(i);
+	ASSERT_TRUE(newHashset.isRehashing());
+
+	printf("Creating a new hashset copying from the one that is rehashing\n");
+	HashSetTestType copiedHashset(newHashset);
+	ASSERT_TRUE(copiedHashset.isRehashing());
+	ASSERT_EQ(copiedHashset.size(), newHashset.size());
+
+	printf("Assigning the rehashing hashset to one with a different capacity\n");
+	HashSetTestType assignedHashset(Capacity / 2);
+	assignedHashset = newHashset;
+	ASSERT_TRUE(assignedHashset.isRehashing());
+	ASSERT_EQ(assignedHashset.capacity(), newHashset.capacity());
+
+	for (unsigned int i = 0; i <= Capacity; i++)
+	{
+		ASSERT_TRUE(copiedHashset.contains(i));
+		ASSERT_TRUE(assignedHashset.contains(i));
+	}
+}
+
 }
@@ -0,0 +1,88 @@
+#include <nctl/MpmcQueue.h>
+#include <nctl/UniquePtr.h>
+#include "gtest/gtest.h"
+
+namespace {
+
+const unsigned int Capacity = 8;
+
+class MpmcQueueTest : public ::testing::Test
+{
+  public:
+	MpmcQueueTest()
+	    : queue_(Capacity) {}
+
+  protected:
+	nctl::MpmcQueue<int> queue_;
+};
+
+TEST_F(MpmcQueueTest, CapacityIsPowerOfTwo)
+{
+	nctl::MpmcQueue<int> queue(Capacity + 1);
+	printf("Capacity requested: %u, capacity obtained: %u\n", Capacity + 1, queue.capacity());
+
+	ASSERT_EQ(queue.capacity(), Capacity * 2);
+	ASSERT_TRUE(queue.isEmpty());
+}
+
+TEST_F(MpmcQueueTest, PopFromEmpty)
+{
+	int value = -1;
+	printf("Trying to pop an element from an empty queue\n");
+
+	ASSERT_FALSE(queue_.pop(value));
+	ASSERT_EQ(value, -1);
+}
+
+TEST_F(MpmcQueueTest, PushAndPop)
+{
+	printf("Pushing elements until the queue is full\n");
+	for (unsigned int i = 0; i < Capacity; i++)
+		ASSERT_TRUE(queue_.push(i));
+	ASSERT_EQ(queue_.size(), Capacity);
+	ASSERT_FALSE(queue_.push(-1));
+
+	printf("Popping all elements in order\n");
+	int value = 0;
+	for (unsigned int i = 0; i < Capacity; i++)
+	{
+		ASSERT_TRUE(queue_.pop(value));
+		ASSERT_EQ(value, static_cast<int>(i));
+	}
+	ASSERT_TRUE(queue_.isEmpty());
+	ASSERT_FALSE(queue_.pop(value));
+}
+
+TEST_F(MpmcQueueTest, WrapAround)
+{
+	printf("Pushing and popping more elements than the capacity\n");
+	int value = 0;
+	for (unsigned int i = 0; i < Capacity * 4; i++)
+	{
+		ASSERT_TRUE(queue_.push(i));
+		ASSERT_TRUE(queue_.push(i));
+		ASSERT_TRUE(queue_.pop(value));
+		ASSERT_TRUE(queue_.pop(value));
+		ASSERT_EQ(value, static_cast<int>(i));
+	}
+	ASSERT_TRUE(queue_.isEmpty());
+}
+
+TEST_F(MpmcQueueTest, MoveOnlyElements)
+{
+	nctl::MpmcQueue<nctl::UniquePtr<int>> queue(Capacity);
+	printf("Pushing and emplacing unique pointers\n");
+	ASSERT_TRUE(queue.push(nctl::makeUnique<int>(1)));
+	ASSERT_TRUE(queue.emplace(nctl::makeUnique<int>(2)));
+	ASSERT_TRUE(queue.push(nctl::makeUnique<int>(3)));
+
+	nctl::UniquePtr<int> ptr;
+	ASSERT_TRUE(queue.pop(ptr));
+	ASSERT_EQ(*ptr, 1);
+	ASSERT_TRUE(queue.pop(ptr));
+	ASSERT_EQ(*ptr, 2);
+	// The last element is destroyed together with the queue
+	ASSERT_EQ(queue.size(), 1u);
+}
+
+}
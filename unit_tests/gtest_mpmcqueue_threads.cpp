@@ -0,0 +1,63 @@
+#include <nctl/MpmcQueue.h>
+#include "gtest/gtest.h"
+#include "test_thread_functions.h"
+
+namespace {
+
+const unsigned int Capacity = 64;
+const int NumProducers = 4;
+const int NumConsumers = 4;
+const int NumElementsPerProducer = 25000;
+const int NumElements = NumProducers * NumElementsPerProducer;
+
+class MpmcQueueThreadsTest : public ::testing::Test
+{
+  public:
+	MpmcQueueThreadsTest()
+	    : queue_(Capacity), tr_(this) {}
+
+	nctl::MpmcQueue<int> queue_;
+	/// Threads starting first are producers, the others are consumers
+	nctl::Atomic32 role_;
+	nctl::Atomic32 numPopped_;
+	nctl::Atomic64 sum_;
+	ThreadRunner<NumProducers + NumConsumers> tr_;
+};
+
+TEST_F(MpmcQueueThreadsTest, ProducersConsumers)
+{
+	tr_.runThreads([](void *arg) -> ThreadRunner<NumProducers + NumConsumers>::threadFuncRet {
+		MpmcQueueThreadsTest *obj = static_cast<MpmcQueueThreadsTest *>(arg);
+		const int role = obj->role_.fetchAdd(1);
+		if (role < NumProducers)
+		{
+			// Every producer pushes a different range of values
+			const int first = role * NumElementsPerProducer;
+			for (int i = first; i < first + NumElementsPerProducer; i++)
+			{
+				while (obj->queue_.push(i) == false) {}
+			}
+		}
+		else
+		{
+			int value = 0;
+			while (obj->numPopped_.load() < NumElements)
+			{
+				if (obj->queue_.pop(value))
+				{
+					obj->sum_.fetchAdd(value);
+					obj->numPopped_.fetchAdd(1);
+				}
+			}
+		}
+		return obj->tr_.retFunc();
+	});
+
+	const int64_t sum = sum_.load();
+	printf("Elements received: %d, sum of elements: %ld\n", numPopped_.load(), static_cast<long>(sum));
+	ASSERT_EQ(numPopped_.load(), NumElements);
+	ASSERT_EQ(sum, static_cast<int64_t>(NumElements) * (NumElements - 1) / 2);
+	ASSERT_TRUE(queue_.isEmpty());
+}
+
+}
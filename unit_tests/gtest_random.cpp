@@ -136,4 +136,76 @@ TEST_F(RandomTest, FastGenerateBoundedReal)
 	}
 }
 
+TEST_F(RandomTest, GenerateIntegersLikeScalar)
+{
+	const unsigned int Count = Repetitions + 3;
+	printf("Generate %u random integers in bulk and compare them with the scalar ones\n", Count);
+	nc::Random scalarRnd(rnd_);
+
+	uint32_t numbers[Count];
+	rnd_.integers(numbers, Count);
+	for (unsigned int i = 0; i < Count; i++)
+		ASSERT_EQ(numbers[i], scalarRnd.integer());
+
+	printf("The generators are at the same position after the bulk generation\n");
+	ASSERT_EQ(rnd_.integer(), scalarRnd.integer());
+}
+
+TEST_F(RandomTest, GenerateBoundedIntegers)
+{
+	const unsigned int Count = Repetitions;
+	const uint32_t min = 10;
+	const uint32_t max = 16;
+	printf("Generate %u random integers in bulk between %u and %u, %u not included\n", Count, min, max, max);
+
+	uint32_t numbers[Count];
+	rnd_.integers(numbers, Count, min, max);
+	for (unsigned int i = 0; i < Count; i++)
+	{
+		ASSERT_TRUE(numbers[i] >= min);
+		ASSERT_TRUE(numbers[i] < max);
+	}
+}
+
+TEST_F(RandomTest, GenerateBoundedReals)
+{
+	const unsigned int Count = Repetitions;
+	const float min = 0.25f;
+	const float max = 0.75f;
+	printf("Generate %u random floats in bulk between %f and %f\n", Count, min, max);
+
+	float numbers[Count];
+	rnd_.reals(numbers, Count, min, max);
+	for (unsigned int i = 0; i < Count; i++)
+	{
+		ASSERT_TRUE(numbers[i] >= min);
+		ASSERT_TRUE(numbers[i] < max);
+	}
+}
+
+TEST_F(RandomTest, Advance)
+{
+	const unsigned int Steps = 1000;
+	printf("Advance the generator by %u steps\n", Steps);
+	nc::Random scalarRnd(rnd_);
+
+	rnd_.advance(Steps);
+	for (unsigned int i = 0; i < Steps; i++)
+		scalarRnd.integer();
+	ASSERT_EQ(rnd_.integer(), scalarRnd.integer());
+}
+
+TEST_F(RandomTest, Substream)
+{
+	printf("Generate numbers from two different substreams\n");
+	nc::Random first = rnd_.substream(0);
+	nc::Random second = rnd_.substream(1);
+
+	ASSERT_EQ(first.integer(), rnd_.integer());
+	bool differentNumbers = false;
+	for (unsigned int i = 0; i < Repetitions; i++)
+		differentNumbers |= (first.integer() != second.integer());
+	ASSERT_TRUE(differentNumbers);
+}
+
 }
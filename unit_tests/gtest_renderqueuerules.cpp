@@ -0,0 +1,176 @@
+#include "RenderQueueRules.h"
+#include <nctl/Array.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+/// A queue element with only the values read by the batching rules
+struct Command
+{
+	uint32_t materialSortKey;
+	bool batchable;
+	/// True if the command does not fit in an empty batch
+	bool tooBig;
+};
+
+struct CommandTraits
+{
+	static inline uint32_t lowerMaterialSortKey(const Command &command) { return command.materialSortKey; }
+	static inline unsigned int primitiveType(const Command &command) { return 0; }
+	static inline bool hasCustomVbo(const Command &command) { return false; }
+	static inline bool isBatchable(const Command &command) { return command.batchable; }
+};
+
+/// A range of commands that has been either batched or passed through
+struct Draw
+{
+	unsigned int start;
+	unsigned int end;
+	bool batched;
+};
+
+const unsigned int MinBatchSize = 2;
+const unsigned int MaxBatchSize = 8;
+
+/// Splits the queue in batches, a batch stops collecting before a command that is too big
+nctl::Array<Draw> createBatches(const Command *queue, unsigned int size, unsigned int minBatchSize, unsigned int maxBatchSize)
+{
+	nctl::Array<Draw> draws;
+	nc::RenderQueueRules::createBatches<CommandTraits>(
+	    queue, size, minBatchSize, maxBatchSize,
+	    [queue, &draws](unsigned int start, unsigned int end) {
+		    unsigned int numCollected = 0;
+		    while (start + numCollected < end && queue[start + numCollected].tooBig == false)
+			    numCollected++;
+		    if (numCollected > 0)
+			    draws.pushBack({ start, start + numCollected, true });
+		    return numCollected;
+	    },
+	    [&draws](unsigned int index) { draws.pushBack({ index, index + 1, false }); });
+
+	return draws;
+}
+
+void printDraws(const nctl::Array<Draw> &draws)
+{
+	for (const Draw &draw : draws)
+		printf("%s [%u, %u) ", draw.batched ? "batch" : "passthrough", draw.start, draw.end);
+	printf("\n");
+}
+
+/// Every command should be drawn exactly once and in queue order
+void assertQueueCovered(const nctl::Array<Draw> &draws, unsigned int size)
+{
+	unsigned int next = 0;
+	for (const Draw &draw : draws)
+	{
+		ASSERT_EQ(draw.start, next);
+		ASSERT_GT(draw.end, draw.start);
+		next = draw.end;
+	}
+	ASSERT_EQ(next, size);
+}
+
+TEST(RenderQueueRulesTest, BatchSingleRun)
+{
+	const Command queue[] = { { 1, true, false }, { 1, true, false }, { 1, true, false }, { 1, true, false } };
+	const unsigned int size = sizeof(queue) / sizeof(*queue);
+	const nctl::Array<Draw> draws = createBatches(queue, size, MinBatchSize, MaxBatchSize);
+	printDraws(draws);
+
+	assertQueueCovered(draws, size);
+	ASSERT_EQ(draws.size(), 1u);
+	ASSERT_TRUE(draws[0].batched);
+}
+
+TEST(RenderQueueRulesTest, SplitAtMaximumBatchSize)
+{
+	const unsigned int size = 5;
+	Command queue[size];
+	for (unsigned int i = 0; i < size; i++)
+		queue[i] = { 1, true, false };
+	const nctl::Array<Draw> draws = createBatches(queue, size, MinBatchSize, 3);
+	printDraws(draws);
+
+	assertQueueCovered(draws, size);
+	ASSERT_EQ(draws.size(), 2u);
+	ASSERT_TRUE(draws[0].batched);
+	ASSERT_EQ(draws[0].end, 3u);
+	ASSERT_TRUE(draws[1].batched);
+}
+
+TEST(RenderQueueRulesTest, PassthroughSmallRun)
+{
+	const Command queue[] = { { 1, true, false }, { 2, true, false }, { 2, true, false } };
+	const unsigned int size = sizeof(queue) / sizeof(*queue);
+	const nctl::Array<Draw> draws = createBatches(queue, size, MinBatchSize, MaxBatchSize);
+	printDraws(draws);
+
+	assertQueueCovered(draws, size);
+	ASSERT_EQ(draws.size(), 2u);
+	ASSERT_FALSE(draws[0].batched);
+	ASSERT_TRUE(draws[1].batched);
+}
+
+TEST(RenderQueueRulesTest, MixedRunBatchesOnlyBatchable)
+{
+	// All commands share the same material sort key, only the batchable ones should be collected
+	const Command queue[] = { { 1, true, false }, { 1, true, false }, { 1, true, false }, { 1, false, false },
+		                      { 1, true, false }, { 1, true, false }, { 1, true, false } };
+	const unsigned int size = sizeof(queue) / sizeof(*queue);
+	const nctl::Array<Draw> draws = createBatches(queue, size, MinBatchSize, MaxBatchSize);
+	printDraws(draws);
+
+	assertQueueCovered(draws, size);
+	ASSERT_EQ(draws.size(), 3u);
+	ASSERT_TRUE(draws[0].batched);
+	ASSERT_EQ(draws[0].end, 3u);
+	ASSERT_FALSE(draws[1].batched);
+	ASSERT_EQ(draws[1].start, 3u);
+	ASSERT_TRUE(draws[2].batched);
+}
+
+TEST(RenderQueueRulesTest, MixedRunEndingWithNonBatchable)
+{
+	const Command queue[] = { { 1, true, false }, { 1, true, false }, { 1, true, false }, { 1, false, false } };
+	const unsigned int size = sizeof(queue) / sizeof(*queue);
+	const nctl::Array<Draw> draws = createBatches(queue, size, MinBatchSize, MaxBatchSize);
+	printDraws(draws);
+
+	assertQueueCovered(draws, size);
+	ASSERT_EQ(draws.size(), 2u);
+	ASSERT_TRUE(draws[0].batched);
+	ASSERT_EQ(draws[0].end, 3u);
+	ASSERT_FALSE(draws[1].batched);
+}
+
+TEST(RenderQueueRulesTest, PassthroughCommandNotFittingInBatch)
+{
+	const Command queue[] = { { 1, true, false }, { 1, true, true }, { 1, true, false }, { 1, true, false }, { 1, true, false } };
+	const unsigned int size = sizeof(queue) / sizeof(*queue);
+	const nctl::Array<Draw> draws = createBatches(queue, size, MinBatchSize, MaxBatchSize);
+	printDraws(draws);
+
+	assertQueueCovered(draws, size);
+	ASSERT_EQ(draws.size(), 3u);
+	ASSERT_TRUE(draws[0].batched);
+	ASSERT_FALSE(draws[1].batched);
+	ASSERT_EQ(draws[1].start, 1u);
+	ASSERT_TRUE(draws[2].batched);
+	ASSERT_EQ(draws[2].start, 2u);
+}
+
+TEST(RenderQueueRulesTest, PassthroughSingleCommand)
+{
+	const Command queue[] = { { 1, true, false } };
+	const nctl::Array<Draw> draws = createBatches(queue, 1, MinBatchSize, MaxBatchSize);
+	printDraws(draws);
+
+	assertQueueCovered(draws, 1);
+	ASSERT_EQ(draws.size(), 1u);
+	ASSERT_FALSE(draws[0].batched);
+}
+
+}
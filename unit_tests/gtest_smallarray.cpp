@@ -0,0 +1,266 @@
+#include <nctl/SmallArray.h>
+#include "gtest/gtest.h"
+
+namespace {
+
+const unsigned int InlineCapacity = 4;
+const unsigned int Size = 10;
+using SmallArrayTestType = nctl::SmallArray<int, InlineCapacity>;
+
+void printArray(const SmallArrayTestType &array)
+{
+	printf("Size %u (%s): ", array.size(), array.isInline() ? "inline" : "heap");
+	for (unsigned int i = 0; i < array.size(); i++)
+		printf("[%u]=%d ", i, array[i]);
+	printf("\n");
+}
+
+void initArray(SmallArrayTestType &array, unsigned int size)
+{
+	for (unsigned int i = 0; i < size; i++)
+		array.pushBack(i);
+}
+
+void assertArrayIsSequence(const SmallArrayTestType &array, unsigned int size)
+{
+	ASSERT_EQ(array.size(), size);
+	for (unsigned int i = 0; i < size; i++)
+		ASSERT_EQ(array[i], static_cast<int>(i));
+}
+
+class SmallArrayTest : public ::testing::Test
+{
+  protected:
+	SmallArrayTestType array_;
+};
+
+TEST_F(SmallArrayTest, InlineByDefault)
+{
+	printf("Creating an empty small array\n");
+	ASSERT_TRUE(array_.isEmpty());
+	ASSERT_TRUE(array_.isInline());
+	ASSERT_EQ(array_.capacity(), SmallArrayTestType::InlineCapacity);
+}
+
+TEST_F(SmallArrayTest, StayInline)
+{
+	printf("Filling the inline capacity of the array\n");
+	initArray(array_, InlineCapacity);
+	printArray(array_);
+
+	ASSERT_TRUE(array_.isInline());
+	ASSERT_EQ(array_.capacity(), InlineCapacity);
+	assertArrayIsSequence(array_, InlineCapacity);
+}
+
+TEST_F(SmallArrayTest, SpillToHeap)
+{
+	printf("Exceeding the inline capacity of the array\n");
+	initArray(array_, Size);
+	printArray(array_);
+
+	ASSERT_FALSE(array_.isInline());
+	ASSERT_GE(array_.capacity(), Size);
+	assertArrayIsSequence(array_, Size);
+}
+
+TEST_F(SmallArrayTest, ExplicitCapacity)
+{
+	SmallArrayTestType smallArray(InlineCapacity - 1);
+	ASSERT_TRUE(smallArray.isInline());
+	ASSERT_EQ(smallArray.capacity(), InlineCapacity);
+
+	SmallArrayTestType bigArray(Size);
+	ASSERT_FALSE(bigArray.isInline());
+	ASSERT_EQ(bigArray.capacity(), Size);
+}
+
+TEST_F(SmallArrayTest, ShrinkBackInline)
+{
+	initArray(array_, Size);
+	ASSERT_FALSE(array_.isInline());
+
+	printf("Removing elements and shrinking the array back to the inline capacity\n");
+	array_.setSize(InlineCapacity - 1);
+	array_.shrinkToFit();
+	printArray(array_);
+
+	ASSERT_TRUE(array_.isInline());
+	ASSERT_EQ(array_.capacity(), InlineCapacity);
+	assertArrayIsSequence(array_, InlineCapacity - 1);
+}
+
+TEST_F(SmallArrayTest, SetCapacityCrops)
+{
+	initArray(array_, Size);
+	printf("Setting a capacity smaller than the size\n");
+	array_.setCapacity(2);
+	printArray(array_);
+
+	ASSERT_TRUE(array_.isInline());
+	assertArrayIsSequence(array_, InlineCapacity);
+}
+
+TEST_F(SmallArrayTest, InsertAndRemove)
+{
+	initArray(array_, InlineCapacity);
+	printf("Inserting an element at the front, spilling to the heap\n");
+	array_.insertAt(0, -1);
+	printArray(array_);
+
+	ASSERT_FALSE(array_.isInline());
+	ASSERT_EQ(array_.size(), InlineCapacity + 1);
+	ASSERT_EQ(array_[0], -1);
+	for (unsigned int i = 1; i < array_.size(); i++)
+		ASSERT_EQ(array_[i], static_cast<int>(i - 1));
+
+	printf("Removing the first element\n");
+	array_.removeAt(0);
+	printArray(array_);
+	assertArrayIsSequence(array_, InlineCapacity);
+}
+
+TEST_F(SmallArrayTest, InsertRange)
+{
+	const int source[] = { 10, 11, 12, 13, 14, 15 };
+	initArray(array_, 2);
+	printf("Inserting a range of elements in the middle of the array\n");
+	array_.insertRange(1, source, source + 6);
+	printArray(array_);
+
+	ASSERT_EQ(array_.size(), 8u);
+	ASSERT_EQ(array_[0], 0);
+	for (unsigned int i = 0; i < 6; i++)
+		ASSERT_EQ(array_[i + 1], source[i]);
+	ASSERT_EQ(array_[7], 1);
+}
+
+TEST_F(SmallArrayTest, Iterate)
+{
+	initArray(array_, Size);
+
+	int value = 0;
+	for (const int element : array_)
+		ASSERT_EQ(element, value++);
+	ASSERT_EQ(value, static_cast<int>(Size));
+
+	for (SmallArrayTestType::ConstReverseIterator i = array_.crBegin(); i != array_.crEnd(); ++i)
+		ASSERT_EQ(*i, --value);
+	ASSERT_EQ(value, 0);
+}
+
+TEST_F(SmallArrayTest, CopyConstructionInline)
+{
+	initArray(array_, InlineCapacity);
+	printf("Creating a new array with copy construction from an inline one\n");
+	SmallArrayTestType newArray(array_);
+	printArray(newArray);
+
+	ASSERT_TRUE(newArray.isInline());
+	assertArrayIsSequence(newArray, InlineCapacity);
+	assertArrayIsSequence(array_, InlineCapacity);
+}
+
+TEST_F(SmallArrayTest, CopyConstructionHeap)
+{
+	initArray(array_, Size);
+	printf("Creating a new array with copy construction from a spilled one\n");
+	SmallArrayTestType newArray(array_);
+	printArray(newArray);
+
+	ASSERT_FALSE(newArray.isInline());
+	ASSERT_NE(newArray.data(), array_.data());
+	assertArrayIsSequence(newArray, Size);
+	assertArrayIsSequence(array_, Size);
+}
+
+TEST_F(SmallArrayTest, MoveConstructionInline)
+{
+	initArray(array_, InlineCapacity);
+	printf("Creating a new array with move construction from an inline one\n");
+	SmallArrayTestType newArray(nctl::move(array_));
+	printArray(newArray);
+
+	ASSERT_TRUE(newArray.isInline());
+	assertArrayIsSequence(newArray, InlineCapacity);
+	ASSERT_TRUE(array_.isEmpty());
+}
+
+TEST_F(SmallArrayTest, MoveConstructionHeap)
+{
+	initArray(array_, Size);
+	const int *data = array_.data();
+	printf("Creating a new array with move construction from a spilled one\n");
+	SmallArrayTestType newArray(nctl::move(array_));
+	printArray(newArray);
+
+	ASSERT_EQ(newArray.data(), data);
+	assertArrayIsSequence(newArray, Size);
+	ASSERT_TRUE(array_.isEmpty());
+	ASSERT_TRUE(array_.isInline());
+	ASSERT_EQ(array_.capacity(), InlineCapacity);
+}
+
+TEST_F(SmallArrayTest, AssignmentOperator)
+{
+	initArray(array_, Size);
+	printf("Assigning a spilled array to an inline one\n");
+	SmallArrayTestType newArray;
+	newArray.pushBack(-1);
+	newArray = array_;
+	printArray(newArray);
+	assertArrayIsSequence(newArray, Size);
+
+	printf("Assigning an inline array to a spilled one\n");
+	SmallArrayTestType smallArray;
+	initArray(smallArray, 2);
+	newArray = smallArray;
+	printArray(newArray);
+	assertArrayIsSequence(newArray, 2);
+}
+
+TEST_F(SmallArrayTest, MoveAssignmentOperator)
+{
+	initArray(array_, Size);
+	const int *data = array_.data();
+	printf("Move assigning a spilled array\n");
+	SmallArrayTestType newArray;
+	initArray(newArray, 2);
+	newArray = nctl::move(array_);
+	printArray(newArray);
+
+	ASSERT_EQ(newArray.data(), data);
+	assertArrayIsSequence(newArray, Size);
+	ASSERT_TRUE(array_.isEmpty());
+	ASSERT_TRUE(array_.isInline());
+
+	printf("Move assigning an inline array\n");
+	SmallArrayTestType smallArray;
+	initArray(smallArray, 3);
+	newArray = nctl::move(smallArray);
+	printArray(newArray);
+	assertArrayIsSequence(newArray, 3);
+	ASSERT_TRUE(smallArray.isEmpty());
+}
+
+TEST_F(SmallArrayTest, SelfAssignment)
+{
+	initArray(array_, Size);
+	printf("Assigning the array to itself\n");
+	array_ = array_;
+	assertArrayIsSequence(array_, Size);
+}
+
+TEST_F(SmallArrayTest, UnorderedRemove)
+{
+	initArray(array_, InlineCapacity);
+	printf("Removing the first element by moving the last one in its place\n");
+	array_.unorderedRemoveAt(0);
+	printArray(array_);
+
+	ASSERT_EQ(array_.size(), InlineCapacity - 1);
+	ASSERT_EQ(array_[0], static_cast<int>(InlineCapacity - 1));
+	ASSERT_EQ(array_[1], 1);
+}
+
+}
@@ -0,0 +1,111 @@
+#include <nctl/SmallArray.h>
+#include "gtest/gtest.h"
+#define PRINT_ALL_COUNTERS (0)
+#include "test_refcounted.h"
+
+int RefCounted::counter_ = 0;
+int RefCounted::constructions_ = 0;
+int RefCounted::destructions_ = 0;
+int RefCounted::copyConstructions_ = 0;
+int RefCounted::moveConstructions_ = 0;
+int RefCounted::assignments_ = 0;
+int RefCounted::moveAssignments_ = 0;
+
+namespace {
+
+const unsigned int InlineCapacity = 4;
+const unsigned int Size = 10;
+
+class SmallArrayRefCountedTest : public ::testing::Test
+{
+  protected:
+	nctl::SmallArray<RefCounted, InlineCapacity> array_;
+};
+
+TEST_F(SmallArrayRefCountedTest, FillInline)
+{
+	ASSERT_EQ(RefCounted::counter(), 0);
+	printf("Filling the inline capacity of the array (%u elements)\n", InlineCapacity);
+	for (unsigned int i = 0; i < InlineCapacity; i++)
+		array_.pushBack(RefCounted());
+
+	printRefCounters();
+	ASSERT_TRUE(array_.isInline());
+	ASSERT_EQ(RefCounted::counter(), InlineCapacity);
+}
+
+TEST_F(SmallArrayRefCountedTest, SpillToHeap)
+{
+	ASSERT_EQ(RefCounted::counter(), 0);
+	printf("Exceeding the inline capacity of the array (%u elements)\n", Size);
+	for (unsigned int i = 0; i < Size; i++)
+		array_.pushBack(RefCounted());
+
+	printRefCounters();
+	ASSERT_FALSE(array_.isInline());
+	ASSERT_EQ(RefCounted::counter(), Size);
+
+	printf("Clearing the array\n");
+	array_.clear();
+	printRefCounters();
+	ASSERT_EQ(RefCounted::counter(), 0);
+}
+
+TEST_F(SmallArrayRefCountedTest, ShrinkBackInline)
+{
+	ASSERT_EQ(RefCounted::counter(), 0);
+	for (unsigned int i = 0; i < Size; i++)
+		array_.pushBack(RefCounted());
+
+	printf("Shrinking the array to the inline capacity, destroying the elements that do not fit\n");
+	array_.setCapacity(InlineCapacity);
+	printRefCounters();
+	ASSERT_TRUE(array_.isInline());
+	ASSERT_EQ(RefCounted::counter(), InlineCapacity);
+}
+
+TEST_F(SmallArrayRefCountedTest, CopyAndMove)
+{
+	ASSERT_EQ(RefCounted::counter(), 0);
+	for (unsigned int i = 0; i < Size; i++)
+		array_.pushBack(RefCounted());
+
+	{
+		printf("Copy constructing an array with spilled elements\n");
+		nctl::SmallArray<RefCounted, InlineCapacity> newArray(array_);
+		printRefCounters();
+		ASSERT_EQ(RefCounted::counter(), Size * 2);
+
+		printf("Move assigning it to an inline array\n");
+		nctl::SmallArray<RefCounted, InlineCapacity> smallArray;
+		smallArray.pushBack(RefCounted());
+		smallArray = nctl::move(newArray);
+		printRefCounters();
+		ASSERT_EQ(RefCounted::counter(), Size * 2);
+	}
+
+	printRefCounters();
+	ASSERT_EQ(RefCounted::counter(), Size);
+	array_.clear();
+	ASSERT_EQ(RefCounted::counter(), 0);
+}
+
+TEST_F(SmallArrayRefCountedTest, MoveInline)
+{
+	ASSERT_EQ(RefCounted::counter(), 0);
+	array_.pushBack(RefCounted());
+	array_.pushBack(RefCounted());
+
+	{
+		printf("Move constructing an array with inline elements\n");
+		nctl::SmallArray<RefCounted, InlineCapacity> newArray(nctl::move(array_));
+		printRefCounters();
+		ASSERT_EQ(RefCounted::counter(), 2);
+		ASSERT_TRUE(array_.isEmpty());
+	}
+
+	printRefCounters();
+	ASSERT_EQ(RefCounted::counter(), 0);
+}
+
+}
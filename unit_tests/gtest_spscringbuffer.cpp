@@ -0,0 +1,88 @@
+#include <nctl/SpscRingBuffer.h>
+#include <nctl/UniquePtr.h>
+#include "gtest/gtest.h"
+
+namespace {
+
+const unsigned int Capacity = 8;
+
+class SpscRingBufferTest : public ::testing::Test
+{
+  public:
+	SpscRingBufferTest()
+	    : ringBuffer_(Capacity) {}
+
+  protected:
+	nctl::SpscRingBuffer<int> ringBuffer_;
+};
+
+TEST_F(SpscRingBufferTest, CapacityIsPowerOfTwo)
+{
+	nctl::SpscRingBuffer<int> ringBuffer(Capacity + 1);
+	printf("Capacity requested: %u, capacity obtained: %u\n", Capacity + 1, ringBuffer.capacity());
+
+	ASSERT_EQ(ringBuffer.capacity(), Capacity * 2);
+	ASSERT_TRUE(ringBuffer.isEmpty());
+}
+
+TEST_F(SpscRingBufferTest, PopFromEmpty)
+{
+	int value = -1;
+	printf("Trying to pop an element from an empty ring buffer\n");
+
+	ASSERT_FALSE(ringBuffer_.pop(value));
+	ASSERT_EQ(value, -1);
+}
+
+TEST_F(SpscRingBufferTest, PushAndPop)
+{
+	printf("Pushing elements until the ring buffer is full\n");
+	for (unsigned int i = 0; i < Capacity; i++)
+		ASSERT_TRUE(ringBuffer_.push(i));
+	ASSERT_EQ(ringBuffer_.size(), Capacity);
+	ASSERT_FALSE(ringBuffer_.push(-1));
+
+	printf("Popping all elements in order\n");
+	int value = 0;
+	for (unsigned int i = 0; i < Capacity; i++)
+	{
+		ASSERT_TRUE(ringBuffer_.pop(value));
+		ASSERT_EQ(value, static_cast<int>(i));
+	}
+	ASSERT_TRUE(ringBuffer_.isEmpty());
+	ASSERT_FALSE(ringBuffer_.pop(value));
+}
+
+TEST_F(SpscRingBufferTest, WrapAround)
+{
+	printf("Pushing and popping more elements than the capacity\n");
+	int value = 0;
+	for (unsigned int i = 0; i < Capacity * 4; i++)
+	{
+		ASSERT_TRUE(ringBuffer_.push(i));
+		ASSERT_TRUE(ringBuffer_.push(i));
+		ASSERT_TRUE(ringBuffer_.pop(value));
+		ASSERT_TRUE(ringBuffer_.pop(value));
+		ASSERT_EQ(value, static_cast<int>(i));
+	}
+	ASSERT_TRUE(ringBuffer_.isEmpty());
+}
+
+TEST_F(SpscRingBufferTest, MoveOnlyElements)
+{
+	nctl::SpscRingBuffer<nctl::UniquePtr<int>> ringBuffer(Capacity);
+	printf("Pushing and emplacing unique pointers\n");
+	ASSERT_TRUE(ringBuffer.push(nctl::makeUnique<int>(1)));
+	ASSERT_TRUE(ringBuffer.emplace(nctl::makeUnique<int>(2)));
+	ASSERT_TRUE(ringBuffer.push(nctl::makeUnique<int>(3)));
+
+	nctl::UniquePtr<int> ptr;
+	ASSERT_TRUE(ringBuffer.pop(ptr));
+	ASSERT_EQ(*ptr, 1);
+	ASSERT_TRUE(ringBuffer.pop(ptr));
+	ASSERT_EQ(*ptr, 2);
+	// The last element is destroyed together with the ring buffer
+	ASSERT_EQ(ringBuffer.size(), 1u);
+}
+
+}
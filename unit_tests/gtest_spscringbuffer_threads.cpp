@@ -0,0 +1,59 @@
+#include <nctl/SpscRingBuffer.h>
+#include "gtest/gtest.h"
+#include "test_thread_functions.h"
+
+namespace {
+
+const unsigned int Capacity = 64;
+const int NumElements = 100000;
+
+class SpscRingBufferThreadsTest : public ::testing::Test
+{
+  public:
+	SpscRingBufferThreadsTest()
+	    : ringBuffer_(Capacity), outOfOrder_(0), sum_(0), tr_(this) {}
+
+	nctl::SpscRingBuffer<int> ringBuffer_;
+	/// The first thread to start is the producer, the other one is the consumer
+	nctl::Atomic32 role_;
+	int outOfOrder_;
+	int64_t sum_;
+	ThreadRunner<2> tr_;
+};
+
+TEST_F(SpscRingBufferThreadsTest, ProducerConsumer)
+{
+	tr_.runThreads([](void *arg) -> ThreadRunner<2>::threadFuncRet {
+		SpscRingBufferThreadsTest *obj = static_cast<SpscRingBufferThreadsTest *>(arg);
+		if (obj->role_.fetchAdd(1) == 0)
+		{
+			for (int i = 0; i < NumElements; i++)
+			{
+				while (obj->ringBuffer_.push(i) == false) {}
+			}
+		}
+		else
+		{
+			int expected = 0;
+			int value = 0;
+			while (expected < NumElements)
+			{
+				if (obj->ringBuffer_.pop(value))
+				{
+					if (value != expected)
+						obj->outOfOrder_++;
+					obj->sum_ += value;
+					expected++;
+				}
+			}
+		}
+		return obj->tr_.retFunc();
+	});
+
+	printf("Elements received out of order: %d, sum of elements: %ld\n", outOfOrder_, static_cast<long>(sum_));
+	ASSERT_EQ(outOfOrder_, 0);
+	ASSERT_EQ(sum_, static_cast<int64_t>(NumElements) * (NumElements - 1) / 2);
+	ASSERT_TRUE(ringBuffer_.isEmpty());
+}
+
+}
@@ -0,0 +1,82 @@
+#include <ncine/StaticBatchNode.h>
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const float PositionX = 300.0f;
+const float PositionY = 200.0f;
+const float ChunkSize = 256.0f;
+const uint16_t Layer = 8;
+
+class StaticBatchNodeTest : public ::testing::Test
+{
+  public:
+	StaticBatchNodeTest()
+	    : batchNode_(nullptr, PositionX, PositionY) {}
+
+  protected:
+	void SetUp() override
+	{
+		batchNode_.setChunkSize(ChunkSize);
+		batchNode_.setLayer(Layer);
+		batchNode_.setUpdateMode(nc::SceneNode::UpdateMode::ON_CHANGE);
+	}
+
+	nc::StaticBatchNode batchNode_;
+};
+
+TEST_F(StaticBatchNodeTest, DefaultConstruction)
+{
+	const nc::StaticBatchNode batchNode;
+	printf("Chunk size: %f, baked children: %u, chunks: %u\n", batchNode.chunkSize(), batchNode.numBakedChildren(), batchNode.numChunks());
+
+	ASSERT_EQ(batchNode.type(), nc::Object::ObjectType::STATIC_BATCH_NODE);
+	ASSERT_FLOAT_EQ(batchNode.chunkSize(), nc::StaticBatchNode::DefaultChunkSize);
+	ASSERT_EQ(batchNode.numBakedChildren(), 0u);
+	ASSERT_EQ(batchNode.numChunks(), 0u);
+	ASSERT_EQ(batchNode.numBakes(), 0u);
+}
+
+TEST_F(StaticBatchNodeTest, Clone)
+{
+	const nc::StaticBatchNode clone = batchNode_.clone();
+	printf("Cloned node with position <%f, %f> and chunk size %f\n", clone.position().x, clone.position().y, clone.chunkSize());
+
+	ASSERT_EQ(clone.type(), nc::Object::ObjectType::STATIC_BATCH_NODE);
+	ASSERT_FLOAT_EQ(clone.position().x, PositionX);
+	ASSERT_FLOAT_EQ(clone.position().y, PositionY);
+	ASSERT_FLOAT_EQ(clone.chunkSize(), ChunkSize);
+	ASSERT_EQ(clone.layer(), Layer);
+	ASSERT_EQ(clone.updateMode(), nc::SceneNode::UpdateMode::ON_CHANGE);
+	ASSERT_EQ(clone.numBakes(), 0u);
+	ASSERT_EQ(clone.numChunks(), 0u);
+}
+
+TEST_F(StaticBatchNodeTest, CloneHasNoChildren)
+{
+	nc::SceneNode *child = new nc::SceneNode(&batchNode_);
+	const nc::StaticBatchNode clone = batchNode_.clone();
+	printf("Original node children: %u, cloned node children: %u\n", batchNode_.children().size(), clone.children().size());
+
+	ASSERT_EQ(batchNode_.children().size(), 1u);
+	ASSERT_EQ(batchNode_.children()[0], child);
+	ASSERT_TRUE(clone.children().isEmpty());
+}
+
+TEST_F(StaticBatchNodeTest, CloneKeepsParent)
+{
+	nc::SceneNode parent;
+	batchNode_.setParent(&parent);
+	nc::StaticBatchNode clone = batchNode_.clone();
+	printf("Parent children after cloning: %u\n", parent.children().size());
+
+	ASSERT_EQ(clone.parent(), &parent);
+	ASSERT_EQ(parent.children().size(), 2u);
+
+	clone.setParent(nullptr);
+	batchNode_.setParent(nullptr);
+}
+
+}
@@ -181,4 +181,78 @@ TEST_F(StaticHashMapStringTest, CannotFind)
 	ASSERT_FALSE(value != nullptr);
 }
 
+
+TEST_F(StaticHashMapStringTest, ContainsWithHash)
+{
+	const nctl::hash_t hash = strHashmap_.hash(Keys[0]);
+	nctl::String value;
+	const bool found = strHashmap_.contains(Keys[0], hash, value);
+	printf("Key %s with hash %u is in the hashmap: %d - Value: %s\n", Keys[0], hash, found, value.data());
+
+	ASSERT_TRUE(found);
+	ASSERT_STREQ(value.data(), Values[0]);
+}
+
+TEST_F(StaticHashMapStringTest, FindWithHashedName)
+{
+	const nctl::HashedName key("AB");
+	const nctl::String *value = strHashmap_.find(key.data(), key.length(), key.hash());
+	printf("Key %s with hash %u is in the hashmap: %d - Value: %s\n", key.data(), key.hash(), value != nullptr, value->data());
+
+	ASSERT_TRUE(value != nullptr);
+	ASSERT_STREQ(value->data(), Values[4]);
+}
+
+TEST_F(StaticHashMapStringTest, CannotFindWithHashedName)
+{
+	const nctl::HashedName key("Z");
+	const nctl::String *value = strHashmap_.find(key.data(), key.length(), key.hash());
+	printf("Key %s with hash %u is in the hashmap: %d\n", key.data(), key.hash(), value != nullptr);
+
+	ASSERT_FALSE(value != nullptr);
+}
+
+TEST_F(StaticHashMapStringTest, ContainsWithHashedName)
+{
+	const nctl::HashedName key("BA");
+	nctl::String value;
+	const bool found = strHashmap_.contains(key.data(), key.length(), key.hash(), value);
+	printf("Key %s with hash %u is in the hashmap: %d - Value: %s\n", key.data(), key.hash(), found, value.data());
+
+	ASSERT_TRUE(found);
+	ASSERT_STREQ(value.data(), Values[5]);
+}
+
+TEST_F(StaticHashMapStringTest, FindCharactersNotNullTerminated)
+{
+	const char *chars = "ABC";
+	const nctl::hash_t hash = nctl::FNV1a::hash(chars, 2);
+	const nctl::String *value = strHashmap_.find(chars, 2, hash);
+	printf("Key %.2s with hash %u is in the hashmap: %d - Value: %s\n", chars, hash, value != nullptr, value->data());
+
+	ASSERT_TRUE(value != nullptr);
+	ASSERT_STREQ(value->data(), Values[4]);
+}
+
+TEST_F(StaticHashMapStringTest, CannotFindCharactersWithDifferentLength)
+{
+	const char *chars = "ABC";
+	const nctl::hash_t hash = nctl::FNV1a::hash(chars, 3);
+	const nctl::String *value = strHashmap_.find(chars, 3, hash);
+	printf("Key %s with hash %u is in the hashmap: %d\n", chars, hash, value != nullptr);
+
+	ASSERT_FALSE(value != nullptr);
+}
+
+TEST_F(StaticHashMapStringTest, FindLongKeyWithHashedName)
+{
+	const nctl::HashedName key("uProjectionMatrixLongName");
+	strHashmap_[key.data()] = "Long";
+	const nctl::String *value = strHashmap_.find(key.data(), key.length(), key.hash());
+	printf("Key %s with hash %u is in the hashmap: %d - Value: %s\n", key.data(), key.hash(), value != nullptr, value->data());
+
+	ASSERT_TRUE(value != nullptr);
+	ASSERT_STREQ(value->data(), "Long");
+}
+
 }
@@ -4,6 +4,7 @@
 #include <nctl/StaticHashMap.h>
 #include <nctl/StaticHashMapIterator.h>
 #include <nctl/String.h>
+#include <nctl/HashedName.h>
 #include "gtest/gtest.h"
 
 namespace {
@@ -273,6 +273,31 @@ TEST_F(StringTest, AccessAtLastConstCharacter)
 	ASSERT_EQ(constSting.at(constSting.length() - 1), '1');
 }
 
+TEST_F(StringTest, Hash)
+{
+	const nctl::hash_t hash = string_.hash();
+	printf("Hash of the string \"%s\": %u\n", string_.data(), hash);
+	ASSERT_EQ(hash, nctl::FNV1aHashFunc<const char *>()(string_.data()));
+	ASSERT_EQ(hash, nctl::HashedName("String1").hash());
+
+	const nctl::String copy = string_;
+	ASSERT_EQ(copy.hash(), hash);
+}
+
+TEST_F(StringTest, HashAfterModification)
+{
+	const nctl::hash_t hash = string_.hash();
+	string_[0] = 's';
+	printf("Hash of the modified string \"%s\": %u\n", string_.data(), string_.hash());
+	ASSERT_NE(string_.hash(), hash);
+	ASSERT_EQ(string_.hash(), nctl::HashedName("string1").hash());
+
+	string_.append("2");
+	ASSERT_EQ(string_.hash(), nctl::HashedName("string12").hash());
+	string_ = "String1";
+	ASSERT_EQ(string_.hash(), hash);
+}
+
 #ifndef __EMSCRIPTEN__
 	#ifdef NCINE_DEBUG
 TEST(StringDeathTest, SubscriptAccessBeyondLastCharacter)
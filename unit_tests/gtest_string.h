@@ -2,6 +2,7 @@
 #define GTEST_STRING_H
 
 #include <nctl/String.h>
+#include <nctl/HashedName.h>
 #include "gtest/gtest.h"
 
 namespace {
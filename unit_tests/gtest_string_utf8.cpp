@@ -435,4 +435,63 @@ TEST_F(StringUTF8Test, Utf8BeyondStringEnd)
 	ASSERT_EQ(i, 5);
 }
 
+TEST_F(StringUTF8Test, Utf8ToCodePointsBulk)
+{
+	nctl::String string(128);
+	string = "A long ASCII prefix before Ω⁋𝄞 and a long ASCII suffix after them";
+	printString("The UTF-8 encoded string: ", string);
+
+	unsigned int codePoints[128];
+	const unsigned int numCodePoints = string.utf8ToCodePoints(codePoints);
+	printf("The string has been decoded to %u code points\n", numCodePoints);
+
+	unsigned int decodeCount = 0;
+	for (unsigned int i = 0; i < string.length();) // increments handled by UTF-8 decoding
+	{
+		unsigned int codePoint = nctl::Utf8::InvalidUnicode;
+		i += string.utf8ToCodePoint(i, codePoint);
+		ASSERT_EQ(codePoints[decodeCount], codePoint);
+		decodeCount++;
+	}
+	ASSERT_EQ(numCodePoints, decodeCount);
+	ASSERT_EQ(numCodePoints, string.length() - 6);
+}
+
+TEST_F(StringUTF8Test, Utf8ToCodePointsBulkInvalid)
+{
+	const char utf8String[] = { 'a', static_cast<char>(0xc3), 0x28, static_cast<char>(0xa0), 'b', static_cast<char>(0xe2), static_cast<char>(0x81) };
+	const unsigned int length = sizeof(utf8String);
+	printf("Decoding a string with invalid and truncated sequences\n");
+
+	unsigned int codePoints[length];
+	const unsigned int numCodePoints = nctl::Utf8::utf8ToCodePoints(utf8String, length, codePoints);
+	ASSERT_EQ(numCodePoints, 6);
+	ASSERT_EQ(codePoints[0], 'a');
+	ASSERT_EQ(codePoints[1], nctl::Utf8::InvalidUnicode);
+	ASSERT_EQ(codePoints[2], 0x28);
+	ASSERT_EQ(codePoints[3], nctl::Utf8::InvalidUnicode);
+	ASSERT_EQ(codePoints[4], 'b');
+	ASSERT_EQ(codePoints[5], nctl::Utf8::InvalidUnicode);
+}
+
+TEST_F(StringUTF8Test, IsValidUtf8)
+{
+	string_ = "Ω⁋𝄞 abc";
+	printString("Validating the string: ", string_);
+	ASSERT_TRUE(string_.isValidUtf8());
+	ASSERT_TRUE(nctl::Utf8::isValid(veryLongCString, sizeof(veryLongCString) - 1));
+
+	const char overlong[] = { static_cast<char>(0xc0), static_cast<char>(0xaf) };
+	const char surrogate[] = { static_cast<char>(0xed), static_cast<char>(0xa0), static_cast<char>(0x80) };
+	const char beyondRange[] = { static_cast<char>(0xf4), static_cast<char>(0x90), static_cast<char>(0x80), static_cast<char>(0x80) };
+	const char truncated[] = { 'a', static_cast<char>(0xe2), static_cast<char>(0x81) };
+	const char continuation[] = { static_cast<char>(0x80), 'a' };
+	printf("Validating overlong, surrogate, out of range, truncated and unexpected sequences\n");
+	ASSERT_FALSE(nctl::Utf8::isValid(overlong, sizeof(overlong)));
+	ASSERT_FALSE(nctl::Utf8::isValid(surrogate, sizeof(surrogate)));
+	ASSERT_FALSE(nctl::Utf8::isValid(beyondRange, sizeof(beyondRange)));
+	ASSERT_FALSE(nctl::Utf8::isValid(truncated, sizeof(truncated)));
+	ASSERT_FALSE(nctl::Utf8::isValid(continuation, sizeof(continuation)));
+}
+
 }
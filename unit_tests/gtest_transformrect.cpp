@@ -0,0 +1,75 @@
+#include "TransformRect.h"
+#include "gtest_rect.h"
+
+namespace {
+
+const float Width = 100.0f;
+const float Height = 50.0f;
+const float PositionX = 300.0f;
+const float PositionY = 200.0f;
+
+/// Builds a world matrix in the same way as `SceneNode::transform()`
+nc::Matrix4x4f nodeMatrix(float rotation, float scale, float anchorX, float anchorY)
+{
+	nc::Matrix4x4f matrix = nc::Matrix4x4f::translation(PositionX, PositionY, 0.0f);
+	matrix.rotateZ(rotation);
+	matrix.scale(scale, scale, 1.0f);
+	matrix.translate(-anchorX, -anchorY, 0.0f);
+	return matrix;
+}
+
+const nc::Rectf localRect = nc::Rectf::fromCenterSize(0.0f, 0.0f, Width, Height);
+
+TEST(TransformRectTest, Identity)
+{
+	const nc::Rectf rect = nc::transformRect(nc::Matrix4x4f::Identity, localRect);
+	printf("Transforming by the identity: ");
+	printRect(rect);
+
+	ASSERT_FLOAT_EQ(rect.x, -Width * 0.5f);
+	ASSERT_FLOAT_EQ(rect.y, -Height * 0.5f);
+	ASSERT_FLOAT_EQ(rect.w, Width);
+	ASSERT_FLOAT_EQ(rect.h, Height);
+}
+
+TEST(TransformRectTest, CenteredAnchor)
+{
+	const nc::Rectf rect = nc::transformRect(nodeMatrix(0.0f, 1.0f, 0.0f, 0.0f), localRect);
+	printf("Transforming with a centered anchor point: ");
+	printRect(rect);
+
+	ASSERT_FLOAT_EQ(rect.x, PositionX - Width * 0.5f);
+	ASSERT_FLOAT_EQ(rect.y, PositionY - Height * 0.5f);
+	ASSERT_FLOAT_EQ(rect.w, Width);
+	ASSERT_FLOAT_EQ(rect.h, Height);
+}
+
+TEST(TransformRectTest, BottomLeftAnchor)
+{
+	// An anchor point at the bottom left corner puts the node position on that corner
+	const nc::Rectf rect = nc::transformRect(nodeMatrix(0.0f, 1.0f, -Width * 0.5f, -Height * 0.5f), localRect);
+	printf("Transforming with a bottom left anchor point: ");
+	printRect(rect);
+
+	ASSERT_FLOAT_EQ(rect.x, PositionX);
+	ASSERT_FLOAT_EQ(rect.y, PositionY);
+	ASSERT_FLOAT_EQ(rect.w, Width);
+	ASSERT_FLOAT_EQ(rect.h, Height);
+}
+
+TEST(TransformRectTest, RotatedScaledAnchor)
+{
+	// Rotating by 90 degrees around a bottom left anchor point swaps the sides and moves the box to the left
+	const float Scale = 2.0f;
+	const nc::Rectf rect = nc::transformRect(nodeMatrix(90.0f, Scale, -Width * 0.5f, -Height * 0.5f), localRect);
+	printf("Transforming with a rotated and scaled bottom left anchor point: ");
+	printRect(rect);
+
+	const float Epsilon = 0.001f;
+	ASSERT_NEAR(rect.x, PositionX - Height * Scale, Epsilon);
+	ASSERT_NEAR(rect.y, PositionY, Epsilon);
+	ASSERT_NEAR(rect.w, Height * Scale, Epsilon);
+	ASSERT_NEAR(rect.h, Width * Scale, Epsilon);
+}
+
+}
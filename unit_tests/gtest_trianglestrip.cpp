@@ -0,0 +1,85 @@
+#include "TriangleStrip.h"
+#include "gtest/gtest.h"
+
+namespace nc = ncine;
+
+namespace {
+
+const unsigned int FirstVertex = 100;
+// Two strips joined by degenerate triangles, like the ones of a mesh sprite
+const unsigned int NumStripIndices = 9;
+const unsigned short StripIndices[NumStripIndices] = { 0, 1, 2, 3, 3, 4, 4, 5, 6 };
+const unsigned int StripIndices32[NumStripIndices] = { 0, 1, 2, 3, 3, 4, 4, 5, 6 };
+const unsigned int NumListIndices = 9;
+const unsigned short ListIndices[NumListIndices] = { 0, 1, 2, 2, 1, 3, 4, 5, 6 };
+
+void printIndices(const nctl::Array<unsigned short> &indices)
+{
+	for (unsigned int i = 0; i < indices.size(); i++)
+		printf("%u ", indices[i]);
+	printf("\n");
+}
+
+TEST(TriangleStripTest, NonIndexedStrip)
+{
+	nctl::Array<unsigned short> indices;
+	nc::TriangleStrip::appendAsList(4, FirstVertex, indices);
+	printf("Converting a non-indexed strip of four vertices: ");
+	printIndices(indices);
+
+	const unsigned short expected[6] = { 0, 1, 2, 2, 1, 3 };
+	ASSERT_EQ(indices.size(), 6u);
+	for (unsigned int i = 0; i < indices.size(); i++)
+		ASSERT_EQ(indices[i], FirstVertex + expected[i]);
+}
+
+TEST(TriangleStripTest, StripWith16BitIndices)
+{
+	nctl::Array<unsigned short> indices;
+	nc::TriangleStrip::appendAsList(StripIndices, NumStripIndices, FirstVertex, indices);
+	printf("Converting a strip with 16-bit indices: ");
+	printIndices(indices);
+
+	ASSERT_EQ(indices.size(), NumListIndices);
+	for (unsigned int i = 0; i < indices.size(); i++)
+		ASSERT_EQ(indices[i], FirstVertex + ListIndices[i]);
+}
+
+TEST(TriangleStripTest, StripWith32BitIndices)
+{
+	nctl::Array<unsigned short> indices;
+	nc::TriangleStrip::appendAsList(StripIndices32, NumStripIndices, FirstVertex, indices);
+	printf("Converting a strip with 32-bit indices: ");
+	printIndices(indices);
+
+	ASSERT_EQ(indices.size(), NumListIndices);
+	for (unsigned int i = 0; i < indices.size(); i++)
+		ASSERT_EQ(indices[i], FirstVertex + ListIndices[i]);
+}
+
+TEST(TriangleStripTest, AppendToExistingIndices)
+{
+	nctl::Array<unsigned short> indices;
+	nc::TriangleStrip::appendAsList(StripIndices32, NumStripIndices, 0, indices);
+	nc::TriangleStrip::appendAsList(StripIndices32, NumStripIndices, FirstVertex, indices);
+	printf("Appending two strips with 32-bit indices: ");
+	printIndices(indices);
+
+	ASSERT_EQ(indices.size(), NumListIndices * 2);
+	for (unsigned int i = 0; i < NumListIndices; i++)
+	{
+		ASSERT_EQ(indices[i], ListIndices[i]);
+		ASSERT_EQ(indices[NumListIndices + i], FirstVertex + ListIndices[i]);
+	}
+}
+
+TEST(TriangleStripTest, TooFewIndices)
+{
+	nctl::Array<unsigned short> indices;
+	nc::TriangleStrip::appendAsList(StripIndices32, 2, FirstVertex, indices);
+	printf("Converting a strip with only two indices\n");
+
+	ASSERT_TRUE(indices.isEmpty());
+}
+
+}